@@ -0,0 +1,260 @@
+/*
+ * PotentialAllocationBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "LagrangianParameterManagement/SlhaCompatibleWithSarahManager.hpp"
+#include "PotentialEvaluation/PotentialFunctions/PotentialFromPolynomialWithMasses.hpp"
+#include "PotentialEvaluation/PotentialFunctions/FixedScaleOneLoopPotential.hpp"
+#include "PotentialEvaluation/PotentialFunctions/RgeImprovedOneLoopPotential.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// The benchmark counts calls of malloc, calloc and realloc by replacing them
+// with versions which forward to the glibc implementations. This catches the
+// allocations made by operator new as well as those made directly by Eigen.
+extern "C"
+{
+  void* __libc_malloc( size_t numberOfBytes );
+  void* __libc_calloc( size_t numberOfElements,
+                       size_t elementSize );
+  void* __libc_realloc( void* oldPointer,
+                        size_t numberOfBytes );
+}
+
+namespace
+{
+  bool countingAllocations( false );
+  size_t allocationCount( 0 );
+}
+
+extern "C"
+{
+  void* malloc( size_t numberOfBytes )
+  {
+    if( countingAllocations )
+    {
+      ++allocationCount;
+    }
+    return __libc_malloc( numberOfBytes );
+  }
+
+  void* calloc( size_t numberOfElements,
+                size_t elementSize )
+  {
+    if( countingAllocations )
+    {
+      ++allocationCount;
+    }
+    return __libc_calloc( numberOfElements,
+                          elementSize );
+  }
+
+  void* realloc( void* oldPointer,
+                 size_t numberOfBytes )
+  {
+    if( countingAllocations )
+    {
+      ++allocationCount;
+    }
+    return __libc_realloc( oldPointer,
+                           numberOfBytes );
+  }
+}
+
+
+// This evaluates the potential (or its gradient if evaluateGradient is true)
+// at each of fieldConfigurations numberOfPasses times after one warm-up pass,
+// and prints the number of heap allocations and the time per evaluation.
+void MeasureEvaluations(
+          VevaciousPlusPlus::PotentialFromPolynomialWithMasses const& potential,
+             std::vector< std::vector< double > > const& fieldConfigurations,
+                         double const temperatureValue,
+                         bool const evaluateGradient,
+                         size_t const numberOfPasses,
+                         std::string const& evaluationName )
+{
+  std::vector< double > gradientVector;
+  double potentialSum( 0.0 );
+  for( size_t passIndex( 0 );
+       passIndex <= numberOfPasses;
+       ++passIndex )
+  {
+    if( passIndex == 1 )
+    {
+      allocationCount = 0;
+      countingAllocations = true;
+    }
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      if( evaluateGradient )
+      {
+        potential.SetAsGradientAt( gradientVector,
+                                fieldConfigurations[ configurationIndex ],
+                                   1.0,
+                                   temperatureValue );
+        potentialSum += gradientVector.front();
+      }
+      else
+      {
+        potentialSum += potential( fieldConfigurations[ configurationIndex ],
+                                   temperatureValue );
+      }
+    }
+  }
+  countingAllocations = false;
+  double const numberOfEvaluations( numberOfPasses
+                                    * fieldConfigurations.size() );
+  std::cout << evaluationName << ": "
+  << ( allocationCount / numberOfEvaluations )
+  << " allocations per evaluation (checksum " << potentialSum << ")"
+  << std::endl;
+}
+
+// This times the evaluations of the potential after the warm-up pass.
+void TimeEvaluations(
+          VevaciousPlusPlus::PotentialFromPolynomialWithMasses const& potential,
+             std::vector< std::vector< double > > const& fieldConfigurations,
+                      size_t const numberOfPasses,
+                      std::string const& evaluationName )
+{
+  double potentialSum( 0.0 );
+  std::chrono::steady_clock::time_point const
+  startTime( std::chrono::steady_clock::now() );
+  for( size_t passIndex( 0 );
+       passIndex < numberOfPasses;
+       ++passIndex )
+  {
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      potentialSum += potential( fieldConfigurations[ configurationIndex ] );
+    }
+  }
+  double const elapsedSeconds( std::chrono::duration< double >(
+                      std::chrono::steady_clock::now() - startTime ).count() );
+  std::cout << evaluationName << ": "
+  << ( ( 1.0e6 * elapsedSeconds )
+       / ( numberOfPasses * fieldConfigurations.size() ) )
+  << " microseconds per evaluation (checksum " << potentialSum << ")"
+  << std::endl;
+}
+
+// This measures the allocations of the potential and its gradient at zero
+// and non-zero temperature.
+void MeasurePotential(
+          VevaciousPlusPlus::PotentialFromPolynomialWithMasses const& potential,
+                       size_t const numberOfPasses,
+                       std::string const& potentialName )
+{
+  // The field configurations are spread deterministically over a box of
+  // a few TeV so that the results can be compared between builds.
+  std::vector< std::vector< double > > fieldConfigurations( 64,
+                  std::vector< double >( potential.NumberOfFieldVariables() ) );
+  for( size_t configurationIndex( 0 );
+       configurationIndex < fieldConfigurations.size();
+       ++configurationIndex )
+  {
+    for( size_t fieldIndex( 0 );
+         fieldIndex < potential.NumberOfFieldVariables();
+         ++fieldIndex )
+    {
+      fieldConfigurations[ configurationIndex ][ fieldIndex ]
+      = ( 100.0 * static_cast< double >( ( ( 7 * configurationIndex )
+                                           + ( 13 * fieldIndex ) ) % 41 )
+          - 2000.0 );
+    }
+  }
+  MeasureEvaluations( potential,
+                      fieldConfigurations,
+                      0.0,
+                      false,
+                      numberOfPasses,
+                      ( potentialName + " at T = 0" ) );
+  MeasureEvaluations( potential,
+                      fieldConfigurations,
+                      100.0,
+                      false,
+                      numberOfPasses,
+                      ( potentialName + " at T = 100 GeV" ) );
+  MeasureEvaluations( potential,
+                      fieldConfigurations,
+                      0.0,
+                      true,
+                      numberOfPasses,
+                      ( potentialName + " gradient at T = 0" ) );
+  MeasureEvaluations( potential,
+                      fieldConfigurations,
+                      100.0,
+                      true,
+                      numberOfPasses,
+                      ( potentialName + " gradient at T = 100 GeV" ) );
+  TimeEvaluations( potential,
+                   fieldConfigurations,
+                   numberOfPasses,
+                   ( potentialName + " at T = 0" ) );
+}
+
+
+// This reads the Lagrangian parameters from an SLHA file for the model and
+// then counts the heap allocations made by evaluations of the fixed-scale
+// and RGE-improved one-loop potentials once the per-thread buffers have been
+// filled. A steady-state evaluation of the potential should make no
+// allocations. A steady-state evaluation of the gradient should only make the
+// one allocation per mass-squared matrix which SelfAdjointEigenSolver makes
+// when it finds the eigenvectors.
+int main( int argumentCount,
+          char** argumentCharArrays )
+{
+  if( argumentCount < 4 )
+  {
+    std::cout
+    << "Usage: PotentialAllocationBenchmark <ScaleAndBlockFile> <ModelFile>"
+    << " <SlhaFile> [number of passes]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string const scaleAndBlockFilename( argumentCharArrays[ 1 ] );
+  std::string const modelFilename( argumentCharArrays[ 2 ] );
+  std::string const slhaFilename( argumentCharArrays[ 3 ] );
+  size_t const numberOfPasses( ( argumentCount > 4 ) ?
+                               atoi( argumentCharArrays[ 4 ] ) :
+                               100 );
+
+  try
+  {
+    VevaciousPlusPlus::SlhaCompatibleWithSarahManager
+    lagrangianParameterManager( scaleAndBlockFilename );
+    VevaciousPlusPlus::FixedScaleOneLoopPotential
+    fixedScalePotential( modelFilename,
+                         0.5,
+                         lagrangianParameterManager );
+    VevaciousPlusPlus::RgeImprovedOneLoopPotential
+    rgeImprovedPotential( modelFilename,
+                          0.5,
+                          lagrangianParameterManager );
+    lagrangianParameterManager.NewParameterPoint( slhaFilename );
+    MeasurePotential( fixedScalePotential,
+                      numberOfPasses,
+                      "FixedScaleOneLoopPotential" );
+    MeasurePotential( rgeImprovedPotential,
+                      numberOfPasses,
+                      "RgeImprovedOneLoopPotential" );
+  }
+  catch( std::exception& caughtException )
+  {
+    std::cout << "Exception caught: " << caughtException.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
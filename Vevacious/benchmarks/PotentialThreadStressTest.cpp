@@ -0,0 +1,293 @@
+/*
+ * PotentialThreadStressTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "LagrangianParameterManagement/SlhaCompatibleWithSarahManager.hpp"
+#include "PotentialEvaluation/BuildingBlocks/FixedScaleCoefficients.hpp"
+#include "PotentialEvaluation/PotentialFunctions/FixedScaleOneLoopPotential.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+
+namespace
+{
+  // This holds the values of the potential and its gradient at each field
+  // configuration at zero and at non-zero temperature.
+  struct EvaluationResults
+  {
+    std::vector< double > potentialValues;
+    std::vector< std::vector< double > > gradientVectors;
+  };
+
+  double const stressTemperatures[] = { 0.0,
+                                        100.0 };
+  size_t const numberOfTemperatures( 2 );
+
+  // This fills the results for configurationIndex into evaluationResults,
+  // which must already be sized for all the configurations and temperatures.
+  void EvaluateConfiguration(
+               VevaciousPlusPlus::FixedScaleOneLoopPotential const& potential,
+         VevaciousPlusPlus::FixedScaleCoefficients const& coefficientSnapshot,
+             std::vector< std::vector< double > > const& fieldConfigurations,
+                              size_t const configurationIndex,
+                              EvaluationResults& evaluationResults )
+  {
+    for( size_t temperatureIndex( 0 );
+         temperatureIndex < numberOfTemperatures;
+         ++temperatureIndex )
+    {
+      size_t const resultIndex( ( temperatureIndex
+                                  * fieldConfigurations.size() )
+                                + configurationIndex );
+      evaluationResults.potentialValues[ resultIndex ]
+      = potential( coefficientSnapshot,
+                   fieldConfigurations[ configurationIndex ],
+                   stressTemperatures[ temperatureIndex ] );
+      potential.SetAsGradientAt( coefficientSnapshot,
+                              evaluationResults.gradientVectors[ resultIndex ],
+                                 fieldConfigurations[ configurationIndex ],
+                                 stressTemperatures[ temperatureIndex ] );
+    }
+  }
+
+  // This evaluates every configuration on the calling thread.
+  EvaluationResults SerialResults(
+               VevaciousPlusPlus::FixedScaleOneLoopPotential const& potential,
+         VevaciousPlusPlus::FixedScaleCoefficients const& coefficientSnapshot,
+             std::vector< std::vector< double > > const& fieldConfigurations )
+  {
+    EvaluationResults serialResults;
+    serialResults.potentialValues.resize( numberOfTemperatures
+                                          * fieldConfigurations.size() );
+    serialResults.gradientVectors.resize( numberOfTemperatures
+                                          * fieldConfigurations.size() );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      EvaluateConfiguration( potential,
+                             coefficientSnapshot,
+                             fieldConfigurations,
+                             configurationIndex,
+                             serialResults );
+    }
+    return serialResults;
+  }
+
+  // This evaluates every configuration numberOfRounds times, shared out over
+  // all the OpenMP threads in a different order in each round, and returns
+  // the number of results which are not bit-for-bit identical to those in
+  // serialResults.
+  size_t CountParallelMismatches(
+               VevaciousPlusPlus::FixedScaleOneLoopPotential const& potential,
+         VevaciousPlusPlus::FixedScaleCoefficients const& coefficientSnapshot,
+             std::vector< std::vector< double > > const& fieldConfigurations,
+                                  EvaluationResults const& serialResults,
+                                  size_t const numberOfRounds )
+  {
+    size_t mismatchCount( 0 );
+    int const numberOfConfigurations( fieldConfigurations.size() );
+#pragma omp parallel reduction( + : mismatchCount )
+    {
+      EvaluationResults threadResults;
+      threadResults.potentialValues.resize( numberOfTemperatures
+                                            * fieldConfigurations.size() );
+      threadResults.gradientVectors.resize( numberOfTemperatures
+                                            * fieldConfigurations.size() );
+      for( size_t roundIndex( 0 );
+           roundIndex < numberOfRounds;
+           ++roundIndex )
+      {
+#pragma omp for schedule( dynamic )
+        for( int loopIndex = 0;
+             loopIndex < numberOfConfigurations;
+             ++loopIndex )
+        {
+          // Each round starts the configurations at a different place so that
+          // the threads interleave differently.
+          size_t const configurationIndex( ( loopIndex + ( 7 * roundIndex ) )
+                                           % numberOfConfigurations );
+          EvaluateConfiguration( potential,
+                                 coefficientSnapshot,
+                                 fieldConfigurations,
+                                 configurationIndex,
+                                 threadResults );
+          for( size_t temperatureIndex( 0 );
+               temperatureIndex < numberOfTemperatures;
+               ++temperatureIndex )
+          {
+            size_t const resultIndex( ( temperatureIndex
+                                        * fieldConfigurations.size() )
+                                      + configurationIndex );
+            if( ( threadResults.potentialValues[ resultIndex ]
+                  != serialResults.potentialValues[ resultIndex ] )
+                ||
+                ( threadResults.gradientVectors[ resultIndex ]
+                  != serialResults.gradientVectors[ resultIndex ] ) )
+            {
+              ++mismatchCount;
+            }
+          }
+        }
+      }
+    }
+    return mismatchCount;
+  }
+}
+
+
+// This evaluates a single FixedScaleOneLoopPotential from all the OpenMP
+// threads at once with the coefficient snapshot of one parameter point and
+// checks that every value of the potential and of its gradient is
+// bit-for-bit identical to the value from serial evaluation, and that a copy
+// of the potential bound to a second Lagrangian parameter manager gives the
+// same values for the same parameter point. It then reads a
+// second parameter point and checks that the snapshot of the first point
+// still gives identical results, both from serial and from parallel
+// evaluation, as snapshots are never changed once they have been filled.
+int main( int argumentCount,
+          char** argumentCharArrays )
+{
+  if( argumentCount < 5 )
+  {
+    std::cout
+    << "Usage: PotentialThreadStressTest <ScaleAndBlockFile> <ModelFile>"
+    << " <SlhaFile> <SecondSlhaFile> [number of rounds]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string const scaleAndBlockFilename( argumentCharArrays[ 1 ] );
+  std::string const modelFilename( argumentCharArrays[ 2 ] );
+  std::string const slhaFilename( argumentCharArrays[ 3 ] );
+  std::string const secondSlhaFilename( argumentCharArrays[ 4 ] );
+  size_t const numberOfRounds( ( argumentCount > 5 ) ?
+                               atoi( argumentCharArrays[ 5 ] ) :
+                               20 );
+
+  try
+  {
+    VevaciousPlusPlus::SlhaCompatibleWithSarahManager
+    lagrangianParameterManager( scaleAndBlockFilename );
+    VevaciousPlusPlus::FixedScaleOneLoopPotential
+    fixedScalePotential( modelFilename,
+                         0.5,
+                         lagrangianParameterManager );
+    lagrangianParameterManager.NewParameterPoint( slhaFilename );
+
+    // The field configurations are spread deterministically over a box of
+    // a few TeV as in PotentialAllocationBenchmark.
+    std::vector< std::vector< double > > fieldConfigurations( 64,
+                                   std::vector< double >(
+                                fixedScalePotential.NumberOfFieldVariables() ) );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      for( size_t fieldIndex( 0 );
+           fieldIndex < fixedScalePotential.NumberOfFieldVariables();
+           ++fieldIndex )
+      {
+        fieldConfigurations[ configurationIndex ][ fieldIndex ]
+        = ( 100.0 * static_cast< double >( ( ( 7 * configurationIndex )
+                                             + ( 13 * fieldIndex ) ) % 41 )
+            - 2000.0 );
+      }
+    }
+
+    std::shared_ptr< VevaciousPlusPlus::FixedScaleCoefficients const >
+    firstSnapshot( fixedScalePotential.CoefficientSnapshot() );
+    EvaluationResults const firstResults( SerialResults( fixedScalePotential,
+                                                         *firstSnapshot,
+                                                       fieldConfigurations ) );
+    size_t const parallelMismatches( CountParallelMismatches(
+                                                           fixedScalePotential,
+                                                                *firstSnapshot,
+                                                           fieldConfigurations,
+                                                                  firstResults,
+                                                            numberOfRounds ) );
+    std::cout << omp_get_max_threads() << " threads, " << numberOfRounds
+    << " rounds: " << parallelMismatches
+    << " results differ from serial evaluation." << std::endl;
+
+    // A copy bound to a Lagrangian parameter manager of its own, as made for
+    // each extra thread of the main program, should give exactly the same
+    // results for the same parameter point.
+    VevaciousPlusPlus::SlhaCompatibleWithSarahManager
+    copyParameterManager( scaleAndBlockFilename );
+    VevaciousPlusPlus::FixedScaleOneLoopPotential
+    copiedPotential( fixedScalePotential,
+                     copyParameterManager );
+    copyParameterManager.NewParameterPoint( slhaFilename );
+    std::shared_ptr< VevaciousPlusPlus::FixedScaleCoefficients const >
+    copiedSnapshot( copiedPotential.CoefficientSnapshot() );
+    EvaluationResults const copiedResults( SerialResults( copiedPotential,
+                                                          *copiedSnapshot,
+                                                       fieldConfigurations ) );
+    bool const copyDiffers( ( copiedResults.potentialValues
+                              != firstResults.potentialValues )
+                            ||
+                            ( copiedResults.gradientVectors
+                              != firstResults.gradientVectors ) );
+    std::cout << "The copy bound to its own parameter manager "
+    << ( copyDiffers ? "differs from" : "matches" ) << " the original."
+    << std::endl;
+
+    lagrangianParameterManager.NewParameterPoint( secondSlhaFilename );
+    std::shared_ptr< VevaciousPlusPlus::FixedScaleCoefficients const >
+    secondSnapshot( fixedScalePotential.CoefficientSnapshot() );
+    EvaluationResults const secondResults( SerialResults( fixedScalePotential,
+                                                          *secondSnapshot,
+                                                       fieldConfigurations ) );
+    EvaluationResults const keptResults( SerialResults( fixedScalePotential,
+                                                        *firstSnapshot,
+                                                       fieldConfigurations ) );
+    size_t keptMismatches( CountParallelMismatches( fixedScalePotential,
+                                                    *firstSnapshot,
+                                                    fieldConfigurations,
+                                                    firstResults,
+                                                    numberOfRounds ) );
+    if( ( keptResults.potentialValues != firstResults.potentialValues )
+        ||
+        ( keptResults.gradientVectors != firstResults.gradientVectors ) )
+    {
+      ++keptMismatches;
+    }
+    std::cout << "After the second point: " << keptMismatches
+    << " results from the snapshot of the first point have changed."
+    << std::endl;
+    bool const secondPointDiffers( secondResults.potentialValues
+                                   != firstResults.potentialValues );
+    if( !secondPointDiffers )
+    {
+      std::cout << "The second point gives the same values as the first, so"
+      << " the snapshots were not tested." << std::endl;
+    }
+
+    if( ( parallelMismatches > 0 )
+        ||
+        copyDiffers
+        ||
+        ( keptMismatches > 0 )
+        ||
+        !secondPointDiffers )
+    {
+      std::cout << "FAILED" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "PASSED" << std::endl;
+  }
+  catch( std::exception& caughtException )
+  {
+    std::cout << "Exception caught: " << caughtException.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
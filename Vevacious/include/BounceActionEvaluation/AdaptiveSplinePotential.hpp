@@ -0,0 +1,267 @@
+/*
+ * AdaptiveSplinePotential.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef ADAPTIVESPLINEPOTENTIAL_HPP_
+#define ADAPTIVESPLINEPOTENTIAL_HPP_
+
+#include "OneDimensionalPotentialAlongPath.hpp"
+#include "PotentialEvaluation/PotentialFunction.hpp"
+#include "PathParameterization/TunnelPath.hpp"
+#include <cstddef>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+namespace VevaciousPlusPlus
+{
+  // This class approximates the potential along a path like SplinePotential,
+  // but rather than sampling the potential at a fixed number of evenly-spaced
+  // points, it starts with numberOfInitialSegments evenly-spaced segments and
+  // then repeatedly halves those segments where the potential at the middle
+  // of the segment differs from the interpolation of the points so far by
+  // more than relativeTolerance times the range of the potential along the
+  // path, down to segments of length 1 / maximumNumberOfSegments. The
+  // potential at the middles of all the segments being halved in a round is
+  // evaluated as a single batch. The segments ending at the path false vacuum
+  // and at the path panic vacuum are quadratics without linear terms, as in
+  // SplinePotential, and the segments in between are cubic Hermite
+  // polynomials with slopes at the points chosen by the Fritsch-Butland
+  // weighted harmonic mean, which keeps the potential monotonic between the
+  // points, so the interpolation does not introduce extra extrema.
+  class AdaptiveSplinePotential : public OneDimensionalPotentialAlongPath
+  {
+  public:
+    AdaptiveSplinePotential( PotentialFunction const& potentialFunction,
+                             TunnelPath const& tunnelPath,
+                             unsigned int const numberOfInitialSegments,
+                             unsigned int const maximumNumberOfSegments,
+                             double const relativeTolerance,
+                          double const minimumSquareDistanceBetweenPathVacua );
+    virtual ~AdaptiveSplinePotential();
+
+
+    virtual bool EnergyBarrierWasResolved() const
+    { return energyBarrierWasResolved; }
+
+    // This returns the value of the potential at auxiliaryValue, by finding
+    // the correct segment and then returning its value at that point.
+    virtual double operator()( double auxiliaryValue ) const;
+
+    // This returns the value of the first derivative of the potential at
+    // auxiliaryValue, by finding the correct segment and then returning its
+    // slope at that point.
+    virtual double FirstDerivative( double const auxiliaryValue ) const;
+
+    // This returns the value of the second derivative of the potential at
+    // the false vacuum end of the path.
+    virtual double SecondDerivativeAtFalseVacuum() const
+    { return ( firstSegmentQuadratic + firstSegmentQuadratic ); }
+
+    // This returns the value of the first derivative of the potential at
+    // (auxiliaryOfPathPanicVacuum + differenceFromMaximumAuxiliary), assuming
+    // that it is in the final segment.
+    virtual double FirstDerivativeNearPathPanic(
+                            double const differenceFromMaximumAuxiliary ) const
+    { return ( 2.0 * differenceFromMaximumAuxiliary * lastSegmentQuadratic ); }
+
+    // This returns the value of the second derivative of the potential at
+    // (auxiliaryOfPathPanicVacuum + differenceFromMaximumAuxiliary), assuming
+    // that it is in the final segment. The second derivative is constant in
+    // the segment, so differenceFromMaximumAuxiliary is ignored.
+    virtual double SecondDerivativeNearPathPanic(
+                            double const differenceFromMaximumAuxiliary ) const
+    { return ( lastSegmentQuadratic + lastSegmentQuadratic ); }
+
+    // This returns the number of points along the path at which the full
+    // potential was evaluated.
+    size_t NumberOfPotentialEvaluations() const
+    { return sampleAuxiliaries.size(); }
+
+
+  protected:
+    PotentialFunction const& potentialFunction;
+    TunnelPath const& tunnelPath;
+    double const pathTemperature;
+    // The auxiliary values of all the points at which the potential was
+    // evaluated are kept in increasing order in sampleAuxiliaries, with the
+    // potential at each in samplePotentials.
+    std::vector< double > sampleAuxiliaries;
+    std::vector< double > samplePotentials;
+    // Once the path vacua have been found, the points from the path false
+    // vacuum to the path panic vacuum are copied into nodeAuxiliaries, with
+    // the potential relative to the path false vacuum in nodePotentials, and
+    // the slope of the interpolation at each of these points in nodeSlopes.
+    std::vector< double > nodeAuxiliaries;
+    std::vector< double > nodePotentials;
+    std::vector< double > nodeSlopes;
+    double firstSegmentQuadratic;
+    double finalPotential;
+    double lastSegmentQuadratic;
+    bool energyBarrierWasResolved;
+
+
+    // This fills sampleAuxiliaries and samplePotentials by halving segments
+    // of the path until the interpolation is within relativeTolerance of the
+    // potential at the middle of each segment, or the segment has reached the
+    // minimum length.
+    void SampleAdaptively( unsigned int const numberOfInitialSegments,
+                           unsigned int const maximumNumberOfSegments,
+                           double const relativeTolerance );
+
+    // This evaluates the potential at each of the points on tunnelPath given
+    // by pathAuxiliaries as a single batch, putting the values in
+    // potentialValues.
+    void EvaluateAlongPath( std::vector< double > const& pathAuxiliaries,
+                            std::vector< double >& potentialValues ) const;
+
+    // This goes along the sampled points in the same way as SplinePotential
+    // goes along the ends of its segments, to find the path false vacuum, the
+    // end of the energy barrier, and the path panic vacuum, repeating if the
+    // path panic vacuum is too close to the false vacuum end of the path. It
+    // returns true and sets falseIndex and panicIndex to be the indices of
+    // the sampled points of the path vacua if it finds an energy barrier
+    // which is resolved, and returns false otherwise.
+    bool FindPathVacua( double const minimumSquareDistanceBetweenPathVacua,
+                        size_t& falseIndex,
+                        size_t& panicIndex );
+
+    // This copies the sampled points from falseIndex to panicIndex into the
+    // node vectors and sets up the quadratic end segments and the slopes for
+    // the cubic segments in between.
+    void SetUpInterpolation( size_t const falseIndex,
+                             size_t const panicIndex );
+
+    // This returns the index of the node at the start of the segment which
+    // contains auxiliaryValue, assuming that it is between the path vacua.
+    size_t SegmentIndex( double const auxiliaryValue ) const;
+
+    // This fills pointSlopes with slopes at each of the points given by
+    // pointAuxiliaries and pointValues which keep a cubic Hermite
+    // interpolation monotonic between the points, taking the slope of the
+    // straight line to the neighboring point for the first and last points.
+    static void
+    SetMonotonicSlopes( std::vector< double > const& pointAuxiliaries,
+                        std::vector< double > const& pointValues,
+                        std::vector< double >& pointSlopes );
+
+    // This returns the slope closest to givenSlope which keeps a cubic
+    // Hermite interpolation monotonic over a segment with the slope of the
+    // straight line between its ends being segmentSlope.
+    static double LimitedSlope( double const givenSlope,
+                                double const segmentSlope );
+
+    // This returns the value at auxiliaryValue of the cubic Hermite
+    // polynomial with value startValue and slope startSlope at
+    // startAuxiliary and value endValue and slope endSlope at endAuxiliary.
+    static double HermiteValue( double const auxiliaryValue,
+                                double const startAuxiliary,
+                                double const endAuxiliary,
+                                double const startValue,
+                                double const endValue,
+                                double const startSlope,
+                                double const endSlope );
+
+    // This returns the first derivative at auxiliaryValue of the cubic
+    // Hermite polynomial with value startValue and slope startSlope at
+    // startAuxiliary and value endValue and slope endSlope at endAuxiliary.
+    static double HermiteSlope( double const auxiliaryValue,
+                                double const startAuxiliary,
+                                double const endAuxiliary,
+                                double const startValue,
+                                double const endValue,
+                                double const startSlope,
+                                double const endSlope );
+  };
+
+
+
+
+  // This returns the index of the node at the start of the segment which
+  // contains auxiliaryValue, assuming that it is between the path vacua.
+  inline size_t
+  AdaptiveSplinePotential::SegmentIndex( double const auxiliaryValue ) const
+  {
+    size_t const nodeAfter( std::upper_bound( nodeAuxiliaries.begin() + 1,
+                                              nodeAuxiliaries.end() - 1,
+                                              auxiliaryValue )
+                            - nodeAuxiliaries.begin() );
+    return ( nodeAfter - 1 );
+  }
+
+  // This returns the slope closest to givenSlope which keeps a cubic Hermite
+  // interpolation monotonic over a segment with the slope of the straight
+  // line between its ends being segmentSlope.
+  inline double AdaptiveSplinePotential::LimitedSlope( double const givenSlope,
+                                                   double const segmentSlope )
+  {
+    if( !( ( givenSlope * segmentSlope ) > 0.0 ) )
+    {
+      return 0.0;
+    }
+    if( fabs( givenSlope ) > ( 3.0 * fabs( segmentSlope ) ) )
+    {
+      return ( 3.0 * segmentSlope );
+    }
+    return givenSlope;
+  }
+
+  // This returns the value at auxiliaryValue of the cubic Hermite polynomial
+  // with value startValue and slope startSlope at startAuxiliary and value
+  // endValue and slope endSlope at endAuxiliary.
+  inline double
+  AdaptiveSplinePotential::HermiteValue( double const auxiliaryValue,
+                                         double const startAuxiliary,
+                                         double const endAuxiliary,
+                                         double const startValue,
+                                         double const endValue,
+                                         double const startSlope,
+                                         double const endSlope )
+  {
+    double const segmentLength( endAuxiliary - startAuxiliary );
+    double const segmentFraction( ( auxiliaryValue - startAuxiliary )
+                                  / segmentLength );
+    double const fractionSquared( segmentFraction * segmentFraction );
+    double const fractionCubed( fractionSquared * segmentFraction );
+    return ( ( ( ( 2.0 * fractionCubed ) - ( 3.0 * fractionSquared ) + 1.0 )
+               * startValue )
+             + ( ( fractionCubed - ( 2.0 * fractionSquared )
+                   + segmentFraction )
+                 * segmentLength * startSlope )
+             + ( ( ( 3.0 * fractionSquared ) - ( 2.0 * fractionCubed ) )
+                 * endValue )
+             + ( ( fractionCubed - fractionSquared )
+                 * segmentLength * endSlope ) );
+  }
+
+  // This returns the first derivative at auxiliaryValue of the cubic Hermite
+  // polynomial with value startValue and slope startSlope at startAuxiliary
+  // and value endValue and slope endSlope at endAuxiliary.
+  inline double
+  AdaptiveSplinePotential::HermiteSlope( double const auxiliaryValue,
+                                         double const startAuxiliary,
+                                         double const endAuxiliary,
+                                         double const startValue,
+                                         double const endValue,
+                                         double const startSlope,
+                                         double const endSlope )
+  {
+    double const segmentLength( endAuxiliary - startAuxiliary );
+    double const segmentFraction( ( auxiliaryValue - startAuxiliary )
+                                  / segmentLength );
+    double const fractionSquared( segmentFraction * segmentFraction );
+    return ( ( ( ( 6.0 * fractionSquared ) - ( 6.0 * segmentFraction ) )
+               * ( startValue - endValue ) / segmentLength )
+             + ( ( ( 3.0 * fractionSquared ) - ( 4.0 * segmentFraction )
+                   + 1.0 )
+                 * startSlope )
+             + ( ( ( 3.0 * fractionSquared ) - ( 2.0 * segmentFraction ) )
+                 * endSlope ) );
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* ADAPTIVESPLINEPOTENTIAL_HPP_ */
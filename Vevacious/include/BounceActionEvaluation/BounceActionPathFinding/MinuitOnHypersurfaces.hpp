@@ -70,6 +70,52 @@ namespace VevaciousPlusPlus
 
 
   protected:
+    // This class evaluates MinuitOnHypersurfaces::operator() on its own
+    // hyperplane, given by its own reflection matrix and origin rather than
+    // by reflectionMatrix and currentHyperplaneOrigin of the path finder, so
+    // that the minimizations on the hyperplanes for several nodes can run at
+    // once, each with its own instance.
+    class NodeHyperplanePotential : public ROOT::Minuit2::FCNBase
+    {
+    public:
+      NodeHyperplanePotential( MinuitOnHypersurfaces const& pathFinder,
+                               Eigen::MatrixXd const& hyperplaneReflection,
+                               Eigen::VectorXd const& hyperplaneOrigin ) :
+        ROOT::Minuit2::FCNBase(),
+        pathFinder( pathFinder ),
+        hyperplaneReflection( hyperplaneReflection ),
+        hyperplaneOrigin( hyperplaneOrigin ) {}
+
+      virtual ~NodeHyperplanePotential() {}
+
+
+      // This returns the value of the potential with the penalty for the
+      // length of nodeParameterization, as for
+      // MinuitOnHypersurfaces::operator(), on this object's hyperplane.
+      virtual double
+      operator()( std::vector< double > const& nodeParameterization ) const
+      { return pathFinder.PotentialOnHyperplane( nodeParameterization,
+                                                 hyperplaneReflection,
+                                                 hyperplaneOrigin ); }
+
+      virtual double Up() const { return pathFinder.Up(); }
+
+
+    protected:
+      MinuitOnHypersurfaces const& pathFinder;
+      Eigen::MatrixXd const& hyperplaneReflection;
+      Eigen::VectorXd const& hyperplaneOrigin;
+    };
+
+
+    // This sets up hyperplaneReflection to be the Householder reflection
+    // matrix which reflects the axis of field 0 to be parallel to
+    // parallelComponent.
+    static void
+    SetUpHouseholderReflection( Eigen::VectorXd const& parallelComponent,
+                                Eigen::MatrixXd& hyperplaneReflection );
+
+
     PotentialFunction const* potentialFunction;
     double potentialAtOrigin;
     double maximumFieldVectorLengthSquared;
@@ -103,10 +149,22 @@ namespace VevaciousPlusPlus
     // maximumFieldVectorLengthSquared.
     double PotentialValue( std::vector< double > fieldConfiguration ) const;
 
+    // This takes nodeParameterization as a vector in the hyperplane
+    // perpendicular to field 0, applies hyperplaneReflection to it, adds the
+    // result to hyperplaneOrigin, and returns the potential function for that
+    // field configuration, plus the fourth power of the Euclidean length of
+    // nodeParameterization as a penalty.
+    double
+    PotentialOnHyperplane( std::vector< double > const& nodeParameterization,
+                           Eigen::MatrixXd const& hyperplaneReflection,
+                           Eigen::VectorXd const& hyperplaneOrigin ) const;
+
     // This sets up reflectionMatrix to be the Householder reflection matrix
     // which reflects the axis of field 0 to be parallel to
     // currentParallelComponent.
-    void SetUpHouseholderReflection();
+    void SetUpHouseholderReflection()
+    { SetUpHouseholderReflection( currentParallelComponent,
+                                  reflectionMatrix ); }
 
     // This takes the numberOfFields-1-dimensional vector and prepends a 0 to
     // make an numberOfFields-dimensional Eigen::VectorXd.
@@ -153,6 +211,16 @@ namespace VevaciousPlusPlus
     // currentHyperplaneOrigin) and puts that into resultVector.
     virtual void
     RunMigradAndPutTransformedResultIn( std::vector< double >& resultVector );
+
+    // This creates and runs a Minuit2 MnMigrad object on a
+    // NodeHyperplanePotential for the hyperplane through hyperplaneOrigin
+    // which is perpendicular to parallelComponent, and returns the result as
+    // a displacement from hyperplaneOrigin, or a zero displacement if Minuit2
+    // did not find a lower value than at hyperplaneOrigin. It does not change
+    // any member variables, so it can be called from several threads at once.
+    Eigen::VectorXd
+    HyperplaneMinimumDisplacement( Eigen::VectorXd const& hyperplaneOrigin,
+                            Eigen::VectorXd const& parallelComponent ) const;
   };
 
 
@@ -203,7 +271,22 @@ namespace VevaciousPlusPlus
   inline double MinuitOnHypersurfaces::operator()(
                       std::vector< double > const& nodeParameterization ) const
   {
-    Eigen::VectorXd const transformedNode( reflectionMatrix
+    return PotentialOnHyperplane( nodeParameterization,
+                                  reflectionMatrix,
+                                  currentHyperplaneOrigin );
+  }
+
+  // This takes nodeParameterization as a vector in the hyperplane
+  // perpendicular to field 0, applies hyperplaneReflection to it, adds the
+  // result to hyperplaneOrigin, and returns the potential function for that
+  // field configuration, plus the fourth power of the Euclidean length of
+  // nodeParameterization as a penalty.
+  inline double MinuitOnHypersurfaces::PotentialOnHyperplane(
+                           std::vector< double > const& nodeParameterization,
+                                   Eigen::MatrixXd const& hyperplaneReflection,
+                                Eigen::VectorXd const& hyperplaneOrigin ) const
+  {
+    Eigen::VectorXd const transformedNode( hyperplaneReflection
                                  * UntransformedNode( nodeParameterization ) );
     std::vector< double > fieldConfiguration( numberOfFields );
     double parameterizationLengthSquared( 0.0 );
@@ -212,7 +295,7 @@ namespace VevaciousPlusPlus
          ++fieldIndex )
     {
       fieldConfiguration[ fieldIndex ] = ( transformedNode( fieldIndex )
-                                     + currentHyperplaneOrigin( fieldIndex ) );
+                                           + hyperplaneOrigin( fieldIndex ) );
       parameterizationLengthSquared
       += ( transformedNode( fieldIndex ) * transformedNode( fieldIndex ) );
     }
@@ -30,7 +30,8 @@ namespace VevaciousPlusPlus
                                           double const dampingFactor,
                        std::vector< double > const neighborDisplacementWeights,
                                           unsigned int const minuitStrategy,
-                                        double const minuitToleranceFraction );
+                                         double const minuitToleranceFraction,
+                                      unsigned int const numberOfThreads = 1 );
     virtual ~MinuitOnPotentialPerpendicularToPath();
 
 
@@ -49,7 +50,13 @@ namespace VevaciousPlusPlus
     // are all sufficiently close to their starting points from lastPath,
     // nodesConverged is set to true. (The bubble profile from the last path is
     // ignored, but there is an empty hook in the loop to allow derived classes
-    // to use it.)
+    // to use it.) If numberOfThreads is not 1, the minimizations for the
+    // nodes are shared out among that many threads (or the OpenMP default if
+    // it is 0), each node with its own hyperplane and Minuit2 function, as
+    // each only depends on lastPath. In that case,
+    // AccountForBubbleProfileAroundNode is not called and operator() is not
+    // used, so derived classes which over-ride either should be constructed
+    // with numberOfThreads = 1.
     virtual TunnelPath const* TryToImprovePath( TunnelPath const& lastPath,
                                      BubbleProfile const& bubbleFromLastPath );
 
@@ -64,6 +71,20 @@ namespace VevaciousPlusPlus
     std::vector< Eigen::VectorXd > nodeDisplacements;
     double bounceBeforeLastPath;
     bool nodesConverged;
+    unsigned int const numberOfThreads;
+
+
+    // This sets nodeDisplacements[ nodeIndex ] for each varying node by
+    // running Minuit2 on the hyperplane for each node in turn through
+    // reflectionMatrix and currentHyperplaneOrigin, calling
+    // AccountForBubbleProfileAroundNode before each.
+    void SetNodeDisplacementsSerially(
+                                     BubbleProfile const& bubbleFromLastPath );
+
+    // This sets nodeDisplacements[ nodeIndex ] for each varying node by
+    // running Minuit2 on a separate NodeHyperplanePotential for each node,
+    // with the nodes shared out among numberOfThreads threads.
+    void SetNodeDisplacementsInParallel();
 
 
     // This sets up nodeDisplacements and lastPathNodes to have the correct
@@ -47,6 +47,11 @@ namespace VevaciousPlusPlus
     // reasonably plotted.
     virtual double MaximumPlotRadius() const = 0;
 
+    // This should make the bubble profile stop depending on anything owned by
+    // the calculator which created it, so that it can outlive the calculator
+    // and be deleted by any thread. By default, it does nothing.
+    virtual void DetachFromCalculator() { ; /* By default, does nothing. */ }
+
 
   protected:
     double bounceAction;
@@ -0,0 +1,74 @@
+/*
+ * BubbleProfileBufferPool.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef BUBBLEPROFILEBUFFERPOOL_HPP_
+#define BUBBLEPROFILEBUFFERPOOL_HPP_
+
+#include "BubbleRadialValueDescription.hpp"
+#include <vector>
+
+namespace VevaciousPlusPlus
+{
+  // This class keeps the vectors used by bubble profiles for their radial
+  // values after the profiles are deleted, so that the next profiles can
+  // take them over with their memory already allocated, rather than having
+  // to grow new vectors point by point for every tried path. It is not safe
+  // to share a pool between threads, and a pool must outlive every bubble
+  // profile which takes buffers from it.
+  class BubbleProfileBufferPool
+  {
+  public:
+    BubbleProfileBufferPool() : spareBuffers() {}
+
+    virtual ~BubbleProfileBufferPool() {}
+
+
+    // This swaps a spare buffer into profileBuffer if there is one, leaving
+    // profileBuffer as it was otherwise. The buffer is empty but keeps its
+    // allocated memory.
+    void
+    TakeBuffer( std::vector< BubbleRadialValueDescription >& profileBuffer );
+
+    // This clears profileBuffer and swaps it into the pool, leaving
+    // profileBuffer without any allocated memory.
+    void
+    ReturnBuffer( std::vector< BubbleRadialValueDescription >& profileBuffer );
+
+
+  protected:
+    std::vector< std::vector< BubbleRadialValueDescription > > spareBuffers;
+  };
+
+
+
+
+  // This swaps a spare buffer into profileBuffer if there is one, leaving
+  // profileBuffer as it was otherwise. The buffer is empty but keeps its
+  // allocated memory.
+  inline void BubbleProfileBufferPool::TakeBuffer(
+                   std::vector< BubbleRadialValueDescription >& profileBuffer )
+  {
+    if( !(spareBuffers.empty()) )
+    {
+      profileBuffer.swap( spareBuffers.back() );
+      spareBuffers.pop_back();
+      profileBuffer.clear();
+    }
+  }
+
+  // This clears profileBuffer and swaps it into the pool, leaving
+  // profileBuffer without any allocated memory.
+  inline void BubbleProfileBufferPool::ReturnBuffer(
+                   std::vector< BubbleRadialValueDescription >& profileBuffer )
+  {
+    profileBuffer.clear();
+    spareBuffers.push_back( std::vector< BubbleRadialValueDescription >() );
+    spareBuffers.back().swap( profileBuffer );
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* BUBBLEPROFILEBUFFERPOOL_HPP_ */
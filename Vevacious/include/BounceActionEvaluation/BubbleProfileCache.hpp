@@ -0,0 +1,147 @@
+/*
+ * BubbleProfileCache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef BUBBLEPROFILECACHE_HPP_
+#define BUBBLEPROFILECACHE_HPP_
+
+#include "BubbleProfile.hpp"
+#include "PathParameterization/TunnelPath.hpp"
+#include "PotentialMinimization/PotentialMinimum.hpp"
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+namespace VevaciousPlusPlus
+{
+  // This class keeps up to maximumNumberOfProfiles bubble profiles, keyed on
+  // what determines them: the false and true vacua, the values of the
+  // potential at the vacua, the temperature, and the definition of the path
+  // through field space. The values are rounded to multiples of a quantum
+  // which is quantizationFraction times the distance between the vacua for
+  // field values and the temperature, and quantizationFraction times the
+  // difference in the potential between the vacua for the potential values,
+  // so that numerical noise in re-finding the same vacua does not stop a
+  // profile being found. The values of the potential at the vacua are those
+  // which were found along with the vacua, so making a key does not need any
+  // evaluations of the potential. The cache should be cleared for each new
+  // parameter point, as the profiles of one point are not valid for another
+  // point, even if it happens to have the same vacua. When the cache is full,
+  // the least recently used profile is dropped. The profiles are detached
+  // from the calculators which created them when they are put in the cache,
+  // and the cache can be shared between threads.
+  class BubbleProfileCache
+  {
+  public:
+    typedef std::vector< long long > CacheKey;
+
+    BubbleProfileCache( size_t const maximumNumberOfProfiles = 0,
+                        double const quantizationFraction = 1.0E-9 );
+    virtual ~BubbleProfileCache();
+
+
+    // This sets how many profiles may be kept, dropping the least recently
+    // used profiles if there are already more than maximumNumberOfProfiles,
+    // and the fraction used to quantize the keys. A maximumNumberOfProfiles
+    // of 0 turns off the cache.
+    void SetLimits( size_t const maximumNumberOfProfiles,
+                    double const quantizationFraction );
+
+    // This returns the key for the bubble profile for tunneling from
+    // falseVacuum to trueVacuum along tunnelPath at the temperature of
+    // tunnelPath, using the values of the potential which were found along
+    // with the vacua (which must be the minima at the temperature of
+    // tunnelPath). If the cache is turned off, it just returns an empty key
+    // without doing any work.
+    CacheKey Key( PotentialMinimum const& falseVacuum,
+                  PotentialMinimum const& trueVacuum,
+                  TunnelPath const& tunnelPath ) const;
+
+    // This returns the profile kept for cacheKey, marking it as the most
+    // recently used, or an empty pointer if there is no profile for cacheKey,
+    // counting a hit or a miss respectively if the cache is turned on.
+    std::shared_ptr< BubbleProfile const > Find( CacheKey const& cacheKey );
+
+    // This takes ownership of newProfile, detaching it from its calculator
+    // and keeping it for cacheKey if the cache is turned on, and returns a
+    // pointer sharing ownership of it.
+    std::shared_ptr< BubbleProfile const > Insert( CacheKey const& cacheKey,
+                                                   BubbleProfile* newProfile );
+
+    // This sets the counts of hits and misses back to zero without dropping
+    // any profiles.
+    void ResetCounters();
+
+    // This drops all the profiles.
+    void Clear();
+
+    bool IsTurnedOn() const { return ( maximumNumberOfProfiles > 0 ); }
+
+    long NumberOfHits() const { return numberOfHits; }
+
+    long NumberOfMisses() const { return numberOfMisses; }
+
+    size_t NumberOfProfiles() const { return profileLookup.size(); }
+
+
+  protected:
+    typedef std::pair< CacheKey, std::shared_ptr< BubbleProfile const > >
+    KeyedProfile;
+    // The largest magnitude of value divided by quantum which can be rounded
+    // to a long long without overflowing.
+    static double const maximumQuantizedMagnitude;
+
+    size_t maximumNumberOfProfiles;
+    double quantizationFraction;
+    // The most recently used profile is at the front of profilesByUse.
+    std::list< KeyedProfile > profilesByUse;
+    std::map< CacheKey, std::list< KeyedProfile >::iterator > profileLookup;
+    long numberOfHits;
+    long numberOfMisses;
+
+
+    // This drops the least recently used profiles until there are no more
+    // than maximumNumberOfProfiles. It should only be called from within the
+    // critical section for the cache.
+    void DropExcessProfiles();
+
+    // This appends the values in unquantizedValues, divided by valueQuantum
+    // and rounded, to cacheKey.
+    static void
+    AppendQuantized( std::vector< double > const& unquantizedValues,
+                     double const valueQuantum,
+                     CacheKey& cacheKey );
+  };
+
+
+
+
+  // This appends the values in unquantizedValues, divided by valueQuantum and
+  // rounded, to cacheKey.
+  inline void BubbleProfileCache::AppendQuantized(
+                                std::vector< double > const& unquantizedValues,
+                                                     double const valueQuantum,
+                                                           CacheKey& cacheKey )
+  {
+    for( std::vector< double >::const_iterator
+         unquantizedValue( unquantizedValues.begin() );
+         unquantizedValue != unquantizedValues.end();
+         ++unquantizedValue )
+    {
+      double const quantizedValue( *unquantizedValue / valueQuantum );
+      cacheKey.push_back( llround( std::max( -maximumQuantizedMagnitude,
+                                             std::min( quantizedValue,
+                                         maximumQuantizedMagnitude ) ) ) );
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* BUBBLEPROFILECACHE_HPP_ */
@@ -19,6 +19,7 @@
 #include "BubbleRadialValueDescription.hpp"
 #include <cmath>
 #include "UndershootOvershootBubble.hpp"
+#include "BubbleProfileBufferPool.hpp"
 #include <cstddef>
 #include "boost/math/special_functions/bessel.hpp"
 #include "boost/math/constants/constants.hpp"
@@ -30,7 +31,9 @@ namespace VevaciousPlusPlus
   {
   public:
     BubbleShootingOnPathInFieldSpace( double const lengthScaleResolution,
-                                      unsigned int const shootAttempts );
+                                      unsigned int const shootAttempts,
+            UndershootOvershootBubble::OdeStepperChoice const odeStepperChoice,
+                                      double const stepperTolerance );
     virtual ~BubbleShootingOnPathInFieldSpace();
 
 
@@ -42,6 +45,8 @@ namespace VevaciousPlusPlus
     // by infinity, but we cannot integrate to infinity, so we choose
     // estimatedRadialMaximum to be initially twice the length scale, as it
     // gets extended over the course of the calculation anyway if necessary.
+    // It also forgets the bubble center from the last path, as it is not
+    // relevant to tunneling between other vacua.
     virtual void ResetVacua( PotentialFunction const& potentialFunction,
                              PotentialMinimum const& falseVacuum,
                              PotentialMinimum const& trueVacuum,
@@ -54,6 +59,10 @@ namespace VevaciousPlusPlus
     // S_3(T), the dimensionful (in GeV) thermal bounce action integrated over
     // three dimensions at temperature T, is calculated: S_3(T) if the
     // temperature T given by tunnelPath is greater than 0.0, S_4 otherwise.
+    // The shooting starts from the bubble center of the last path since the
+    // last call of ResetVacua, as successive paths are usually small
+    // changes of each other, and the bubble profile takes its memory from
+    // bufferPool.
     virtual BubbleProfile* operator()( TunnelPath const& tunnelPath,
                  OneDimensionalPotentialAlongPath const& pathPotential ) const;
 
@@ -66,6 +75,16 @@ namespace VevaciousPlusPlus
     double estimatedRadialMaximum;
     unsigned int const shootAttempts;
     double const auxiliaryThreshold;
+    UndershootOvershootBubble::OdeStepperChoice const odeStepperChoice;
+    double const stepperTolerance;
+    // The pool of profile buffers and the bubble center of the last path are
+    // not part of the logical state of the calculator, but are kept between
+    // calls to save effort, so they are mutable. They are the reason that an
+    // instance of this class cannot be used by more than one thread at a
+    // time, and the bubble profiles returned by operator() must be deleted
+    // before the instance which created them.
+    mutable BubbleProfileBufferPool bufferPool;
+    mutable double lastBubbleCenterAuxiliary;
 
 
     // This evaluates the bounce action density at the given point on the
@@ -87,6 +106,8 @@ namespace VevaciousPlusPlus
   // by infinity, but we cannot integrate to infinity, so we choose
   // estimatedRadialMaximum to be initially twice the length scale, as it
   // gets extended over the course of the calculation anyway if necessary.
+  // It also forgets the bubble center from the last path, as it is not
+  // relevant to tunneling between other vacua.
   inline void BubbleShootingOnPathInFieldSpace::ResetVacua(
                                     PotentialFunction const& potentialFunction,
                                            PotentialMinimum const& falseVacuum,
@@ -99,6 +120,7 @@ namespace VevaciousPlusPlus
           sqrt( potentialFunction.ScaleSquaredRelevantToTunneling( falseVacuum,
                                                             trueVacuum ) ) ) );
     radialStepSize = ( lengthScaleResolution * 0.5 * estimatedRadialMaximum );
+    lastBubbleCenterAuxiliary = -1.0;
   }
 
   // This evaluates the bounce action density at the given point on the
@@ -0,0 +1,97 @@
+/*
+ * OdeintBubbleActionDerivatives.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef ODEINTBUBBLEACTIONDERIVATIVES_HPP_
+#define ODEINTBUBBLEACTIONDERIVATIVES_HPP_
+
+#include "OneDimensionalPotentialAlongPath.hpp"
+#include "PathParameterization/TunnelPath.hpp"
+#include <cmath>
+
+namespace VevaciousPlusPlus
+{
+  // This class is like OdeintBubbleDerivatives, but has a third component to
+  // the state, which is the integral of the bounce action density times
+  // r^dampingFactor from r = 0 (without the solid angle), divided by
+  // actionScale so that it is of a similar size to the auxiliary variable, so
+  // that the error control of the stepper also applies to the bounce action.
+  // The state type is a template parameter so that the same derivatives can
+  // be used both with std::vector< double > for the explicit Runge-Kutta
+  // steppers and with boost::numeric::ublas::vector< double > for the
+  // Rosenbrock stepper.
+  class OdeintBubbleActionDerivatives
+  {
+  public:
+    OdeintBubbleActionDerivatives(
+                         OneDimensionalPotentialAlongPath const& pathPotential,
+                                   TunnelPath const& tunnelPath,
+                                   double const actionScale ) :
+      pathPotential( pathPotential ),
+      tunnelPath( tunnelPath ),
+      dampingFactor( tunnelPath.NonZeroTemperature() ? 2.0 : 3.0 ),
+      inverseActionScale( 1.0 / actionScale ) {}
+
+    virtual ~OdeintBubbleActionDerivatives() {}
+
+
+    // This puts the derivatives of the auxiliary value, its slope, and the
+    // scaled bounce action integral based on auxiliarySlopeAndAction into
+    // stateDerivatives, in the form required for the Boost odeint package.
+    template< class StateType >
+    void operator()( StateType const& auxiliarySlopeAndAction,
+                     StateType& stateDerivatives,
+                     double const radialValue ) const;
+
+
+  protected:
+    OneDimensionalPotentialAlongPath const& pathPotential;
+    TunnelPath const& tunnelPath;
+    double dampingFactor;
+    double inverseActionScale;
+  };
+
+
+
+
+  // This puts the derivatives of the auxiliary value, its slope, and the
+  // scaled bounce action integral based on auxiliarySlopeAndAction into
+  // stateDerivatives, in the form required for the Boost odeint package.
+  template< class StateType >
+  inline void OdeintBubbleActionDerivatives::operator()(
+                                    StateType const& auxiliarySlopeAndAction,
+                                                  StateType& stateDerivatives,
+                                             double const radialValue ) const
+  {
+    double const auxiliaryValue( auxiliarySlopeAndAction[ 0 ] );
+    // As in OdeintBubbleDerivatives, this cheats if there has already been an
+    // overshoot, though the integration should stop at the overshoot anyway.
+    if( auxiliaryValue < 0.0 )
+    {
+      stateDerivatives[ 0 ] = 0.0;
+      stateDerivatives[ 1 ] = 0.0;
+      stateDerivatives[ 2 ] = 0.0;
+      return;
+    }
+    double const auxiliaryDerivative( auxiliarySlopeAndAction[ 1 ] );
+    double const slopeSquared( tunnelPath.SlopeSquared( auxiliaryValue ) );
+    stateDerivatives[ 0 ] = auxiliaryDerivative;
+    stateDerivatives[ 1 ]
+     = ( ( ( pathPotential.FirstDerivative( auxiliaryValue )
+             - ( tunnelPath.SlopeDotAcceleration( auxiliaryValue )
+                 * auxiliaryDerivative * auxiliaryDerivative ) )
+           / slopeSquared )
+         - ( ( dampingFactor * auxiliaryDerivative ) / radialValue ) );
+    stateDerivatives[ 2 ]
+    = ( ( ( 0.5 * auxiliaryDerivative * auxiliaryDerivative * slopeSquared )
+          + pathPotential( auxiliaryValue ) )
+        * pow( radialValue,
+               dampingFactor )
+        * inverseActionScale );
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* ODEINTBUBBLEACTIONDERIVATIVES_HPP_ */
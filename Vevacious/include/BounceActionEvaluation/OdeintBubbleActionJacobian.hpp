@@ -0,0 +1,120 @@
+/*
+ * OdeintBubbleActionJacobian.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef ODEINTBUBBLEACTIONJACOBIAN_HPP_
+#define ODEINTBUBBLEACTIONJACOBIAN_HPP_
+
+#include "OdeintBubbleActionDerivatives.hpp"
+#include "boost/numeric/ublas/vector.hpp"
+#include "boost/numeric/ublas/matrix.hpp"
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+namespace VevaciousPlusPlus
+{
+  // This class provides the Jacobian of the derivatives given by an
+  // OdeintBubbleActionDerivatives, as well as the explicit derivatives with
+  // respect to the radial variable, in the form required by the Rosenbrock
+  // stepper of the Boost odeint package. The derivatives of the potential
+  // along the path are only available to first order, so the Jacobian is
+  // taken by central finite differences.
+  class OdeintBubbleActionJacobian
+  {
+  public:
+    typedef boost::numeric::ublas::vector< double > StateVector;
+    typedef boost::numeric::ublas::matrix< double > JacobianMatrix;
+
+    OdeintBubbleActionJacobian(
+              OdeintBubbleActionDerivatives const& bubbleActionDerivatives ) :
+      bubbleActionDerivatives( bubbleActionDerivatives ),
+      relativeDifferenceStep( 1.0e-6 ) {}
+
+    virtual ~OdeintBubbleActionJacobian() {}
+
+
+    // This fills stateJacobian with the derivatives of the components of the
+    // derivatives of the state with respect to the components of the state,
+    // and radialDerivatives with the derivatives with respect to the radial
+    // variable, at the point given by auxiliarySlopeAndAction and radialValue.
+    void operator()( StateVector const& auxiliarySlopeAndAction,
+                     JacobianMatrix& stateJacobian,
+                     double const radialValue,
+                     StateVector& radialDerivatives ) const;
+
+
+  protected:
+    OdeintBubbleActionDerivatives const& bubbleActionDerivatives;
+    double const relativeDifferenceStep;
+  };
+
+
+
+
+  // This fills stateJacobian with the derivatives of the components of the
+  // derivatives of the state with respect to the components of the state, and
+  // radialDerivatives with the derivatives with respect to the radial
+  // variable, at the point given by auxiliarySlopeAndAction and radialValue.
+  inline void OdeintBubbleActionJacobian::operator()(
+                                   StateVector const& auxiliarySlopeAndAction,
+                                                 JacobianMatrix& stateJacobian,
+                                                     double const radialValue,
+                                       StateVector& radialDerivatives ) const
+  {
+    size_t const stateSize( auxiliarySlopeAndAction.size() );
+    StateVector shiftedState( auxiliarySlopeAndAction );
+    StateVector derivativesAbove( stateSize );
+    StateVector derivativesBelow( stateSize );
+    for( size_t stateIndex( 0 );
+         stateIndex < stateSize;
+         ++stateIndex )
+    {
+      double const differenceStep( relativeDifferenceStep
+                 * std::max( 1.0,
+                            fabs( auxiliarySlopeAndAction[ stateIndex ] ) ) );
+      shiftedState[ stateIndex ]
+      = ( auxiliarySlopeAndAction[ stateIndex ] + differenceStep );
+      bubbleActionDerivatives( shiftedState,
+                               derivativesAbove,
+                               radialValue );
+      shiftedState[ stateIndex ]
+      = ( auxiliarySlopeAndAction[ stateIndex ] - differenceStep );
+      bubbleActionDerivatives( shiftedState,
+                               derivativesBelow,
+                               radialValue );
+      shiftedState[ stateIndex ] = auxiliarySlopeAndAction[ stateIndex ];
+      for( size_t derivativeIndex( 0 );
+           derivativeIndex < stateSize;
+           ++derivativeIndex )
+      {
+        stateJacobian( derivativeIndex,
+                       stateIndex )
+        = ( ( derivativesAbove[ derivativeIndex ]
+              - derivativesBelow[ derivativeIndex ] )
+            / ( 2.0 * differenceStep ) );
+      }
+    }
+    double const radialStep( relativeDifferenceStep * radialValue );
+    bubbleActionDerivatives( auxiliarySlopeAndAction,
+                             derivativesAbove,
+                             ( radialValue + radialStep ) );
+    bubbleActionDerivatives( auxiliarySlopeAndAction,
+                             derivativesBelow,
+                             ( radialValue - radialStep ) );
+    for( size_t derivativeIndex( 0 );
+         derivativeIndex < stateSize;
+         ++derivativeIndex )
+    {
+      radialDerivatives[ derivativeIndex ]
+      = ( ( derivativesAbove[ derivativeIndex ]
+            - derivativesBelow[ derivativeIndex ] )
+          / ( 2.0 * radialStep ) );
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* ODEINTBUBBLEACTIONJACOBIAN_HPP_ */
@@ -51,6 +51,12 @@ namespace VevaciousPlusPlus
     void PutOnSegment( Eigen::VectorXd& fieldConfiguration,
                        double const segmentAuxiliary ) const;
 
+    // This fills the numberOfFields values starting at configurationStart
+    // with the values that the fields should have when the segment auxiliary
+    // is given by segmentAuxiliary.
+    void PutOnSegment( std::vector< double >::iterator configurationStart,
+                       double const segmentAuxiliary ) const;
+
     // This returns the sum of the squares of the slopes at segmentAuxiliary.
     double SlopeSquared( double const segmentAuxiliary ) const
     { return slopeSquared; }
@@ -136,6 +142,22 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This fills the numberOfFields values starting at configurationStart with
+  // the values that the fields should have when the segment auxiliary is
+  // given by segmentAuxiliary.
+  inline void LinearSplinePathSegment::PutOnSegment(
+                            std::vector< double >::iterator configurationStart,
+                                          double const segmentAuxiliary ) const
+  {
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      configurationStart[ fieldIndex ] = ( fieldConstants[ fieldIndex ]
+                         + ( segmentAuxiliary * fieldLinears[ fieldIndex ] ) );
+    }
+  }
+
   // This is for debugging.
   inline std::string LinearSplinePathSegment::AsDebuggingString(
                                               double const segmentStart ) const
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
 
 namespace VevaciousPlusPlus
 {
@@ -40,6 +41,19 @@ namespace VevaciousPlusPlus
     virtual void PutOnPathAt( Eigen::VectorXd& fieldConfiguration,
                               double const auxiliaryValue ) const;
 
+    // This fills fieldConfigurations with the field configurations for all
+    // the values of the path auxiliary in auxiliaryValues, one after another,
+    // so that the configuration for auxiliaryValues[ i ] starts at
+    // fieldConfigurations[ i * NumberOfFields() ].
+    virtual void
+    PutOnPathAt( std::vector< double >& fieldConfigurations,
+                 std::vector< double > const& auxiliaryValues ) const;
+
+    // This appends the field configurations of the nodes of the path to
+    // pathDefinition, as they determine the path exactly.
+    virtual void
+    AppendPathDefinition( std::vector< double >& pathDefinition ) const;
+
     // This returns the dot product with itself of the derivative of the
     // field vector with respect to the path auxiliary evaluated at
     // auxiliaryValue. This is constant by construction (constant "speed" along
@@ -64,7 +78,22 @@ namespace VevaciousPlusPlus
   protected:
     std::vector< LinearSplinePathSegment > pathSegments;
     double slopeSquared;
-
+    // segmentStarts[ i ] is the value of the path auxiliary at the start of
+    // pathSegments[ i ], with segmentStarts.back() being the value at the end
+    // of the last segment. If all the segments have the same length, the
+    // segment for a value of the path auxiliary is found directly by dividing
+    // by that length, otherwise it is found by binary search in
+    // segmentStarts.
+    std::vector< double > segmentStarts;
+    bool segmentsAreUniform;
+    double inverseUniformSegmentLength;
+
+
+    // This returns the index of the segment which contains auxiliaryValue,
+    // which is the first segment for values below zero, and the last segment
+    // for values beyond the end of the path, so that such values are put on
+    // the extensions of the segments at the ends of the path.
+    size_t SegmentIndex( double const auxiliaryValue ) const;
 
     // This gives the index for which path segment is correct for
     // auxiliaryValue along with the value of the auxiliary value along the
@@ -82,22 +111,11 @@ namespace VevaciousPlusPlus
                                      std::vector< double >& fieldConfiguration,
                                             double const auxiliaryValue ) const
   {
-    size_t segmentIndex( 0 );
-    double segmentAuxiliary( auxiliaryValue );
-    while( ( segmentIndex < ( pathSegments.size() - 1 ) )
-           &&
-           ( segmentAuxiliary
-             > pathSegments[ segmentIndex ].SegmentLength() ) )
-    {
-      segmentAuxiliary -= pathSegments[ segmentIndex ].SegmentLength();
-      ++segmentIndex;
-    }
-    // At this point, either we found the segment which contains the
-    // auxiliary point, or segmentIndex = ( pathSegments.size() - 1 ), so the
-    // last segment. Auxiliary values outside the range get put on the
-    // extensions of the first or last segment appropriately.
+    // Auxiliary values outside the range get put on the extensions of the
+    // first or last segment appropriately.
+    size_t const segmentIndex( SegmentIndex( auxiliaryValue ) );
     pathSegments[ segmentIndex ].PutOnSegment( fieldConfiguration,
-                                               segmentAuxiliary );
+                         ( auxiliaryValue - segmentStarts[ segmentIndex ] ) );
   }
 
   // This fills fieldConfiguration with the values that the fields
@@ -106,22 +124,61 @@ namespace VevaciousPlusPlus
                                            Eigen::VectorXd& fieldConfiguration,
                                             double const auxiliaryValue ) const
   {
-    size_t segmentIndex( 0 );
-    double segmentAuxiliary( auxiliaryValue );
-    while( ( segmentIndex < ( pathSegments.size() - 1 ) )
-           &&
-           ( segmentAuxiliary
-             > pathSegments[ segmentIndex ].SegmentLength() ) )
+    // Auxiliary values outside the range get put on the extensions of the
+    // first or last segment appropriately.
+    size_t const segmentIndex( SegmentIndex( auxiliaryValue ) );
+    pathSegments[ segmentIndex ].PutOnSegment( fieldConfiguration,
+                         ( auxiliaryValue - segmentStarts[ segmentIndex ] ) );
+  }
+
+  // This fills fieldConfigurations with the field configurations for all the
+  // values of the path auxiliary in auxiliaryValues, one after another, so
+  // that the configuration for auxiliaryValues[ i ] starts at
+  // fieldConfigurations[ i * NumberOfFields() ].
+  inline void LinearSplineThroughNodes::PutOnPathAt(
+                                    std::vector< double >& fieldConfigurations,
+                          std::vector< double > const& auxiliaryValues ) const
+  {
+    fieldConfigurations.resize( auxiliaryValues.size() * numberOfFields );
+    for( size_t pointIndex( 0 );
+         pointIndex < auxiliaryValues.size();
+         ++pointIndex )
     {
-      segmentAuxiliary -= pathSegments[ segmentIndex ].SegmentLength();
-      ++segmentIndex;
+      double const auxiliaryValue( auxiliaryValues[ pointIndex ] );
+      size_t const segmentIndex( SegmentIndex( auxiliaryValue ) );
+      pathSegments[ segmentIndex ].PutOnSegment( ( fieldConfigurations.begin()
+                                           + ( pointIndex * numberOfFields ) ),
+                         ( auxiliaryValue - segmentStarts[ segmentIndex ] ) );
     }
-    // At this point, either we found the segment which contains the
-    // auxiliary point, or segmentIndex = ( pathSegments.size() - 1 ), so the
-    // last segment. Auxiliary values outside the range get put on the
-    // extensions of the first or last segment appropriately.
-    pathSegments[ segmentIndex ].PutOnSegment( fieldConfiguration,
-                                               segmentAuxiliary );
+  }
+
+  // This returns the index of the segment which contains auxiliaryValue,
+  // which is the first segment for values below zero, and the last segment
+  // for values beyond the end of the path, so that such values are put on the
+  // extensions of the segments at the ends of the path.
+  inline size_t
+  LinearSplineThroughNodes::SegmentIndex( double const auxiliaryValue ) const
+  {
+    size_t const lastSegment( pathSegments.size() - 1 );
+    if( segmentsAreUniform )
+    {
+      if( !( auxiliaryValue > 0.0 ) )
+      {
+        return 0;
+      }
+      size_t const
+      segmentIndex( auxiliaryValue * inverseUniformSegmentLength );
+      return std::min( lastSegment,
+                       segmentIndex );
+    }
+    // The first segment start which is greater than auxiliaryValue is the
+    // start of the segment after the one which contains auxiliaryValue. The
+    // first start and the end of the path are left out of the search so that
+    // values outside the path get the first or last segment.
+    return ( std::upper_bound( ( segmentStarts.begin() + 1 ),
+                               ( segmentStarts.end() - 1 ),
+                               auxiliaryValue )
+             - ( segmentStarts.begin() + 1 ) );
   }
 
   // This gives the index for which path segment is correct for
@@ -136,20 +193,27 @@ namespace VevaciousPlusPlus
       return std::make_pair( 0,
                              0.0 );
     }
-    size_t segmentIndex( 0 );
-    double auxiliaryRemainder( auxiliaryValue );
-    while( segmentIndex < pathSegments.size() )
+    if( !( auxiliaryValue < segmentStarts.back() ) )
     {
-      if( auxiliaryRemainder < pathSegments[ segmentIndex ].SegmentLength() )
-      {
-        return std::make_pair( segmentIndex,
-                               auxiliaryRemainder );
-      }
-      auxiliaryRemainder -= pathSegments[ segmentIndex ].SegmentLength();
-      ++segmentIndex;
+      return std::make_pair( ( pathSegments.size() - 1 ),
+                             pathSegments.back().SegmentLength() );
     }
-    return std::make_pair( ( pathSegments.size() - 1 ),
-                           pathSegments.back().SegmentLength() );
+    size_t const segmentIndex( SegmentIndex( auxiliaryValue ) );
+    return std::make_pair( segmentIndex,
+                       ( auxiliaryValue - segmentStarts[ segmentIndex ] ) );
+  }
+
+  // This appends the field configurations of the nodes of the path to
+  // pathDefinition, as they determine the path exactly.
+  inline void LinearSplineThroughNodes::AppendPathDefinition(
+                                  std::vector< double >& pathDefinition ) const
+  {
+    std::vector< double > nodeConfigurations;
+    PutOnPathAt( nodeConfigurations,
+                 segmentStarts );
+    pathDefinition.insert( pathDefinition.end(),
+                           nodeConfigurations.begin(),
+                           nodeConfigurations.end() );
   }
 
   // This is for debugging.
@@ -13,6 +13,7 @@
 #include "Eigen/Dense"
 #include <string>
 #include <sstream>
+#include <algorithm>
 
 namespace VevaciousPlusPlus
 {
@@ -49,6 +50,25 @@ namespace VevaciousPlusPlus
     virtual void PutOnPathAt( Eigen::VectorXd& fieldConfiguration,
                               double const auxiliaryValue ) const = 0;
 
+    // This fills fieldConfigurations with the field configurations for all
+    // the values of the path auxiliary in auxiliaryValues, one after another,
+    // so that the configuration for auxiliaryValues[ i ] starts at
+    // fieldConfigurations[ i * NumberOfFields() ]. By default it just calls
+    // PutOnPathAt for each value in turn, but derived classes can over-ride
+    // it to share the work of finding where the values are along the path.
+    virtual void
+    PutOnPathAt( std::vector< double >& fieldConfigurations,
+                 std::vector< double > const& auxiliaryValues ) const;
+
+    // This appends values to pathDefinition which determine the path, so
+    // that two paths which append the same values can be taken to be the same
+    // path. By default it appends the field configurations at
+    // numberOfDefinitionPoints evenly-spaced values of the path auxiliary
+    // from 0 to 1, but derived classes which are defined by a finite set of
+    // field configurations should over-ride it to append those instead.
+    virtual void
+    AppendPathDefinition( std::vector< double >& pathDefinition ) const;
+
     // This should return the dot product with itself of the derivative of the
     // field vector with respect to the path auxiliary evaluated at
     // auxiliaryValue.
@@ -72,6 +92,8 @@ namespace VevaciousPlusPlus
 
 
   protected:
+    static size_t const numberOfDefinitionPoints = 33;
+
     size_t const numberOfFields;
     std::vector< double > pathParameterization;
 
@@ -88,6 +110,57 @@ namespace VevaciousPlusPlus
 
 
 
+  // This fills fieldConfigurations with the field configurations for all the
+  // values of the path auxiliary in auxiliaryValues, one after another, so
+  // that the configuration for auxiliaryValues[ i ] starts at
+  // fieldConfigurations[ i * NumberOfFields() ]. By default it just calls
+  // PutOnPathAt for each value in turn, but derived classes can over-ride it
+  // to share the work of finding where the values are along the path.
+  inline void
+  TunnelPath::PutOnPathAt( std::vector< double >& fieldConfigurations,
+                          std::vector< double > const& auxiliaryValues ) const
+  {
+    fieldConfigurations.resize( auxiliaryValues.size() * numberOfFields );
+    std::vector< double > fieldConfiguration( numberOfFields );
+    for( size_t pointIndex( 0 );
+         pointIndex < auxiliaryValues.size();
+         ++pointIndex )
+    {
+      PutOnPathAt( fieldConfiguration,
+                   auxiliaryValues[ pointIndex ] );
+      std::copy( fieldConfiguration.begin(),
+                 fieldConfiguration.end(),
+                 ( fieldConfigurations.begin()
+                   + ( pointIndex * numberOfFields ) ) );
+    }
+  }
+
+  // This appends values to pathDefinition which determine the path, so that
+  // two paths which append the same values can be taken to be the same path.
+  // By default it appends the field configurations at
+  // numberOfDefinitionPoints evenly-spaced values of the path auxiliary from
+  // 0 to 1, but derived classes which are defined by a finite set of field
+  // configurations should over-ride it to append those instead.
+  inline void TunnelPath::AppendPathDefinition(
+                                  std::vector< double >& pathDefinition ) const
+  {
+    std::vector< double > auxiliaryValues( numberOfDefinitionPoints );
+    for( size_t pointIndex( 0 );
+         pointIndex < numberOfDefinitionPoints;
+         ++pointIndex )
+    {
+      auxiliaryValues[ pointIndex ]
+      = ( static_cast< double >( pointIndex )
+          / static_cast< double >( numberOfDefinitionPoints - 1 ) );
+    }
+    std::vector< double > fieldConfigurations;
+    PutOnPathAt( fieldConfigurations,
+                 auxiliaryValues );
+    pathDefinition.insert( pathDefinition.end(),
+                           fieldConfigurations.begin(),
+                           fieldConfigurations.end() );
+  }
+
   // This is for debugging.
   inline std::string
   TunnelPath::FieldsString( double const auxiliaryValue ) const
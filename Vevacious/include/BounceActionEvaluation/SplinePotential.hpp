@@ -14,6 +14,7 @@
 #include <string>
 #include <cstddef>
 #include <vector>
+#include <algorithm>
 #include "LHPC/Utilities/ParsingUtilities.hpp"
 
 namespace VevaciousPlusPlus
@@ -88,25 +89,43 @@ namespace VevaciousPlusPlus
     double lastSegmentQuadratic;
     bool energyBarrierWasResolved;
     bool tunnelingPossibleOnPath;
-    std::vector< double > fieldConfiguration;
     PotentialFunction const& potentialFunction;
     TunnelPath const& tunnelPath;
     double const pathTemperature;
-
+    // The field configurations at all the segment ends along tunnelPath are
+    // put into sampledConfigurations (configuration by configuration, so the
+    // configuration at auxiliary value ( i * auxiliaryStep ) starts at
+    // element ( i * NumberOfFieldVariables() )), and the potential at each of
+    // them is evaluated as a single batch into sampledPotentials before the
+    // scans for the path vacua and the barrier, which then just look up the
+    // values.
+    std::vector< double > sampledConfigurations;
+    std::vector< double > sampledPotentials;
+
+
+    // This fills sampledConfigurations with the field configurations at the
+    // ( numberOfPotentialSegments + 1 ) segment ends along tunnelPath and
+    // sampledPotentials with the potential at each of them.
+    void
+    SamplePotentialAlongPath( unsigned int const numberOfPotentialSegments );
+
+    // This returns the index in sampledPotentials of the segment end nearest
+    // to auxiliaryValue.
+    size_t SampleIndex( double const auxiliaryValue ) const;
 
     // This returns the potential on tunnelPath at auxiliaryValue, relative to
-    // the potential at the path false vacuum being zero. It puts values into
-    // fieldConfiguration, so it is not const and should be used with caution.
-    double CalculatePotentialDifference( double const auxiliaryValue );
+    // the potential at the path false vacuum being zero. The auxiliary values
+    // used by the scans are always segment ends, so this just looks up the
+    // sampled potential at the nearest one.
+    double CalculatePotentialDifference( double const auxiliaryValue ) const;
 
     // This goes along the segment ends checking for the lowest before the
     // potential starts to rise again, returning true if it finds such a point
     // before the end of the path, false otherwise. It leaves the auxiliary
     // value of this point with lowest potential in auxiliaryOfPathFalseVacuum,
-    // the lowest potential in pathFalsePotential, its field configuration in
-    // fieldConfiguration, and the difference in potential at
-    // ( auxiliaryOfPathFalseVacuum + auxiliaryStep ) along tunnelPath from
-    // pathFalsePotential in potentialValues.front().
+    // the lowest potential in pathFalsePotential, and the difference in
+    // potential at ( auxiliaryOfPathFalseVacuum + auxiliaryStep ) along
+    // tunnelPath from pathFalsePotential in potentialValues.front().
     bool RollForwardToPathFalseVacuum( size_t const maximumFalseIndex );
 
     // This goes along the segment ends adding the differences from
@@ -168,16 +187,26 @@ namespace VevaciousPlusPlus
     return firstDerivatives[ auxiliarySteps - 1 ];
   }
 
+  // This returns the index in sampledPotentials of the segment end nearest
+  // to auxiliaryValue.
+  inline size_t
+  SplinePotential::SampleIndex( double const auxiliaryValue ) const
+  {
+    size_t const nearestIndex( static_cast< size_t >( ( auxiliaryValue
+                                                    * inverseOfAuxiliaryStep )
+                                                      + 0.5 ) );
+    return std::min( nearestIndex,
+                     ( sampledPotentials.size() - 1 ) );
+  }
+
   // This returns the potential on tunnelPath at auxiliaryValue, relative to
-  // the potential at the path false vacuum being zero. It puts values into
-  // fieldConfiguration, so it is not const and should be used with caution.
-  inline double
-  SplinePotential::CalculatePotentialDifference( double const auxiliaryValue )
+  // the potential at the path false vacuum being zero. The auxiliary values
+  // used by the scans are always segment ends, so this just looks up the
+  // sampled potential at the nearest one.
+  inline double SplinePotential::CalculatePotentialDifference(
+                                           double const auxiliaryValue ) const
   {
-    tunnelPath.PutOnPathAt( fieldConfiguration,
-                            auxiliaryValue );
-    return ( potentialFunction( fieldConfiguration,
-                                pathTemperature )
+    return ( sampledPotentials[ SampleIndex( auxiliaryValue ) ]
              - pathFalsePotential );
   }
 
@@ -185,19 +214,16 @@ namespace VevaciousPlusPlus
   // potential starts to rise again, returning true if it finds such a point
   // before the end of the path, false otherwise. It leaves the auxiliary
   // value of this point with lowest potential in auxiliaryOfPathFalseVacuum,
-  // the lowest potential in pathFalsePotential, its field configuration in
-  // fieldConfiguration, and the difference in potential at
-  // ( auxiliaryOfPathFalseVacuum + auxiliaryStep ) along tunnelPath from
-  // pathFalsePotential in potentialValues.front().
+  // the lowest potential in pathFalsePotential, and the difference in
+  // potential at ( auxiliaryOfPathFalseVacuum + auxiliaryStep ) along
+  // tunnelPath from pathFalsePotential in potentialValues.front().
   inline bool SplinePotential::RollForwardToPathFalseVacuum(
                                                size_t const maximumFalseIndex )
   {
     while( pathFalseVacuumIndex <= maximumFalseIndex )
     {
-      tunnelPath.PutOnPathAt( fieldConfiguration,
-                              ( auxiliaryOfPathFalseVacuum + auxiliaryStep ) );
-      potentialValues.front() = potentialFunction( fieldConfiguration,
-                                                   pathTemperature );
+      potentialValues.front() = sampledPotentials[ SampleIndex(
+                              auxiliaryOfPathFalseVacuum + auxiliaryStep ) ];
       if( potentialValues.front() > pathFalsePotential )
       {
         potentialValues.front() -= pathFalsePotential;
@@ -12,15 +12,24 @@
 #include "PathParameterization/TunnelPath.hpp"
 #include "OneDimensionalPotentialAlongPath.hpp"
 #include "BubbleRadialValueDescription.hpp"
+#include "BubbleProfileBufferPool.hpp"
 #include <vector>
 #include <utility>
 #include <cstddef>
 #include "OdeintBubbleDerivatives.hpp"
 #include "OdeintBubbleObserver.hpp"
+#include "OdeintBubbleActionDerivatives.hpp"
+#include "OdeintBubbleActionJacobian.hpp"
 #include "boost/numeric/odeint/integrate/integrate.hpp"
+#include "boost/numeric/odeint/stepper/runge_kutta_dopri5.hpp"
+#include "boost/numeric/odeint/stepper/rosenbrock4.hpp"
+#include "boost/numeric/odeint/stepper/rosenbrock4_controller.hpp"
+#include "boost/numeric/odeint/stepper/rosenbrock4_dense_output.hpp"
+#include "boost/numeric/odeint/stepper/generation.hpp"
 #include <cmath>
 #include "boost/math/special_functions/bessel.hpp"
 #include <algorithm>
+#include "Utilities/PerformanceLogger.hpp"
 
 namespace VevaciousPlusPlus
 {
@@ -28,10 +37,29 @@ namespace VevaciousPlusPlus
   class UndershootOvershootBubble : public BubbleProfile
   {
   public:
+    // OdeintDefault integrates the bubble equation of motion with
+    // boost::numeric::odeint::integrate and checks the whole integration range
+    // afterwards for an undershoot or an overshoot. The other choices use a
+    // dense-output stepper with error control at stepperTolerance, which also
+    // integrates the bounce action along with the bubble profile, and stop the
+    // integration at the radial value where the shot is first definitely an
+    // undershoot or an overshoot. RosenbrockDense uses an implicit stepper
+    // which copes better with the stiff equations of thin-walled bubbles.
+    enum OdeStepperChoice
+    {
+      OdeintDefault,
+      DormandPrinceDense,
+      RosenbrockDense
+    };
+
     UndershootOvershootBubble( double const initialIntegrationStepSize,
                                double const initialIntegrationEndRadius,
                                unsigned int const allowShootingAttempts,
-                               double const shootingThreshold );
+                               double const shootingThreshold,
+                               double const warmStartAuxiliary = -1.0,
+                            BubbleProfileBufferPool* const bufferPool = NULL,
+                       OdeStepperChoice const odeStepperChoice = OdeintDefault,
+                               double const stepperTolerance = 1.0e-6 );
     virtual ~UndershootOvershootBubble();
 
 
@@ -43,7 +71,14 @@ namespace VevaciousPlusPlus
     // until the auxiliary value at the largest radial value is within
     // shootingThreshold of auxiliaryAtRadialInfinity. It also correctly sets
     // auxiliaryAtRadialInfinity beforehand and afterwards
-    // auxiliaryAtBubbleCenter.
+    // auxiliaryAtBubbleCenter. If warmStartAuxiliary is between the definite
+    // undershoot and the path panic vacuum (as it should be if it is the
+    // auxiliary value at the center of the bubble for a similar path), the
+    // first shot is from there, and then shots are taken at doubling
+    // distances from there until the perfect shot is bracketed, before
+    // carrying on by bisection until the bracket is as narrow as it would
+    // have been after undershootOvershootAttempts bisections of the whole
+    // range.
     virtual void CalculateProfile( TunnelPath const& tunnelPath,
                        OneDimensionalPotentialAlongPath const& pathPotential );
 
@@ -60,6 +95,10 @@ namespace VevaciousPlusPlus
     virtual double MaximumPlotRadius() const
     { return auxiliaryProfile.back().radialValue; }
 
+    // This stops the buffers of the bubble profile going back to bufferPool
+    // when it is deleted, so that the profile can outlive the pool.
+    virtual void DetachFromCalculator() { bufferPool = NULL; }
+
     // This returns the discretized bubble profile calculated by the last call
     // of CalculateProfile.
     std::vector< BubbleRadialValueDescription > const& AuxiliaryProfile() const
@@ -74,6 +113,19 @@ namespace VevaciousPlusPlus
     double AuxiliaryAtRadialInfinity() const
     { return auxiliaryAtRadialInfinity; }
 
+    // This returns true if the bounce action was integrated along with the
+    // bubble profile, which is the case for all choices of stepper except
+    // OdeintDefault.
+    bool ActionIsIntegrated() const
+    { return ( odeStepperChoice != OdeintDefault ); }
+
+    // This returns the integral of the bounce action density times
+    // r^dampingFactor from r = 0 to the largest radial value in
+    // auxiliaryProfile, without the solid angle factor, if
+    // ActionIsIntegrated() is true.
+    double IntegratedActionToProfileEnd() const
+    { return integratedActionToProfileEnd; }
+
 
   protected:
     typedef std::pair< size_t, double > IndexAndRemainder;
@@ -95,12 +147,22 @@ namespace VevaciousPlusPlus
     bool worthIntegratingFurther;
     bool currentShotGoodEnough;
     TunnelPath const* tunnelPath;
+    double const warmStartAuxiliary;
+    BubbleProfileBufferPool* bufferPool;
+    std::vector< double > falseConfiguration;
+    std::vector< double > currentConfiguration;
+    std::vector< double > initialConfiguration;
+    OdeStepperChoice const odeStepperChoice;
+    double const stepperTolerance;
+    std::vector< double > odeintActionIntegrals;
+    double integratedActionToProfileEnd;
+    double actionScale;
 
 
-    // This walks along auxiliaryProfile looking for the segment which starts
-    // before radialValue and ends after it, in terms of the radial variable,
-    // then returns the index of that segment and the difference between
-    // radialValue and the radial start of the segment.
+    // This finds the segment of auxiliaryProfile which starts before
+    // radialValue and ends after it, in terms of the radial variable, by
+    // binary search, then returns the index of that segment and the
+    // difference between radialValue and the radial start of the segment.
     IndexAndRemainder
     SegmentAndRemainder( double const radialValue ) const;
 
@@ -118,6 +180,25 @@ namespace VevaciousPlusPlus
     // odeintProfile to auxiliaryProfile.
     void RecordFromOdeintProfile( TunnelPath const& tunnelPath );
 
+    // This sets up initialConditions for a shot from initialAuxiliary and then
+    // integrates until the shot is definitely an undershoot or an overshoot,
+    // or is close enough to the false vacuum.
+    void ShootFromInitialAuxiliary( TunnelPath const& tunnelPath,
+                        OneDimensionalPotentialAlongPath const& pathPotential,
+                                    double const twoPlusTwiceDampingFactor );
+
+    // This returns the distance along the path between undershootAuxiliary
+    // and overshootAuxiliary, taking into account that either might be stored
+    // as an offset from the path panic vacuum.
+    double BracketWidth(
+                 OneDimensionalPotentialAlongPath const& pathPotential ) const;
+
+    // This returns pathAuxiliary as it should be stored in initialAuxiliary,
+    // which is as the (negative) offset from the path panic vacuum if it is
+    // close to the path panic vacuum.
+    double ShotAuxiliary( double const pathAuxiliary,
+                 OneDimensionalPotentialAlongPath const& pathPotential ) const;
+
     // This performs the integration based on what is in initialConditions. It
     // also sets undershootAuxiliary, overshootAuxiliary, and
     // worthIntegratingFurther based on whether the integration showed that
@@ -127,6 +208,39 @@ namespace VevaciousPlusPlus
     void ShootFromInitialConditions( TunnelPath const& tunnelPath,
                        OneDimensionalPotentialAlongPath const& pathPotential );
 
+    // This integrates the bubble equation of motion and the bounce action
+    // from initialConditions and integratedActionToProfileEnd with the
+    // dense-output stepper given by odeStepperChoice, filling odeintProfile
+    // and odeintActionIntegrals.
+    void ShootWithDenseOutput( TunnelPath const& tunnelPath,
+                       OneDimensionalPotentialAlongPath const& pathPotential );
+
+    // This steps denseStepper from integrationStartRadius until
+    // integrationEndRadius, or until the shot is definitely an undershoot or
+    // an overshoot, in which case the radial value where that first happens
+    // is found by bisection using the dense output. The state at the end of
+    // each step is recorded in odeintProfile and odeintActionIntegrals, and
+    // if the integration stopped early, the last 2 points recorded are just
+    // before and just after the shot was decided.
+    template< class DenseStepper, class SystemType, class StateType >
+    void IntegrateToEvent( DenseStepper& denseStepper,
+                           SystemType bubbleSystem,
+                           StateType& integrationState );
+
+    // This records the point given by radialValue and integrationState in
+    // odeintProfile and odeintActionIntegrals.
+    template< class StateType >
+    void RecordDenseOutputPoint( double const radialValue,
+                                 StateType const& integrationState );
+
+    // This returns true if the state shows that the shot has definitely
+    // overshot or undershot, in the same way as RecordFromOdeintProfile.
+    template< class StateType >
+    bool ShotIsDecided( StateType const& integrationState ) const
+    { return ( ( integrationState[ 0 ] < auxiliaryAtRadialInfinity )
+               ||
+               ( integrationState[ 1 ] > 0.0 ) ); }
+
     // This returns the slope of the solution for the bubble equation of motion
     // along the path in terms of p, which is either the derivative of
     // 2*sinh(x)/x for T != 0 or of 4*I_1(x)/x.
@@ -181,26 +295,36 @@ namespace VevaciousPlusPlus
         * auxiliaryProfile[ segmentAndRemainder.first + 1 ].auxiliarySlope ) );
   }
 
-  // This walks along auxiliaryProfile looking for the segment which starts
-  // before radialValue and ends after it, in terms of the radial variable,
-  // then returns the index of that segment and the difference between
+  // This finds the segment of auxiliaryProfile which starts before
+  // radialValue and ends after it, in terms of the radial variable, by binary
+  // search, then returns the index of that segment and the difference between
   // radialValue and the radial start of the segment.
   inline UndershootOvershootBubble::IndexAndRemainder
   UndershootOvershootBubble::SegmentAndRemainder(
                                                double const radialValue ) const
   {
-    size_t segmentIndex( 0 );
-    size_t const maximumIndexForLoop( auxiliaryProfile.size() - 1 );
-    while( ( segmentIndex < maximumIndexForLoop )
-           &&
-           ( radialValue > auxiliaryProfile[ ++segmentIndex ].radialValue ) )
-    {}
-    // The condition of the loop iterates segmentIndex until it is at the point
-    // where auxiliaryProfile[ segmentIndex ] (after increment) starts beyond
-    // radialValue, so we know that segmentIndex is 1 beyond what we want to
-    // return.
-    return IndexAndRemainder( segmentIndex - 1,
-          ( radialValue - auxiliaryProfile[ segmentIndex - 1 ].radialValue ) );
+    if( auxiliaryProfile.size() < 2 )
+    {
+      return IndexAndRemainder( 0,
+                  ( radialValue - auxiliaryProfile.front().radialValue ) );
+    }
+    // The first point from the 2nd point onwards which does not start before
+    // radialValue is the end of the segment we want. The last point is left
+    // out of the search so that radial values beyond the end of the profile
+    // get the last segment.
+    std::vector< BubbleRadialValueDescription >::const_iterator const
+    secondPoint( auxiliaryProfile.begin() + 1 );
+    std::vector< BubbleRadialValueDescription >::const_iterator const
+    lastPoint( auxiliaryProfile.end() - 1 );
+    size_t const segmentIndex( std::lower_bound( secondPoint,
+                                                 lastPoint,
+                                    BubbleRadialValueDescription( radialValue,
+                                                                  0.0,
+                                                                  0.0 ),
+                              BubbleRadialValueDescription::SortByRadialValue )
+                               - secondPoint );
+    return IndexAndRemainder( segmentIndex,
+              ( radialValue - auxiliaryProfile[ segmentIndex ].radialValue ) );
   }
 
   // This returns the weights of the ends of the segment with index
@@ -221,6 +345,39 @@ namespace VevaciousPlusPlus
                                         weightForLargerRadius );
   }
 
+  // This returns the distance along the path between undershootAuxiliary and
+  // overshootAuxiliary, taking into account that either might be stored as an
+  // offset from the path panic vacuum.
+  inline double UndershootOvershootBubble::BracketWidth(
+                  OneDimensionalPotentialAlongPath const& pathPotential ) const
+  {
+    // It shouldn't ever happen that undershootAuxiliary is negative while
+    // overshootAuxiliary is positive, so either both are stored the same way
+    // or only overshootAuxiliary is an offset from the path panic vacuum.
+    if( ( undershootAuxiliary > 0.0 )
+        &&
+        ( overshootAuxiliary <= 0.0 ) )
+    {
+      return ( overshootAuxiliary + pathPotential.AuxiliaryOfPathPanicVacuum()
+               - undershootAuxiliary );
+    }
+    return ( overshootAuxiliary - undershootAuxiliary );
+  }
+
+  // This returns pathAuxiliary as it should be stored in initialAuxiliary,
+  // which is as the (negative) offset from the path panic vacuum if it is
+  // close to the path panic vacuum.
+  inline double UndershootOvershootBubble::ShotAuxiliary(
+                                                   double const pathAuxiliary,
+                  OneDimensionalPotentialAlongPath const& pathPotential ) const
+  {
+    if( pathAuxiliary >= pathPotential.ThresholdForNearPathPanic() )
+    {
+      return ( pathAuxiliary - pathPotential.AuxiliaryOfPathPanicVacuum() );
+    }
+    return pathAuxiliary;
+  }
+
   // This performs the integration based on what is in initialConditions. It
   // also sets undershootAuxiliary, overshootAuxiliary, and
   // worthIntegratingFurther based on whether the integration showed that
@@ -231,6 +388,13 @@ namespace VevaciousPlusPlus
                                                   TunnelPath const& tunnelPath,
                         OneDimensionalPotentialAlongPath const& pathPotential )
   {
+    if( ActionIsIntegrated() )
+    {
+      ShootWithDenseOutput( tunnelPath,
+                            pathPotential );
+      RecordFromOdeintProfile( tunnelPath );
+      return;
+    }
     odeintProfile.clear();
     OdeintBubbleDerivatives bubbleDerivatives( pathPotential,
                                                tunnelPath );
@@ -17,6 +17,7 @@
 #include <map>
 #include <algorithm>
 #include "LhaLinearlyInterpolatedBlockEntry.hpp"
+#include "LhaScaleInterpolationTable.hpp"
 #include "Utilities/VirtualSimpleLhaParser.hpp"
 #include "LhaSourcedParameterFunctionoid.hpp"
 #include <sstream>
@@ -144,6 +145,10 @@ namespace VevaciousPlusPlus
     std::map< std::string, size_t > activeParametersToIndices;
     std::vector< LhaBlockEntryInterpolator* > referenceSafeActiveParameters;
     std::vector< LhaBlockEntryInterpolator > referenceUnsafeActiveParameters;
+    // This holds the values of all of referenceUnsafeActiveParameters on a
+    // shared set of scales, so that ParameterValues only has to find the
+    // segment of scales once for all the parameters.
+    LhaScaleInterpolationTable sharedScaleTable;
     std::set< std::string > validBlocks;
     std::vector<std::pair<std::string,std::string>> derivedparameters;
     VirtualSimpleLhaParser lhaParser;
@@ -173,7 +178,8 @@ namespace VevaciousPlusPlus
     // parameter in referenceSafeActiveParameters to update itself, and sets up
     // referenceUnsafeActiveParameters as a contiguous array of
     // LhaBlockEntryInterpolator objects copied from the objects pointed at by
-    // the pointers in referenceSafeActiveParameters.
+    // the pointers in referenceSafeActiveParameters, then puts them all into
+    // sharedScaleTable.
     virtual void PrepareNewParameterPoint( std::string const& newInput );
     
     // This reads a slha block into a lhaParser object
@@ -270,20 +276,15 @@ namespace VevaciousPlusPlus
   // that the indices given out by RegisterParameter correctly match the
   // parameter with its element in the vector. There may be gaps if a derived
   // class has registered parameters other than those in
-  // activeInterpolatedParameters.
+  // activeInterpolatedParameters. The segment of scales is found once by
+  // binary search in sharedScaleTable for all the parameters.
   inline void LesHouchesAccordBlockEntryManager::ParameterValues(
                                                  double const logarithmOfScale,
                                std::vector< double >& destinationVector ) const
   {
     destinationVector.resize( numberOfDistinctActiveParameters );
-    for( std::vector< LhaBlockEntryInterpolator >::const_iterator
-         parameterInterpolator( referenceUnsafeActiveParameters.begin() );
-         parameterInterpolator != referenceUnsafeActiveParameters.end();
-         ++parameterInterpolator )
-    {
-      destinationVector[ parameterInterpolator->IndexInValuesVector() ]
-      = (*parameterInterpolator)( logarithmOfScale );
-    }
+    sharedScaleTable.FillValues( logarithmOfScale,
+                                 destinationVector );
   }
 
   // This writes a function in the form
@@ -374,7 +375,8 @@ namespace VevaciousPlusPlus
   // parameter in referenceSafeActiveParameters to update itself, and sets up
   // referenceUnsafeActiveParameters as a contiguous array of
   // LhaBlockEntryInterpolator objects copied from the objects pointed at by
-  // the pointers in referenceSafeActiveParameters.
+  // the pointers in referenceSafeActiveParameters, then puts them all into
+  // sharedScaleTable.
   inline void LesHouchesAccordBlockEntryManager::PrepareNewParameterPoint(
                                                   std::string const& newInput )
   {
@@ -394,6 +396,7 @@ namespace VevaciousPlusPlus
       referenceUnsafeActiveParameters[ parameterIndex ]
       = *(referenceSafeActiveParameters[ parameterIndex ]);
     }
+    sharedScaleTable.SetEntries( referenceUnsafeActiveParameters );
   }
   
 //Parse Derived Parameters from the xmlbody and save it in the derivedparameters vector
@@ -450,6 +453,9 @@ namespace VevaciousPlusPlus
                                               numberOfDistinctActiveParameters,
                                                                      lhaParser,
                                                              parameterName ) );
+    // The entry is registered with the parser so that it is read from a slot
+    // for each new parameter point.
+    referenceSafeActiveParameters.back()->RegisterEntrySlot( lhaParser );
     return *(referenceSafeActiveParameters.back());
   }
 
@@ -11,8 +11,13 @@
 #include "LhaSourcedParameterFunctionoid.hpp"
 #include <cstddef>
 #include "LHPC/SimpleLhaParser.hpp"
+#include "LHPC/Utilities/ParsingUtilities.hpp"
+#include "Utilities/VirtualSimpleLhaParser.hpp"
 #include <vector>
 #include <string>
+#include <utility>
+#include <sstream>
+#include <stdexcept>
 
 namespace VevaciousPlusPlus
 {
@@ -22,17 +27,25 @@ namespace VevaciousPlusPlus
   {
   public:
     LhaInterpolatedParameterFunctionoid( size_t const indexInValuesVector,
-                                        LHPC::SimpleLhaParser const& lhaParser,
+                                       VirtualSimpleLhaParser const& lhaParser,
                                          std::string const& parameterName ) :
       LhaSourcedParameterFunctionoid( indexInValuesVector ),
       parameterName( parameterName ),
-      lhaParser( &lhaParser ) {}
+      blockNameWithIndices(
+       LHPC::SimpleLhaParser::ParseBlockNameAndIndices( parameterName ) ),
+      lhaParser( &lhaParser ),
+      entrySlot( false,
+                 0 )
+    { LHPC::ParsingUtilities::TransformToUppercase(
+                                                blockNameWithIndices.first ); }
 
     LhaInterpolatedParameterFunctionoid(
                       LhaInterpolatedParameterFunctionoid const& copySource ) :
       LhaSourcedParameterFunctionoid( copySource.indexInValuesVector ),
       parameterName( copySource.parameterName ),
-      lhaParser( copySource.lhaParser ) {}
+      blockNameWithIndices( copySource.blockNameWithIndices ),
+      lhaParser( copySource.lhaParser ),
+      entrySlot( copySource.entrySlot ) {}
 
     virtual ~LhaInterpolatedParameterFunctionoid() {}
 
@@ -54,12 +67,79 @@ namespace VevaciousPlusPlus
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const = 0;
 
+    // This registers the block entry with lhaParserToRegisterWith, which must
+    // be the parser given to the constructor, so that its values are read
+    // from a slot for each new parameter point rather than being looked up
+    // by block name and indices. Functionoids which are not registered, such
+    // as those for once-off evaluations through a const parser, still work
+    // by looking up the entry by its name.
+    void RegisterEntrySlot( VirtualSimpleLhaParser& lhaParserToRegisterWith );
+
 
   protected:
     std::string parameterName;
-    LHPC::SimpleLhaParser const* lhaParser;
+    // The block name and indices are parsed once here so that the numeric
+    // entries can be looked up directly for each new parameter point.
+    std::pair< std::string, std::vector< int > > blockNameWithIndices;
+    VirtualSimpleLhaParser const* lhaParser;
+    std::pair< bool, size_t > entrySlot;
+
+
+    // This fills entriesAtScales with the values of the block entry paired
+    // with the scales of their blocks, from the registered slot if there is
+    // one, ignoring blocks without explicit scales if onlyWithExplicitScale
+    // is true.
+    void NumericEntries(
+                   std::vector< std::pair< double, double > >& entriesAtScales,
+                         bool const onlyWithExplicitScale ) const;
   };
 
+
+
+
+
+  // This registers the block entry with lhaParserToRegisterWith, which must
+  // be the parser given to the constructor, so that its values are read from
+  // a slot for each new parameter point rather than being looked up by block
+  // name and indices.
+  inline void LhaInterpolatedParameterFunctionoid::RegisterEntrySlot(
+                              VirtualSimpleLhaParser& lhaParserToRegisterWith )
+  {
+    if( &lhaParserToRegisterWith != lhaParser )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "Cannot register \"" << parameterName
+      << "\" with a different parser from the one it reads!";
+      throw std::runtime_error( errorBuilder.str() );
+    }
+    entrySlot.second
+    = lhaParserToRegisterWith.RegisterEntrySlot( blockNameWithIndices.first,
+                                                 blockNameWithIndices.second );
+    entrySlot.first = true;
+  }
+
+  // This fills entriesAtScales with the values of the block entry paired with
+  // the scales of their blocks, from the registered slot if there is one,
+  // ignoring blocks without explicit scales if onlyWithExplicitScale is true.
+  inline void LhaInterpolatedParameterFunctionoid::NumericEntries(
+                   std::vector< std::pair< double, double > >& entriesAtScales,
+                                       bool const onlyWithExplicitScale ) const
+  {
+    if( entrySlot.first )
+    {
+      lhaParser->NumericEntries( entrySlot.second,
+                                 entriesAtScales,
+                                 onlyWithExplicitScale );
+    }
+    else
+    {
+      lhaParser->NumericEntries( blockNameWithIndices.first,
+                                 blockNameWithIndices.second,
+                                 entriesAtScales,
+                                 onlyWithExplicitScale );
+    }
+  }
+
 } /* namespace VevaciousPlusPlus */
 
 #endif /* LHAINTERPOLATEDPARAMETERFUNCTIONOID_HPP_ */
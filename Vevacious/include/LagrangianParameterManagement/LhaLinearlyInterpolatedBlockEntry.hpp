@@ -12,10 +12,12 @@
 #include <utility>
 #include <cstddef>
 #include "LHPC/SimpleLhaParser.hpp"
+#include "Utilities/VirtualSimpleLhaParser.hpp"
 #include <string>
 #include <vector>
 #include <sstream>
 #include <list>
+#include <algorithm>
 #include "LHPC/Utilities/ParsingUtilities.hpp"
 #include <cmath>
 #include <iomanip>
@@ -33,7 +35,7 @@ namespace VevaciousPlusPlus
     { return ( firstPair.second < secondPair.second ); }
 
     LhaLinearlyInterpolatedBlockEntry( size_t const indexInValuesVector,
-                                       LHPC::SimpleLhaParser const& lhaParser,
+                                       VirtualSimpleLhaParser const& lhaParser,
                                        std::string const& parameterName );
     LhaLinearlyInterpolatedBlockEntry(
                          LhaLinearlyInterpolatedBlockEntry const& copySource );
@@ -55,6 +57,9 @@ namespace VevaciousPlusPlus
     // block's scale according to the current status of the block.
     virtual void UpdateForNewLhaParameters();
 
+    std::vector< std::pair< double, double > > const&
+    LogScalesWithValues() const { return logScalesWithValues; }
+
     // This is for creating a Python version of the potential.
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const;
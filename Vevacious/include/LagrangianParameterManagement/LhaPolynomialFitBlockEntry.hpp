@@ -11,6 +11,7 @@
 #include "LhaInterpolatedParameterFunctionoid.hpp"
 #include <cstddef>
 #include "LHPC/SimpleLhaParser.hpp"
+#include "Utilities/VirtualSimpleLhaParser.hpp"
 #include <string>
 #include <vector>
 #include <cstddef>
@@ -28,7 +29,7 @@ namespace VevaciousPlusPlus
   {
   public:
     LhaPolynomialFitBlockEntry( size_t const indexInValuesVector,
-                                LHPC::SimpleLhaParser const& lhaParser,
+                                VirtualSimpleLhaParser const& lhaParser,
                                 std::string const& parameterName  );
     LhaPolynomialFitBlockEntry( LhaPolynomialFitBlockEntry const& copySource );
     virtual ~LhaPolynomialFitBlockEntry();
@@ -0,0 +1,120 @@
+/*
+ * LhaScaleInterpolationTable.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef LHASCALEINTERPOLATIONTABLE_HPP_
+#define LHASCALEINTERPOLATIONTABLE_HPP_
+
+#include "LhaLinearlyInterpolatedBlockEntry.hpp"
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace VevaciousPlusPlus
+{
+  // This class holds the values of a set of LhaLinearlyInterpolatedBlockEntry
+  // objects at every logarithm of scale at which any of them has a value, so
+  // that all of them can be interpolated together with a single binary search
+  // for the segment of scales. As each entry is linear between its own
+  // scales, and each of those scales is also in the shared set, the
+  // interpolation of the values on the shared set of scales is the same as
+  // the interpolation of each entry on its own scales (including the linear
+  // extrapolation beyond the lowest and highest scales). The values and the
+  // slopes are stored scale by scale, so that the values of all the entries
+  // for a given segment are contiguous in memory.
+  class LhaScaleInterpolationTable
+  {
+  public:
+    LhaScaleInterpolationTable();
+    virtual ~LhaScaleInterpolationTable();
+
+
+    // This sets up the shared set of logarithms of scales from the scales of
+    // all the entries in blockEntries, and the values and slopes of each
+    // entry at each of those logarithms of scales.
+    void
+    SetEntries(
+        std::vector< LhaLinearlyInterpolatedBlockEntry > const& blockEntries );
+
+    // This sets the element of destinationVector given by the
+    // IndexInValuesVector() of each entry to be the value of the entry at
+    // logarithmOfScale. It does not change the size of destinationVector.
+    void FillValues( double const logarithmOfScale,
+                     std::vector< double >& destinationVector ) const;
+
+
+  protected:
+    size_t numberOfEntries;
+    std::vector< size_t > destinationIndices;
+    std::vector< double > logScales;
+    // The value of the entry with index entryIndex at the scale with index
+    // scaleIndex is
+    // valuesAtScales[ ( scaleIndex * numberOfEntries ) + entryIndex ], and
+    // slopesBelowScales[ ( scaleIndex * numberOfEntries ) + entryIndex ] is
+    // the slope of the straight line between that value and the value at the
+    // scale with index ( scaleIndex - 1 ) (with the slopes for scaleIndex = 0
+    // left as zero).
+    std::vector< double > valuesAtScales;
+    std::vector< double > slopesBelowScales;
+
+
+    // This returns the index of the smallest logarithm of scale in logScales
+    // which is larger than logarithmOfScale, starting from index 1 so that
+    // there is always an index just before, and returning the last index if
+    // logarithmOfScale is larger than all of them, matching
+    // LhaLinearlyInterpolatedBlockEntry::InterpolateOrExtrapolate.
+    size_t IndexOfGreaterLog( double const logarithmOfScale ) const;
+  };
+
+
+
+
+
+  // This sets the element of destinationVector given by the
+  // IndexInValuesVector() of each entry to be the value of the entry at
+  // logarithmOfScale. It does not change the size of destinationVector.
+  inline void LhaScaleInterpolationTable::FillValues(
+                                                 double const logarithmOfScale,
+                               std::vector< double >& destinationVector ) const
+  {
+    if( numberOfEntries == 0 )
+    {
+      return;
+    }
+    size_t const scaleIndex( IndexOfGreaterLog( logarithmOfScale ) );
+    double const scaleDifference( logarithmOfScale
+                                  - logScales[ scaleIndex ] );
+    double const* const segmentValues( valuesAtScales.data()
+                                       + ( scaleIndex * numberOfEntries ) );
+    double const* const segmentSlopes( slopesBelowScales.data()
+                                       + ( scaleIndex * numberOfEntries ) );
+    for( size_t entryIndex( 0 );
+         entryIndex < numberOfEntries;
+         ++entryIndex )
+    {
+      destinationVector[ destinationIndices[ entryIndex ] ]
+      = ( segmentValues[ entryIndex ]
+          + ( segmentSlopes[ entryIndex ] * scaleDifference ) );
+    }
+  }
+
+  // This returns the index of the smallest logarithm of scale in logScales
+  // which is larger than logarithmOfScale, starting from index 1 so that there
+  // is always an index just before, and returning the last index if
+  // logarithmOfScale is larger than all of them, matching
+  // LhaLinearlyInterpolatedBlockEntry::InterpolateOrExtrapolate.
+  inline size_t LhaScaleInterpolationTable::IndexOfGreaterLog(
+                                          double const logarithmOfScale ) const
+  {
+    size_t const lastIndex( logScales.size() - 1 );
+    return ( std::upper_bound( logScales.begin() + 1,
+                               logScales.begin() + lastIndex,
+                               logarithmOfScale ) - logScales.begin() );
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* LHASCALEINTERPOLATIONTABLE_HPP_ */
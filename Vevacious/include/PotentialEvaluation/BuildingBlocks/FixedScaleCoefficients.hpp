@@ -0,0 +1,82 @@
+/*
+ * FixedScaleCoefficients.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef FIXEDSCALECOEFFICIENTS_HPP_
+#define FIXEDSCALECOEFFICIENTS_HPP_
+
+#include <vector>
+#include <cstddef>
+
+namespace VevaciousPlusPlus
+{
+  // This class holds the values of the Lagrangian parameters at a single
+  // fixed renormalization scale, along with the coefficient (the constant
+  // factor multiplied by the Lagrangian parameters) of every term of every
+  // ParametersAndFieldsProductTape of a potential at that scale. Each tape is
+  // given the offset of its block of coefficients once, when the potential
+  // is prepared for evaluation, and then reads its coefficients from
+  // whichever FixedScaleCoefficients it is given. A new object is filled for
+  // each parameter point and is not changed once evaluations have been given
+  // it, so any number of threads can evaluate with it at the same time.
+  class FixedScaleCoefficients
+  {
+  public:
+    FixedScaleCoefficients( double const renormalizationScale,
+                            size_t const numberOfTermCoefficients ) :
+      renormalizationScale( renormalizationScale ),
+      inverseScaleSquared( 1.0 / ( renormalizationScale
+                                   * renormalizationScale ) ),
+      parameterValues(),
+      termCoefficients( numberOfTermCoefficients,
+                        0.0 ) {}
+
+    FixedScaleCoefficients( FixedScaleCoefficients const& copySource ) :
+      renormalizationScale( copySource.renormalizationScale ),
+      inverseScaleSquared( copySource.inverseScaleSquared ),
+      parameterValues( copySource.parameterValues ),
+      termCoefficients( copySource.termCoefficients ) {}
+
+    virtual ~FixedScaleCoefficients() {}
+
+
+    double RenormalizationScale() const { return renormalizationScale; }
+
+    double InverseScaleSquared() const { return inverseScaleSquared; }
+
+    // This returns the values of the Lagrangian parameters at the scale.
+    std::vector< double > const& ParameterValues() const
+    { return parameterValues; }
+
+    // This allows the values of the Lagrangian parameters to be set while the
+    // coefficients are being filled.
+    std::vector< double >& ParameterValues() { return parameterValues; }
+
+    // This returns a pointer to the first of the coefficients of the tape
+    // with the offset coefficientOffset.
+    double const*
+    TermCoefficients( size_t const coefficientOffset ) const
+    { return ( termCoefficients.data() + coefficientOffset ); }
+
+    // This allows the coefficients of the tape with the offset
+    // coefficientOffset to be set while the coefficients are being filled.
+    double* TermCoefficients( size_t const coefficientOffset )
+    { return ( termCoefficients.data() + coefficientOffset ); }
+
+    size_t NumberOfTermCoefficients() const
+    { return termCoefficients.size(); }
+
+
+  protected:
+    double renormalizationScale;
+    double inverseScaleSquared;
+    std::vector< double > parameterValues;
+    std::vector< double > termCoefficients;
+  };
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* FIXEDSCALECOEFFICIENTS_HPP_ */
@@ -9,9 +9,12 @@
 #define PARAMETERSANDFIELDSPRODUCTSUM_HPP_
 
 #include "ParametersAndFieldsProductTerm.hpp"
+#include "ParametersAndFieldsProductTape.hpp"
+#include "FixedScaleCoefficients.hpp"
 #include <vector>
 #include <string>
 #include <sstream>
+#include <cstddef>
 
 namespace VevaciousPlusPlus
 {
@@ -19,39 +22,88 @@ namespace VevaciousPlusPlus
   class ParametersAndFieldsProductSum
   {
   public:
-    ParametersAndFieldsProductSum() : parametersAndFieldsProducts() {}
+    ParametersAndFieldsProductSum() : parametersAndFieldsProducts(),
+                                      compiledTape(),
+                                      tapeIsCurrent( false ) {}
 
     ParametersAndFieldsProductSum(
                             ParametersAndFieldsProductSum const& copySource ) :
-      parametersAndFieldsProducts( copySource.parametersAndFieldsProducts ) {}
+      parametersAndFieldsProducts( copySource.parametersAndFieldsProducts ),
+      compiledTape( copySource.compiledTape ),
+      tapeIsCurrent( copySource.tapeIsCurrent ) {}
 
     virtual ~ParametersAndFieldsProductSum() {}
 
 
-    // This calls UpdateForFixedScale on each element of
-    // parametersAndFieldsProducts.
-    void UpdateForFixedScale( std::vector< double > const& parameterValues );
+    // This gives compiledTape its offset within any FixedScaleCoefficients
+    // from nextOffset if it is current, as for
+    // ParametersAndFieldsProductTape::AssignCoefficientOffset. It should be
+    // called after CompileTape.
+    void AssignCoefficientOffset( size_t& nextOffset );
+
+    // This sets the coefficients of compiledTape in coefficientSnapshot if it
+    // is current.
+    void SetFixedScaleCoefficients(
+                           FixedScaleCoefficients& coefficientSnapshot ) const;
 
     // This returns the sum of operator() for each element of
-    // parametersAndFieldsProducts.
+    // parametersAndFieldsProducts, evaluated through compiledTape if it is
+    // current.
     double operator()( std::vector< double > const& parameterValues,
                        std::vector< double > const& fieldConfiguration ) const;
 
     // This returns the sum of operator() for each element of
-    // parametersAndFieldsProducts.
-    double operator()( std::vector< double > const& fieldConfiguration ) const;
+    // parametersAndFieldsProducts with the Lagrangian parameters at the scale
+    // of coefficientSnapshot, evaluated through compiledTape with its
+    // coefficients from coefficientSnapshot if it is current.
+    double operator()( FixedScaleCoefficients const& coefficientSnapshot,
+                       std::vector< double > const& fieldConfiguration ) const;
+
+    // This adds the sum of operator() for each element of
+    // parametersAndFieldsProducts, with the Lagrangian parameters at the
+    // scale of coefficientSnapshot, to each of the numberOfConfigurations
+    // elements of batchSums, for field values given field by field in
+    // fieldValuesByField as for ParametersAndFieldsProductTape, through
+    // compiledTape if it is current.
+    void AddToBatchSums( FixedScaleCoefficients const& coefficientSnapshot,
+                         std::vector< double > const& fieldValuesByField,
+                         size_t const numberOfConfigurations,
+                         std::vector< double >& termProducts,
+                         double* const batchSums ) const;
+
+    // This flattens parametersAndFieldsProducts into compiledTape, which is
+    // then used for evaluating the sum until the terms are next accessed
+    // through the non-const version of ParametersAndFieldsProducts(). It
+    // should be called once all the terms have been read in, and before
+    // AssignCoefficientOffset.
+    void CompileTape();
 
     std::vector< ParametersAndFieldsProductTerm > const&
     ParametersAndFieldsProducts() const
     { return parametersAndFieldsProducts; }
 
+    // This allows the terms to be changed, so compiledTape is marked as no
+    // longer current.
     std::vector< ParametersAndFieldsProductTerm >&
-    ParametersAndFieldsProducts() { return parametersAndFieldsProducts; }
+    ParametersAndFieldsProducts()
+    { tapeIsCurrent = false;
+      return parametersAndFieldsProducts; }
 
     // This returns the highest sum of field powers of all the terms in
     // parametersAndFieldsProducts.
     unsigned int HighestFieldPower() const;
 
+    // This returns true if any of the terms has a non-zero power of the field
+    // with index fieldIndex.
+    bool NonZeroDerivative( size_t const fieldIndex ) const;
+
+    // This returns a ParametersAndFieldsProductSum that is the partial
+    // derivative with respect to the field with index fieldIndex. Terms which
+    // do not depend on the field are left out rather than kept with zero
+    // coefficients.
+    ParametersAndFieldsProductSum
+    PartialDerivative( size_t const fieldIndex ) const;
+
     // This returns a string that should be valid Python assuming that the
     // field configuration is given as an array called "fv" and that the
     // Lagrangian parameters are in an array called "lp".
@@ -63,32 +115,50 @@ namespace VevaciousPlusPlus
 
   protected:
     std::vector< ParametersAndFieldsProductTerm > parametersAndFieldsProducts;
+    ParametersAndFieldsProductTape compiledTape;
+    bool tapeIsCurrent;
   };
 
 
 
 
 
-  // This calls UpdateForFixedScale on each element of
-  // parametersAndFieldsProducts.
-  inline void ParametersAndFieldsProductSum::UpdateForFixedScale(
-                                 std::vector< double > const& parameterValues )
+  // This gives compiledTape its offset within any FixedScaleCoefficients from
+  // nextOffset if it is current, as for
+  // ParametersAndFieldsProductTape::AssignCoefficientOffset. It should be
+  // called after CompileTape.
+  inline void
+  ParametersAndFieldsProductSum::AssignCoefficientOffset( size_t& nextOffset )
   {
-    for( std::vector< ParametersAndFieldsProductTerm >::iterator
-         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
-         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
-         ++parametersAndFieldsProduct )
+    if( tapeIsCurrent )
+    {
+      compiledTape.AssignCoefficientOffset( nextOffset );
+    }
+  }
+
+  // This sets the coefficients of compiledTape in coefficientSnapshot if it is
+  // current.
+  inline void ParametersAndFieldsProductSum::SetFixedScaleCoefficients(
+                            FixedScaleCoefficients& coefficientSnapshot ) const
+  {
+    if( tapeIsCurrent )
     {
-      parametersAndFieldsProduct->UpdateForFixedScale( parameterValues );
+      compiledTape.SetFixedScaleCoefficients( coefficientSnapshot );
     }
   }
 
   // This returns the sum of operator() for each element of
-  // parametersAndFieldsProducts.
+  // parametersAndFieldsProducts, evaluated through compiledTape if it is
+  // current.
   inline double ParametersAndFieldsProductSum::operator()(
                                   std::vector< double > const& parameterValues,
                         std::vector< double > const& fieldConfiguration ) const
   {
+    if( tapeIsCurrent )
+    {
+      return compiledTape( parameterValues,
+                           fieldConfiguration );
+    }
     double returnSum( 0.0 );
     for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
          parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
@@ -102,19 +172,76 @@ namespace VevaciousPlusPlus
   }
 
   // This returns the sum of operator() for each element of
-  // parametersAndFieldsProducts.
+  // parametersAndFieldsProducts with the Lagrangian parameters at the scale of
+  // coefficientSnapshot, evaluated through compiledTape with its coefficients
+  // from coefficientSnapshot if it is current.
   inline double ParametersAndFieldsProductSum::operator()(
+                             FixedScaleCoefficients const& coefficientSnapshot,
                         std::vector< double > const& fieldConfiguration ) const
   {
-    double returnSum( 0.0 );
-    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
-         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
-         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
-         ++parametersAndFieldsProduct )
+    if( tapeIsCurrent )
     {
-      returnSum += (*parametersAndFieldsProduct)( fieldConfiguration );
+      return compiledTape( coefficientSnapshot,
+                           fieldConfiguration );
     }
-    return returnSum;
+    return (*this)( coefficientSnapshot.ParameterValues(),
+                    fieldConfiguration );
+  }
+
+  // This adds the sum of operator() for each element of
+  // parametersAndFieldsProducts, with the Lagrangian parameters at the scale
+  // of coefficientSnapshot, to each of the numberOfConfigurations elements of
+  // batchSums, for field values given field by field in fieldValuesByField as
+  // for ParametersAndFieldsProductTape, through compiledTape if it is current.
+  inline void ParametersAndFieldsProductSum::AddToBatchSums(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldValuesByField,
+                                           size_t const numberOfConfigurations,
+                                           std::vector< double >& termProducts,
+                                         double* const batchSums ) const
+  {
+    if( tapeIsCurrent )
+    {
+      compiledTape.AddToBatchSums( coefficientSnapshot,
+                                   fieldValuesByField,
+                                   numberOfConfigurations,
+                                   termProducts,
+                                   batchSums );
+      return;
+    }
+    if( numberOfConfigurations == 0 )
+    {
+      return;
+    }
+    size_t const numberOfFields( fieldValuesByField.size()
+                                 / numberOfConfigurations );
+    termProducts.resize( numberOfFields );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < numberOfConfigurations;
+         ++configurationIndex )
+    {
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        termProducts[ fieldIndex ]
+        = fieldValuesByField[ ( fieldIndex * numberOfConfigurations )
+                              + configurationIndex ];
+      }
+      batchSums[ configurationIndex ] += (*this)( coefficientSnapshot,
+                                                  termProducts );
+    }
+  }
+
+  // This flattens parametersAndFieldsProducts into compiledTape, which is
+  // then used for evaluating the sum until the terms are next accessed
+  // through the non-const version of ParametersAndFieldsProducts(). It should
+  // be called once all the terms have been read in.
+  inline void ParametersAndFieldsProductSum::CompileTape()
+  {
+    compiledTape
+    = ParametersAndFieldsProductTape( parametersAndFieldsProducts );
+    tapeIsCurrent = true;
   }
 
   // This returns the highest sum of field powers of all the terms in
@@ -135,6 +262,47 @@ namespace VevaciousPlusPlus
     return highestPower;
   }
 
+  // This returns true if any of the terms has a non-zero power of the field
+  // with index fieldIndex.
+  inline bool ParametersAndFieldsProductSum::NonZeroDerivative(
+                                                size_t const fieldIndex ) const
+  {
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      if( parametersAndFieldsProduct->NonZeroDerivative( fieldIndex ) )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // This returns a ParametersAndFieldsProductSum that is the partial
+  // derivative with respect to the field with index fieldIndex. Terms which
+  // do not depend on the field are left out rather than kept with zero
+  // coefficients.
+  inline ParametersAndFieldsProductSum
+  ParametersAndFieldsProductSum::PartialDerivative(
+                                                size_t const fieldIndex ) const
+  {
+    ParametersAndFieldsProductSum partialDerivative;
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      if( parametersAndFieldsProduct->NonZeroDerivative( fieldIndex ) )
+      {
+        partialDerivative.parametersAndFieldsProducts.push_back(
+                 parametersAndFieldsProduct->PartialDerivative( fieldIndex ) );
+      }
+    }
+    return partialDerivative;
+  }
+
   // This returns a string that should be valid Python assuming that the
   // field configuration is given as an array called "fv" and that the
   // Lagrangian parameters are in an array called "lp".
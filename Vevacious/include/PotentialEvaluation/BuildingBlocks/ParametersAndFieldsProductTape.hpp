@@ -0,0 +1,356 @@
+/*
+ * ParametersAndFieldsProductTape.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef PARAMETERSANDFIELDSPRODUCTTAPE_HPP_
+#define PARAMETERSANDFIELDSPRODUCTTAPE_HPP_
+
+#include "ParametersAndFieldsProductTerm.hpp"
+#include "FixedScaleCoefficients.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace VevaciousPlusPlus
+{
+  // This class holds a flattened copy of a sum of
+  // ParametersAndFieldsProductTerm objects, with the coefficients and the
+  // indices of all the terms each packed into a single contiguous array, so
+  // that evaluating the sum does not have to follow a pointer to separate
+  // arrays for each term. The terms are sorted by their total power of
+  // fields, so that the innermost loop over the field indices of a term has
+  // the same length for a whole block of terms. The coefficients of the
+  // terms with the Lagrangian parameters at a fixed scale are not kept in the
+  // tape but in a FixedScaleCoefficients object, starting at the offset
+  // given to the tape by AssignCoefficientOffset, so that the tape itself is
+  // never changed once it has been built.
+  class ParametersAndFieldsProductTape
+  {
+  public:
+    ParametersAndFieldsProductTape();
+    ParametersAndFieldsProductTape(
+             std::vector< ParametersAndFieldsProductTerm > const& sumOfTerms );
+    ParametersAndFieldsProductTape(
+                            ParametersAndFieldsProductTape const& copySource );
+    virtual ~ParametersAndFieldsProductTape() {}
+
+
+    // This sets the offset of the coefficients of this tape within any
+    // FixedScaleCoefficients to nextOffset, and then increases nextOffset by
+    // the number of terms.
+    void AssignCoefficientOffset( size_t& nextOffset )
+    { coefficientOffset = nextOffset;
+      nextOffset += coefficientConstants.size(); }
+
+    // This sets the coefficient of each term which multiplies the field
+    // values in the block of coefficientSnapshot belonging to this tape,
+    // using the values of the Lagrangian parameters of coefficientSnapshot.
+    void SetFixedScaleCoefficients(
+                           FixedScaleCoefficients& coefficientSnapshot ) const;
+
+    // This returns the sum of the terms evaluated with the values of the
+    // Lagrangian parameters found in parameterValues.
+    double operator()( std::vector< double > const& parameterValues,
+                       std::vector< double > const& fieldConfiguration ) const;
+
+    // This returns the sum of the terms evaluated with the coefficients in
+    // the block of coefficientSnapshot belonging to this tape.
+    double operator()( FixedScaleCoefficients const& coefficientSnapshot,
+                       std::vector< double > const& fieldConfiguration ) const
+    { return SumOfFieldProducts( coefficientSnapshot.TermCoefficients(
+                                                           coefficientOffset ),
+                                 fieldConfiguration ); }
+
+    // This adds the sum of the terms, evaluated with the coefficients in the
+    // block of coefficientSnapshot belonging to this tape, to each of the
+    // numberOfConfigurations elements of batchSums. The field
+    // values are given field by field, so the value of the field with index
+    // fieldIndex in the configuration with index configurationIndex is
+    // fieldValuesByField[ ( fieldIndex * numberOfConfigurations )
+    // + configurationIndex ]. Each term is evaluated for every configuration
+    // in a single loop over contiguous memory, using termProducts as scratch
+    // space.
+    void AddToBatchSums( FixedScaleCoefficients const& coefficientSnapshot,
+                         std::vector< double > const& fieldValuesByField,
+                         size_t const numberOfConfigurations,
+                         std::vector< double >& termProducts,
+                         double* const batchSums ) const;
+
+    // This returns the number of terms in the sum.
+    size_t NumberOfTerms() const { return coefficientConstants.size(); }
+
+
+  protected:
+    // coefficientConstants[ termIndex ] is the constant factor of the term
+    // with index termIndex, and its constant factor multiplied by its
+    // Lagrangian parameters at a fixed scale is at
+    // ( coefficientOffset + termIndex ) in a FixedScaleCoefficients.
+    std::vector< double > coefficientConstants;
+    size_t coefficientOffset;
+    // The Lagrangian parameter indices of the term with index termIndex are
+    // the elements of parameterIndices from parameterOffsets[ termIndex ] up
+    // to (but not including) parameterOffsets[ termIndex + 1 ].
+    std::vector< size_t > parameterOffsets;
+    std::vector< size_t > parameterIndices;
+    // The terms with a total field power of fieldPower have indices from
+    // powerOffsets[ fieldPower ] up to (but not including)
+    // powerOffsets[ fieldPower + 1 ], and each has fieldPower consecutive
+    // elements of fieldIndices, with repeated indices for powers of a field
+    // greater than 1.
+    std::vector< size_t > powerOffsets;
+    std::vector< size_t > fieldIndices;
+
+    // This returns the sum of termCoefficients[ termIndex ] multiplied by the
+    // field product of the term with index termIndex for each term.
+    double SumOfFieldProducts( double const* const termCoefficients,
+                       std::vector< double > const& fieldConfiguration ) const;
+  };
+
+
+
+
+
+  inline ParametersAndFieldsProductTape::ParametersAndFieldsProductTape() :
+    coefficientConstants(),
+    coefficientOffset( 0 ),
+    parameterOffsets( 1,
+                      0 ),
+    parameterIndices(),
+    powerOffsets( 1,
+                  0 ),
+    fieldIndices()
+  {
+    // This constructor is just an initialization list.
+  }
+
+  inline ParametersAndFieldsProductTape::ParametersAndFieldsProductTape(
+            std::vector< ParametersAndFieldsProductTerm > const& sumOfTerms ) :
+    coefficientConstants(),
+    coefficientOffset( 0 ),
+    parameterOffsets( 1,
+                      0 ),
+    parameterIndices(),
+    powerOffsets( 1,
+                  0 ),
+    fieldIndices()
+  {
+    size_t highestPower( 0 );
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         sumTerm( sumOfTerms.begin() );
+         sumTerm < sumOfTerms.end();
+         ++sumTerm )
+    {
+      if( sumTerm->FieldPower() > highestPower )
+      {
+        highestPower = sumTerm->FieldPower();
+      }
+    }
+    coefficientConstants.reserve( sumOfTerms.size() );
+    parameterOffsets.reserve( sumOfTerms.size() + 1 );
+    powerOffsets.reserve( highestPower + 2 );
+    for( size_t fieldPower( 0 );
+         fieldPower <= highestPower;
+         ++fieldPower )
+    {
+      for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+           sumTerm( sumOfTerms.begin() );
+           sumTerm < sumOfTerms.end();
+           ++sumTerm )
+      {
+        if( sumTerm->FieldPower() != fieldPower )
+        {
+          continue;
+        }
+        coefficientConstants.push_back( sumTerm->CoefficientConstant() );
+        parameterIndices.insert( parameterIndices.end(),
+                                 sumTerm->ParameterIndices().begin(),
+                                 sumTerm->ParameterIndices().end() );
+        parameterOffsets.push_back( parameterIndices.size() );
+        fieldIndices.insert( fieldIndices.end(),
+                             sumTerm->FieldProductByIndex().begin(),
+                             sumTerm->FieldProductByIndex().end() );
+      }
+      powerOffsets.push_back( coefficientConstants.size() );
+    }
+  }
+
+  inline ParametersAndFieldsProductTape::ParametersAndFieldsProductTape(
+                           ParametersAndFieldsProductTape const& copySource ) :
+    coefficientConstants( copySource.coefficientConstants ),
+    coefficientOffset( copySource.coefficientOffset ),
+    parameterOffsets( copySource.parameterOffsets ),
+    parameterIndices( copySource.parameterIndices ),
+    powerOffsets( copySource.powerOffsets ),
+    fieldIndices( copySource.fieldIndices )
+  {
+    // This constructor is just an initialization list.
+  }
+
+  // This sets the coefficient of each term which multiplies the field values
+  // in the block of coefficientSnapshot belonging to this tape, using the
+  // values of the Lagrangian parameters of coefficientSnapshot.
+  inline void ParametersAndFieldsProductTape::SetFixedScaleCoefficients(
+                            FixedScaleCoefficients& coefficientSnapshot ) const
+  {
+    std::vector< double > const&
+    parameterValues( coefficientSnapshot.ParameterValues() );
+    double* const
+    fixedScaleCoefficients( coefficientSnapshot.TermCoefficients(
+                                                         coefficientOffset ) );
+    size_t const numberOfTerms( coefficientConstants.size() );
+    for( size_t termIndex( 0 );
+         termIndex < numberOfTerms;
+         ++termIndex )
+    {
+      double termCoefficient( coefficientConstants[ termIndex ] );
+      for( size_t parameterIndex( parameterOffsets[ termIndex ] );
+           parameterIndex < parameterOffsets[ termIndex + 1 ];
+           ++parameterIndex )
+      {
+        termCoefficient
+        *= parameterValues[ parameterIndices[ parameterIndex ] ];
+      }
+      fixedScaleCoefficients[ termIndex ] = termCoefficient;
+    }
+  }
+
+  // This returns the sum of the terms evaluated with the values of the
+  // Lagrangian parameters found in parameterValues.
+  inline double ParametersAndFieldsProductTape::operator()(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& fieldConfiguration ) const
+  {
+    double returnSum( 0.0 );
+    size_t const* termFields( fieldIndices.data() );
+    size_t termIndex( 0 );
+    for( size_t fieldPower( 0 );
+         ( fieldPower + 1 ) < powerOffsets.size();
+         ++fieldPower )
+    {
+      for( ;
+           termIndex < powerOffsets[ fieldPower + 1 ];
+           ++termIndex )
+      {
+        double termValue( coefficientConstants[ termIndex ] );
+        for( size_t parameterIndex( parameterOffsets[ termIndex ] );
+             parameterIndex < parameterOffsets[ termIndex + 1 ];
+             ++parameterIndex )
+        {
+          termValue *= parameterValues[ parameterIndices[ parameterIndex ] ];
+        }
+        for( size_t powerIndex( 0 );
+             powerIndex < fieldPower;
+             ++powerIndex )
+        {
+          termValue *= fieldConfiguration[ termFields[ powerIndex ] ];
+        }
+        termFields += fieldPower;
+        returnSum += termValue;
+      }
+    }
+    return returnSum;
+  }
+
+  // This adds the sum of the terms, evaluated with the coefficients in the
+  // block of coefficientSnapshot belonging to this tape, to each of the
+  // numberOfConfigurations elements of batchSums. The field values are
+  // given field by field, so the value of the field with index fieldIndex in
+  // the configuration with index configurationIndex is
+  // fieldValuesByField[ ( fieldIndex * numberOfConfigurations )
+  // + configurationIndex ]. Each term is evaluated for every configuration in
+  // a single loop over contiguous memory, using termProducts as scratch
+  // space.
+  inline void ParametersAndFieldsProductTape::AddToBatchSums(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldValuesByField,
+                                           size_t const numberOfConfigurations,
+                                           std::vector< double >& termProducts,
+                                         double* const batchSums ) const
+  {
+    termProducts.resize( numberOfConfigurations );
+    double* const productValues( termProducts.data() );
+    double const* const fieldValues( fieldValuesByField.data() );
+    double const* const
+    fixedScaleCoefficients( coefficientSnapshot.TermCoefficients(
+                                                         coefficientOffset ) );
+    size_t const* termFields( fieldIndices.data() );
+    for( size_t fieldPower( 0 );
+         ( fieldPower + 1 ) < powerOffsets.size();
+         ++fieldPower )
+    {
+      size_t const endIndex( powerOffsets[ fieldPower + 1 ] );
+      for( size_t termIndex( powerOffsets[ fieldPower ] );
+           termIndex < endIndex;
+           ++termIndex )
+      {
+        double const termCoefficient( fixedScaleCoefficients[ termIndex ] );
+        for( size_t configurationIndex( 0 );
+             configurationIndex < numberOfConfigurations;
+             ++configurationIndex )
+        {
+          productValues[ configurationIndex ] = termCoefficient;
+        }
+        for( size_t powerIndex( 0 );
+             powerIndex < fieldPower;
+             ++powerIndex )
+        {
+          double const* const factorValues( fieldValues
+                                            + ( termFields[ powerIndex ]
+                                                * numberOfConfigurations ) );
+          for( size_t configurationIndex( 0 );
+               configurationIndex < numberOfConfigurations;
+               ++configurationIndex )
+          {
+            productValues[ configurationIndex ]
+            *= factorValues[ configurationIndex ];
+          }
+        }
+        termFields += fieldPower;
+        for( size_t configurationIndex( 0 );
+             configurationIndex < numberOfConfigurations;
+             ++configurationIndex )
+        {
+          batchSums[ configurationIndex ]
+          += productValues[ configurationIndex ];
+        }
+      }
+    }
+  }
+
+  // This returns the sum of termCoefficients[ termIndex ] multiplied by the
+  // field product of the term with index termIndex for each term.
+  inline double ParametersAndFieldsProductTape::SumOfFieldProducts(
+                                       double const* const termCoefficients,
+                        std::vector< double > const& fieldConfiguration ) const
+  {
+    double const* const fieldValues( fieldConfiguration.data() );
+    size_t const* termFields( fieldIndices.data() );
+    double returnSum( 0.0 );
+    for( size_t fieldPower( 0 );
+         ( fieldPower + 1 ) < powerOffsets.size();
+         ++fieldPower )
+    {
+      size_t const endIndex( powerOffsets[ fieldPower + 1 ] );
+      for( size_t termIndex( powerOffsets[ fieldPower ] );
+           termIndex < endIndex;
+           ++termIndex )
+      {
+        double termValue( termCoefficients[ termIndex ] );
+        for( size_t powerIndex( 0 );
+             powerIndex < fieldPower;
+             ++powerIndex )
+        {
+          termValue *= fieldValues[ termFields[ powerIndex ] ];
+        }
+        termFields += fieldPower;
+        returnSum += termValue;
+      }
+    }
+    return returnSum;
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* PARAMETERSANDFIELDSPRODUCTTAPE_HPP_ */
@@ -116,6 +116,17 @@ namespace VevaciousPlusPlus
     std::vector< unsigned int > const& FieldPowersByIndex() const
     { return fieldPowersByIndex; }
 
+    std::vector< size_t > const& FieldProductByIndex() const
+    { return fieldProductByIndex; }
+
+    std::vector< size_t > const& ParameterIndices() const
+    { return parameterIndices; }
+
+    double CoefficientConstant() const { return coefficientConstant; }
+
+    double CoefficientForFixedScale() const
+    { return totalCoefficientForFixedScale; }
+
     // This returns the sum of the powers of the fields.
     size_t FieldPower() const
     { return fieldProductByIndex.size(); }
@@ -11,8 +11,10 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <cstddef>
 #include "LHPC/Utilities/ParsingUtilities.hpp"
 #include <stdexcept>
+#include "PotentialEvaluation/BuildingBlocks/FixedScaleCoefficients.hpp"
 
 namespace VevaciousPlusPlus
 {
@@ -49,11 +51,70 @@ namespace VevaciousPlusPlus
     MassesSquared( std::vector< double > const& parameterValues,
                    std::vector< double > const& fieldConfiguration ) const = 0;
 
-    // This should return the masses-squared using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale and the
-    // values for the fields found in fieldConfiguration.
+    // This should return the masses-squared using the Lagrangian parameters
+    // at the fixed scale of coefficientSnapshot and the values for the fields
+    // found in fieldConfiguration.
     virtual std::vector< double >
-    MassesSquared( std::vector< double > const& fieldConfiguration ) const = 0;
+    MassesSquared( FixedScaleCoefficients const& coefficientSnapshot,
+                   std::vector< double > const& fieldConfiguration ) const = 0;
+
+    // This puts the masses-squared into massesSquared, using the values for
+    // the Lagrangian parameters found in parameterValues and the values for
+    // the fields found in fieldConfiguration. Derived classes should
+    // over-write this to re-use the memory already held by massesSquared, as
+    // this default just copies the result of MassesSquared( ... ).
+    virtual void
+    SetMassesSquared( std::vector< double > const& parameterValues,
+                      std::vector< double > const& fieldConfiguration,
+                      std::vector< double >& massesSquared ) const
+    { massesSquared = MassesSquared( parameterValues,
+                                     fieldConfiguration ); }
+
+    // This puts the masses-squared into massesSquared, using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot and the values for
+    // the fields found in fieldConfiguration. Derived classes should
+    // over-write this to re-use the memory already held by massesSquared, as
+    // this default just copies the result of MassesSquared( ... ).
+    virtual void
+    SetMassesSquared( FixedScaleCoefficients const& coefficientSnapshot,
+                      std::vector< double > const& fieldConfiguration,
+                      std::vector< double >& massesSquared ) const
+    { massesSquared = MassesSquared( coefficientSnapshot,
+                                     fieldConfiguration ); }
+
+    // This should put the masses-squared into massesSquared and their partial
+    // derivatives with respect to the fields into fieldDerivatives, so that
+    // fieldDerivatives[ fieldIndex ][ massIndex ] is the derivative of
+    // massesSquared[ massIndex ] with respect to the field with index
+    // fieldIndex, using the values for the Lagrangian parameters found in
+    // parameterValues and the values for the fields found in
+    // fieldConfiguration. PrepareForEvaluation must have been called
+    // before this.
+    virtual void MassesSquaredWithFieldDerivatives(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                         std::vector< double >& massesSquared,
+         std::vector< std::vector< double > >& fieldDerivatives ) const = 0;
+
+    // This should put the masses-squared into massesSquared and their partial
+    // derivatives with respect to the fields into fieldDerivatives, so that
+    // fieldDerivatives[ fieldIndex ][ massIndex ] is the derivative of
+    // massesSquared[ massIndex ] with respect to the field with index
+    // fieldIndex, using the Lagrangian parameters at the fixed scale of
+    // coefficientSnapshot and the values for the fields found in
+    // fieldConfiguration. PrepareForEvaluation must have been called
+    // before this.
+    virtual void MassesSquaredWithFieldDerivatives(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                         std::vector< double >& massesSquared,
+         std::vector< std::vector< double > >& fieldDerivatives ) const = 0;
+
+    // This should compile the elements into whatever form is fastest to
+    // evaluate and set up whatever is needed to evaluate the derivatives of
+    // the masses-squared with respect to each of numberOfFields fields. It
+    // should be called once all the elements have been set.
+    virtual void PrepareForEvaluation( size_t const numberOfFields ) = 0;
 
     // This returns the number of identical copies of this mass-squared matrix
     // that the model has.
@@ -61,10 +122,17 @@ namespace VevaciousPlusPlus
 
     SpinType GetSpinType() const{ return spinType; }
 
-    // This should update all objects which contribute to the masses with the
-    // values for the Lagrangian parameters given in parameterValues.
-    virtual void
-    UpdateForFixedScale( std::vector< double > const& parameterValues ) = 0;
+    // This should give each of the objects which contribute to the masses
+    // its offset within any FixedScaleCoefficients, starting from nextOffset
+    // and leaving nextOffset just after the last of them. It should be called
+    // after PrepareForEvaluation.
+    virtual void AssignCoefficientOffsets( size_t& nextOffset ) = 0;
+
+    // This should set the coefficients of all the objects which contribute
+    // to the masses in coefficientSnapshot, using its values for the
+    // Lagrangian parameters.
+    virtual void SetFixedScaleCoefficients(
+                       FixedScaleCoefficients& coefficientSnapshot ) const = 0;
 
 
   protected:
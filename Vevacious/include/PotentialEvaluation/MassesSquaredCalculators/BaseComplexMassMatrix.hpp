@@ -35,22 +35,35 @@ namespace VevaciousPlusPlus
                                                          attributeMap ),
       matrixElements( ( numberOfRows * numberOfRows ),
          ComplexParametersAndFieldsProductSum( ParametersAndFieldsProductSum(),
-                                         ParametersAndFieldsProductSum() ) ) {}
+                                           ParametersAndFieldsProductSum() ) ),
+      fieldDerivativeElements() {}
 
     BaseComplexMassMatrix( BaseComplexMassMatrix const& copySource ) :
       MassesSquaredFromMatrix< std::complex< double > >( copySource ),
-      matrixElements( copySource.matrixElements ) {}
+      matrixElements( copySource.matrixElements ),
+      fieldDerivativeElements( copySource.fieldDerivativeElements ) {}
 
     BaseComplexMassMatrix() :
       MassesSquaredFromMatrix< std::complex< double > >(),
-      matrixElements() {}
+      matrixElements(),
+      fieldDerivativeElements() {}
 
     virtual ~BaseComplexMassMatrix() {}
 
 
-    // This calls UpdateForFixedScale on each element of matrixElements.
-    virtual void
-    UpdateForFixedScale( std::vector< double > const& parameterValues );
+    // This calls AssignCoefficientOffset on each element of matrixElements
+    // and of fieldDerivativeElements.
+    virtual void AssignCoefficientOffsets( size_t& nextOffset );
+
+    // This calls SetFixedScaleCoefficients on each element of matrixElements
+    // and of fieldDerivativeElements.
+    virtual void SetFixedScaleCoefficients(
+                           FixedScaleCoefficients& coefficientSnapshot ) const;
+
+    // This fills fieldDerivativeElements with the partial derivatives of
+    // matrixElements with respect to each of numberOfFields fields, and
+    // compiles the tapes of all the elements and their derivatives.
+    virtual void PrepareForEvaluation( size_t const numberOfFields );
 
     // This allows access to the pair of polynomial sums for a given index.
     ComplexParametersAndFieldsProductSum&
@@ -66,23 +79,124 @@ namespace VevaciousPlusPlus
 
   protected:
     std::vector< ComplexParametersAndFieldsProductSum > matrixElements;
+    // fieldDerivativeElements[ fieldIndex ] is either the set of derivatives
+    // of matrixElements with respect to the field with index fieldIndex, or
+    // empty if none of the elements depend on that field.
+    std::vector< std::vector< ComplexParametersAndFieldsProductSum > >
+    fieldDerivativeElements;
   };
 
 
 
 
 
-  // This calls UpdateForFixedScale on each element of matrixElements.
-  inline void BaseComplexMassMatrix::UpdateForFixedScale(
-                                 std::vector< double > const& parameterValues )
+  // This calls AssignCoefficientOffset on each element of matrixElements and
+  // of fieldDerivativeElements.
+  inline void
+  BaseComplexMassMatrix::AssignCoefficientOffsets( size_t& nextOffset )
+  {
+    for( std::vector< ComplexParametersAndFieldsProductSum >::iterator
+         complexPair( matrixElements.begin() );
+         complexPair < matrixElements.end();
+         ++complexPair )
+    {
+      complexPair->first.AssignCoefficientOffset( nextOffset );
+      complexPair->second.AssignCoefficientOffset( nextOffset );
+    }
+    for( std::vector< std::vector< ComplexParametersAndFieldsProductSum > >
+         ::iterator derivativeElements( fieldDerivativeElements.begin() );
+         derivativeElements < fieldDerivativeElements.end();
+         ++derivativeElements )
+    {
+      for( std::vector< ComplexParametersAndFieldsProductSum >::iterator
+           complexPair( derivativeElements->begin() );
+           complexPair < derivativeElements->end();
+           ++complexPair )
+      {
+        complexPair->first.AssignCoefficientOffset( nextOffset );
+        complexPair->second.AssignCoefficientOffset( nextOffset );
+      }
+    }
+  }
+
+  // This calls SetFixedScaleCoefficients on each element of matrixElements and
+  // of fieldDerivativeElements.
+  inline void BaseComplexMassMatrix::SetFixedScaleCoefficients(
+                            FixedScaleCoefficients& coefficientSnapshot ) const
+  {
+    for( std::vector< ComplexParametersAndFieldsProductSum >::const_iterator
+         complexPair( matrixElements.begin() );
+         complexPair < matrixElements.end();
+         ++complexPair )
+    {
+      complexPair->first.SetFixedScaleCoefficients( coefficientSnapshot );
+      complexPair->second.SetFixedScaleCoefficients( coefficientSnapshot );
+    }
+    for( std::vector< std::vector< ComplexParametersAndFieldsProductSum > >
+         ::const_iterator derivativeElements( fieldDerivativeElements.begin() );
+         derivativeElements < fieldDerivativeElements.end();
+         ++derivativeElements )
+    {
+      for( std::vector< ComplexParametersAndFieldsProductSum >::const_iterator
+           complexPair( derivativeElements->begin() );
+           complexPair < derivativeElements->end();
+           ++complexPair )
+      {
+        complexPair->first.SetFixedScaleCoefficients( coefficientSnapshot );
+        complexPair->second.SetFixedScaleCoefficients( coefficientSnapshot );
+      }
+    }
+  }
+
+  // This fills fieldDerivativeElements with the partial derivatives of
+  // matrixElements with respect to each of numberOfFields fields, and
+  // compiles the tapes of all the elements and their derivatives.
+  inline void
+  BaseComplexMassMatrix::PrepareForEvaluation( size_t const numberOfFields )
   {
+    fieldDerivativeElements.assign( numberOfFields,
+                       std::vector< ComplexParametersAndFieldsProductSum >() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      bool dependsOnField( false );
+      for( std::vector< ComplexParametersAndFieldsProductSum >::const_iterator
+           complexPair( matrixElements.begin() );
+           complexPair < matrixElements.end();
+           ++complexPair )
+      {
+        if( complexPair->first.NonZeroDerivative( fieldIndex )
+            ||
+            complexPair->second.NonZeroDerivative( fieldIndex ) )
+        {
+          dependsOnField = true;
+          break;
+        }
+      }
+      if( dependsOnField )
+      {
+        for( std::vector< ComplexParametersAndFieldsProductSum >
+             ::const_iterator complexPair( matrixElements.begin() );
+             complexPair < matrixElements.end();
+             ++complexPair )
+        {
+          fieldDerivativeElements[ fieldIndex ].push_back(
+                                          ComplexParametersAndFieldsProductSum(
+                            complexPair->first.PartialDerivative( fieldIndex ),
+                       complexPair->second.PartialDerivative( fieldIndex ) ) );
+          fieldDerivativeElements[ fieldIndex ].back().first.CompileTape();
+          fieldDerivativeElements[ fieldIndex ].back().second.CompileTape();
+        }
+      }
+    }
     for( std::vector< ComplexParametersAndFieldsProductSum >::iterator
          complexPair( matrixElements.begin() );
          complexPair < matrixElements.end();
          ++complexPair )
     {
-      complexPair->first.UpdateForFixedScale( parameterValues );
-      complexPair->second.UpdateForFixedScale( parameterValues );
+      complexPair->first.CompileTape();
+      complexPair->second.CompileTape();
     }
   }
 
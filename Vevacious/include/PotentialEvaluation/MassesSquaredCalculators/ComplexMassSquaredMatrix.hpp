@@ -29,18 +29,39 @@ namespace VevaciousPlusPlus
 
 
   protected:
-    // This returns a matrix of the values of the elements for a field
+    // This fills valuesMatrix with the values of the elements for a field
     // configuration given by fieldConfiguration, using the values for the
     // Lagrangian parameters found in parameterValues.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const;
+    virtual void
+    SetCurrentValues( std::vector< double > const& parameterValues,
+                      std::vector< double > const& fieldConfiguration,
+                      Eigen::MatrixXcd& valuesMatrix ) const;
 
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const;
+    // This fills valuesMatrix with the values of the elements for a field
+    // configuration given by fieldConfiguration, using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot.
+    virtual void
+    SetCurrentValues( FixedScaleCoefficients const& coefficientSnapshot,
+                      std::vector< double > const& fieldConfiguration,
+                      Eigen::MatrixXcd& valuesMatrix ) const;
+
+    // This puts the matrices of the partial derivatives of the elements with
+    // respect to each field into derivativeMatrices, using the values for the
+    // Lagrangian parameters found in parameterValues. Fields on which no
+    // element depends get an empty matrix.
+    virtual void
+    FieldDerivativeValues( std::vector< double > const& parameterValues,
+                           std::vector< double > const& fieldConfiguration,
+               std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const;
+
+    // This puts the matrices of the partial derivatives of the elements with
+    // respect to each field into derivativeMatrices, using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot. Fields on which
+    // no element depends get an empty matrix.
+    virtual void
+    FieldDerivativeValues( FixedScaleCoefficients const& coefficientSnapshot,
+                           std::vector< double > const& fieldConfiguration,
+               std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const;
   };
 
 } /* namespace VevaciousPlusPlus */
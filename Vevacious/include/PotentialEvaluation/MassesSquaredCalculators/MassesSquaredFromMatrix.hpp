@@ -14,6 +14,8 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <complex>
+#include <algorithm>
 
 namespace VevaciousPlusPlus
 {
@@ -38,30 +40,139 @@ namespace VevaciousPlusPlus
     MassesSquared( std::vector< double > const& parameterValues,
                    std::vector< double > const& fieldConfiguration ) const;
 
-    // This returns the eigenvalues of the matrix, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale and the
-    // values for the fields found in fieldConfiguration.
+    // This returns the eigenvalues of the matrix, using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot and the values for
+    // the fields found in fieldConfiguration.
     virtual std::vector< double >
-    MassesSquared( std::vector< double > const& fieldConfiguration ) const;
+    MassesSquared( FixedScaleCoefficients const& coefficientSnapshot,
+                   std::vector< double > const& fieldConfiguration ) const;
+
+    // This puts the eigenvalues of the matrix into massesSquared, using the
+    // values for the Lagrangian parameters found in parameterValues and the
+    // values for the fields found in fieldConfiguration. Once the buffers for
+    // the current thread have been used for a matrix of this size and
+    // massesSquared has been filled once, this does not allocate any memory.
+    virtual void
+    SetMassesSquared( std::vector< double > const& parameterValues,
+                      std::vector< double > const& fieldConfiguration,
+                      std::vector< double >& massesSquared ) const;
+
+    // This puts the eigenvalues of the matrix into massesSquared, using the
+    // Lagrangian parameters at the fixed scale of coefficientSnapshot and the
+    // values for the fields found in fieldConfiguration. Once the buffers for
+    // the current thread have been used for a matrix of this size and
+    // massesSquared has been filled once, this does not allocate any memory.
+    virtual void
+    SetMassesSquared( FixedScaleCoefficients const& coefficientSnapshot,
+                      std::vector< double > const& fieldConfiguration,
+                      std::vector< double >& massesSquared ) const;
+
+    // This puts the eigenvalues of the matrix into massesSquared and their
+    // partial derivatives with respect to the fields into fieldDerivatives,
+    // using the values for the Lagrangian parameters found in parameterValues
+    // and the values for the fields found in fieldConfiguration.
+    virtual void MassesSquaredWithFieldDerivatives(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+              std::vector< std::vector< double > >& fieldDerivatives ) const;
+
+    // This puts the eigenvalues of the matrix into massesSquared and their
+    // partial derivatives with respect to the fields into fieldDerivatives,
+    // using the Lagrangian parameters at the fixed scale of
+    // coefficientSnapshot and the values for the fields found in
+    // fieldConfiguration.
+    virtual void MassesSquaredWithFieldDerivatives(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+              std::vector< std::vector< double > >& fieldDerivatives ) const;
 
     size_t NumberOfRows() const { return numberOfRows; }
 
 
   protected:
+    // This holds the Eigen objects used when finding the eigenvalues of a
+    // matrix, so that they can be re-used by later evaluations on the same
+    // thread instead of being allocated afresh for every evaluation.
+    // workingMatrix is free for derived classes to use within
+    // SetCurrentValues and FieldDerivativeValues.
+    struct EigenvalueBuffers
+    {
+      EigenMatrix valuesMatrix;
+      EigenMatrix workingMatrix;
+      EigenMatrix derivativeTimesEigenvectors;
+      std::vector< EigenMatrix > derivativeMatrices;
+      Eigen::SelfAdjointEigenSolver< EigenMatrix > eigenvalueFinder;
+    };
+
     size_t numberOfRows;
 
-    // This should return a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    virtual EigenMatrix
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const = 0;
-
-    // This should return a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual EigenMatrix
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const = 0;
+    // This returns the EigenvalueBuffers for the current thread for matrices
+    // with numberOfRows rows. Each thread has its own set of buffers for each
+    // size of matrix, shared by all the matrices of that size, so that
+    // evaluations on different threads never share memory and evaluations on
+    // the same thread re-use memory which already has the right size.
+    EigenvalueBuffers& ThreadBuffers() const;
+
+    // This should fill valuesMatrix with the values of the elements for a
+    // field configuration given by fieldConfiguration, using the values for
+    // the Lagrangian parameters found in parameterValues. Only the lower
+    // triangle needs to be filled. valuesMatrix should only be resized if it
+    // does not already have numberOfRows rows and columns.
+    virtual void
+    SetCurrentValues( std::vector< double > const& parameterValues,
+                      std::vector< double > const& fieldConfiguration,
+                      EigenMatrix& valuesMatrix ) const = 0;
+
+    // This should fill valuesMatrix with the values of the elements for a
+    // field configuration given by fieldConfiguration, using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot. Only the lower
+    // triangle needs to be filled. valuesMatrix should only be resized if it
+    // does not already have numberOfRows rows and columns.
+    virtual void
+    SetCurrentValues( FixedScaleCoefficients const& coefficientSnapshot,
+                      std::vector< double > const& fieldConfiguration,
+                      EigenMatrix& valuesMatrix ) const = 0;
+
+    // This should put the matrices of the partial derivatives of the elements
+    // with respect to each field into derivativeMatrices (with one matrix per
+    // field, in the same order as the fields), using the values for the
+    // Lagrangian parameters found in parameterValues. Only the lower triangle
+    // of each matrix needs to be filled, as with SetCurrentValues.
+    virtual void
+    FieldDerivativeValues( std::vector< double > const& parameterValues,
+                           std::vector< double > const& fieldConfiguration,
+                 std::vector< EigenMatrix >& derivativeMatrices ) const = 0;
+
+    // This should put the matrices of the partial derivatives of the elements
+    // with respect to each field into derivativeMatrices (with one matrix per
+    // field, in the same order as the fields), using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot. Only the lower
+    // triangle of each matrix needs to be filled, as with SetCurrentValues.
+    virtual void
+    FieldDerivativeValues( FixedScaleCoefficients const& coefficientSnapshot,
+                           std::vector< double > const& fieldConfiguration,
+                 std::vector< EigenMatrix >& derivativeMatrices ) const = 0;
+
+    // This puts the eigenvalues of threadBuffers.valuesMatrix into
+    // massesSquared.
+    void EigenvaluesOnly( EigenvalueBuffers& threadBuffers,
+                          std::vector< double >& massesSquared ) const;
+
+    // This puts the eigenvalues of threadBuffers.valuesMatrix into
+    // massesSquared and their derivatives with respect to the fields, from
+    // threadBuffers.derivativeMatrices, into fieldDerivatives. By the
+    // Hellmann-Feynman theorem, the
+    // derivative of each eigenvalue is the expectation value of the
+    // derivative of the matrix in the corresponding eigenvector. (For
+    // degenerate eigenvalues, the individual derivatives depend on the basis
+    // chosen for the degenerate subspace, but their sum does not, and since
+    // the loop corrections treat degenerate eigenvalues identically, only
+    // their sum matters.)
+    void EigenvaluesWithDerivatives( EigenvalueBuffers& threadBuffers,
+                                     std::vector< double >& massesSquared,
+              std::vector< std::vector< double > >& fieldDerivatives ) const;
   };
 
 
@@ -107,38 +218,209 @@ namespace VevaciousPlusPlus
                                   std::vector< double > const& parameterValues,
                         std::vector< double > const& fieldConfiguration ) const
   {
-    Eigen::SelfAdjointEigenSolver< EigenMatrix >
-    eigenvalueFinder( CurrentValues( parameterValues,
-                                     fieldConfiguration ),
-                      Eigen::EigenvaluesOnly );
-    std::vector< double > massesSquared( numberOfRows );
+    std::vector< double > massesSquared;
+    SetMassesSquared( parameterValues,
+                      fieldConfiguration,
+                      massesSquared );
+    return massesSquared;
+  }
+
+  // This returns the eigenvalues of the matrix, using the Lagrangian
+  // parameters at the fixed scale of coefficientSnapshot and the values for
+  // the fields found in fieldConfiguration.
+  template< typename ElementType > inline std::vector< double >
+  MassesSquaredFromMatrix< ElementType >::MassesSquared(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                        std::vector< double > const& fieldConfiguration ) const
+  {
+    std::vector< double > massesSquared;
+    SetMassesSquared( coefficientSnapshot,
+                      fieldConfiguration,
+                      massesSquared );
+    return massesSquared;
+  }
+
+  // This puts the eigenvalues of the matrix into massesSquared, using the
+  // values for the Lagrangian parameters found in parameterValues and the
+  // values for the fields found in fieldConfiguration. Once the buffers for
+  // the current thread have been used for a matrix of this size and
+  // massesSquared has been filled once, this does not allocate any memory.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::SetMassesSquared(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                   std::vector< double >& massesSquared ) const
+  {
+    EigenvalueBuffers& threadBuffers( ThreadBuffers() );
+    SetCurrentValues( parameterValues,
+                      fieldConfiguration,
+                      threadBuffers.valuesMatrix );
+    EigenvaluesOnly( threadBuffers,
+                     massesSquared );
+  }
+
+  // This puts the eigenvalues of the matrix into massesSquared, using the
+  // Lagrangian parameters at the fixed scale of coefficientSnapshot and the
+  // values for the fields found in fieldConfiguration. Once the buffers for
+  // the current thread have been used for a matrix of this size and
+  // massesSquared has been filled once, this does not allocate any memory.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::SetMassesSquared(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                   std::vector< double >& massesSquared ) const
+  {
+    EigenvalueBuffers& threadBuffers( ThreadBuffers() );
+    SetCurrentValues( coefficientSnapshot,
+                      fieldConfiguration,
+                      threadBuffers.valuesMatrix );
+    EigenvaluesOnly( threadBuffers,
+                     massesSquared );
+  }
+
+  // This puts the eigenvalues of the matrix into massesSquared and their
+  // partial derivatives with respect to the fields into fieldDerivatives,
+  // using the values for the Lagrangian parameters found in parameterValues
+  // and the values for the fields found in fieldConfiguration.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::MassesSquaredWithFieldDerivatives(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+               std::vector< std::vector< double > >& fieldDerivatives ) const
+  {
+    EigenvalueBuffers& threadBuffers( ThreadBuffers() );
+    FieldDerivativeValues( parameterValues,
+                           fieldConfiguration,
+                           threadBuffers.derivativeMatrices );
+    SetCurrentValues( parameterValues,
+                      fieldConfiguration,
+                      threadBuffers.valuesMatrix );
+    EigenvaluesWithDerivatives( threadBuffers,
+                                massesSquared,
+                                fieldDerivatives );
+  }
+
+  // This puts the eigenvalues of the matrix into massesSquared and their
+  // partial derivatives with respect to the fields into fieldDerivatives,
+  // using the Lagrangian parameters at the fixed scale of coefficientSnapshot
+  // and the values for the fields found in fieldConfiguration.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::MassesSquaredWithFieldDerivatives(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+               std::vector< std::vector< double > >& fieldDerivatives ) const
+  {
+    EigenvalueBuffers& threadBuffers( ThreadBuffers() );
+    FieldDerivativeValues( coefficientSnapshot,
+                           fieldConfiguration,
+                           threadBuffers.derivativeMatrices );
+    SetCurrentValues( coefficientSnapshot,
+                      fieldConfiguration,
+                      threadBuffers.valuesMatrix );
+    EigenvaluesWithDerivatives( threadBuffers,
+                                massesSquared,
+                                fieldDerivatives );
+  }
+
+  // This returns the EigenvalueBuffers for the current thread for matrices
+  // with numberOfRows rows. Each thread has its own set of buffers for each
+  // size of matrix, shared by all the matrices of that size, so that
+  // evaluations on different threads never share memory and evaluations on
+  // the same thread re-use memory which already has the right size.
+  template< typename ElementType > inline
+  typename MassesSquaredFromMatrix< ElementType >::EigenvalueBuffers&
+  MassesSquaredFromMatrix< ElementType >::ThreadBuffers() const
+  {
+    static thread_local std::vector< EigenvalueBuffers > buffersBySize;
+    if( buffersBySize.size() <= numberOfRows )
+    {
+      buffersBySize.resize( numberOfRows + 1 );
+    }
+    return buffersBySize[ numberOfRows ];
+  }
+
+  // This puts the eigenvalues of threadBuffers.valuesMatrix into
+  // massesSquared.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::EigenvaluesOnly(
+                                              EigenvalueBuffers& threadBuffers,
+                                   std::vector< double >& massesSquared ) const
+  {
+    threadBuffers.eigenvalueFinder.compute( threadBuffers.valuesMatrix,
+                                            Eigen::EigenvaluesOnly );
+    massesSquared.resize( numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
     {
-      massesSquared[ rowIndex ] = eigenvalueFinder.eigenvalues()( rowIndex );
+      massesSquared[ rowIndex ]
+      = threadBuffers.eigenvalueFinder.eigenvalues()( rowIndex );
     }
-    return massesSquared;
   }
 
-  // This returns the eigenvalues of the matrix, using the values for the
-  // Lagrangian parameters from the last call of UpdateForFixedScale and the
-  // values for the fields found in fieldConfiguration.
-  template< typename ElementType > inline std::vector< double >
-  MassesSquaredFromMatrix< ElementType >::MassesSquared(
-                        std::vector< double > const& fieldConfiguration ) const
+  // This puts the eigenvalues of threadBuffers.valuesMatrix into
+  // massesSquared and their derivatives with respect to the fields, from
+  // threadBuffers.derivativeMatrices, into fieldDerivatives. By the
+  // Hellmann-Feynman theorem, the derivative of each eigenvalue is the
+  // expectation value of the derivative of the matrix in the corresponding
+  // eigenvector. (For degenerate eigenvalues, the individual derivatives
+  // depend on the basis chosen for the degenerate subspace, but their sum
+  // does not, and since the loop corrections treat degenerate eigenvalues
+  // identically, only their sum matters.)
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::EigenvaluesWithDerivatives(
+                                              EigenvalueBuffers& threadBuffers,
+                                          std::vector< double >& massesSquared,
+               std::vector< std::vector< double > >& fieldDerivatives ) const
   {
-    Eigen::SelfAdjointEigenSolver< EigenMatrix >
-    eigenvalueFinder( CurrentValues( fieldConfiguration ),
-                      Eigen::EigenvaluesOnly );
-    std::vector< double > massesSquared( numberOfRows );
+    // The eigenvectors are only found through the public interface of
+    // SelfAdjointEigenSolver. SelfAdjointEigenSolver::compute re-uses the
+    // memory of eigenvalueFinder for matrices of the same size, but it does
+    // allocate a workspace of its own for building the eigenvectors on every
+    // call.
+    Eigen::SelfAdjointEigenSolver< EigenMatrix >&
+    eigenvalueFinder( threadBuffers.eigenvalueFinder );
+    eigenvalueFinder.compute( threadBuffers.valuesMatrix,
+                              Eigen::ComputeEigenvectors );
+    typename Eigen::SelfAdjointEigenSolver< EigenMatrix >::EigenvectorsType
+    const& eigenvectorMatrix( eigenvalueFinder.eigenvectors() );
+    massesSquared.resize( numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
     {
-      massesSquared[ rowIndex ] = eigenvalueFinder.eigenvalues()( rowIndex );
+      massesSquared[ rowIndex ]
+      = eigenvalueFinder.eigenvalues()( rowIndex );
+    }
+    std::vector< EigenMatrix > const&
+    derivativeMatrices( threadBuffers.derivativeMatrices );
+    fieldDerivatives.resize( derivativeMatrices.size() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < derivativeMatrices.size();
+         ++fieldIndex )
+    {
+      fieldDerivatives[ fieldIndex ].assign( numberOfRows,
+                                             0.0 );
+      if( derivativeMatrices[ fieldIndex ].size() == 0 )
+      {
+        // An empty matrix means that no element depends on this field.
+        continue;
+      }
+      threadBuffers.derivativeTimesEigenvectors.noalias()
+      = ( derivativeMatrices[ fieldIndex ].template selfadjointView<
+                                                             Eigen::Lower >()
+          * eigenvectorMatrix );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        fieldDerivatives[ fieldIndex ][ rowIndex ]
+        = std::real( eigenvectorMatrix.col( rowIndex ).dot(
+                 threadBuffers.derivativeTimesEigenvectors.col( rowIndex ) ) );
+      }
     }
-    return massesSquared;
   }
 
 } /* namespace VevaciousPlusPlus */
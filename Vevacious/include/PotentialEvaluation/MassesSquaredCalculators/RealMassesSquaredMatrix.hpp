@@ -30,9 +30,19 @@ namespace VevaciousPlusPlus
     virtual ~RealMassesSquaredMatrix();
 
 
-    // This calls UpdateForFixedScale on each element of matrixElements.
-    virtual void
-    UpdateForFixedScale( std::vector< double > const& parameterValues );
+    // This calls AssignCoefficientOffset on each element of matrixElements
+    // and of fieldDerivativeElements.
+    virtual void AssignCoefficientOffsets( size_t& nextOffset );
+
+    // This calls SetFixedScaleCoefficients on each element of matrixElements
+    // and of fieldDerivativeElements.
+    virtual void SetFixedScaleCoefficients(
+                           FixedScaleCoefficients& coefficientSnapshot ) const;
+
+    // This fills fieldDerivativeElements with the partial derivatives of
+    // matrixElements with respect to each of numberOfFields fields, and
+    // compiles the tapes of all the elements and their derivatives.
+    virtual void PrepareForEvaluation( size_t const numberOfFields );
 
     // This allows access to the polynomial sum for a given index.
     ParametersAndFieldsProductSum& ElementAt( size_t const elementIndex )
@@ -47,35 +57,150 @@ namespace VevaciousPlusPlus
 
   protected:
     std::vector< ParametersAndFieldsProductSum > matrixElements;
+    // fieldDerivativeElements[ fieldIndex ] is either the set of derivatives
+    // of matrixElements with respect to the field with index fieldIndex, or
+    // empty if none of the elements depend on that field.
+    std::vector< std::vector< ParametersAndFieldsProductSum > >
+    fieldDerivativeElements;
 
-    // This returns a matrix of the values of the elements for a field
+    // This fills valuesMatrix with the values of the elements for a field
     // configuration given by fieldConfiguration, using the values for the
     // Lagrangian parameters found in parameterValues.
-    virtual Eigen::MatrixXd
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const;
+    virtual void
+    SetCurrentValues( std::vector< double > const& parameterValues,
+                      std::vector< double > const& fieldConfiguration,
+                      Eigen::MatrixXd& valuesMatrix ) const;
 
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual Eigen::MatrixXd
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const;
+    // This fills valuesMatrix with the values of the elements for a field
+    // configuration given by fieldConfiguration, using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot.
+    virtual void
+    SetCurrentValues( FixedScaleCoefficients const& coefficientSnapshot,
+                      std::vector< double > const& fieldConfiguration,
+                      Eigen::MatrixXd& valuesMatrix ) const;
+
+    // This puts the matrices of the partial derivatives of the elements with
+    // respect to each field into derivativeMatrices, using the values for the
+    // Lagrangian parameters found in parameterValues. Fields on which no
+    // element depends get an empty matrix.
+    virtual void
+    FieldDerivativeValues( std::vector< double > const& parameterValues,
+                           std::vector< double > const& fieldConfiguration,
+                    std::vector< Eigen::MatrixXd >& derivativeMatrices ) const;
+
+    // This puts the matrices of the partial derivatives of the elements with
+    // respect to each field into derivativeMatrices, using the Lagrangian
+    // parameters at the fixed scale of coefficientSnapshot. Fields on which
+    // no element depends get an empty matrix.
+    virtual void
+    FieldDerivativeValues( FixedScaleCoefficients const& coefficientSnapshot,
+                           std::vector< double > const& fieldConfiguration,
+                    std::vector< Eigen::MatrixXd >& derivativeMatrices ) const;
   };
 
 
 
 
 
-  // This calls UpdateForFixedScale on each element of matrixElements.
-  inline void RealMassesSquaredMatrix::UpdateForFixedScale(
-                                 std::vector< double > const& parameterValues )
+  // This calls AssignCoefficientOffset on each element of matrixElements and
+  // of fieldDerivativeElements.
+  inline void
+  RealMassesSquaredMatrix::AssignCoefficientOffsets( size_t& nextOffset )
   {
     for( std::vector< ParametersAndFieldsProductSum >::iterator
          parametersAndFieldsProduct( matrixElements.begin() );
          parametersAndFieldsProduct < matrixElements.end();
          ++parametersAndFieldsProduct )
     {
-      parametersAndFieldsProduct->UpdateForFixedScale( parameterValues );
+      parametersAndFieldsProduct->AssignCoefficientOffset( nextOffset );
+    }
+    for( std::vector< std::vector< ParametersAndFieldsProductSum > >::iterator
+         derivativeElements( fieldDerivativeElements.begin() );
+         derivativeElements < fieldDerivativeElements.end();
+         ++derivativeElements )
+    {
+      for( std::vector< ParametersAndFieldsProductSum >::iterator
+           parametersAndFieldsProduct( derivativeElements->begin() );
+           parametersAndFieldsProduct < derivativeElements->end();
+           ++parametersAndFieldsProduct )
+      {
+        parametersAndFieldsProduct->AssignCoefficientOffset( nextOffset );
+      }
+    }
+  }
+
+  // This calls SetFixedScaleCoefficients on each element of matrixElements and
+  // of fieldDerivativeElements.
+  inline void RealMassesSquaredMatrix::SetFixedScaleCoefficients(
+                            FixedScaleCoefficients& coefficientSnapshot ) const
+  {
+    for( std::vector< ParametersAndFieldsProductSum >::const_iterator
+         parametersAndFieldsProduct( matrixElements.begin() );
+         parametersAndFieldsProduct < matrixElements.end();
+         ++parametersAndFieldsProduct )
+    {
+      parametersAndFieldsProduct->SetFixedScaleCoefficients(
+                                                         coefficientSnapshot );
+    }
+    for( std::vector< std::vector< ParametersAndFieldsProductSum > >
+         ::const_iterator derivativeElements( fieldDerivativeElements.begin() );
+         derivativeElements < fieldDerivativeElements.end();
+         ++derivativeElements )
+    {
+      for( std::vector< ParametersAndFieldsProductSum >::const_iterator
+           parametersAndFieldsProduct( derivativeElements->begin() );
+           parametersAndFieldsProduct < derivativeElements->end();
+           ++parametersAndFieldsProduct )
+      {
+        parametersAndFieldsProduct->SetFixedScaleCoefficients(
+                                                         coefficientSnapshot );
+      }
+    }
+  }
+
+  // This fills fieldDerivativeElements with the partial derivatives of
+  // matrixElements with respect to each of numberOfFields fields, and
+  // compiles the tapes of all the elements and their derivatives.
+  inline void RealMassesSquaredMatrix::PrepareForEvaluation(
+                                                 size_t const numberOfFields )
+  {
+    fieldDerivativeElements.assign( numberOfFields,
+                              std::vector< ParametersAndFieldsProductSum >() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      bool dependsOnField( false );
+      for( std::vector< ParametersAndFieldsProductSum >::const_iterator
+           matrixElement( matrixElements.begin() );
+           matrixElement < matrixElements.end();
+           ++matrixElement )
+      {
+        if( matrixElement->NonZeroDerivative( fieldIndex ) )
+        {
+          dependsOnField = true;
+          break;
+        }
+      }
+      if( dependsOnField )
+      {
+        for( std::vector< ParametersAndFieldsProductSum >::const_iterator
+             matrixElement( matrixElements.begin() );
+             matrixElement < matrixElements.end();
+             ++matrixElement )
+        {
+          fieldDerivativeElements[ fieldIndex ].push_back(
+                              matrixElement->PartialDerivative( fieldIndex ) );
+          fieldDerivativeElements[ fieldIndex ].back().CompileTape();
+        }
+      }
+    }
+    for( std::vector< ParametersAndFieldsProductSum >::iterator
+         matrixElement( matrixElements.begin() );
+         matrixElement < matrixElements.end();
+         ++matrixElement )
+    {
+      matrixElement->CompileTape();
     }
   }
 
@@ -29,41 +29,131 @@ namespace VevaciousPlusPlus
 
 
   protected:
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const
-    { return LowerTriangleOfSquareMatrix( MatrixToSquare( parameterValues,
-                                                      fieldConfiguration ) ); }
-
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const
-    { return
-      LowerTriangleOfSquareMatrix( MatrixToSquare( fieldConfiguration ) ); }
-
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    Eigen::MatrixXcd
-    MatrixToSquare( std::vector< double > const& parameterValues,
-                    std::vector< double > const& fieldConfiguration ) const;
-
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    Eigen::MatrixXcd
-    MatrixToSquare( std::vector< double > const& fieldConfiguration ) const;
-
-    // This returns a matrix that is the lower-triangular part (only column
-    // index <= row index) of the square of matrixToSquare.
-    Eigen::MatrixXcd LowerTriangleOfSquareMatrix(
-                                Eigen::MatrixXcd const& matrixToSquare ) const;
+    // This fills valuesMatrix with the lower triangle of the square of the
+    // mass matrix for a field configuration given by fieldConfiguration,
+    // using the values for the Lagrangian parameters found in
+    // parameterValues. The mass matrix itself is put into the working matrix
+    // of the buffers for the current thread.
+    virtual void
+    SetCurrentValues( std::vector< double > const& parameterValues,
+                      std::vector< double > const& fieldConfiguration,
+                      Eigen::MatrixXcd& valuesMatrix ) const;
+
+    // This fills valuesMatrix with the lower triangle of the square of the
+    // mass matrix for a field configuration given by fieldConfiguration,
+    // using the Lagrangian parameters at the fixed scale of
+    // coefficientSnapshot. The mass matrix itself is put into the working
+    // matrix of the buffers for the current thread.
+    virtual void
+    SetCurrentValues( FixedScaleCoefficients const& coefficientSnapshot,
+                      std::vector< double > const& fieldConfiguration,
+                      Eigen::MatrixXcd& valuesMatrix ) const;
+
+    // This fills valuesMatrix with the values of the elements of the mass
+    // matrix (which is then squared) for a field configuration given by
+    // fieldConfiguration, using the values for the Lagrangian parameters
+    // found in parameterValues.
+    void SetMatrixToSquare( std::vector< double > const& parameterValues,
+                            std::vector< double > const& fieldConfiguration,
+                            Eigen::MatrixXcd& valuesMatrix ) const;
+
+    // This fills valuesMatrix with the values of the elements of the mass
+    // matrix (which is then squared) for a field configuration given by
+    // fieldConfiguration, using the Lagrangian parameters at the fixed scale
+    // of coefficientSnapshot.
+    void SetMatrixToSquare( FixedScaleCoefficients const& coefficientSnapshot,
+                            std::vector< double > const& fieldConfiguration,
+                            Eigen::MatrixXcd& valuesMatrix ) const;
+
+    // This fills the lower-triangular part (only column index <= row index)
+    // of valuesSquaredMatrix with the square of matrixToSquare.
+    void SetLowerTriangleOfSquare( Eigen::MatrixXcd const& matrixToSquare,
+                               Eigen::MatrixXcd& valuesSquaredMatrix ) const;
+
+    // This puts the matrices of the partial derivatives of the square of the
+    // mass matrix with respect to each field into derivativeMatrices, using
+    // the values for the Lagrangian parameters found in parameterValues.
+    // Fields on which no element depends get an empty matrix.
+    virtual void
+    FieldDerivativeValues( std::vector< double > const& parameterValues,
+                           std::vector< double > const& fieldConfiguration,
+               std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const;
+
+    // This puts the matrices of the partial derivatives of the square of the
+    // mass matrix with respect to each field into derivativeMatrices, using
+    // the Lagrangian parameters at the fixed scale of coefficientSnapshot.
+    // Fields on which no element depends get an empty matrix.
+    virtual void
+    FieldDerivativeValues( FixedScaleCoefficients const& coefficientSnapshot,
+                           std::vector< double > const& fieldConfiguration,
+               std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const;
+
+    // This puts the matrices of the partial derivatives of the mass matrix
+    // (rather than its square) with respect to each field into
+    // derivativeMatrices, using the values for the Lagrangian parameters found
+    // in parameterValues. Fields on which no element depends get an empty
+    // matrix.
+    void DerivativesOfMatrixToSquare(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+               std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const;
+
+    // This puts the matrices of the partial derivatives of the mass matrix
+    // (rather than its square) with respect to each field into
+    // derivativeMatrices, using the Lagrangian parameters at the fixed scale
+    // of coefficientSnapshot. Fields on which no element depends get an
+    // empty matrix.
+    void DerivativesOfMatrixToSquare(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+               std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const;
+
+    // This replaces each non-empty derivative dM in derivativeMatrices with
+    // the corresponding derivative of the square of matrixToSquare, which is
+    // dM^dagger M + M^dagger dM for M being matrixToSquare.
+    void DerivativesOfSquare( Eigen::MatrixXcd const& matrixToSquare,
+               std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const;
   };
 
+
+
+
+
+  // This fills valuesMatrix with the lower triangle of the square of the mass
+  // matrix for a field configuration given by fieldConfiguration, using the
+  // values for the Lagrangian parameters found in parameterValues. The mass
+  // matrix itself is put into the working matrix of the buffers for the
+  // current thread.
+  inline void SymmetricComplexMassMatrix::SetCurrentValues(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                         Eigen::MatrixXcd& valuesMatrix ) const
+  {
+    Eigen::MatrixXcd& matrixToSquare( ThreadBuffers().workingMatrix );
+    SetMatrixToSquare( parameterValues,
+                       fieldConfiguration,
+                       matrixToSquare );
+    SetLowerTriangleOfSquare( matrixToSquare,
+                              valuesMatrix );
+  }
+
+  // This fills valuesMatrix with the lower triangle of the square of the mass
+  // matrix for a field configuration given by fieldConfiguration, using the
+  // Lagrangian parameters at the fixed scale of coefficientSnapshot. The mass
+  // matrix itself is put into the working matrix of the buffers for the
+  // current thread.
+  inline void SymmetricComplexMassMatrix::SetCurrentValues(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                         Eigen::MatrixXcd& valuesMatrix ) const
+  {
+    Eigen::MatrixXcd& matrixToSquare( ThreadBuffers().workingMatrix );
+    SetMatrixToSquare( coefficientSnapshot,
+                       fieldConfiguration,
+                       matrixToSquare );
+    SetLowerTriangleOfSquare( matrixToSquare,
+                              valuesMatrix );
+  }
+
 } /* namespace VevaciousPlusPlus */
 #endif /* COMPLEXMASSMATRIX_HPP_ */
@@ -18,7 +18,17 @@
 
 namespace VevaciousPlusPlus
 {
-
+  // Evaluating the potential through the const member functions operator()
+  // and SetAsGradientAt( ... ) must be reentrant, as minimizations from
+  // different starting points may evaluate the same PotentialFunction from
+  // several threads at once. Everything which can change from one call to the
+  // next (the field configuration and the temperature) is passed in as an
+  // argument and any scratch space has to be local to the call or to the
+  // calling thread. The coefficients for a parameter point may only be
+  // changed by non-const member functions (such as those responding to a new
+  // parameter point from the LagrangianParameterManager), which must not be
+  // called while any evaluation is in progress, so that each parameter point
+  // is an immutable snapshot as far as the evaluations are concerned.
   class PotentialFunction
   {
   public:
@@ -37,6 +47,16 @@ namespace VevaciousPlusPlus
       dsbFieldInputStrings( copySource.dsbFieldInputStrings ),
       dsbFieldValueInputs( copySource.dsbFieldValueInputs ) {}
 
+    // This copies copySource but binds the copy to lagrangianParameterManager,
+    // which should have been set up in the same way as that of copySource.
+    PotentialFunction( PotentialFunction const& copySource,
+                     LagrangianParameterManager& lagrangianParameterManager ) :
+      lagrangianParameterManager( lagrangianParameterManager ),
+      fieldNames( copySource.fieldNames ),
+      numberOfFields( copySource.numberOfFields ),
+      dsbFieldInputStrings( copySource.dsbFieldInputStrings ),
+      dsbFieldValueInputs( copySource.dsbFieldValueInputs ) {}
+
     virtual ~PotentialFunction() {}
 
 
@@ -60,6 +80,20 @@ namespace VevaciousPlusPlus
     virtual double operator()( std::vector< double > const& fieldConfiguration,
                                double const temperatureValue = 0.0 ) const = 0;
 
+    // This puts the values of the potential at temperatureValue for each of
+    // the field configurations in fieldConfigurations into potentialValues.
+    // The configurations are packed one after another into
+    // fieldConfigurations, so the value of the field with index fieldIndex
+    // in the configuration with index configurationIndex is
+    // fieldConfigurations[ ( configurationIndex * NumberOfFieldVariables() )
+    // + fieldIndex ]. This default just calls operator() for each
+    // configuration in turn, but derived classes can over-write it to share
+    // work between the configurations.
+    virtual void
+    EvaluateBatch( std::vector< double > const& fieldConfigurations,
+                   double const temperatureValue,
+                   std::vector< double >& potentialValues ) const;
+
     // If overridden, this should write the potential as
     // def PotentialFunction( fv ): return ...
     // in pythonFilename for fv being an array of floating-point numbers in the
@@ -73,13 +107,19 @@ namespace VevaciousPlusPlus
     { throw std::runtime_error(
             "PotentialFunction::WriteAsPython(..) needs to be overridden." ); }
 
-    // This numerically evaluates the gradient at fieldConfiguration based on
-    // steps of numericalStepSize GeV in each field direction and places the
-    // gradient in gradientVector. Derived classes which can analytically
-    // evaluate the gradient can over-write this function.
+    // This numerically evaluates the gradient at fieldConfiguration and
+    // temperature temperatureValue based on steps of numericalStepSize GeV in
+    // each field direction and places the gradient in gradientVector. Derived
+    // classes which can analytically evaluate the gradient can over-write this
+    // function.
     virtual void SetAsGradientAt( std::vector< double >& gradientVector,
                                std::vector< double > const& fieldConfiguration,
-                                  double const numericalStepSize = 1.0 ) const;
+                                  double const numericalStepSize = 1.0,
+                                  double const temperatureValue = 0.0 ) const;
+
+    // This returns true if SetAsGradientAt( ... ) is evaluated analytically,
+    // so that minimizers can use it instead of their own finite differences.
+    virtual bool HasAnalyticGradient() const { return false; }
 
     // This should return the square of the scale (in GeV^2) relevant to
     // tunneling between the given minima for this potential.
@@ -137,28 +177,79 @@ namespace VevaciousPlusPlus
     return stringBuilder.str();
   }
 
-  // This numerically evaluates the gradient at fieldConfiguration based on
-  // steps of numericalStepSize GeV in each field direction, places the
-  // the gradient in gradientVector, and returns the potential evaluated at
-  // fieldConfiguration. Derived classes which can analytically evaluate the
-  // gradient can over-write this function, as well as SetAsGradientAt( ... ).
+  // This puts the values of the potential at temperatureValue for each of the
+  // field configurations in fieldConfigurations into potentialValues. The
+  // configurations are packed one after another into fieldConfigurations, so
+  // the value of the field with index fieldIndex in the configuration with
+  // index configurationIndex is
+  // fieldConfigurations[ ( configurationIndex * NumberOfFieldVariables() )
+  // + fieldIndex ]. This default just calls operator() for each configuration
+  // in turn, but derived classes can over-write it to share work between the
+  // configurations.
+  inline void PotentialFunction::EvaluateBatch(
+                              std::vector< double > const& fieldConfigurations,
+                                                 double const temperatureValue,
+                                std::vector< double >& potentialValues ) const
+  {
+    size_t const numberOfConfigurations( ( numberOfFields > 0 ) ?
+                              ( fieldConfigurations.size() / numberOfFields ) :
+                                         0 );
+    potentialValues.resize( numberOfConfigurations );
+    std::vector< double > fieldConfiguration( numberOfFields );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < numberOfConfigurations;
+         ++configurationIndex )
+    {
+      std::vector< double >::const_iterator const configurationStart(
+                                                   fieldConfigurations.begin()
+                                   + ( configurationIndex * numberOfFields ) );
+      fieldConfiguration.assign( configurationStart,
+                                 configurationStart + numberOfFields );
+      potentialValues[ configurationIndex ] = (*this)( fieldConfiguration,
+                                                       temperatureValue );
+    }
+  }
+
+  // This numerically evaluates the gradient at fieldConfiguration and
+  // temperature temperatureValue based on steps of numericalStepSize GeV in
+  // each field direction and places the gradient in gradientVector. Derived
+  // classes which can analytically evaluate the gradient can over-write this
+  // function. The undisplaced configuration and the numberOfFields displaced
+  // configurations are evaluated together as a single batch.
   inline void
   PotentialFunction::SetAsGradientAt( std::vector< double >& gradientVector,
                                std::vector< double > const& fieldConfiguration,
-                                         double const numericalStepSize ) const
+                                          double const numericalStepSize,
+                                          double const temperatureValue ) const
   {
     gradientVector.resize( numberOfFields );
-    double const potentialValue( (*this)( fieldConfiguration ) );
-    std::vector< double > displacementVector( fieldConfiguration );
+    std::vector< double > displacedConfigurations;
+    displacedConfigurations.reserve( ( numberOfFields + 1 ) * numberOfFields );
+    for( size_t configurationIndex( 0 );
+         configurationIndex <= numberOfFields;
+         ++configurationIndex )
+    {
+      displacedConfigurations.insert( displacedConfigurations.end(),
+                                      fieldConfiguration.begin(),
+                                      fieldConfiguration.end() );
+      if( configurationIndex > 0 )
+      {
+        displacedConfigurations[ ( configurationIndex * numberOfFields )
+                                 + configurationIndex - 1 ]
+        += numericalStepSize;
+      }
+    }
+    std::vector< double > potentialValues;
+    EvaluateBatch( displacedConfigurations,
+                   temperatureValue,
+                   potentialValues );
     for( size_t fieldIndex( 0 );
          fieldIndex < numberOfFields;
          ++fieldIndex )
     {
-      displacementVector[ fieldIndex ] += numericalStepSize;
       gradientVector[ fieldIndex ]
-      = ( ( (*this)( displacementVector ) - potentialValue )
+      = ( ( potentialValues[ fieldIndex + 1 ] - potentialValues[ 0 ] )
           / numericalStepSize );
-      displacementVector[ fieldIndex ] -= numericalStepSize;
     }
   }
 
@@ -20,10 +20,21 @@
 #include "PotentialEvaluation/MassesSquaredCalculators/ComplexMassSquaredMatrix.hpp"
 #include <sstream>
 #include <iomanip>
+#include "Utilities/PerformanceLogger.hpp"
+#include "PotentialEvaluation/BuildingBlocks/FixedScaleCoefficients.hpp"
+#include <memory>
 
 namespace VevaciousPlusPlus
 {
 
+  // This class evaluates the one-loop potential with all the Lagrangian
+  // parameters at a single renormalization scale. The parameters at that
+  // scale and the coefficients of all the tapes are held in an immutable
+  // FixedScaleCoefficients which is replaced by a new one for each parameter
+  // point rather than being updated in place, so an evaluation given a
+  // snapshot always sees the coefficients of a single point. Snapshots are
+  // only replaced between parameter points by RespondToObservedSignal, which
+  // must not run while this potential is being evaluated by other threads.
   class FixedScaleOneLoopPotential : public PotentialFromPolynomialWithMasses,
                                      public LHPC::BasicObserver
   {
@@ -33,6 +44,13 @@ namespace VevaciousPlusPlus
                       LagrangianParameterManager& lagrangianParameterManager );
     FixedScaleOneLoopPotential(
                     PotentialFromPolynomialWithMasses const& potentialToCopy );
+
+    // This copies potentialToCopy without reading its model file again, but
+    // binds the copy to lagrangianParameterManager, which must have been set
+    // up in the same way as the manager of potentialToCopy.
+    FixedScaleOneLoopPotential(
+                      PotentialFromPolynomialWithMasses const& potentialToCopy,
+                      LagrangianParameterManager& lagrangianParameterManager );
     virtual ~FixedScaleOneLoopPotential();
 
 
@@ -44,16 +62,64 @@ namespace VevaciousPlusPlus
     operator()( std::vector< double > const& fieldConfiguration,
                 double const temperatureValue = 0.0 ) const;
 
+    // This returns the energy density in GeV^4 of the potential for the
+    // fields given by fieldConfiguration and temperature in GeV given by
+    // temperatureValue, with the Lagrangian parameters of
+    // coefficientSnapshot rather than of the current parameter point.
+    double operator()( FixedScaleCoefficients const& coefficientSnapshot,
+                       std::vector< double > const& fieldConfiguration,
+                       double const temperatureValue = 0.0 ) const;
+
+    // This puts the values of the potential at temperatureValue for each of
+    // the field configurations packed into fieldConfigurations into
+    // potentialValues. The polynomial parts are evaluated term by term for
+    // the whole batch at once, and then the mass-squared matrices are
+    // diagonalized for each configuration in turn.
+    virtual void
+    EvaluateBatch( std::vector< double > const& fieldConfigurations,
+                   double const temperatureValue,
+                   std::vector< double >& potentialValues ) const;
+
+    // This evaluates the gradient of the potential with respect to the fields
+    // analytically at fieldConfiguration and temperature temperatureValue and
+    // places it in gradientVector. The polynomial parts are differentiated
+    // term by term and the derivatives of the masses-squared come from the
+    // eigenvectors of the mass-squared matrices, so numericalStepSize is not
+    // used.
+    virtual void SetAsGradientAt( std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                  double const numericalStepSize = 1.0,
+                                  double const temperatureValue = 0.0 ) const;
+
+    // This evaluates the gradient of the potential analytically at
+    // fieldConfiguration and temperature temperatureValue with the Lagrangian
+    // parameters of coefficientSnapshot and places it in gradientVector.
+    void SetAsGradientAt( FixedScaleCoefficients const& coefficientSnapshot,
+                          std::vector< double >& gradientVector,
+                          std::vector< double > const& fieldConfiguration,
+                          double const temperatureValue = 0.0 ) const;
+
+    // This returns true as SetAsGradientAt( ... ) is evaluated analytically.
+    virtual bool HasAnalyticGradient() const { return true; }
+
     // This returns the square of the current renormalization scale.
     virtual double
     ScaleSquaredRelevantToTunneling( PotentialMinimum const& falseVacuum,
                                      PotentialMinimum const& trueVacuum ) const
-    { return ( renormalizationScale * renormalizationScale ); }
+    { return ( fixedScaleCoefficients->RenormalizationScale()
+               * fixedScaleCoefficients->RenormalizationScale() ); }
+
+    // This returns the snapshot of the Lagrangian parameters and term
+    // coefficients for the current parameter point. It stays valid and
+    // unchanged for as long as it is held, even after the next parameter
+    // point has replaced it as the current snapshot.
+    std::shared_ptr< FixedScaleCoefficients const > CoefficientSnapshot() const
+    { return fixedScaleCoefficients; }
 
-    // This updates the scale used for the loop corrections based on the
-    // appropriate scale from lagrangianParameterManager, and updates all
-    // components used to evaluate the potential to use the Lagrangian
-    // parameters evaluated at that scale.
+    // This fills a new snapshot of the Lagrangian parameters and term
+    // coefficients at the appropriate scale from lagrangianParameterManager
+    // and makes it the current snapshot. Snapshots which were taken before
+    // are left unchanged.
     virtual void RespondToObservedSignal();
 
     // This returns a string that is valid Python with no indentation to
@@ -69,8 +135,42 @@ namespace VevaciousPlusPlus
 
 
   protected:
-    double renormalizationScale;
-    double inverseRenormalizationScaleSquared;
+    // This holds everything which a single evaluation reads or writes apart
+    // from the immutable structure of the potential: the coefficient snapshot
+    // which it was given, the temperature, and the buffers of the calling
+    // thread. Each evaluation builds its own, so nothing in it is shared with
+    // evaluations on other threads except the read-only snapshot.
+    struct EvaluationContext
+    {
+      EvaluationContext( FixedScaleCoefficients const& coefficientSnapshot,
+                         double const temperatureValue,
+                         EvaluationWorkspace& threadWorkspace ) :
+        coefficientSnapshot( coefficientSnapshot ),
+        temperatureValue( temperatureValue ),
+        threadWorkspace( threadWorkspace ) {}
+
+      FixedScaleCoefficients const& coefficientSnapshot;
+      double const temperatureValue;
+      EvaluationWorkspace& threadWorkspace;
+    };
+
+    // This is the snapshot for the current parameter point. Evaluations take
+    // a reference to the object rather than a copy of the pointer, so that
+    // they do not contend for its reference count.
+    std::shared_ptr< FixedScaleCoefficients const > fixedScaleCoefficients;
+
+
+    // This puts the masses-squared with their multiplicities into the
+    // workspace of evaluationContext and returns the potential.
+    double PotentialInContext( EvaluationContext const& evaluationContext,
+                 std::vector< double > const& fieldConfiguration ) const;
+
+    // This puts the gradient of the potential into gradientVector, using the
+    // workspace of evaluationContext for the masses-squared and their
+    // derivatives.
+    void GradientInContext( EvaluationContext const& evaluationContext,
+                            std::vector< double >& gradientVector,
+                     std::vector< double > const& fieldConfiguration ) const;
   };
 
 
@@ -85,25 +185,142 @@ namespace VevaciousPlusPlus
                                std::vector< double > const& fieldConfiguration,
                                           double const temperatureValue ) const
   {
-    std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
+    return (*this)( *fixedScaleCoefficients,
+                    fieldConfiguration,
+                    temperatureValue );
+  }
+
+  // This returns the energy density in GeV^4 of the potential for the fields
+  // given by fieldConfiguration and temperature in GeV given by
+  // temperatureValue, with the Lagrangian parameters of coefficientSnapshot
+  // rather than of the current parameter point.
+  inline double FixedScaleOneLoopPotential::operator()(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                          double const temperatureValue ) const
+  {
+    PerformanceLogger::IncrementCounter(
+                                     PerformanceRecord::PotentialEvaluations );
+    return PotentialInContext( EvaluationContext( coefficientSnapshot,
+                                                  temperatureValue,
+                                                  ThreadWorkspace() ),
+                               fieldConfiguration );
+  }
+
+  // This evaluates the gradient of the potential with respect to the fields
+  // analytically at fieldConfiguration and temperature temperatureValue and
+  // places it in gradientVector. The polynomial parts are differentiated term
+  // by term and the derivatives of the masses-squared come from the
+  // eigenvectors of the mass-squared matrices, so numericalStepSize is not
+  // used.
+  inline void FixedScaleOneLoopPotential::SetAsGradientAt(
+                                         std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                                double const numericalStepSize,
+                                          double const temperatureValue ) const
+  {
+    SetAsGradientAt( *fixedScaleCoefficients,
+                     gradientVector,
+                     fieldConfiguration,
+                     temperatureValue );
+  }
+
+  // This evaluates the gradient of the potential analytically at
+  // fieldConfiguration and temperature temperatureValue with the Lagrangian
+  // parameters of coefficientSnapshot and places it in gradientVector.
+  inline void FixedScaleOneLoopPotential::SetAsGradientAt(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                                         std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                          double const temperatureValue ) const
+  {
+    PerformanceLogger::IncrementCounter(
+                                      PerformanceRecord::GradientEvaluations );
+    GradientInContext( EvaluationContext( coefficientSnapshot,
+                                          temperatureValue,
+                                          ThreadWorkspace() ),
+                       gradientVector,
+                       fieldConfiguration );
+  }
+
+  // This puts the masses-squared with their multiplicities into the workspace
+  // of evaluationContext and returns the potential.
+  inline double FixedScaleOneLoopPotential::PotentialInContext(
+                                  EvaluationContext const& evaluationContext,
+                         std::vector< double > const& fieldConfiguration ) const
+  {
+    FixedScaleCoefficients const&
+    coefficientSnapshot( evaluationContext.coefficientSnapshot );
+    EvaluationWorkspace& threadWorkspace( evaluationContext.threadWorkspace );
+    SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                      fieldConfiguration,
                                       scalarSquareMasses,
-                                      scalarMassesSquaredWithFactors );
-    std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
+                              threadWorkspace.scalarMassesSquaredWithFactors );
+    SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                      fieldConfiguration,
                                       fermionSquareMasses,
-                                      fermionMassesSquaredWithFactors );
-    std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
+                             threadWorkspace.fermionMassesSquaredWithFactors );
+    SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                      fieldConfiguration,
                                       vectorSquareMasses,
-                                      vectorMassesSquaredWithFactors );
-    return ( treeLevelPotential( fieldConfiguration )
-             + polynomialLoopCorrections( fieldConfiguration )
-             + LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
-                                          fermionMassesSquaredWithFactors,
-                                          vectorMassesSquaredWithFactors,
-                                          inverseRenormalizationScaleSquared,
-                                          temperatureValue ) );
+                              threadWorkspace.vectorMassesSquaredWithFactors );
+    return ( treeLevelPotential( coefficientSnapshot,
+                                 fieldConfiguration )
+             + polynomialLoopCorrections( coefficientSnapshot,
+                                          fieldConfiguration )
+             + LoopAndThermalCorrections(
+                                threadWorkspace.scalarMassesSquaredWithFactors,
+                               threadWorkspace.fermionMassesSquaredWithFactors,
+                                threadWorkspace.vectorMassesSquaredWithFactors,
+                                     coefficientSnapshot.InverseScaleSquared(),
+                                        evaluationContext.temperatureValue ) );
+  }
+
+  // This puts the gradient of the potential into gradientVector, using the
+  // workspace of evaluationContext for the masses-squared and their
+  // derivatives.
+  inline void FixedScaleOneLoopPotential::GradientInContext(
+                                  EvaluationContext const& evaluationContext,
+                                         std::vector< double >& gradientVector,
+                         std::vector< double > const& fieldConfiguration ) const
+  {
+    FixedScaleCoefficients const&
+    coefficientSnapshot( evaluationContext.coefficientSnapshot );
+    EvaluationWorkspace& threadWorkspace( evaluationContext.threadWorkspace );
+    gradientVector.resize( numberOfFields );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      gradientVector[ fieldIndex ]
+      = polynomialGradient[ fieldIndex ]( coefficientSnapshot,
+                                          fieldConfiguration );
+    }
+    SetMassesSquaredWithFieldDerivatives( coefficientSnapshot,
+                                          fieldConfiguration,
+                                          scalarSquareMasses,
+                                threadWorkspace.scalarMassesSquaredWithFactors,
+                              threadWorkspace.scalarMassesSquaredDerivatives );
+    SetMassesSquaredWithFieldDerivatives( coefficientSnapshot,
+                                          fieldConfiguration,
+                                          fermionSquareMasses,
+                               threadWorkspace.fermionMassesSquaredWithFactors,
+                             threadWorkspace.fermionMassesSquaredDerivatives );
+    SetMassesSquaredWithFieldDerivatives( coefficientSnapshot,
+                                          fieldConfiguration,
+                                          vectorSquareMasses,
+                                threadWorkspace.vectorMassesSquaredWithFactors,
+                              threadWorkspace.vectorMassesSquaredDerivatives );
+    AddLoopAndThermalCorrectionsGradient(
+                                threadWorkspace.scalarMassesSquaredWithFactors,
+                                threadWorkspace.scalarMassesSquaredDerivatives,
+                               threadWorkspace.fermionMassesSquaredWithFactors,
+                               threadWorkspace.fermionMassesSquaredDerivatives,
+                                threadWorkspace.vectorMassesSquaredWithFactors,
+                                threadWorkspace.vectorMassesSquaredDerivatives,
+                                     coefficientSnapshot.InverseScaleSquared(),
+                                          evaluationContext.temperatureValue,
+                                          gradientVector );
   }
 
 } /* namespace VevaciousPlusPlus */
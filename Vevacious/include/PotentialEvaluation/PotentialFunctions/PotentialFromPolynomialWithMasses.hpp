@@ -30,6 +30,12 @@
 #include "VersionInformation.hpp"
 #include "PotentialEvaluation/ThermalFunctions.hpp"
 #include <iomanip>
+#include <map>
+#include <set>
+#include <cstdint>
+#include <typeinfo>
+#include "Utilities/MappedFileReader.hpp"
+#include "Utilities/BinaryFileWriter.hpp"
 
 namespace VevaciousPlusPlus
 {
@@ -65,9 +71,33 @@ namespace VevaciousPlusPlus
 
   protected:
     typedef std::pair< std::vector< double >, double > DoubleVectorWithDouble;
+    // This is for the derivatives of a set of masses-squared with respect to
+    // the fields, ordered as [ fieldIndex ][ massIndex ].
+    typedef std::vector< std::vector< double > > MassesSquaredDerivatives;
+
+    // This holds the vectors which are filled during an evaluation of the
+    // potential, so that each thread can re-use the memory allocated for them
+    // during its earlier evaluations instead of allocating afresh for every
+    // evaluation. The masses-squared derivatives are only used by
+    // evaluations of the gradient, and the last three vectors are only used by
+    // evaluations of batches of field configurations.
+    struct EvaluationWorkspace
+    {
+      std::vector< double > parameterValues;
+      std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors;
+      std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors;
+      std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors;
+      std::vector< MassesSquaredDerivatives > scalarMassesSquaredDerivatives;
+      std::vector< MassesSquaredDerivatives > fermionMassesSquaredDerivatives;
+      std::vector< MassesSquaredDerivatives > vectorMassesSquaredDerivatives;
+      std::vector< double > fieldConfiguration;
+      std::vector< double > batchFieldValues;
+      std::vector< double > batchTermProducts;
+    };
     typedef
     std::pair< ParametersAndFieldsProductSum, ParametersAndFieldsProductSum >
     ComplexParametersAndFieldsProductSum;
+    typedef std::map< std::string, std::string > AttributeMap;
     static std::string const digitChars;
     static std::string const dotAndDigits;
     static std::string const allowedVariableInitials;
@@ -77,6 +107,14 @@ namespace VevaciousPlusPlus
     static double const thermalFactor;
     static std::string const positiveByConvention;
     static std::string const negativeByConvention;
+    // This is appended to the name of the model file to give the name of the
+    // binary cache of the parsed model.
+    static std::string const modelCacheSuffix;
+    // This starts every binary cache of a parsed model. modelCacheVersion
+    // must be increased whenever the layout of the cache changes, so that
+    // caches in the old layout are ignored.
+    static std::string const modelCacheIdentifier;
+    static std::uint32_t const modelCacheVersion;
 
 
     // This splits trimmedXmlContent by newline characters and puts the lines
@@ -103,6 +141,24 @@ namespace VevaciousPlusPlus
     std::vector< size_t > fieldsAssumedNegative;
     double const assumedPositiveOrNegativeTolerance;
     bool readImaginaryPartForRealValue;
+    // polynomialGradient[ fieldIndex ] is the partial derivative of the sum of
+    // treeLevelPotential and polynomialLoopCorrections with respect to the
+    // field with index fieldIndex.
+    std::vector< ParametersAndFieldsProductSum > polynomialGradient;
+    // This is the number of coefficients which a FixedScaleCoefficients needs
+    // to hold for all the tapes of the polynomials and mass matrices, each of
+    // which has been given the offset of its block of coefficients by
+    // PrepareForEvaluation.
+    size_t numberOfFixedScaleCoefficients;
+    // These record the names given to RegisterParameter of
+    // lagrangianParameterManager while parsing the model file, in the order
+    // of their first registration, along with the validity and index which
+    // each was given, so that the registrations can be repeated in the same
+    // order when the parsed model is read from its binary cache or copied for
+    // another Lagrangian parameter manager.
+    std::vector< std::string > parameterRegistrationOrder;
+    std::vector< std::pair< bool, size_t > > parameterRegistrationResults;
+    std::set< std::string > registeredParameterNames;
 
 
     // This is just for derived classes.
@@ -113,16 +169,138 @@ namespace VevaciousPlusPlus
     PotentialFromPolynomialWithMasses(
                          PotentialFromPolynomialWithMasses const& copySource );
 
+    // This is just for derived classes. It copies copySource but binds the
+    // copy to lagrangianParameterManager, which must have been set up in the
+    // same way as that of copySource, registering the Lagrangian parameters
+    // of copySource with it in the same order, and throwing an exception if
+    // they are not given the same indices. The model file is not read again.
+    PotentialFromPolynomialWithMasses(
+                           PotentialFromPolynomialWithMasses const& copySource,
+                      LagrangianParameterManager& lagrangianParameterManager );
+
+    // This returns the EvaluationWorkspace belonging to the calling thread.
+    // It is shared by all the potentials evaluated on that thread, so it
+    // should only be used within a single evaluation which does not itself
+    // evaluate another potential.
+    static EvaluationWorkspace& ThreadWorkspace();
+
     // This evaluates the one-loop potential with thermal corrections assuming
     // that the squared masses were evaluated at the given scale correctly.
     double
     LoopAndThermalCorrections(
-          std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors,
-         std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors,
-          std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors,
+   std::vector< DoubleVectorWithDouble > const& scalarMassesSquaredWithFactors,
+  std::vector< DoubleVectorWithDouble > const& fermionMassesSquaredWithFactors,
+   std::vector< DoubleVectorWithDouble > const& vectorMassesSquaredWithFactors,
                                               double const inverseScaleSquared,
                                          double const temperatureValue ) const;
 
+    // This adds the partial derivatives of the one-loop potential with
+    // thermal corrections with respect to the fields to gradientVector,
+    // assuming that the squared masses and their derivatives were evaluated
+    // at the given scale correctly.
+    void AddLoopAndThermalCorrectionsGradient(
+   std::vector< DoubleVectorWithDouble > const& scalarMassesSquaredWithFactors,
+ std::vector< MassesSquaredDerivatives > const& scalarMassesSquaredDerivatives,
+  std::vector< DoubleVectorWithDouble > const& fermionMassesSquaredWithFactors,
+std::vector< MassesSquaredDerivatives > const& fermionMassesSquaredDerivatives,
+   std::vector< DoubleVectorWithDouble > const& vectorMassesSquaredWithFactors,
+ std::vector< MassesSquaredDerivatives > const& vectorMassesSquaredDerivatives,
+                                              double const inverseScaleSquared,
+                                                double const temperatureValue,
+                                 std::vector< double >& gradientVector ) const;
+
+    // This compiles the tapes of the polynomial sums, sets up
+    // polynomialGradient, and prepares each of the mass-squared matrices for
+    // evaluation, including derivatives with respect to the fields, and then
+    // assigns each tape the offset of its block of coefficients in a
+    // FixedScaleCoefficients. It should be called once the polynomials and
+    // matrices have all been read in.
+    void PrepareForEvaluation();
+
+    // This fills the coefficients of all the tapes of the polynomials and
+    // mass matrices in coefficientSnapshot, which should already hold the
+    // values of the Lagrangian parameters at its scale.
+    void
+    SetFixedScaleCoefficients(
+                           FixedScaleCoefficients& coefficientSnapshot ) const;
+
+    // This parses the model file as XML, filling the polynomials and the
+    // mass matrices, and putting the attributes of each matrix into the
+    // vector for its type, in the same order as the matrices.
+    void ParseModelFile( std::string const& modelFilename,
+                         std::vector< AttributeMap >& scalarMatrixAttributes,
+                         std::vector< AttributeMap >& fermionMatrixAttributes,
+                  std::vector< AttributeMap >& fermionSquaredMatrixAttributes,
+                         std::vector< AttributeMap >& vectorMatrixAttributes );
+
+    // This fills the polynomials and the mass matrices from the binary cache
+    // in cacheFilename, returning true if it succeeded. It returns false,
+    // leaving the model empty, if there is no cache, if the cache was written
+    // for a model file with a different hash from sourceHash or in a
+    // different layout, if it is corrupt, or if registering its Lagrangian
+    // parameters does not give the same indices as when it was written.
+    bool ReadModelCache( std::string const& cacheFilename,
+                         std::uint64_t const sourceHash );
+
+    // This writes the parsed model into the binary cache in cacheFilename
+    // along with sourceHash. Nothing is written if the file cannot be
+    // written, as the cache is only there to save time.
+    void WriteModelCache( std::string const& cacheFilename,
+                          std::uint64_t const sourceHash,
+                   std::vector< AttributeMap > const& scalarMatrixAttributes,
+                  std::vector< AttributeMap > const& fermionMatrixAttributes,
+           std::vector< AttributeMap > const& fermionSquaredMatrixAttributes,
+                  std::vector< AttributeMap > const& vectorMatrixAttributes );
+
+    // This reads a polynomial sum written by AppendSum into polynomialSum,
+    // throwing an exception if it has a field index which is out of range or
+    // a parameter index which is not in validParameterIndices.
+    void ReadSum( MappedFileReader& cacheReader,
+                  std::set< size_t > const& validParameterIndices,
+                  ParametersAndFieldsProductSum& polynomialSum ) const;
+
+    // This reads a pair of polynomial sums written by AppendSum into
+    // polynomialSum.
+    void ReadSum( MappedFileReader& cacheReader,
+                  std::set< size_t > const& validParameterIndices,
+                  ComplexParametersAndFieldsProductSum& polynomialSum ) const
+    { ReadSum( cacheReader,
+               validParameterIndices,
+               polynomialSum.first );
+      ReadSum( cacheReader,
+               validParameterIndices,
+               polynomialSum.second ); }
+
+    // This reads mass matrices written by AppendMatrices and appends them to
+    // massMatrices.
+    template< typename MatrixType >
+    void ReadMatrices( MappedFileReader& cacheReader,
+                       std::set< size_t > const& validParameterIndices,
+                       std::vector< MatrixType >& massMatrices ) const;
+
+    // This appends the coefficient, parameter indices, and field indices of
+    // each term of polynomialSum to cacheWriter.
+    static void
+    AppendSum( BinaryFileWriter& cacheWriter,
+               ParametersAndFieldsProductSum const& polynomialSum );
+
+    // This appends both parts of polynomialSum to cacheWriter.
+    static void
+    AppendSum( BinaryFileWriter& cacheWriter,
+               ComplexParametersAndFieldsProductSum const& polynomialSum )
+    { AppendSum( cacheWriter,
+                 polynomialSum.first );
+      AppendSum( cacheWriter,
+                 polynomialSum.second ); }
+
+    // This appends the attributes, number of rows, and elements of each of
+    // massMatrices to cacheWriter.
+    template< typename MatrixType >
+    static void
+    AppendMatrices( BinaryFileWriter& cacheWriter,
+                    std::vector< MatrixType > const& massMatrices,
+                    std::vector< AttributeMap > const& matrixAttributes );
+
     // This interprets stringToParse as a sum of complex polynomial terms and
     // sets polynomialSum accordingly.
     void ParseSumOfPolynomialTerms( std::string const& stringToParse,
@@ -145,24 +323,54 @@ namespace VevaciousPlusPlus
                                 ParametersAndFieldsProductTerm& polynomialTerm,
                                            bool& imaginaryTerm );
 
-    // This appends the masses-squared and multiplicity from each
-    // MassesSquaredFromMatrix in massSquaredMatrices to massSquaredMatrices,
-    // with the values of the Lagrangian parameters given in parameterValues.
-    void AddMassesSquaredWithMultiplicity(
+    // This sets massesSquaredWithFactors to hold the masses-squared and
+    // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices,
+    // with the values of the Lagrangian parameters given in parameterValues,
+    // re-using the memory already held by massesSquaredWithFactors.
+    void SetMassesSquaredWithMultiplicity(
                                   std::vector< double > const& parameterValues,
                                std::vector< double > const& fieldConfiguration,
             std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
        std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors ) const;
 
-    // This appends the masses-squared and multiplicity from each
-    // MassesSquaredFromMatrix in massSquaredMatrices to massSquaredMatrices,
-    // with all Lagrangian parameters evaluated at the last scale which was
-    // used to update them.
-    void AddMassesSquaredWithMultiplicity(
+    // This sets massesSquaredWithFactors to hold the masses-squared and
+    // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices,
+    // with all Lagrangian parameters evaluated at the fixed scale of
+    // coefficientSnapshot, re-using the memory already held by
+    // massesSquaredWithFactors.
+    void SetMassesSquaredWithMultiplicity(
+                             FixedScaleCoefficients const& coefficientSnapshot,
                                std::vector< double > const& fieldConfiguration,
             std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
        std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors ) const;
 
+    // This sets massesSquaredWithFactors to hold the masses-squared and
+    // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices
+    // and massesSquaredDerivatives to hold the derivatives of the
+    // masses-squared with respect to the fields, with the values of the
+    // Lagrangian parameters given in parameterValues, re-using the memory
+    // already held by massesSquaredWithFactors and massesSquaredDerivatives.
+    void SetMassesSquaredWithFieldDerivatives(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+              std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors,
+     std::vector< MassesSquaredDerivatives >& massesSquaredDerivatives ) const;
+
+    // This sets massesSquaredWithFactors to hold the masses-squared and
+    // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices
+    // and massesSquaredDerivatives to hold the derivatives of the
+    // masses-squared with respect to the fields, with all Lagrangian
+    // parameters evaluated at the fixed scale of coefficientSnapshot,
+    // re-using the memory already held by massesSquaredWithFactors and
+    // massesSquaredDerivatives.
+    void SetMassesSquaredWithFieldDerivatives(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+              std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors,
+     std::vector< MassesSquaredDerivatives >& massesSquaredDerivatives ) const;
+
     // This evaluates the sum of corrections for the degrees of freedom with
     // masses-squared given by massesSquaredWithFactors with
     // subtractFromLogarithm as the constant to subtract from the logarithm of
@@ -180,6 +388,24 @@ namespace VevaciousPlusPlus
                            double& cumulativeQuantumCorrection,
                            double& cumulativeThermalCorrection ) const;
 
+    // This adds the derivatives with respect to the fields of the corrections
+    // summed by AddToCorrections to gradientVector, using the derivatives of
+    // the masses-squared given in massesSquaredDerivatives and the derivative
+    // of the thermal correction function given by ThermalFunctionDerivative.
+    // The quantum corrections are multiplied by quantumFactor and the thermal
+    // corrections by thermalFactor before being added.
+    void AddToCorrectionsGradient(
+         std::vector< DoubleVectorWithDouble > const& massesSquaredWithFactors,
+       std::vector< MassesSquaredDerivatives > const& massesSquaredDerivatives,
+                                   double const inverseScaleSquared,
+                                   bool const temperatureGreaterThanZero,
+                                   double const inverseTemperatureSquared,
+                                   double const subtractFromLogarithm,
+                           double (*ThermalFunctionDerivative)( double const ),
+                                   double const quantumFactor,
+                                   double const thermalFactor,
+                                 std::vector< double >& gradientVector ) const;
+
     // This should return a string that is valid Python with no indentedation
     // to evaluate the potential in three functions:
     // TreeLevelPotential( fv ), JustLoopCorrectedPotential( fv ), and
@@ -243,46 +469,202 @@ namespace VevaciousPlusPlus
     = complexSum.first.ParametersAndFieldsProducts();
   }
 
-  // This appends the masses-squared and multiplicity from each
-  // MassesSquaredFromMatrix in massSquaredMatrices to massSquaredMatrices,
-  // with the values of the Lagrangian parameters given in parameterValues.
+  // This returns the EvaluationWorkspace belonging to the calling thread. It
+  // is shared by all the potentials evaluated on that thread, so it should
+  // only be used within a single evaluation which does not itself evaluate
+  // another potential.
+  inline PotentialFromPolynomialWithMasses::EvaluationWorkspace&
+  PotentialFromPolynomialWithMasses::ThreadWorkspace()
+  {
+    static thread_local EvaluationWorkspace threadWorkspace;
+    return threadWorkspace;
+  }
+
+  // This reads mass matrices written by AppendMatrices and appends them to
+  // massMatrices.
+  template< typename MatrixType >
+  inline void PotentialFromPolynomialWithMasses::ReadMatrices(
+                                                MappedFileReader& cacheReader,
+                               std::set< size_t > const& validParameterIndices,
+                                std::vector< MatrixType >& massMatrices ) const
+  {
+    // Each matrix takes at least the 8 bytes of each of its two counts.
+    size_t const numberOfMatrices( cacheReader.ReadCount( 16 ) );
+    for( size_t matrixIndex( 0 );
+         matrixIndex < numberOfMatrices;
+         ++matrixIndex )
+    {
+      AttributeMap matrixAttributes;
+      size_t const numberOfAttributes( cacheReader.ReadCount( 16 ) );
+      for( size_t attributeIndex( 0 );
+           attributeIndex < numberOfAttributes;
+           ++attributeIndex )
+      {
+        std::string const attributeName( cacheReader.ReadString() );
+        matrixAttributes[ attributeName ] = cacheReader.ReadString();
+      }
+      // Each of the numberOfRows^2 elements takes at least the 8 bytes of
+      // its number of terms, checked as numberOfRows rows of numberOfRows
+      // elements so that the square cannot overflow.
+      size_t const numberOfRows( cacheReader.ReadCount( 8 ) );
+      cacheReader.CheckCount( numberOfRows,
+                              ( numberOfRows * 8 ) );
+      massMatrices.push_back( MatrixType( numberOfRows,
+                                          matrixAttributes ) );
+      for( size_t elementIndex( 0 );
+           elementIndex < ( numberOfRows * numberOfRows );
+           ++elementIndex )
+      {
+        ReadSum( cacheReader,
+                 validParameterIndices,
+                 massMatrices.back().ElementAt( elementIndex ) );
+      }
+    }
+  }
+
+  // This appends the attributes, number of rows, and elements of each of
+  // massMatrices to cacheWriter.
+  template< typename MatrixType >
+  inline void PotentialFromPolynomialWithMasses::AppendMatrices(
+                                                 BinaryFileWriter& cacheWriter,
+                                 std::vector< MatrixType > const& massMatrices,
+                          std::vector< AttributeMap > const& matrixAttributes )
+  {
+    cacheWriter.AppendValue< std::uint64_t >( massMatrices.size() );
+    for( size_t matrixIndex( 0 );
+         matrixIndex < massMatrices.size();
+         ++matrixIndex )
+    {
+      AttributeMap const& attributeMap( matrixAttributes[ matrixIndex ] );
+      cacheWriter.AppendValue< std::uint64_t >( attributeMap.size() );
+      for( AttributeMap::const_iterator
+           matrixAttribute( attributeMap.begin() );
+           matrixAttribute != attributeMap.end();
+           ++matrixAttribute )
+      {
+        cacheWriter.AppendString( matrixAttribute->first );
+        cacheWriter.AppendString( matrixAttribute->second );
+      }
+      cacheWriter.AppendValue< std::uint64_t >(
+                                  massMatrices[ matrixIndex ].NumberOfRows() );
+      for( size_t elementIndex( 0 );
+           elementIndex
+           < massMatrices[ matrixIndex ].MatrixElements().size();
+           ++elementIndex )
+      {
+        AppendSum( cacheWriter,
+               massMatrices[ matrixIndex ].MatrixElements()[ elementIndex ] );
+      }
+    }
+  }
+
+  // This sets massesSquaredWithFactors to hold the masses-squared and
+  // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices,
+  // with the values of the Lagrangian parameters given in parameterValues,
+  // re-using the memory already held by massesSquaredWithFactors.
   inline void
-  PotentialFromPolynomialWithMasses::AddMassesSquaredWithMultiplicity(
+  PotentialFromPolynomialWithMasses::SetMassesSquaredWithMultiplicity(
                                   std::vector< double > const& parameterValues,
                                std::vector< double > const& fieldConfiguration,
             std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
         std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors ) const
   {
-    for( std::vector< MassesSquaredCalculator* >::const_iterator
-         whichMatrix( massSquaredMatrices.begin() );
-         whichMatrix < massSquaredMatrices.end();
-         ++whichMatrix )
+    massesSquaredWithFactors.resize( massSquaredMatrices.size() );
+    for( size_t matrixIndex( 0 );
+         matrixIndex < massSquaredMatrices.size();
+         ++matrixIndex )
     {
-      massesSquaredWithFactors.push_back(
-           std::make_pair( (*whichMatrix)->MassesSquared( parameterValues,
-                                                          fieldConfiguration ),
-                           (*whichMatrix)->MultiplicityFactor() ) );
+      massSquaredMatrices[ matrixIndex ]->SetMassesSquared( parameterValues,
+                                                            fieldConfiguration,
+                              massesSquaredWithFactors[ matrixIndex ].first );
+      massesSquaredWithFactors[ matrixIndex ].second
+      = massSquaredMatrices[ matrixIndex ]->MultiplicityFactor();
     }
   }
 
-  // This appends the masses-squared and multiplicity from each
-  // MassesSquaredFromMatrix in massSquaredMatrices to massSquaredMatrices,
-  // with all Lagrangian parameters evaluated at the last scale which was
-  // used to update them.
+  // This sets massesSquaredWithFactors to hold the masses-squared and
+  // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices,
+  // with all Lagrangian parameters evaluated at the fixed scale of
+  // coefficientSnapshot, re-using the memory already held by
+  // massesSquaredWithFactors.
   inline void
-  PotentialFromPolynomialWithMasses::AddMassesSquaredWithMultiplicity(
+  PotentialFromPolynomialWithMasses::SetMassesSquaredWithMultiplicity(
+                             FixedScaleCoefficients const& coefficientSnapshot,
                                std::vector< double > const& fieldConfiguration,
             std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
         std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors ) const
   {
-    for( std::vector< MassesSquaredCalculator* >::const_iterator
-         whichMatrix( massSquaredMatrices.begin() );
-         whichMatrix < massSquaredMatrices.end();
-         ++whichMatrix )
+    massesSquaredWithFactors.resize( massSquaredMatrices.size() );
+    for( size_t matrixIndex( 0 );
+         matrixIndex < massSquaredMatrices.size();
+         ++matrixIndex )
+    {
+      massSquaredMatrices[ matrixIndex ]->SetMassesSquared(
+                                                           coefficientSnapshot,
+                                                            fieldConfiguration,
+                              massesSquaredWithFactors[ matrixIndex ].first );
+      massesSquaredWithFactors[ matrixIndex ].second
+      = massSquaredMatrices[ matrixIndex ]->MultiplicityFactor();
+    }
+  }
+
+  // This sets massesSquaredWithFactors to hold the masses-squared and
+  // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices and
+  // massesSquaredDerivatives to hold the derivatives of the masses-squared
+  // with respect to the fields, with the values of the Lagrangian parameters
+  // given in parameterValues, re-using the memory already held by
+  // massesSquaredWithFactors and massesSquaredDerivatives.
+  inline void
+  PotentialFromPolynomialWithMasses::SetMassesSquaredWithFieldDerivatives(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+              std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors,
+      std::vector< MassesSquaredDerivatives >& massesSquaredDerivatives ) const
+  {
+    massesSquaredWithFactors.resize( massSquaredMatrices.size() );
+    massesSquaredDerivatives.resize( massSquaredMatrices.size() );
+    for( size_t matrixIndex( 0 );
+         matrixIndex < massSquaredMatrices.size();
+         ++matrixIndex )
+    {
+      massSquaredMatrices[ matrixIndex ]->MassesSquaredWithFieldDerivatives(
+                                                               parameterValues,
+                                                            fieldConfiguration,
+                                 massesSquaredWithFactors[ matrixIndex ].first,
+                                      massesSquaredDerivatives[ matrixIndex ] );
+      massesSquaredWithFactors[ matrixIndex ].second
+      = massSquaredMatrices[ matrixIndex ]->MultiplicityFactor();
+    }
+  }
+
+  // This sets massesSquaredWithFactors to hold the masses-squared and
+  // multiplicity from each MassesSquaredFromMatrix in massSquaredMatrices and
+  // massesSquaredDerivatives to hold the derivatives of the masses-squared
+  // with respect to the fields, with all Lagrangian parameters evaluated at
+  // the fixed scale of coefficientSnapshot, re-using the memory already held
+  // by massesSquaredWithFactors and massesSquaredDerivatives.
+  inline void
+  PotentialFromPolynomialWithMasses::SetMassesSquaredWithFieldDerivatives(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+              std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors,
+      std::vector< MassesSquaredDerivatives >& massesSquaredDerivatives ) const
+  {
+    massesSquaredWithFactors.resize( massSquaredMatrices.size() );
+    massesSquaredDerivatives.resize( massSquaredMatrices.size() );
+    for( size_t matrixIndex( 0 );
+         matrixIndex < massSquaredMatrices.size();
+         ++matrixIndex )
     {
-      massesSquaredWithFactors.push_back(
-           std::make_pair( (*whichMatrix)->MassesSquared( fieldConfiguration ),
-                           (*whichMatrix)->MultiplicityFactor() ) );
+      massSquaredMatrices[ matrixIndex ]->MassesSquaredWithFieldDerivatives(
+                                                           coefficientSnapshot,
+                                                            fieldConfiguration,
+                                 massesSquaredWithFactors[ matrixIndex ].first,
+                                      massesSquaredDerivatives[ matrixIndex ] );
+      massesSquaredWithFactors[ matrixIndex ].second
+      = massSquaredMatrices[ matrixIndex ]->MultiplicityFactor();
     }
   }
 
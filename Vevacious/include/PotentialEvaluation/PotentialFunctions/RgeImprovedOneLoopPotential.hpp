@@ -18,6 +18,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <iomanip>
+#include "Utilities/PerformanceLogger.hpp"
 
 namespace VevaciousPlusPlus
 {
@@ -31,6 +32,13 @@ namespace VevaciousPlusPlus
                       LagrangianParameterManager& lagrangianParameterManager );
     RgeImprovedOneLoopPotential(
                     PotentialFromPolynomialWithMasses const& potentialToCopy );
+
+    // This copies potentialToCopy without reading its model file again, but
+    // binds the copy to lagrangianParameterManager, which must have been set
+    // up in the same way as the manager of potentialToCopy.
+    RgeImprovedOneLoopPotential(
+                      PotentialFromPolynomialWithMasses const& potentialToCopy,
+                      LagrangianParameterManager& lagrangianParameterManager );
     virtual ~RgeImprovedOneLoopPotential();
 
 
@@ -42,6 +50,22 @@ namespace VevaciousPlusPlus
     operator()( std::vector< double > const& fieldConfiguration,
                 double const temperatureValue = 0.0 ) const;
 
+    // This evaluates the gradient of the potential with respect to the fields
+    // at fieldConfiguration and temperature temperatureValue and places it in
+    // gradientVector. The gradient at fixed Lagrangian parameters is evaluated
+    // analytically, and the contribution from the running of the parameters
+    // with the field-dependent renormalization scale is evaluated from the
+    // change of the potential under steps in the logarithm of the scale which
+    // correspond to steps of numericalStepSize GeV in the length of
+    // fieldConfiguration.
+    virtual void SetAsGradientAt( std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                  double const numericalStepSize = 1.0,
+                                  double const temperatureValue = 0.0 ) const;
+
+    // This returns true as SetAsGradientAt( ... ) is evaluated analytically.
+    virtual bool HasAnalyticGradient() const { return true; }
+
     // This returns the square of the Euclidean distance between the given
     // vacua in field space.
     virtual double
@@ -65,6 +89,25 @@ namespace VevaciousPlusPlus
   protected:
     double minimumScaleSquared;
     double maximumScaleSquared;
+
+    // This returns the sum of the square of temperatureValue and the squares
+    // of the field values, without restricting it to lie between
+    // minimumScaleSquared and maximumScaleSquared.
+    double
+    UnrestrictedScaleSquared( std::vector< double > const& fieldConfiguration,
+                              double const temperatureValue ) const;
+
+    // This returns scaleSquared restricted to lie between minimumScaleSquared
+    // and maximumScaleSquared.
+    double RestrictedScaleSquared( double const scaleSquared ) const;
+
+    // This returns the energy density in GeV^4 of the potential for the
+    // fields given by fieldConfiguration and temperature in GeV given by
+    // temperatureValue, with the Lagrangian parameters evaluated at the
+    // renormalization scale given by the square root of scaleSquared.
+    double PotentialAtScale( std::vector< double > const& fieldConfiguration,
+                             double const temperatureValue,
+                             double const scaleSquared ) const;
   };
 
 
@@ -96,6 +139,57 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This returns the energy density in GeV^4 of the potential for a state
+  // strongly peaked around expectation values (in GeV) for the fields given
+  // by the values of fieldConfiguration and temperature in GeV given by
+  // temperatureValue.
+  inline double RgeImprovedOneLoopPotential::operator()(
+                               std::vector< double > const& fieldConfiguration,
+                                          double const temperatureValue ) const
+  {
+    PerformanceLogger::IncrementCounter(
+                                     PerformanceRecord::PotentialEvaluations );
+    return PotentialAtScale( fieldConfiguration,
+                             temperatureValue,
+                             RestrictedScaleSquared( UnrestrictedScaleSquared(
+                                                            fieldConfiguration,
+                                                       temperatureValue ) ) );
+  }
+
+  // This returns the sum of the square of temperatureValue and the squares of
+  // the field values, without restricting it to lie between
+  // minimumScaleSquared and maximumScaleSquared.
+  inline double RgeImprovedOneLoopPotential::UnrestrictedScaleSquared(
+                               std::vector< double > const& fieldConfiguration,
+                                          double const temperatureValue ) const
+  {
+    double scaleSquared( temperatureValue * temperatureValue );
+    for( std::vector< double >::const_iterator
+         fieldValue( fieldConfiguration.begin() );
+         fieldValue < fieldConfiguration.end();
+         ++fieldValue )
+    {
+      scaleSquared += ( (*fieldValue) * (*fieldValue) );
+    }
+    return scaleSquared;
+  }
+
+  // This returns scaleSquared restricted to lie between minimumScaleSquared
+  // and maximumScaleSquared.
+  inline double RgeImprovedOneLoopPotential::RestrictedScaleSquared(
+                                              double const scaleSquared ) const
+  {
+    if( scaleSquared < minimumScaleSquared )
+    {
+      return minimumScaleSquared;
+    }
+    else if( scaleSquared > maximumScaleSquared )
+    {
+      return maximumScaleSquared;
+    }
+    return scaleSquared;
+  }
+
 } /* namespace VevaciousPlusPlus */
 
 #endif /* RGEIMPROVEDONELOOPPOTENTIAL_HPP_ */
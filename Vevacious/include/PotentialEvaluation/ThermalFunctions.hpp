@@ -22,6 +22,12 @@ namespace VevaciousPlusPlus
     static double BosonicJ( double const squareRatio );
     static double FermionicJ( double const squareRatio );
 
+    // These return the derivatives of BosonicJ and FermionicJ with respect to
+    // squareRatio, consistent with the linear interpolation used by those
+    // functions.
+    static double BosonicJDerivative( double const squareRatio );
+    static double FermionicJDerivative( double const squareRatio );
+
     static std::string JFunctionsAsPython();
 
   private:
@@ -66,6 +72,13 @@ namespace VevaciousPlusPlus
 
     // 1 to 100 (element [0] is 1, [100] is 100), in steps of 1.0.
     static double FermionPlusOneToPlusOneHundred( double const squareRatio );
+
+    // This returns the difference between the element of tableValues at the
+    // integer part of scaledRatio and the next element. Given the way that the
+    // interpolations are written, this is the magnitude of the slope of each
+    // interpolation with respect to squareRatio.
+    static double TableStepDifference( double const* const tableValues,
+                                       double const scaledRatio );
   };
 
 
@@ -128,6 +141,80 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This returns the derivative of BosonicJ with respect to squareRatio,
+  // consistent with the linear interpolation used by BosonicJ. (The minus
+  // signs come from the tables for negative squareRatio being in order of
+  // decreasing squareRatio.)
+  inline double
+  ThermalFunctions::BosonicJDerivative( double const squareRatio )
+  {
+    if( squareRatio <= -12.0 )
+    {
+      return 0.0;
+    }
+    else if( squareRatio <= -1.0 )
+    {
+      return -TableStepDifference( bosonMinusOneToMinusTwelve,
+                                   ( -10.0 * ( squareRatio + 1.0 ) ) );
+    }
+    else if( squareRatio < 0.0 )
+    {
+      return -TableStepDifference( bosonZeroToMinusOne,
+                                   ( -100.0 * squareRatio ) );
+    }
+    else if( squareRatio < 1.0 )
+    {
+      return TableStepDifference( bosonZeroToPlusOne,
+                                  ( 100.0 * squareRatio ) );
+    }
+    else if( squareRatio < 100.0 )
+    {
+      return TableStepDifference( bosonPlusOneToPlusOneHundred,
+                                  ( squareRatio - 1.0 ) );
+    }
+    else
+    {
+      return 0.0;
+    }
+  }
+
+  // This returns the derivative of FermionicJ with respect to squareRatio,
+  // consistent with the linear interpolation used by FermionicJ. (The minus
+  // signs come from the tables for negative squareRatio being in order of
+  // decreasing squareRatio.)
+  inline double
+  ThermalFunctions::FermionicJDerivative( double const squareRatio )
+  {
+    if( squareRatio <= -12.0 )
+    {
+      return 0.0;
+    }
+    else if( squareRatio <= -1.0 )
+    {
+      return -TableStepDifference( fermionMinusOneToMinusTwelve,
+                                   ( -10.0 * ( squareRatio + 1.0 ) ) );
+    }
+    else if( squareRatio < 0.0 )
+    {
+      return -TableStepDifference( fermionZeroToMinusOne,
+                                   ( -100.0 * squareRatio ) );
+    }
+    else if( squareRatio < 1.0 )
+    {
+      return TableStepDifference( fermionZeroToPlusOne,
+                                  ( 100.0 * squareRatio ) );
+    }
+    else if( squareRatio < 100.0 )
+    {
+      return TableStepDifference( fermionPlusOneToPlusOneHundred,
+                                  ( squareRatio - 1.0 ) );
+    }
+    else
+    {
+      return 0.0;
+    }
+  }
+
   // -1 to -12 (element [0] is -1, [111] is -12), in steps of 0.1.
   inline double
   ThermalFunctions::BosonMinusOneToMinusTwelve( double const squareRatio )
@@ -224,5 +311,17 @@ namespace VevaciousPlusPlus
                      - fermionPlusOneToPlusOneHundred[ floorIndex ] ) ) );
   }
 
+  // This returns the difference between the element of tableValues at the
+  // integer part of scaledRatio and the next element. Given the way that the
+  // interpolations are written, this is the magnitude of the slope of each
+  // interpolation with respect to squareRatio.
+  inline double
+  ThermalFunctions::TableStepDifference( double const* const tableValues,
+                                         double const scaledRatio )
+  {
+    size_t floorIndex( static_cast< size_t >( scaledRatio ) );
+    return ( tableValues[ floorIndex + 1 ] - tableValues[ floorIndex ] );
+  }
+
 } /* namespace VevaciousPlusPlus */
 #endif /* THERMALFUNCTIONS_HPP_ */
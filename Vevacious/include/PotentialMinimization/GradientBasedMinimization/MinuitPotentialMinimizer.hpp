@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <algorithm>
 #include <cmath>
+#include "Utilities/PerformanceLogger.hpp"
 
 
 namespace VevaciousPlusPlus
@@ -48,6 +49,13 @@ namespace VevaciousPlusPlus
     { return PotentialMinimum( MinuitMinimum( startingPoint.size(),
                                               RunMigrad( startingPoint ) ) ); }
 
+    // This performs a Minuit2 migrad() minimization at temperature
+    // minimizationTemperature with its own PotentialForMinuit, so that it does
+    // not change the temperature used by operator().
+    virtual PotentialMinimum
+    MinimumAtTemperature( std::vector< double > const& startingPoint,
+                          double const minimizationTemperature ) const;
+
     // This ensures that the minimizations are calculated at the given
     // temperature.
     virtual void SetTemperature( double const minimizationTemperature )
@@ -56,10 +64,14 @@ namespace VevaciousPlusPlus
     // This sets up a ROOT::Minuit2::MnMigrad instance and runs its operator().
     // The initial step sizes are set to be the values of startingPoint
     // multiplied by errorFraction, absolute values taken. Any step size less
-    // than errorMinimum is set to errorMinimum.
+    // than errorMinimum is set to errorMinimum. The analytic gradient of the
+    // potential is given to Minuit2 if the potential provides one.
     ROOT::Minuit2::FunctionMinimum
     RunMigrad( std::vector< double > const& startingPoint,
-               double givenTolerance = -1.0 ) const;
+               double givenTolerance = -1.0 ) const
+    { return RunMigrad( minimizationFunction,
+                        startingPoint,
+                        givenTolerance ); }
 
     // This returns the value of the potential at the field origin and at the
     // current temperature, which is subtracted from the potential by
@@ -73,20 +85,46 @@ namespace VevaciousPlusPlus
     double const errorFraction;
     double const errorMinimum;
     unsigned int const minuitStrategy;
+
+    // This sets up a ROOT::Minuit2::MnMigrad instance for functionForMinuit
+    // and runs its operator(), as RunMigrad( startingPoint, givenTolerance )
+    // does for minimizationFunction.
+    ROOT::Minuit2::FunctionMinimum
+    RunMigrad( PotentialForMinuit const& functionForMinuit,
+               std::vector< double > const& startingPoint,
+               double givenTolerance ) const;
   };
 
 
 
 
 
-  // This sets up a ROOT::Minuit2::MnMigrad instance and runs its operator().
-  // The initial step sizes are set to be the values of startingPoint
-  // multiplied by errorFraction, absolute values taken. Any step size less
-  // than errorMinimum is set to errorMinimum.
+  // This performs a Minuit2 migrad() minimization at temperature
+  // minimizationTemperature with its own PotentialForMinuit, so that it does
+  // not change the temperature used by operator().
+  inline PotentialMinimum MinuitPotentialMinimizer::MinimumAtTemperature(
+                                    std::vector< double > const& startingPoint,
+                                   double const minimizationTemperature ) const
+  {
+    PotentialForMinuit const functionForMinuit( potentialFunction,
+                                                minimizationTemperature );
+    return PotentialMinimum( MinuitMinimum( startingPoint.size(),
+                                            RunMigrad( functionForMinuit,
+                                                       startingPoint,
+                                                       -1.0 ) ) );
+  }
+
+  // This sets up a ROOT::Minuit2::MnMigrad instance for functionForMinuit
+  // and runs its operator(), as RunMigrad( startingPoint, givenTolerance )
+  // does for minimizationFunction.
   inline ROOT::Minuit2::FunctionMinimum MinuitPotentialMinimizer::RunMigrad(
+                                  PotentialForMinuit const& functionForMinuit,
                                     std::vector< double > const& startingPoint,
                                                   double givenTolerance ) const
   {
+    PerformanceLogger::ScopedTimer
+    migradTimer( PerformanceRecord::MigradTimer );
+    PerformanceLogger::IncrementCounter( PerformanceRecord::MigradCalls );
     std::vector< double > initialStepSizes( startingPoint.size(),
                                             errorMinimum );
     for( size_t vectorIndex( 0 );
@@ -99,14 +137,35 @@ namespace VevaciousPlusPlus
     if( givenTolerance <= 0.0 )
     {
       givenTolerance = std::max( errorMinimum,
-                  ( errorFraction * minimizationFunction( startingPoint ) ) );
+                     ( errorFraction * functionForMinuit( startingPoint ) ) );
+    }
+    if( functionForMinuit.HasAnalyticGradient() )
+    {
+      ROOT::Minuit2::MnMigrad mnMigrad( functionForMinuit,
+                                        startingPoint,
+                                        initialStepSizes,
+                                        minuitStrategy );
+      ROOT::Minuit2::FunctionMinimum const
+      minuitMinimum( mnMigrad( 0,
+                               givenTolerance ) );
+      PerformanceLogger::AddToHistogram(
+                                     PerformanceRecord::FunctionCallsPerMigrad,
+                                         minuitMinimum.NFcn() );
+      return minuitMinimum;
     }
-    ROOT::Minuit2::MnMigrad mnMigrad( minimizationFunction,
-                                      startingPoint,
-                                      initialStepSizes,
-                                      minuitStrategy );
-    return mnMigrad( 0,
-                     givenTolerance );
+    ROOT::Minuit2::MnMigrad
+    mnMigrad( static_cast< ROOT::Minuit2::FCNBase const& >(
+                                                           functionForMinuit ),
+              startingPoint,
+              initialStepSizes,
+              minuitStrategy );
+    ROOT::Minuit2::FunctionMinimum const
+    minuitMinimum( mnMigrad( 0,
+                             givenTolerance ) );
+    PerformanceLogger::AddToHistogram(
+                                     PerformanceRecord::FunctionCallsPerMigrad,
+                                       minuitMinimum.NFcn() );
+    return minuitMinimum;
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -8,23 +8,25 @@
 #ifndef POTENTIALFORMINUIT_HPP_
 #define POTENTIALFORMINUIT_HPP_
 
-#include "Minuit2/FCNBase.h"
+#include "Minuit2/FCNGradientBase.h"
 #include "PotentialEvaluation/PotentialFunction.hpp"
 #include <vector>
 
 namespace VevaciousPlusPlus
 {
 
-  class PotentialForMinuit : public ROOT::Minuit2::FCNBase
+  class PotentialForMinuit : public ROOT::Minuit2::FCNGradientBase
   {
   public:
-    PotentialForMinuit( PotentialFunction const& minimizationFunction ) :
-      ROOT::Minuit2::FCNBase(),
+    PotentialForMinuit( PotentialFunction const& minimizationFunction,
+                        double const minimizationTemperature = 0.0 ) :
+      ROOT::Minuit2::FCNGradientBase(),
       minimizationFunction( minimizationFunction ),
       fieldOrigin( minimizationFunction.NumberOfFieldVariables(),
                    0.0 ),
-      functionAtOrigin( minimizationFunction( fieldOrigin ) ),
-      currentTemperature( 0.0 ) {}
+      functionAtOrigin( minimizationFunction( fieldOrigin,
+                                              minimizationTemperature ) ),
+      currentTemperature( minimizationTemperature ) {}
 
     virtual ~PotentialForMinuit() {}
 
@@ -39,6 +41,21 @@ namespace VevaciousPlusPlus
     // This implements Up() for FCNBase just to stick to a basic value.
     virtual double Up() const { return 1.0; }
 
+    // This implements Gradient( ... ) for FCNGradientBase, returning the
+    // gradient of the potential at the current temperature.
+    virtual std::vector< double >
+    Gradient( std::vector< double > const& fieldConfiguration ) const;
+
+    // This tells Minuit2 not to compare Gradient( ... ) against its own
+    // numerical gradient before starting each minimization.
+    virtual bool CheckGradient() const { return false; }
+
+    // This returns true if minimizationFunction can evaluate its gradient
+    // analytically. If it cannot, Minuit2 should be given this object as a
+    // plain FCNBase so that it uses its own numerical gradient.
+    bool HasAnalyticGradient() const
+    { return minimizationFunction.HasAnalyticGradient(); }
+
     // The potential is minimized at a fixed temperature, so this sets the
     // temperature.
     void SetTemperature( double const currentTemperature );
@@ -56,6 +73,19 @@ namespace VevaciousPlusPlus
 
 
 
+  // This implements Gradient( ... ) for FCNGradientBase, returning the
+  // gradient of the potential at the current temperature.
+  inline std::vector< double > PotentialForMinuit::Gradient(
+                        std::vector< double > const& fieldConfiguration ) const
+  {
+    std::vector< double > gradientVector;
+    minimizationFunction.SetAsGradientAt( gradientVector,
+                                          fieldConfiguration,
+                                          1.0,
+                                          currentTemperature );
+    return gradientVector;
+  }
+
   // The potential is minimized at a fixed temperature, so this sets the
   // temperature.
   inline void
@@ -15,6 +15,9 @@
 #include "PotentialMinimum.hpp"
 #include <vector>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
 #include <cmath>
 
 namespace VevaciousPlusPlus
@@ -26,7 +29,8 @@ namespace VevaciousPlusPlus
                                 std::unique_ptr<StartingPointFinder> startingPointFinder,
                                 std::unique_ptr<GradientMinimizer> gradientMinimizer,
                               double const extremumSeparationThresholdFraction,
-                                double const nonDsbRollingToDsbScalingFactor, bool global_Is_Panic );
+                                double const nonDsbRollingToDsbScalingFactor, bool global_Is_Panic,
+                                unsigned int const numberOfThreads = 1 );
     virtual ~GradientFromStartingPoints();
 
 
@@ -37,7 +41,10 @@ namespace VevaciousPlusPlus
     // given by minimizationTemperature, recording the found minima in
     // foundMinima. It also records the minima lower than dsbVacuum in
     // panicVacua, and of those, it sets panicVacuum to be the minimum in
-    // panicVacua closest to dsbVacuum.
+    // panicVacua closest to dsbVacuum. The minimizations from the starting
+    // points are shared out among numberOfThreads threads, but the results
+    // are recorded in the order of startingPoints regardless of which thread
+    // finished first.
     virtual void FindMinima( double const minimizationTemperature = 0.0 );
 
     // This uses gradientMinimizer to find the minimum at temperature
@@ -55,6 +62,22 @@ namespace VevaciousPlusPlus
     double extremumSeparationThresholdFraction;
     double nonDsbRollingToDsbScalingFactor;
     bool global_Is_Panic;
+    unsigned int numberOfThreads;
+
+    // This uses gradientMinimizer to find the minimum at temperature
+    // minimizationTemperature starting from startingPoint, re-rolling from
+    // startingPoint scaled by nonDsbRollingToDsbScalingFactor if it rolled to
+    // dsbVacuum or a phase rotation of it, and sets rolledToDsbOrSignFlip to
+    // whether the returned minimum is still dsbVacuum or a phase rotation of
+    // it. Progress is written to rollingLog rather than directly to std::cout
+    // so that this can be called from several threads at once.
+    PotentialMinimum
+    RollFromStartingPoint( std::vector< double > const& startingPoint,
+                           double const minimizationTemperature,
+                           double const thresholdSeparationSquared,
+                           double const thresholdSeparation,
+                           bool& rolledToDsbOrSignFlip,
+                           std::ostream& rollingLog ) const;
   };
 
 
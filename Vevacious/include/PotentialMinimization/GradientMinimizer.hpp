@@ -29,6 +29,14 @@ namespace VevaciousPlusPlus
     virtual PotentialMinimum
     operator()( std::vector< double > const& startingPoint ) const = 0;
 
+    // This should find the minimum at temperature minimizationTemperature
+    // using startingPoint as a starting point without changing the
+    // temperature set by SetTemperature( ... ), so that it can be called from
+    // several threads at once.
+    virtual PotentialMinimum
+    MinimumAtTemperature( std::vector< double > const& startingPoint,
+                          double const minimizationTemperature ) const = 0;
+
     // This should ensure that the minimizations are calculated at the given
     // temperature.
     virtual void SetTemperature( double const minimizationTemperature ) = 0;
@@ -22,6 +22,7 @@
 #include <sstream>
 #include <fstream>
 #include "LHPC/Utilities/ParsingUtilities.hpp"
+#include "Utilities/WarningLogger.hpp"
 #include <complex>
 #include <cmath>
 
@@ -45,6 +46,27 @@ namespace VevaciousPlusPlus
 
 
   protected:
+    // This removes the folder for a single run of HOM4PS2 on destruction,
+    // even if an exception is being thrown, so that a failed run does not
+    // leave its folder behind in HOM4PS2's folder.
+    class ScopedRunFolder
+    {
+    public:
+      ScopedRunFolder( std::string const& runFolder ) :
+        runFolder( runFolder ) {}
+
+      ~ScopedRunFolder()
+      { std::string const systemCommand( "rm -rf " + runFolder );
+        if( system( systemCommand.c_str() ) == -1 )
+        { WarningLogger::LogWarning( "System could not execute \""
+                                     + systemCommand + "\"." ); } }
+
+
+    protected:
+      std::string const runFolder;
+    };
+
+
     static std::string const fieldNamePrefix;
 
     std::string const pathToHom4ps2;
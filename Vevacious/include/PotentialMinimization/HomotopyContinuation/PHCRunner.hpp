@@ -28,6 +28,7 @@
 #include <regex>
 #include <sys/stat.h>
 #include <chrono>
+#include <cstdio>
 namespace VevaciousPlusPlus
 {
 
@@ -45,6 +46,12 @@ namespace VevaciousPlusPlus
     operator()( std::vector< PolynomialConstraint > const& systemToSolve,
                 std::vector< std::vector< double > >& systemSolutions ) const;
 
+    // PHC is run on input, output and lock files whose names contain a UUID
+    // generated for each call, without changing the working directory, and
+    // each call removes only its own files, so several calls can run at
+    // once.
+    virtual bool CanRunConcurrently() const { return true; }
+
 
   protected:
     static std::string const fieldNamePrefix;
@@ -77,6 +84,12 @@ namespace VevaciousPlusPlus
                              std::vector< std::string > const& variableNames,
                          std::map< std::string, size_t > const& nameToIndexMap,
               std::vector< PolynomialConstraint > const& systemToSolve ) const;
+
+    // This removes the input and output files of a single run of PHC. Any
+    // file which does not exist is ignored, as PHC may have failed before
+    // writing it.
+    void RemoveRunFiles( std::string const& PHCInputFileName,
+                         std::string const& PHCOutputFilename ) const;
   };
 
 } /* namespace VevaciousPlusPlus */
@@ -0,0 +1,176 @@
+/*
+ * TotalDegreeHomotopySolver.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef TOTALDEGREEHOMOTOPYSOLVER_HPP_
+#define TOTALDEGREEHOMOTOPYSOLVER_HPP_
+
+#include "PotentialMinimization/StartingPointGeneration/PolynomialSystemSolver.hpp"
+#include <vector>
+#include <cstddef>
+#include <complex>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "Eigen/Dense"
+
+namespace VevaciousPlusPlus
+{
+  // This class finds all the solutions of a system of polynomial constraints
+  // by numerical homotopy continuation within the process, rather than
+  // writing the system to a file for an external program. The start system
+  // is the total-degree system x_i^(d_i) - 1 = 0, where d_i is the highest
+  // total power of fields in the ith constraint, whose product-of-d_i
+  // solutions are the products of roots of unity, and each of these is
+  // tracked independently along the linear homotopy
+  // H( x, t ) = ( 1 - t ) gamma G( x ) + t F( x ) from t = 0 to t = 1, so the
+  // paths are shared out among numberOfThreads threads.
+  class TotalDegreeHomotopySolver : public PolynomialSystemSolver
+  {
+  public:
+    TotalDegreeHomotopySolver( double const resolutionSize,
+                               unsigned int const numberOfThreads = 1,
+                             unsigned int const maximumStepsPerPath = 10000 );
+    virtual ~TotalDegreeHomotopySolver();
+
+
+    // This tracks every path of the total-degree homotopy to fill
+    // systemSolutions with all the purely real solutions of systemToSolve,
+    // along with any valid sign-flip variations of them.
+    virtual void
+    operator()( std::vector< PolynomialConstraint > const& systemToSolve,
+                std::vector< std::vector< double > >& systemSolutions ) const;
+
+    // Everything is held in memory local to each call, so several systems
+    // can be solved at once.
+    virtual bool CanRunConcurrently() const { return true; }
+
+
+  protected:
+    typedef std::complex< double > ComplexNumber;
+    typedef Eigen::Matrix< ComplexNumber, Eigen::Dynamic, 1 > ComplexVector;
+    typedef Eigen::Matrix< ComplexNumber, Eigen::Dynamic, Eigen::Dynamic >
+    ComplexMatrix;
+
+    // This holds the target system with the fields divided by a common scale
+    // and each constraint divided by its largest coefficient, so that the
+    // paths are tracked through values of order 1. The terms of the
+    // constraint with index constraintIndex have indices from
+    // termOffsets[ constraintIndex ] up to (but not including)
+    // termOffsets[ constraintIndex + 1 ], and each term has
+    // numberOfVariables consecutive elements of termPowers.
+    struct ScaledSystem
+    {
+      size_t numberOfVariables;
+      unsigned int highestPower;
+      std::vector< unsigned int > totalDegrees;
+      std::vector< size_t > termOffsets;
+      std::vector< double > termCoefficients;
+      std::vector< unsigned int > termPowers;
+    };
+
+    // This holds the matrices and vectors used at each step of tracking a
+    // single path, so that they are allocated once per path.
+    struct PathWorkspace
+    {
+      PathWorkspace( ScaledSystem const& scaledSystem );
+
+      std::vector< ComplexNumber > powerTable;
+      ComplexVector targetValues;
+      ComplexMatrix targetJacobian;
+      ComplexVector homotopyValues;
+      ComplexMatrix homotopyJacobian;
+      ComplexVector timeDerivative;
+      ComplexVector stepVector;
+      ComplexVector predictorSlopes[ 4 ];
+      ComplexVector stagePoint;
+    };
+
+    // The constant multiplying the start system has to have a phase which is
+    // not a multiple of pi, so that the paths avoid singularities for all t
+    // less than 1 with probability 1. It is fixed rather than random so that
+    // runs are reproducible.
+    static ComplexNumber const gammaConstant;
+    static double const initialStepSize;
+    static double const maximumStepSize;
+    static double const minimumStepSize;
+    static double const correctorTolerance;
+    static double const divergenceThreshold;
+    // Paths going to solutions at infinity grow roughly as a power of
+    // ( 1 - t ), so they only reach divergenceThreshold with very small steps
+    // very close to t = 1. Instead, once t passes endgameStartTime, a path
+    // whose largest field magnitude is above endgameMagnitude is abandoned
+    // as soon as an accepted step shows that magnitude growing at least as
+    // fast as ( 1 - t )^(-divergenceExponent).
+    static double const endgameStartTime;
+    static double const endgameMagnitude;
+    static double const divergenceExponent;
+
+    double const resolutionSize;
+    unsigned int const numberOfThreads;
+    unsigned int const maximumStepsPerPath;
+
+    // This returns the scale for the fields which minimizes the spread of the
+    // magnitudes of the terms within each constraint, found by a least-
+    // squares fit of the logarithms of the coefficients against the total
+    // powers of the terms.
+    static double
+    FieldScale( std::vector< PolynomialConstraint > const& systemToSolve );
+
+    // This fills scaledSystem with the terms of systemToSolve for the fields
+    // divided by fieldScale.
+    static void
+    PrepareScaledSystem(
+                      std::vector< PolynomialConstraint > const& systemToSolve,
+                         double const fieldScale,
+                         ScaledSystem& scaledSystem );
+
+    // This sets startPoint to be the solution of the start system with index
+    // pathIndex, counting the roots of unity for each field in turn.
+    static void StartPoint( ScaledSystem const& scaledSystem,
+                            size_t pathIndex,
+                            ComplexVector& startPoint );
+
+    // This puts the values of the scaled target system at pathPoint into
+    // pathWorkspace.targetValues and its Jacobian into
+    // pathWorkspace.targetJacobian.
+    static void EvaluateTarget( ScaledSystem const& scaledSystem,
+                                ComplexVector const& pathPoint,
+                                PathWorkspace& pathWorkspace );
+
+    // This puts the values of the homotopy at pathPoint and homotopyTime into
+    // pathWorkspace.homotopyValues, its Jacobian with respect to the fields
+    // into pathWorkspace.homotopyJacobian, and its derivative with respect to
+    // homotopyTime into pathWorkspace.timeDerivative.
+    static void EvaluateHomotopy( ScaledSystem const& scaledSystem,
+                                  ComplexVector const& pathPoint,
+                                  double const homotopyTime,
+                                  PathWorkspace& pathWorkspace );
+
+    // This puts the derivative of the path with respect to homotopyTime at
+    // pathPoint into pathSlope, returning false if the Jacobian is singular.
+    static bool PathSlope( ScaledSystem const& scaledSystem,
+                           ComplexVector const& pathPoint,
+                           double const homotopyTime,
+                           PathWorkspace& pathWorkspace,
+                           ComplexVector& pathSlope );
+
+    // This tracks the path starting at pathPoint from t = 0 to t = 1 with a
+    // fourth-order Runge-Kutta predictor and a Newton corrector, adapting
+    // the step size, then refines the end point with Newton's method on the
+    // target system. It leaves the end of the path in pathPoint and returns
+    // true if it reached t = 1 without diverging to infinity.
+    bool TrackPath( ScaledSystem const& scaledSystem,
+                    ComplexVector& pathPoint,
+                    PathWorkspace& pathWorkspace ) const;
+  };
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* TOTALDEGREEHOMOTOPYSOLVER_HPP_ */
@@ -22,6 +22,8 @@
 #include "Eigen/Dense"
 #include <cstddef>
 #include <memory>
+#include <string>
+#include "Utilities/WarningLogger.hpp"
 
 
 namespace VevaciousPlusPlus
@@ -36,7 +38,9 @@ namespace VevaciousPlusPlus
                           std::unique_ptr<PolynomialSystemSolver> polynomialSystemSolver,
                                    unsigned int const numberOfScales,
                                    bool const returnOnlyPolynomialMinima,
-                                   size_t const numberOfFields );
+                                   size_t const numberOfFields,
+                                   unsigned int const numberOfThreads = 1,
+                      double const neighbouringScaleDuplicateFraction = 0.01 );
     virtual ~PolynomialAtFixedScalesSolver();
 
 
@@ -61,6 +65,11 @@ namespace VevaciousPlusPlus
     // solutions with length less than 10^3 or greater than 10^7 are discarded.
     // The lowest scale does not discard any solution for being too small, and
     // the highest scale does not discard any solutions for being too large.
+    // The scales are solved by up to numberOfThreads threads at once if
+    // polynomialSystemSolver can run concurrently, and the solutions are then
+    // appended in order of increasing scale, leaving out any solution which
+    // is within a hypercube of side neighbouringScaleDuplicateFraction times
+    // its length of a solution from the next-lowest scale.
     virtual void
     operator()( std::vector< std::vector< double > >& startingPoints ) const;
 
@@ -75,6 +84,8 @@ namespace VevaciousPlusPlus
     unsigned int const numberOfScales;
     bool const returnOnlyPolynomialMinima;
     size_t const numberOfFields;
+    unsigned int const numberOfThreads;
+    double const neighbouringScaleDuplicateFraction;
 
     // This uses polynomialSystemSolver to solve the system at the scale given
     // by exp(logCurrentScale), discarding solutions with Euclidean length
@@ -86,6 +97,13 @@ namespace VevaciousPlusPlus
                        double const lowerSolutionLengthBound,
                        double const upperSolutionLengthBound ) const;
 
+    // This returns true if givenSolution is within a hypercube of side
+    // neighbouringScaleDuplicateFraction times the length of givenSolution of
+    // any of the solutions in neighbouringSolutions.
+    bool IsDuplicateOfNeighbouringSolution(
+                                    std::vector< double > const& givenSolution,
+     std::vector< std::vector< double > > const& neighbouringSolutions ) const;
+
     // This puts the polynomial constraint system for the given scale into
     // polynomialConstraints.
     void
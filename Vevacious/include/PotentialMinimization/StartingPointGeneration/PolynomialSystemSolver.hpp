@@ -11,7 +11,10 @@
 #include <utility>
 #include <vector>
 #include <cstddef>
+#include <cmath>
+#include <unordered_map>
 #include "Utilities/VectorUtilities.hpp"
+#include "Utilities/PerformanceLogger.hpp"
 
 namespace VevaciousPlusPlus
 {
@@ -33,161 +36,265 @@ namespace VevaciousPlusPlus
                       std::vector< PolynomialConstraint > const& systemToSolve,
              std::vector< std::vector< double > >& systemSolutions ) const = 0;
 
+    // This should return true if operator() can be called from several
+    // threads at once. Solvers which change the working directory of the
+    // whole process, for example, must not be run concurrently.
+    virtual bool CanRunConcurrently() const { return false; }
+
 
   protected:
+    // This class holds a reference to a set of solutions along with a hash of
+    // which cell of a grid each solution falls into, so that checking whether
+    // a new solution is within a hypercube of side resolutionSize of any of
+    // the solutions already in the set only compares it with the solutions in
+    // neighboring cells. The grid is one-dimensional, along a fixed direction
+    // in field space with components which are not rational multiples of each
+    // other, as a grid over all the fields would need 3^N neighboring cells
+    // for N fields. Two solutions within the hypercube of each other have
+    // projections on this direction which differ by at most resolutionSize
+    // times the sum of the components, so the cells have that width.
+    class IndexedSolutionSet
+    {
+    public:
+      IndexedSolutionSet( std::vector< std::vector< double > >& solutionSet,
+                          double const resolutionSize );
+      ~IndexedSolutionSet() {}
+
+
+      // This returns true if givenSolution is within a hypercube of side
+      // resolutionSize with any of the solutions in the set.
+      bool ContainsNear( std::vector< double > const& givenSolution ) const;
+
+      // This appends newSolution to the set and records its grid cell.
+      void Append( std::vector< double > const& newSolution );
+
+      double ResolutionSize() const { return resolutionSize; }
+
+
+    protected:
+      std::vector< std::vector< double > >& solutionSet;
+      double const resolutionSize;
+      std::vector< double > projectionDirection;
+      double cellWidth;
+      std::unordered_map< long, std::vector< size_t > > solutionsInCells;
+
+      // This sets up projectionDirection for solutions with numberOfFields
+      // elements and sets cellWidth appropriately.
+      void SetUpProjection( size_t const numberOfFields );
+
+      // This returns the index of the grid cell which contains fieldValues.
+      long CellIndex( std::vector< double > const& fieldValues ) const;
+    };
+
+
     // This is useful if the main method somehow manages to miss some vaild
     // solutions where some of the fields have flipped sign, as we observed
     // would happen sometimes with HOM4PS2. It finds all the possible solutions
     // which have one or more of solutionConfiguration's elements flipped in
     // sign, and appends solutionConfiguration and all of the sign-flip
     // variations which pass IsValidSolution(...) to the end of solutionSet.
+    // The variations are made one at a time in a single buffer rather than
+    // all being stored at once.
     static void AppendSolutionAndValidSignFlips(
                             std::vector< double > const& solutionConfiguration,
-                             std::vector< std::vector< double > >& solutionSet,
-                      std::vector< PolynomialConstraint > const& systemToSolve,
-                                                 double const resolutionSize );
-
-    // This puts solutionToFlip and every possible variant where at least one
-    // element has had a sign flip into signFlips.
-    static void AllSignFlips( std::vector< double > solutionToFlip,
-                             std::vector< std::vector< double > >& signFlips );
-
-    // This returns true if givenSolution is within a hypercube of side
-    // resolutionSize with any of the solutions in solutionSet.
-    static bool
-    AlreadyInSolutionSet( std::vector< double > const& givenSolution,
-                          std::vector< std::vector< double > >& solutionSet,
-                          double const resolutionSize );
-
-    // This appends any solution in candidateSolutions which is not already in
-    // destinationSolutions and which also solves systemToSolve, within
-    // resolutionSize.
-    static void AppendValidSolutions(
-                std::vector< std::vector< double > > const& candidateSolutions,
-                    std::vector< std::vector< double > >& destinationSolutions,
-                      std::vector< PolynomialConstraint > const& systemToSolve,
-                                      double const resolutionSize );
+                                               IndexedSolutionSet& solutionSet,
+                    std::vector< PolynomialConstraint > const& systemToSolve );
 
     // This goes through each of the constraints in systemToSolve, stepping
     // resolutionSize either side of givenSolution in the field appropriate to
     // the constraint, and returns false if any of the constraints do not
     // change sign in stepping from one side of givenSolution to the other in
-    // any of the fields.
-    static bool IsValidSolution( std::vector< double > givenSolution,
+    // any of the fields. Each element of givenSolution is restored to its
+    // original value after being stepped, so givenSolution is unchanged when
+    // this returns.
+    static bool IsValidSolution( std::vector< double >& givenSolution,
                       std::vector< PolynomialConstraint > const& systemToSolve,
                                  double const resolutionSize );
 
     // This returns the value of fieldConstraint for the field values given in
     // fieldConfiguration.
     static double PartialSlope( PolynomialConstraint const& fieldConstraint,
-                                std::vector< double > fieldConfiguration );
+                          std::vector< double > const& fieldConfiguration );
   };
 
 
 
 
 
-  // This is useful if the main method somehow manages to miss some vaild
-  // solutions where some of the fields have flipped sign, as we observed
-  // would happen sometimes with HOM4PS2. It finds all the possible solutions
-  // which have one or more of solutionConfiguration's elements flipped in
-  // sign, and appends solutionConfiguration and all of the sign-flip
-  // variations which pass IsValidSolution(...) to the end of solutionSet.
-  inline void PolynomialSystemSolver::AppendSolutionAndValidSignFlips(
-                            std::vector< double > const& solutionConfiguration,
+  inline PolynomialSystemSolver::IndexedSolutionSet::IndexedSolutionSet(
                              std::vector< std::vector< double > >& solutionSet,
-                      std::vector< PolynomialConstraint > const& systemToSolve,
-                                                  double const resolutionSize )
+                                                double const resolutionSize ) :
+    solutionSet( solutionSet ),
+    resolutionSize( resolutionSize ),
+    projectionDirection(),
+    cellWidth( 0.0 ),
+    solutionsInCells()
   {
-    if( !(AlreadyInSolutionSet( solutionConfiguration,
-                                solutionSet,
-                                resolutionSize )) )
+    for( size_t solutionIndex( 0 );
+         solutionIndex < solutionSet.size();
+         ++solutionIndex )
     {
-      solutionSet.push_back( solutionConfiguration );
-      std::vector< std::vector< double > > signFlips;
-      AllSignFlips( solutionConfiguration,
-                    signFlips );
-      AppendValidSolutions( signFlips,
-                            solutionSet,
-                            systemToSolve,
-                            resolutionSize );
+      if( projectionDirection.empty() )
+      {
+        SetUpProjection( solutionSet[ solutionIndex ].size() );
+      }
+      solutionsInCells[ CellIndex( solutionSet[ solutionIndex ] ) ].push_back(
+                                                               solutionIndex );
     }
   }
 
-  // This puts solutionToFlip and every possible variant where at least one
-  // element has had a sign flip into signFlips.
-  inline void
-  PolynomialSystemSolver::AllSignFlips( std::vector< double > solutionToFlip,
-                              std::vector< std::vector< double > >& signFlips )
+  // This returns true if givenSolution is within a hypercube of side
+  // resolutionSize with any of the solutions in the set.
+  inline bool PolynomialSystemSolver::IndexedSolutionSet::ContainsNear(
+                             std::vector< double > const& givenSolution ) const
   {
-    signFlips.push_back( solutionToFlip );
-    size_t const numberOfElements( solutionToFlip.size() );
-    for( size_t flipIndex( 0 );
-         flipIndex < numberOfElements;
-         ++flipIndex )
+    if( solutionSet.empty() )
     {
-      size_t const vectorSize( signFlips.size() );
-      for( size_t vectorIndex( 0 );
-           vectorIndex < vectorSize;
-           ++vectorIndex )
+      return false;
+    }
+    long const centralCell( CellIndex( givenSolution ) );
+    for( long cellIndex( centralCell - 1 );
+         cellIndex <= ( centralCell + 1 );
+         ++cellIndex )
+    {
+      std::unordered_map< long, std::vector< size_t > >::const_iterator
+      cellSolutions( solutionsInCells.find( cellIndex ) );
+      if( cellSolutions == solutionsInCells.end() )
       {
-        if( signFlips[ vectorIndex ][ flipIndex ] != 0.0 )
+        continue;
+      }
+      for( std::vector< size_t >::const_iterator
+           solutionIndex( cellSolutions->second.begin() );
+           solutionIndex < cellSolutions->second.end();
+           ++solutionIndex )
+      {
+        if( VectorUtilities::DifferenceIsWithinHypercube( givenSolution,
+                                                solutionSet[ *solutionIndex ],
+                                                          resolutionSize ) )
         {
-          solutionToFlip = signFlips[ vectorIndex ];
-          solutionToFlip[ flipIndex ] = -(solutionToFlip[ flipIndex ]);
-          signFlips.push_back( solutionToFlip );
+          return true;
         }
       }
     }
+    return false;
   }
 
-  // This appends any solution in candidateSolutions which is not already in
-  // destinationSolutions and which also solves systemToSolve, within
-  // resolutionSize.
-  inline void PolynomialSystemSolver::AppendValidSolutions(
-                std::vector< std::vector< double > > const& candidateSolutions,
-                    std::vector< std::vector< double > >& destinationSolutions,
-                      std::vector< PolynomialConstraint > const& systemToSolve,
-                                                  double const resolutionSize )
+  // This appends newSolution to the set and records its grid cell.
+  inline void PolynomialSystemSolver::IndexedSolutionSet::Append(
+                                    std::vector< double > const& newSolution )
   {
-    for( std::vector< std::vector< double > >::const_iterator
-         candidateSolution( candidateSolutions.begin() );
-         candidateSolution != candidateSolutions.end();
-         ++candidateSolution )
+    if( projectionDirection.empty() )
     {
-      if( !(AlreadyInSolutionSet( *candidateSolution,
-                                  destinationSolutions,
-                                  resolutionSize ))
-          &&
-          IsValidSolution( *candidateSolution,
-                           systemToSolve,
-                           resolutionSize ) )
-      {
-        destinationSolutions.push_back( *candidateSolution );
-      }
+      SetUpProjection( newSolution.size() );
     }
+    solutionsInCells[ CellIndex( newSolution ) ].push_back(
+                                                         solutionSet.size() );
+    solutionSet.push_back( newSolution );
   }
 
-  // This returns true if givenSolution is within a hypercube of side
-  // resolutionSize with any of the solutions in solutionSet.
-  inline bool PolynomialSystemSolver::AlreadyInSolutionSet(
-                                    std::vector< double > const& givenSolution,
-                             std::vector< std::vector< double > >& solutionSet,
-                                                  double const resolutionSize )
+  // This sets up projectionDirection for solutions with numberOfFields
+  // elements and sets cellWidth appropriately.
+  inline void PolynomialSystemSolver::IndexedSolutionSet::SetUpProjection(
+                                                  size_t const numberOfFields )
+  {
+    // The fractional parts of multiples of the golden ratio are spread evenly
+    // between 0 and 1 without any being rational multiples of each other.
+    double const goldenRatio( 0.5 * ( 1.0 + sqrt( 5.0 ) ) );
+    projectionDirection.resize( numberOfFields );
+    double sumOfComponents( 0.0 );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      double const goldenMultiple( ( fieldIndex + 1 ) * goldenRatio );
+      projectionDirection[ fieldIndex ]
+      = ( 0.5 + goldenMultiple - floor( goldenMultiple ) );
+      sumOfComponents += projectionDirection[ fieldIndex ];
+    }
+    cellWidth = ( resolutionSize * sumOfComponents );
+  }
+
+  // This returns the index of the grid cell which contains fieldValues.
+  inline long PolynomialSystemSolver::IndexedSolutionSet::CellIndex(
+                               std::vector< double > const& fieldValues ) const
   {
-    for( std::vector< std::vector< double > >::const_iterator
-         existingSolution( solutionSet.begin() );
-         existingSolution < solutionSet.end();
-         ++existingSolution )
+    if( !( cellWidth > 0.0 ) )
     {
-      if( VectorUtilities::DifferenceIsWithinHypercube( givenSolution,
-                                                        *existingSolution,
-                                                        resolutionSize ) )
+      return 0;
+    }
+    double projectedValue( 0.0 );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < projectionDirection.size();
+         ++fieldIndex )
+    {
+      projectedValue += ( projectionDirection[ fieldIndex ]
+                          * fieldValues[ fieldIndex ] );
+    }
+    return static_cast< long >( floor( projectedValue / cellWidth ) );
+  }
+
+  // This is useful if the main method somehow manages to miss some vaild
+  // solutions where some of the fields have flipped sign, as we observed
+  // would happen sometimes with HOM4PS2. It finds all the possible solutions
+  // which have one or more of solutionConfiguration's elements flipped in
+  // sign, and appends solutionConfiguration and all of the sign-flip
+  // variations which pass IsValidSolution(...) to the end of solutionSet.
+  // The variations are made one at a time in a single buffer rather than all
+  // being stored at once.
+  inline void PolynomialSystemSolver::AppendSolutionAndValidSignFlips(
+                            std::vector< double > const& solutionConfiguration,
+                                               IndexedSolutionSet& solutionSet,
+                     std::vector< PolynomialConstraint > const& systemToSolve )
+  {
+    // Every real solution found by the solver is counted, even if it turns
+    // out to be a duplicate.
+    PerformanceLogger::IncrementCounter(
+                                        PerformanceRecord::HomotopySolutions );
+    if( solutionSet.ContainsNear( solutionConfiguration ) )
+    {
+      return;
+    }
+    solutionSet.Append( solutionConfiguration );
+
+    // Only non-zero elements give distinct variations when flipped, and the
+    // variations are visited in the same order as the bits of flipMask
+    // counting up, with bit i flipping the ith non-zero element.
+    std::vector< size_t > flippableIndices;
+    for( size_t fieldIndex( 0 );
+         fieldIndex < solutionConfiguration.size();
+         ++fieldIndex )
+    {
+      if( solutionConfiguration[ fieldIndex ] != 0.0 )
       {
-        return true;
+        flippableIndices.push_back( fieldIndex );
+      }
+    }
+    std::vector< double > flippedSolution( solutionConfiguration );
+    size_t const numberOfVariations( static_cast< size_t >( 1 )
+                                     << flippableIndices.size() );
+    for( size_t flipMask( 1 );
+         flipMask < numberOfVariations;
+         ++flipMask )
+    {
+      for( size_t flipIndex( 0 );
+           flipIndex < flippableIndices.size();
+           ++flipIndex )
+      {
+        size_t const fieldIndex( flippableIndices[ flipIndex ] );
+        flippedSolution[ fieldIndex ]
+        = ( ( ( flipMask >> flipIndex ) & 1 ) ?
+            -(solutionConfiguration[ fieldIndex ]) :
+            solutionConfiguration[ fieldIndex ] );
+      }
+      if( !(solutionSet.ContainsNear( flippedSolution ))
+          &&
+          IsValidSolution( flippedSolution,
+                           systemToSolve,
+                           solutionSet.ResolutionSize() ) )
+      {
+        solutionSet.Append( flippedSolution );
       }
     }
-    return false;
   }
 
 } /* namespace VevaciousPlusPlus */
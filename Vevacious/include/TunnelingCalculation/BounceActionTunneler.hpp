@@ -17,7 +17,9 @@
 #include <cmath>
 #include <limits>
 #include "Utilities/WarningLogger.hpp"
+#include "BounceActionEvaluation/BubbleProfileCache.hpp"
 #include <vector>
+#include <cstddef>
 
 namespace VevaciousPlusPlus
 {
@@ -40,6 +42,14 @@ namespace VevaciousPlusPlus
                         PotentialMinimum const& falseVacuum,
                         PotentialMinimum const& trueVacuum );
 
+    // This sets bubbleProfileCache to keep up to maximumNumberOfProfiles
+    // bubble profiles (0 turning it off), with keys quantized by
+    // quantizationFraction.
+    void SetBubbleProfileCache( size_t const maximumNumberOfProfiles,
+                                double const quantizationFraction )
+    { bubbleProfileCache.SetLimits( maximumNumberOfProfiles,
+                                    quantizationFraction ); }
+
 
   protected:
     static double const maximumPowerOfNaturalExponent;
@@ -56,6 +66,11 @@ namespace VevaciousPlusPlus
     std::pair< double, double > rangeOfMaxTemperatureForOriginToTrue;
 
     double const vacuumSeparationFractionSquared;
+    // The cache keeps bubble profiles from call to call, as the same vacua
+    // are often tunneled between at the same temperature along the same path
+    // more than once, for example the straight path between the same panic
+    // vacuum found from different starting points. It is off by default.
+    BubbleProfileCache bubbleProfileCache;
 
 
     // This is a hook to allow for derived classes to prepare things common to
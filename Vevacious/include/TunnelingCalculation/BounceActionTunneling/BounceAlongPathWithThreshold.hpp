@@ -20,10 +20,18 @@
 #include "PotentialMinimization/GradientBasedMinimization/MinuitPotentialMinimizer.hpp"
 #include <iostream>
 #include "Utilities/WarningLogger.hpp"
+#include "Utilities/PerformanceLogger.hpp"
 #include "BounceActionEvaluation/PathParameterization/TunnelPath.hpp"
 #include "BounceActionEvaluation/PathParameterization/LinearSplineThroughNodes.hpp"
 #include "BounceActionEvaluation/SplinePotential.hpp"
+#include "BounceActionEvaluation/AdaptiveSplinePotential.hpp"
+#include "BounceActionEvaluation/OneDimensionalPotentialAlongPath.hpp"
 #include "BounceActionEvaluation/BubbleProfile.hpp"
+#include <memory>
+#include <atomic>
+#include <string>
+#include <sstream>
+#include <stdexcept>
 
 namespace VevaciousPlusPlus
 {
@@ -39,17 +47,66 @@ namespace VevaciousPlusPlus
                                   unsigned int const temperatureAccuracy,
                                   unsigned int const pathPotentialResolution,
                                   unsigned int const pathFindingTimeout,
-                                  double const vacuumSeparationFraction );
+                                  double const vacuumSeparationFraction,
+                                unsigned int const initialPathResolution = 16,
+                                double const pathPotentialTolerance = 0.0 );
     virtual ~BounceAlongPathWithThreshold();
 
 
+    // This adds another set of path finders and another action calculator,
+    // each set being used by a single thread at a time, so that the bounce
+    // actions for one more temperature can be calculated at the same time in
+    // ContinueThermalTunneling. The path finders and the action calculator
+    // keep state from call to call, so they cannot be shared between threads.
+    void AddConcurrentPathFindingChain(
+                 std::vector< std::unique_ptr<BouncePathFinder> > pathFinders,
+                    std::unique_ptr<BounceActionCalculator> actionCalculator );
+
   protected:
+    // This holds a set of path finders and an action calculator for one
+    // thread in ContinueThermalTunneling beyond the first, which uses
+    // pathFinders and actionCalculator.
+    struct PathFindingChain
+    {
+      std::vector< std::unique_ptr<BouncePathFinder> > pathFinders;
+      std::unique_ptr<BounceActionCalculator> actionCalculator;
+    };
+
     std::vector< std::unique_ptr<BouncePathFinder> > pathFinders;
     std::unique_ptr<BounceActionCalculator> actionCalculator;
+    std::vector< PathFindingChain > additionalChains;
     unsigned int thermalIntegrationResolution;
     unsigned int const pathPotentialResolution;
     unsigned int const pathFindingTimeout;
+    unsigned int const initialPathResolution;
+    double const pathPotentialTolerance;
+
+
+    // This returns a new approximation of the potential along tunnelPath. If
+    // pathPotentialTolerance is positive, it is an AdaptiveSplinePotential
+    // starting from initialPathResolution segments and refining down to
+    // segments of 1 / pathPotentialResolution of the path, otherwise it is a
+    // SplinePotential with pathPotentialResolution segments.
+    std::unique_ptr< OneDimensionalPotentialAlongPath >
+    ApproximatePathPotential( PotentialFunction const& potentialFunction,
+                              TunnelPath const& tunnelPath,
+                       double const requiredVacuumSeparationSquared ) const;
 
+    // This returns the bubble profile for tunneling from falseVacuum to
+    // trueVacuum along tunnelPath from bubbleProfileCache if the cache has
+    // one, and otherwise calculates it with chainCalculator along a new
+    // approximation of the potential along tunnelPath and puts it in the
+    // cache. Profiles for paths where the energy barrier is not resolved are
+    // not put in the cache, and if requireResolvedBarrier is true, an empty
+    // pointer is returned for such paths instead.
+    std::shared_ptr< BubbleProfile const >
+    CachedOrNewBubble( PotentialFunction const& potentialFunction,
+                       PotentialMinimum const& falseVacuum,
+                       PotentialMinimum const& trueVacuum,
+                       TunnelPath const& tunnelPath,
+                       double const requiredVacuumSeparationSquared,
+                       BounceActionCalculator& chainCalculator,
+                       bool const requireResolvedBarrier );
 
     // This returns either the dimensionless bounce action integrated over four
     // dimensions (for zero temperature) or the dimensionful bounce action
@@ -67,7 +124,13 @@ namespace VevaciousPlusPlus
     // the critical temperature for tunneling to be possible from T = 0 unless
     // the integral already passes a threshold, and sets
     // dominantTemperatureInGigaElectronVolts to be the temperature with the
-    // lowest survival probability.
+    // lowest survival probability. The thermal vacua are tracked from each
+    // temperature to the next first, then the bounce actions for the
+    // temperatures are shared out among the threads which have their own
+    // path-finding chains, each chain always being given the same
+    // temperatures, and any temperatures which are still running or
+    // waiting once the decay width summed in order of temperature passes the
+    // threshold are abandoned.
     virtual void
     ContinueThermalTunneling( PotentialFunction const& potentialFunction,
                               PotentialMinimum const& falseVacuum,
@@ -87,11 +150,101 @@ namespace VevaciousPlusPlus
                                 double const tunnelingTemperature,
                                 double const actionThreshold,
                                 double const requiredVacuumSeparationSquared );
+
+    // This does the work of BoundedBounceAction using chainPathFinders and
+    // chainCalculator rather than pathFinders and actionCalculator. If
+    // cancellationFlag is not NULL, it is checked before each new path is
+    // tried, and if it has been set, the lowest action so far is returned
+    // straight away, as it is no longer needed.
+    double
+    ChainBoundedBounceAction( PotentialFunction const& potentialFunction,
+                              PotentialMinimum const& falseVacuum,
+                              PotentialMinimum const& trueVacuum,
+                              double const tunnelingTemperature,
+                              double const actionThreshold,
+                              double const requiredVacuumSeparationSquared,
+      std::vector< std::unique_ptr<BouncePathFinder> > const& chainPathFinders,
+                              BounceActionCalculator& chainCalculator,
+                           std::atomic< bool > const* const cancellationFlag );
   };
 
 
 
 
+  // This returns a new approximation of the potential along tunnelPath. If
+  // pathPotentialTolerance is positive, it is an AdaptiveSplinePotential
+  // starting from initialPathResolution segments and refining down to
+  // segments of 1 / pathPotentialResolution of the path, otherwise it is a
+  // SplinePotential with pathPotentialResolution segments.
+  inline std::unique_ptr< OneDimensionalPotentialAlongPath >
+  BounceAlongPathWithThreshold::ApproximatePathPotential(
+                                    PotentialFunction const& potentialFunction,
+                                                  TunnelPath const& tunnelPath,
+                          double const requiredVacuumSeparationSquared ) const
+  {
+    if( pathPotentialTolerance > 0.0 )
+    {
+      return std::unique_ptr< OneDimensionalPotentialAlongPath >(
+                               new AdaptiveSplinePotential( potentialFunction,
+                                                            tunnelPath,
+                                                         initialPathResolution,
+                                                       pathPotentialResolution,
+                                                        pathPotentialTolerance,
+                                           requiredVacuumSeparationSquared ) );
+    }
+    return std::unique_ptr< OneDimensionalPotentialAlongPath >(
+                                       new SplinePotential( potentialFunction,
+                                                            tunnelPath,
+                                                       pathPotentialResolution,
+                                           requiredVacuumSeparationSquared ) );
+  }
+
+  // This returns the bubble profile for tunneling from falseVacuum to
+  // trueVacuum along tunnelPath from bubbleProfileCache if the cache has
+  // one, and otherwise calculates it with chainCalculator along a new
+  // approximation of the potential along tunnelPath and puts it in the
+  // cache. Profiles for paths where the energy barrier is not resolved are
+  // not put in the cache, and if requireResolvedBarrier is true, an empty
+  // pointer is returned for such paths instead.
+  inline std::shared_ptr< BubbleProfile const >
+  BounceAlongPathWithThreshold::CachedOrNewBubble(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                            PotentialMinimum const& trueVacuum,
+                                                  TunnelPath const& tunnelPath,
+                                  double const requiredVacuumSeparationSquared,
+                                       BounceActionCalculator& chainCalculator,
+                                            bool const requireResolvedBarrier )
+  {
+    BubbleProfileCache::CacheKey const
+    cacheKey( bubbleProfileCache.Key( falseVacuum,
+                                      trueVacuum,
+                                      tunnelPath ) );
+    std::shared_ptr< BubbleProfile const >
+    bubbleProfile( bubbleProfileCache.Find( cacheKey ) );
+    if( bubbleProfile )
+    {
+      return bubbleProfile;
+    }
+    std::unique_ptr< OneDimensionalPotentialAlongPath >
+    pathPotential( ApproximatePathPotential( potentialFunction,
+                                             tunnelPath,
+                                           requiredVacuumSeparationSquared ) );
+    if( !(pathPotential->EnergyBarrierWasResolved()) )
+    {
+      if( requireResolvedBarrier )
+      {
+        return bubbleProfile;
+      }
+      bubbleProfile.reset( chainCalculator( tunnelPath,
+                                            *pathPotential ) );
+      return bubbleProfile;
+    }
+    return bubbleProfileCache.Insert( cacheKey,
+                                      chainCalculator( tunnelPath,
+                                                       *pathPotential ) );
+  }
+
   // This returns either the dimensionless bounce action integrated over four
   // dimensions (for zero temperature) or the dimensionful bounce action
   // integrated over three dimensions (for non-zero temperature) for
@@ -126,5 +279,31 @@ namespace VevaciousPlusPlus
                               * falseVacuum.SquareDistanceTo( trueVacuum ) ) );
   }
 
+  // This returns either the dimensionless bounce action integrated over four
+  // dimensions (for zero temperature) or the dimensionful bounce action
+  // integrated over three dimensions (for non-zero temperature) for
+  // tunneling from falseVacuum to trueVacuum at temperature
+  // tunnelingTemperature, or an upper bound if the upper bound drops below
+  // actionThreshold during the course of the calculation. The vacua are
+  // assumed to already be the minima at tunnelingTemperature.
+  inline double BounceAlongPathWithThreshold::BoundedBounceAction(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                            PotentialMinimum const& trueVacuum,
+                                             double const tunnelingTemperature,
+                                                  double const actionThreshold,
+                                 double const requiredVacuumSeparationSquared )
+  {
+    return ChainBoundedBounceAction( potentialFunction,
+                                     falseVacuum,
+                                     trueVacuum,
+                                     tunnelingTemperature,
+                                     actionThreshold,
+                                     requiredVacuumSeparationSquared,
+                                     pathFinders,
+                                     *actionCalculator,
+                                     NULL );
+  }
+
 } /* namespace VevaciousPlusPlus */
 #endif /* BOUNCEALONGPATHWITHTHRESHOLD_HPP_ */
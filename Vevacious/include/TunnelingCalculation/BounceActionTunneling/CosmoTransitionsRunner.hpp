@@ -28,7 +28,12 @@
 #include "BounceActionEvaluation/PathParameterization/LinearSplineThroughNodes.hpp"
 #include "BounceActionEvaluation/SplinePotential.hpp"
 #include "BounceActionEvaluation/BubbleProfile.hpp"
+#include "BounceActionEvaluation/BubbleProfileCache.hpp"
 #include <limits>
+#include <memory>
+#include <atomic>
+#include <sstream>
+#include <unistd.h>
 
 namespace VevaciousPlusPlus
 {
@@ -50,8 +55,11 @@ namespace VevaciousPlusPlus
 
 
   protected:
-    static std::string pythonPotentialFilenameBase;
-
+    // The Python files are named with uniqueFilenameTag, which is different
+    // for every instance in every process, so that several instances can run
+    // at the same time in the same working directory.
+    std::string const uniqueFilenameTag;
+    std::string const pythonPotentialFilenameBase;
     std::string const pathToCosmotransitions;
     unsigned int const resolutionOfDsbVacuum;
     unsigned int const maxInnerLoops;
@@ -129,6 +137,11 @@ namespace VevaciousPlusPlus
                                             PotentialMinimum const& trueVacuum,
                                   std::vector< double > const& fitTemperatures,
                                   std::vector< double >& straightPathActions );
+
+    // This returns a tag made from the process ID and a count of the calls
+    // to this function, which is valid as part of the name of a Python
+    // module.
+    static std::string UniqueFilenameTag();
   };
 
 } /* namespace VevaciousPlusPlus */
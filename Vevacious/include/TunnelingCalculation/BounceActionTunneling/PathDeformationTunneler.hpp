@@ -0,0 +1,148 @@
+/*
+ * PathDeformationTunneler.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef PATHDEFORMATIONTUNNELER_HPP_
+#define PATHDEFORMATIONTUNNELER_HPP_
+
+#include "CosmoTransitionsRunner.hpp"
+#include "TunnelingCalculation/TunnelingCalculator.hpp"
+#include "PotentialEvaluation/PotentialFunction.hpp"
+#include "PotentialMinimization/PotentialMinimum.hpp"
+#include "BounceActionEvaluation/BubbleShootingOnPathInFieldSpace.hpp"
+#include "BounceActionEvaluation/UndershootOvershootBubble.hpp"
+#include "BounceActionEvaluation/PathParameterization/LinearSplineThroughNodes.hpp"
+#include "BounceActionEvaluation/SplinePotential.hpp"
+#include "BounceActionEvaluation/BubbleProfile.hpp"
+#include "BounceActionEvaluation/BubbleProfileCache.hpp"
+#include "Utilities/WarningLogger.hpp"
+#include "Eigen/Dense"
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <iostream>
+#include <sstream>
+
+namespace VevaciousPlusPlus
+{
+  // This class does the same job as CosmoTransitionsRunner with the same
+  // options, but rather than writing the potential and a program as Python
+  // for CosmoTransitions to run, it deforms the tunneling path in the same
+  // way as CosmoTransitions does, using the PotentialFunction directly. The
+  // path is a set of nodes evenly spaced along it, starting as a straight
+  // line between the vacua. Each outer loop calculates the bubble profile
+  // along the path by overshooting and undershooting, and then each inner
+  // loop moves the nodes along the force which is normal to the path, which
+  // is the gradient of the potential perpendicular to the path balanced
+  // against the square of the speed of the fields along the path in the
+  // bubble profile times the curvature of the path. The inner loops stop
+  // when the largest normal force is small compared to the largest gradient
+  // of the potential, and the outer loops stop when the path is already at
+  // that point before it is moved. As the bounce action calculated along any
+  // path is an upper bound on the true bounce action, the lowest action from
+  // the outer loops is returned. The thermal tunneling is estimated as it is
+  // by CosmoTransitionsRunner, which already only used internal calculations
+  // for the straight-path fit.
+  class PathDeformationTunneler : public CosmoTransitionsRunner
+  {
+  public:
+    PathDeformationTunneler(
+                TunnelingCalculator::TunnelingStrategy const tunnelingStrategy,
+                             double const survivalProbabilityThreshold,
+                             unsigned int const temperatureAccuracy,
+                             unsigned int const resolutionOfDsbVacuum,
+                             unsigned int const maxInnerLoops,
+                             unsigned int const maxOuterLoops,
+                           unsigned int const thermalStraightPathFitResolution,
+                             double const vacuumSeparationFraction );
+    virtual ~PathDeformationTunneler();
+
+
+  protected:
+    // This is the ratio of the largest normal force on the nodes to the
+    // largest gradient of the potential at the nodes below which the path is
+    // taken to have converged, which is the default of CosmoTransitions.
+    static double const convergedForceRatio;
+    // This is the fraction of the distance between the vacua used as the
+    // step for the numerical gradient of the potential, which is only used
+    // for potentials which do not have an analytic gradient.
+    static double const gradientStepFraction;
+
+
+    // Nothing needs to be written out for the potential, as it is used
+    // directly.
+    virtual void
+    PrepareCommonExtras( PotentialFunction const& potentialFunction ) {}
+
+    // This returns either the dimensionless bounce action integrated over four
+    // dimensions (for zero temperature) or the dimensionful bounce action
+    // integrated over three dimensions (for non-zero temperature) for
+    // tunneling from falseVacuum to trueVacuum at temperature
+    // tunnelingTemperature, as the lowest action along the paths from up to
+    // maxOuterLoops rounds of deformation of an initially straight path. The
+    // vacua are assumed to already be the minima at tunnelingTemperature.
+    virtual double BounceAction( PotentialFunction const& potentialFunction,
+                                 PotentialMinimum const& falseVacuum,
+                                 PotentialMinimum const& trueVacuum,
+                                 double const tunnelingTemperature );
+
+    // This moves the nodes of pathNodes (apart from the ends) along the
+    // normal forces on them up to maxInnerLoops times, with the speed of the
+    // fields at each node taken from bubbleProfile along tunnelPath, which
+    // should go through pathNodes. The gradients of the potential at all the
+    // nodes are evaluated together by SetNodeGradients for each inner loop.
+    // It then spaces the nodes evenly along the deformed path again. It
+    // returns true without moving the nodes if the normal forces were already
+    // small enough for the path to have converged.
+    bool DeformPath( PotentialFunction const& potentialFunction,
+                     double const tunnelingTemperature,
+                     double const gradientStep,
+                     LinearSplineThroughNodes const& tunnelPath,
+                     BubbleProfile const& bubbleProfile,
+                     std::vector< std::vector< double > >& pathNodes ) const;
+
+    // This returns the square of the speed of the fields with respect to the
+    // radial variable in bubbleProfile at the point where the path auxiliary
+    // is auxiliaryValue, found by bisection assuming that the path auxiliary
+    // decreases with increasing radial value. It returns 0 for values of the
+    // path auxiliary beyond the center of the bubble.
+    static double
+    FieldSpeedSquared( BubbleProfile const& bubbleProfile,
+                       LinearSplineThroughNodes const& tunnelPath,
+                       double const auxiliaryValue );
+
+    // This puts the gradient of the potential at each node of pathNodes
+    // apart from the ends into nodeGradients, which must already have an
+    // element for every node. If potentialFunction has an analytic gradient,
+    // it is evaluated node by node, as that is cheaper than any finite
+    // difference. Otherwise the nodes and their displacements by
+    // gradientStep along each field are all evaluated as a single batch by
+    // EvaluateBatch, and the gradients are taken as forward differences.
+    static void
+    SetNodeGradients( PotentialFunction const& potentialFunction,
+                      double const tunnelingTemperature,
+                      double const gradientStep,
+                      std::vector< std::vector< double > > const& pathNodes,
+                      std::vector< std::vector< double > >& nodeGradients );
+
+    // This puts the normal force on the node with index nodeIndex of
+    // pathNodes into normalForce and returns the length of nodeGradient, the
+    // gradient of the potential at the node. The normal force is the
+    // gradient minus fieldSpeedSquared times the curvature of the path at
+    // the node, with the component along the path projected out.
+    static double
+    NormalForce( std::vector< std::vector< double > > const& pathNodes,
+                 size_t const nodeIndex,
+                 std::vector< double > const& nodeGradient,
+                 double const fieldSpeedSquared,
+                 Eigen::VectorXd& normalForce );
+  };
+
+} /* namespace VevaciousPlusPlus */
+#endif /* PATHDEFORMATIONTUNNELER_HPP_ */
@@ -33,10 +33,13 @@ namespace VevaciousPlusPlus
       quantumSurvivalProbability( -1.0 ),
       logOfMinusLogOfQuantumProbability( -1.0E+100 ),
       quantumLifetimeInSeconds( -1.0 ),
+      quantumBounceAction( -1.0 ),
       thermalSurvivalProbability( -1.0 ),
       logOfMinusLogOfThermalProbability( -1.0E+100 ),
       dominantTemperatureInGigaElectronVolts( -1.0 ),
-      survivalProbabilityThreshold( survivalProbabilityThreshold ) {}
+      survivalProbabilityThreshold( survivalProbabilityThreshold ),
+      bubbleProfileCacheHits( -1 ),
+      bubbleProfileCacheMisses( -1 ) {}
 
     virtual ~TunnelingCalculator() {}
 
@@ -64,6 +67,11 @@ namespace VevaciousPlusPlus
     double QuantumLifetimeInSeconds() const
     { return quantumLifetimeInSeconds; }
 
+    // This returns the bounce action for tunneling at zero temperature, if
+    // the calculator calculates one and it was calculated by the last call
+    // of CalculateTunneling, or -1.0 otherwise.
+    double QuantumBounceAction() const { return quantumBounceAction; }
+
     double ThermalSurvivalProbability() const
     { return thermalSurvivalProbability; }
 
@@ -76,16 +84,29 @@ namespace VevaciousPlusPlus
     double SurvivalProbabilityThreshold() const
     { return survivalProbabilityThreshold; }
 
+    // This returns how many bubble profiles were found in a cache rather than
+    // calculated during the last call of CalculateTunneling, or a negative
+    // number if no cache was used.
+    long BubbleProfileCacheHits() const { return bubbleProfileCacheHits; }
+
+    // This returns how many bubble profiles were looked for in a cache but
+    // had to be calculated during the last call of CalculateTunneling, or a
+    // negative number if no cache was used.
+    long BubbleProfileCacheMisses() const { return bubbleProfileCacheMisses; }
+
 
   protected:
     TunnelingStrategy tunnelingStrategy;
     double quantumSurvivalProbability;
     double logOfMinusLogOfQuantumProbability;
     double quantumLifetimeInSeconds;
+    double quantumBounceAction;
     double thermalSurvivalProbability;
     double logOfMinusLogOfThermalProbability;
     double dominantTemperatureInGigaElectronVolts;
     double survivalProbabilityThreshold;
+    long bubbleProfileCacheHits;
+    long bubbleProfileCacheMisses;
   };
 
 } /* namespace VevaciousPlusPlus */
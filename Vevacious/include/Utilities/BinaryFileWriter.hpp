@@ -0,0 +1,63 @@
+/*
+ * BinaryFileWriter.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef BINARYFILEWRITER_HPP_
+#define BINARYFILEWRITER_HPP_
+
+#include <string>
+#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <fstream>
+#include <unistd.h>
+
+namespace VevaciousPlusPlus
+{
+  // This class builds up the bytes of a binary file in memory, to be read
+  // back in the same order by a MappedFileReader, and then writes them to a
+  // file in one go. The file is written under a temporary name which is then
+  // renamed to the proper name, so that other processes or threads reading
+  // the file never see it half-written, and if several write the same file at
+  // once, one complete version wins.
+  class BinaryFileWriter
+  {
+  public:
+    BinaryFileWriter();
+    virtual ~BinaryFileWriter();
+
+
+    // This appends the bytes of valueToAppend. It should only be used for
+    // plain types such as integers and floating-point numbers.
+    template< typename ValueType >
+    void AppendValue( ValueType const valueToAppend )
+    { fileBytes.append( reinterpret_cast< char const* >( &valueToAppend ),
+                        sizeof( ValueType ) ); }
+
+    // This appends the length of stringToAppend followed by its characters.
+    void AppendString( std::string const& stringToAppend )
+    { AppendValue< std::uint64_t >( stringToAppend.size() );
+      fileBytes.append( stringToAppend ); }
+
+    // This writes all the appended bytes to fileName, returning false if the
+    // file could not be written, for example if the folder is read-only.
+    bool WriteFile( std::string const& fileName ) const;
+
+
+  protected:
+    std::string fileBytes;
+
+
+    // This returns a tag made of the process ID and a count of the calls to
+    // this function, so that temporary files from different processes or
+    // threads do not clash.
+    static std::string UniqueTemporaryTag();
+  };
+
+} /* namespace VevaciousPlusPlus */
+#endif /* BINARYFILEWRITER_HPP_ */
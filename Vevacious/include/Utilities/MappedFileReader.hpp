@@ -0,0 +1,172 @@
+/*
+ * MappedFileReader.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef MAPPEDFILEREADER_HPP_
+#define MAPPEDFILEREADER_HPP_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace VevaciousPlusPlus
+{
+  // This class maps a file into memory read-only with mmap, so that it can be
+  // read without copying the whole file into a buffer first. It can hash the
+  // bytes of the file, and it can read values in sequence as they were
+  // written by a BinaryFileWriter. Reading past the end of the file throws an
+  // exception, so that a truncated file is noticed.
+  class MappedFileReader
+  {
+  public:
+    // This is the offset basis for the 64-bit FNV-1a hash.
+    static std::uint64_t const initialHash;
+
+    MappedFileReader( std::string const& fileName );
+    virtual ~MappedFileReader();
+
+
+    // This returns true if the file could be opened and mapped.
+    bool IsMapped() const { return ( mappedBytes != NULL ); }
+
+    // This returns the number of bytes of the file.
+    size_t FileSize() const { return fileSize; }
+
+    // This returns true if every byte of the file has been read.
+    bool AtEnd() const { return !( readPosition < fileSize ); }
+
+    // This returns the 64-bit FNV-1a hash of all the bytes of the file,
+    // continuing from hashSoFar.
+    std::uint64_t
+    ContentHash( std::uint64_t const hashSoFar = initialHash ) const
+    { return HashBytes( mappedBytes,
+                        fileSize,
+                        hashSoFar ); }
+
+    // This copies the next sizeof( ValueType ) bytes into a ValueType and
+    // returns it. It should only be used for plain types such as integers and
+    // floating-point numbers.
+    template< typename ValueType >
+    ValueType ReadValue();
+
+    // This reads a length followed by that many characters.
+    std::string ReadString();
+
+    // This reads a count of elements which each take up at least
+    // minimumBytesPerElement bytes in the file, throwing an exception if
+    // there are not enough bytes left for that many elements, so that a
+    // corrupt count is noticed before the caller sizes anything with it.
+    size_t ReadCount( size_t const minimumBytesPerElement );
+
+    // This throws an exception if there are not enough bytes left for
+    // numberOfElements elements which each take up at least
+    // minimumBytesPerElement bytes.
+    void CheckCount( size_t const numberOfElements,
+                     size_t const minimumBytesPerElement ) const;
+
+    // This returns the 64-bit FNV-1a hash of numberOfBytes bytes starting at
+    // bytesToHash, continuing from hashSoFar.
+    static std::uint64_t HashBytes( char const* bytesToHash,
+                                    size_t const numberOfBytes,
+                                    std::uint64_t hashSoFar = initialHash );
+
+
+  protected:
+    char const* mappedBytes;
+    size_t fileSize;
+    size_t readPosition;
+
+
+    // This throws an exception if there are fewer than numberOfBytes bytes
+    // left to read.
+    void CheckRemainingBytes( size_t const numberOfBytes ) const;
+  };
+
+
+
+
+
+  // This copies the next sizeof( ValueType ) bytes into a ValueType and
+  // returns it. It should only be used for plain types such as integers and
+  // floating-point numbers.
+  template< typename ValueType >
+  inline ValueType MappedFileReader::ReadValue()
+  {
+    CheckRemainingBytes( sizeof( ValueType ) );
+    // The bytes are copied rather than cast, as there is no guarantee that
+    // they are aligned for ValueType.
+    ValueType readValue;
+    memcpy( &readValue,
+            ( mappedBytes + readPosition ),
+            sizeof( ValueType ) );
+    readPosition += sizeof( ValueType );
+    return readValue;
+  }
+
+  // This reads a length followed by that many characters.
+  inline std::string MappedFileReader::ReadString()
+  {
+    size_t const stringLength( ReadValue< std::uint64_t >() );
+    CheckRemainingBytes( stringLength );
+    std::string readString( ( mappedBytes + readPosition ),
+                            stringLength );
+    readPosition += stringLength;
+    return readString;
+  }
+
+  // This reads a count of elements which each take up at least
+  // minimumBytesPerElement bytes in the file, throwing an exception if there
+  // are not enough bytes left for that many elements, so that a corrupt count
+  // is noticed before the caller sizes anything with it.
+  inline size_t
+  MappedFileReader::ReadCount( size_t const minimumBytesPerElement )
+  {
+    size_t const numberOfElements( ReadValue< std::uint64_t >() );
+    CheckCount( numberOfElements,
+                minimumBytesPerElement );
+    return numberOfElements;
+  }
+
+  // This throws an exception if there are not enough bytes left for
+  // numberOfElements elements which each take up at least
+  // minimumBytesPerElement bytes.
+  inline void
+  MappedFileReader::CheckCount( size_t const numberOfElements,
+                                size_t const minimumBytesPerElement ) const
+  {
+    // Dividing rather than multiplying avoids overflow for huge counts.
+    if( ( minimumBytesPerElement > 0 )
+        &&
+        ( numberOfElements
+          > ( ( fileSize - readPosition ) / minimumBytesPerElement ) ) )
+    {
+      throw std::runtime_error( "Count is too large for mapped file!" );
+    }
+  }
+
+  // This throws an exception if there are fewer than numberOfBytes bytes
+  // left to read.
+  inline void
+  MappedFileReader::CheckRemainingBytes( size_t const numberOfBytes ) const
+  {
+    if( ( mappedBytes == NULL )
+        ||
+        ( numberOfBytes > ( fileSize - readPosition ) ) )
+    {
+      throw std::runtime_error( "Tried to read past end of mapped file!" );
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* MAPPEDFILEREADER_HPP_ */
@@ -0,0 +1,150 @@
+/*
+ * PerformanceLogger.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef PERFORMANCELOGGER_HPP_
+#define PERFORMANCELOGGER_HPP_
+
+#include "Utilities/PerformanceRecord.hpp"
+#include <cstddef>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace VevaciousPlusPlus
+{
+  // This passes counts, histogram values and times on to the
+  // PerformanceRecord of the parameter point being run, in the same way as
+  // WarningLogger passes on warnings: each thread has its own record, so that
+  // several VevaciousPlusPlus objects can run on separate threads at the same
+  // time, and the record set outside of any parallel region is also used by
+  // threads which have not set their own record. If no record has been set,
+  // nothing is recorded.
+  class PerformanceLogger
+  {
+  public:
+    // This adds the time between its construction and its destruction to a
+    // timer of the record which was current when it was constructed.
+    class ScopedTimer
+    {
+    public:
+      ScopedTimer( PerformanceRecord::TimerName const whichTimer ) :
+        performanceRecord( CurrentRecord() ),
+        whichTimer( whichTimer ),
+        startTime( PerformanceRecord::PerformanceClock::now() ) {}
+
+      ~ScopedTimer()
+      { if( performanceRecord != NULL )
+        { performanceRecord->AddTime( whichTimer,
+                                ( PerformanceRecord::PerformanceClock::now()
+                                  - startTime ) ); } }
+
+
+    protected:
+      PerformanceRecord* const performanceRecord;
+      PerformanceRecord::TimerName const whichTimer;
+      PerformanceRecord::PerformanceClock::time_point const startTime;
+    };
+
+
+    // This sets performanceRecord as the record for the calling thread (and
+    // for threads without their own record if not constructed within a
+    // parallel region) on construction, and on destruction, even if an
+    // exception is being thrown, unsets it again and then merges the
+    // counters of all the threads into it.
+    class ScopedRecord
+    {
+    public:
+      ScopedRecord( PerformanceRecord& performanceRecord ) :
+        performanceRecord( performanceRecord )
+      { SetPerformanceRecord( &performanceRecord ); }
+
+      ~ScopedRecord()
+      { SetPerformanceRecord( NULL );
+        performanceRecord.MergeThreadCounters(); }
+
+
+    protected:
+      PerformanceRecord& performanceRecord;
+    };
+
+
+    // This sets the record for the calling thread, and also for threads
+    // without their own record if not called from within a parallel region.
+    static void
+    SetPerformanceRecord( PerformanceRecord* const performanceDestination );
+
+    // This returns the record for the calling thread, which may be NULL.
+    static PerformanceRecord* CurrentRecord()
+    { return ( ( threadPerformanceRecord != NULL ) ?
+               threadPerformanceRecord : sharedPerformanceRecord ); }
+
+    // This adds incrementAmount to the counter whichCounter of the current
+    // record.
+    static void
+    IncrementCounter( PerformanceRecord::CounterName const whichCounter,
+                      long long const incrementAmount = 1 );
+
+    // This adds 1 to the bin of whichHistogram of the current record which
+    // covers recordedValue.
+    static void
+    AddToHistogram( PerformanceRecord::HistogramName const whichHistogram,
+                    unsigned long long const recordedValue );
+
+
+  private:
+    static PerformanceRecord* sharedPerformanceRecord;
+    static thread_local PerformanceRecord* threadPerformanceRecord;
+  };
+
+
+
+
+  // This sets the record for the calling thread, and also for threads
+  // without their own record if not called from within a parallel region.
+  inline void PerformanceLogger::SetPerformanceRecord(
+                              PerformanceRecord* const performanceDestination )
+  {
+    threadPerformanceRecord = performanceDestination;
+#ifdef _OPENMP
+    if( omp_in_parallel() )
+    {
+      return;
+    }
+#endif
+    sharedPerformanceRecord = performanceDestination;
+  }
+
+  // This adds incrementAmount to the counter whichCounter of the current
+  // record.
+  inline void PerformanceLogger::IncrementCounter(
+                             PerformanceRecord::CounterName const whichCounter,
+                                              long long const incrementAmount )
+  {
+    PerformanceRecord* const performanceRecord( CurrentRecord() );
+    if( performanceRecord != NULL )
+    {
+      performanceRecord->IncrementCounter( whichCounter,
+                                           incrementAmount );
+    }
+  }
+
+  // This adds 1 to the bin of whichHistogram of the current record which
+  // covers recordedValue.
+  inline void PerformanceLogger::AddToHistogram(
+                         PerformanceRecord::HistogramName const whichHistogram,
+                                      unsigned long long const recordedValue )
+  {
+    PerformanceRecord* const performanceRecord( CurrentRecord() );
+    if( performanceRecord != NULL )
+    {
+      performanceRecord->AddToHistogram( whichHistogram,
+                                         recordedValue );
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* PERFORMANCELOGGER_HPP_ */
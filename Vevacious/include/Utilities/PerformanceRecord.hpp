@@ -0,0 +1,235 @@
+/*
+ * PerformanceRecord.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef PERFORMANCERECORD_HPP_
+#define PERFORMANCERECORD_HPP_
+
+#include <string>
+#include <sstream>
+#include <cstddef>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <iomanip>
+
+namespace VevaciousPlusPlus
+{
+  // This class holds the counters, histograms and timers for a single
+  // parameter point. The histogram bins and summed times are atomic so that
+  // they can be added to from several threads at once, such as minimizations
+  // from different starting points running in parallel. The counters are
+  // incremented far more often, for example for every evaluation of the
+  // potential, so each thread counts into a block of its own, padded so
+  // that no two threads write to the same cache line, and the blocks are
+  // only added together by MergeThreadCounters once no thread is counting
+  // any more. The times of the stages of the point are wall-clock times,
+  // while the other times are summed over all the threads which contributed
+  // to them, so may add up to more than the stage in which they happened.
+  class PerformanceRecord
+  {
+  public:
+    typedef std::chrono::steady_clock PerformanceClock;
+
+    enum StageName
+    {
+      PotentialMinimizationStage,
+      TunnelingCalculationStage,
+      WholePointStage,
+      NumberOfStages
+    };
+
+    enum CounterName
+    {
+      PotentialEvaluations,
+      GradientEvaluations,
+      MigradCalls,
+      PolynomialSystemsSolved,
+      HomotopySolutions,
+      BounceActionCalculations,
+      PathFinderIterations,
+      BubbleProfiles,
+      ShootingAttempts,
+      NumberOfCounters
+    };
+
+    enum HistogramName
+    {
+      FunctionCallsPerMigrad,
+      PathFinderIterationsPerBounceAction,
+      ShootingAttemptsPerBubbleProfile,
+      NumberOfHistograms
+    };
+
+    enum TimerName
+    {
+      MigradTimer,
+      PolynomialSystemSolverTimer,
+      BounceActionTimer,
+      BubbleShootingTimer,
+      NumberOfTimers
+    };
+
+    // The histogram bins are in powers of 2: bin 0 counts zeroes, and bin n
+    // counts values from 2^(n-1) to (2^n)-1, except that the last bin also
+    // counts all larger values.
+    static size_t const numberOfHistogramBins = 32;
+
+    PerformanceRecord();
+    virtual ~PerformanceRecord();
+
+
+    // This sets all the counters, histogram bins and times back to zero.
+    void Reset();
+
+    // This records stageDuration as the wall-clock time of whichStage.
+    void SetStageTime( StageName const whichStage,
+                       PerformanceClock::duration const stageDuration )
+    { stageNanoseconds[ whichStage ].store( std::chrono::duration_cast<
+                                 std::chrono::nanoseconds >( stageDuration
+                                                                ).count() ); }
+
+    // This adds incrementAmount to the counter whichCounter in the block of
+    // the calling thread, without any synchronization with other threads.
+    void IncrementCounter( CounterName const whichCounter,
+                           long long const incrementAmount = 1 );
+
+    // This adds the counts of all the threads to the counters and starts
+    // new blocks for any further counts. It must not be called while any
+    // thread might be counting into this record.
+    void MergeThreadCounters();
+
+    // This adds 1 to the bin of whichHistogram which covers recordedValue.
+    void AddToHistogram( HistogramName const whichHistogram,
+                         unsigned long long const recordedValue )
+    { histogramBins[ whichHistogram ][ BinForValue( recordedValue )
+                     ].fetch_add( 1,
+                                  std::memory_order_relaxed ); }
+
+    // This adds elapsedTime to the summed time of whichTimer.
+    void AddTime( TimerName const whichTimer,
+                  PerformanceClock::duration const elapsedTime )
+    { timerNanoseconds[ whichTimer ].fetch_add(
+           std::chrono::duration_cast< std::chrono::nanoseconds >( elapsedTime
+                                                                  ).count(),
+                                                std::memory_order_relaxed ); }
+
+    // This returns the wall-clock time of whichStage in seconds.
+    double StageSeconds( StageName const whichStage ) const
+    { return ( 1.0e-9 * stageNanoseconds[ whichStage ].load() ); }
+
+    // This returns the value of the counter whichCounter, which only includes
+    // the counts made up to the last call of MergeThreadCounters.
+    long long CounterValue( CounterName const whichCounter ) const
+    { return counterValues[ whichCounter ]; }
+
+    // This returns the summed time of whichTimer in seconds.
+    double TimerSeconds( TimerName const whichTimer ) const
+    { return ( 1.0e-9 * timerNanoseconds[ whichTimer ].load() ); }
+
+    // This returns the record as a <Performance> element for the results XML,
+    // with each line indented by indentationSpaces spaces.
+    std::string AsXmlElement( int const indentationSpaces = 2 ) const;
+
+    // This returns the record as a single line of JSON (without the newline
+    // at the end), with pointName as the value of the "point" member.
+    std::string AsJsonLine( std::string const& pointName ) const;
+
+
+  protected:
+    static char const* const stageNames[ NumberOfStages ];
+    static char const* const counterNames[ NumberOfCounters ];
+    static char const* const histogramNames[ NumberOfHistograms ];
+    static char const* const timerNames[ NumberOfTimers ];
+
+    // The counters of a single thread are padded on both sides by a whole
+    // cache line so that they never share a cache line with the counters of
+    // another thread, whichever addresses they are given.
+    static size_t const cacheLineBytes = 64;
+    struct ThreadCounters
+    {
+      char leadingPadding[ cacheLineBytes ];
+      long long counterValues[ NumberOfCounters ];
+      char trailingPadding[ cacheLineBytes ];
+    };
+
+    // Each Reset or MergeThreadCounters of any record gives the record a new
+    // generation from lastGeneration, so that each thread can tell from the
+    // generation of its cached block whether the block still belongs to the
+    // record which it is counting into.
+    static std::atomic< unsigned long long > lastGeneration;
+    static thread_local unsigned long long cachedGeneration;
+    static thread_local long long* cachedCounterValues;
+
+    std::atomic< long long > stageNanoseconds[ NumberOfStages ];
+    long long counterValues[ NumberOfCounters ];
+    std::atomic< long long >
+    histogramBins[ NumberOfHistograms ][ numberOfHistogramBins ];
+    std::atomic< long long > timerNanoseconds[ NumberOfTimers ];
+    std::vector< std::unique_ptr< ThreadCounters > > threadCounterBlocks;
+    unsigned long long recordGeneration;
+
+
+    // This adds a new block of counters for the calling thread, starting at
+    // zero, and returns a pointer to its counters.
+    long long* NewThreadCounters();
+
+    // This drops the blocks of counters of all the threads and gives the
+    // record a new generation. It should only be called from within the
+    // critical section for the blocks.
+    void DropThreadCounters();
+
+
+    // This returns the index of the histogram bin which covers
+    // recordedValue.
+    static size_t BinForValue( unsigned long long recordedValue );
+
+    // This returns the range of values covered by the histogram bin with
+    // index binIndex as a string such as "4-7", or "1073741824+" for the last
+    // bin.
+    static std::string BinRange( size_t const binIndex );
+
+    // This returns stringToEscape with backslashes, quotes and control
+    // characters escaped for use as a JSON string.
+    static std::string JsonEscaped( std::string const& stringToEscape );
+  };
+
+
+
+
+
+  // This adds incrementAmount to the counter whichCounter in the block of the
+  // calling thread, without any synchronization with other threads.
+  inline void
+  PerformanceRecord::IncrementCounter( CounterName const whichCounter,
+                                       long long const incrementAmount )
+  {
+    if( cachedGeneration != recordGeneration )
+    {
+      cachedCounterValues = NewThreadCounters();
+      cachedGeneration = recordGeneration;
+    }
+    cachedCounterValues[ whichCounter ] += incrementAmount;
+  }
+
+  // This returns the index of the histogram bin which covers recordedValue.
+  inline size_t
+  PerformanceRecord::BinForValue( unsigned long long recordedValue )
+  {
+    size_t binIndex( 0 );
+    while( ( recordedValue > 0 )
+           &&
+           ( binIndex < ( numberOfHistogramBins - 1 ) ) )
+    {
+      recordedValue >>= 1;
+      ++binIndex;
+    }
+    return binIndex;
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* PERFORMANCERECORD_HPP_ */
@@ -0,0 +1,153 @@
+/*
+ * ScanWorkQueue.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#ifndef SCANWORKQUEUE_HPP_
+#define SCANWORKQUEUE_HPP_
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include <cstddef>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <atomic>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+
+namespace VevaciousPlusPlus
+{
+  // This class shares out the input files in a folder among any number of
+  // processes, possibly on different computers sharing the folders, so that
+  // each input file is run by only one process. A process claims an input by
+  // creating its claim file with open( O_CREAT | O_EXCL ), which only one
+  // process can do, and the claim is removed once the output file has been
+  // written. Inputs which already have their output file are skipped. A claim
+  // file which has not been touched for longer than leaseInSeconds is taken
+  // to have been left by a process which crashed, and is taken over by
+  // renaming it, which again only one process can do. The claim file is not
+  // touched again while its input is being run, so leaseInSeconds must be
+  // longer than the time taken by the slowest point, or another process will
+  // run the same input again. Each claim, recovery, and completion is
+  // appended as a line to a journal file in the output folder, so that the
+  // progress of a scan can be followed. The input folder is only listed once,
+  // and no shell commands are run.
+  class ScanWorkQueue
+  {
+  public:
+    ScanWorkQueue( std::string const& inputSuffix = "",
+                   std::string const& claimSuffix = ".claim",
+                   std::string const& outputSuffix = ".vout",
+                   double const leaseInSeconds = 86400.0 );
+    virtual ~ScanWorkQueue();
+
+
+    // This takes the names of all the files in the folder given by
+    // inputDirectory which end in inputSuffix, and prepares the names of the
+    // claim files in claimDirectory and of the output files in
+    // outputDirectory, creating those folders if they do not already exist.
+    void PrepareFilenames( std::string const& inputDirectory,
+                           std::string const& claimDirectory,
+                           std::string const& outputDirectory );
+
+    // This claims the next input which has no output file and no live claim
+    // by another process, returning false if there are no more such inputs.
+    // If the claim on the previous input was not released by
+    // FinishCurrentPoint, it is released without marking the input as
+    // finished.
+    bool ClaimNextPoint();
+
+    // This marks the currently claimed input as finished in the journal and
+    // removes its claim file. It should be called once the output file has
+    // been written.
+    void FinishCurrentPoint();
+
+    std::string const& CurrentInput() const
+    { return workItems[ currentIndex ].inputFile; }
+
+    std::string const& CurrentClaim() const
+    { return workItems[ currentIndex ].claimFile; }
+
+    std::string const& CurrentOutput() const
+    { return workItems[ currentIndex ].outputFile; }
+
+
+  protected:
+    struct WorkItem
+    {
+      std::string baseName;
+      std::string inputFile;
+      std::string claimFile;
+      std::string outputFile;
+    };
+
+    std::string const inputSuffix;
+    std::string const claimSuffix;
+    std::string const outputSuffix;
+    double const leaseInSeconds;
+    std::vector< WorkItem > workItems;
+    size_t nextIndex;
+    size_t currentIndex;
+    bool holdingClaim;
+    std::time_t claimTime;
+    std::string journalFile;
+    std::string workerName;
+
+
+    // This tries to create the claim file for workItems[ itemIndex ],
+    // recovering it from a crashed process if its lease has expired, and
+    // returns true if the claim now belongs to this process.
+    bool TryToClaim( size_t const itemIndex );
+
+    // This renames the claim file of workItems[ itemIndex ] to a name unique
+    // to this process if it has not been touched for longer than
+    // leaseInSeconds, and then deletes it, returning true if the claim file
+    // is now gone so that it is worth trying to claim the input again.
+    bool RecoverStaleClaim( size_t const itemIndex );
+
+    // This deletes the claim file of the current input if this process holds
+    // it.
+    void ReleaseCurrentClaim();
+
+    // This appends a line with the time, this worker's name, journalEntry,
+    // and baseName to the journal, with a single write so that lines from
+    // different processes are not mixed.
+    void WriteJournalEntry( std::string const& journalEntry,
+                            std::string const& baseName ) const;
+
+    // This creates the folder given by directoryName and any missing parent
+    // folders, throwing an exception if it could not.
+    static void EnsureDirectoryExists( std::string const& directoryName );
+
+    // This returns true if there is a file called fileName.
+    static bool FileExists( std::string const& fileName );
+
+    // This returns the name of the host, the process ID, and a count of the
+    // calls to this function, so that queues on different threads of the
+    // same process are told apart.
+    static std::string WorkerName();
+  };
+
+
+
+
+
+  // This returns true if there is a file called fileName.
+  inline bool ScanWorkQueue::FileExists( std::string const& fileName )
+  {
+    struct stat fileStatus;
+    return ( stat( fileName.c_str(),
+                   &fileStatus ) == 0 );
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* SCANWORKQUEUE_HPP_ */
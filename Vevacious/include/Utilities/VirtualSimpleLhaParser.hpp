@@ -31,6 +31,41 @@ namespace VevaciousPlusPlus
   class VirtualSimpleLhaParser: public LHPC::SimpleLhaParser
     {
   public:
+    // This holds the numbers of a single block at a single scale for the
+    // entries which have been registered with RegisterEntrySlot, indexed by
+    // their slots. The lines of a block are only tokenized if the block has
+    // registered entries, and each word on a line is the value of the entry
+    // with the words before it interpreted as integers as its indices. This
+    // matches the way that LHPC::LhaBlockAtSingleScale::MatchingEntry finds
+    // entries, but without having to split and convert strings every time an
+    // entry is looked up. An entry which was not found keeps a value of 0.0,
+    // as the empty string returned by the string-based look-up would give.
+    struct NumericBlock
+    {
+      NumericBlock( bool const hasExplicitScale,
+                    double const scaleValue,
+                    size_t const numberOfEntrySlots ) :
+        hasExplicitScale( hasExplicitScale ),
+        scaleValue( scaleValue ),
+        slotValues( numberOfEntrySlots,
+                    0.0 ),
+        slotIsFilled( numberOfEntrySlots,
+                      false ) {}
+
+      bool hasExplicitScale;
+      double scaleValue;
+      std::vector< double > slotValues;
+      std::vector< bool > slotIsFilled;
+    };
+
+
+    VirtualSimpleLhaParser() : LHPC::SimpleLhaParser(),
+                               numericBlockSets(),
+                               entrySlotsByBlockName(),
+                               entrySlotBlockSets() {}
+
+    virtual ~VirtualSimpleLhaParser() {}
+
    
     // This opens the file with name fileName and parses it into blocks.
     void ReadFile( std::string const& fileName );
@@ -46,7 +81,82 @@ namespace VevaciousPlusPlus
     void ReadBlock(std::string const& uppercaseBlockName, double const scale, 
     			   std::vector<std::pair<int,double>> const& parameters, 
     			   int const dimension);
-    
+
+    // This returns the slot for the entry with indices entryIndices in the
+    // blocks with name uppercaseBlockName, registering it if it has not
+    // already been registered. The value of the entry is then stored in that
+    // slot of each block with the name whenever blocks are read, so that it
+    // can be read for each new parameter point without looking up the block
+    // name or the indices.
+    size_t RegisterEntrySlot( std::string const& uppercaseBlockName,
+                              std::vector< int > const& entryIndices );
+
+    // This fills entriesAtScales with the value of the entry registered with
+    // slot entrySlot from each block with its name, paired with the scale of
+    // the block, in the same way as the operator() of LHPC::SimpleLhaParser
+    // but from the numbers stored when the blocks were read. If a block has
+    // no explicit scale, it is ignored if onlyWithExplicitScale is true, or
+    // else its entry is paired with implicitScale.
+    void NumericEntries( size_t const entrySlot,
+                   std::vector< std::pair< double, double > >& entriesAtScales,
+                         bool const onlyWithExplicitScale,
+                         double const implicitScale = 0.0 ) const;
+
+    // This fills entriesAtScales in the same way as the version which takes
+    // a slot, but for an entry which has not been registered, by tokenizing
+    // the lines of each block with name uppercaseBlockName. It is meant for
+    // once-off look-ups through a const parser.
+    void NumericEntries( std::string const& uppercaseBlockName,
+                         std::vector< int > const& entryIndices,
+                   std::vector< std::pair< double, double > >& entriesAtScales,
+                         bool const onlyWithExplicitScale,
+                         double const implicitScale = 0.0 ) const;
+
+
+  protected:
+    // The vectors of numeric blocks are in the same order as
+    // blocksInFirstInstanceReadOrder, so blockNamesToIndices gives the index
+    // for both.
+    std::vector< std::vector< NumericBlock > > numericBlockSets;
+    // The slots are registered by block name and then by indices, and for
+    // each slot, the index of the block set with its name is kept, if there
+    // is one, so that it does not have to be found by name again.
+    std::map< std::string, std::map< std::vector< int >, size_t > >
+    entrySlotsByBlockName;
+    std::vector< std::pair< bool, size_t > > entrySlotBlockSets;
+
+
+    // This fills numericBlockSets from the text of all the blocks which have
+    // been read.
+    void TokenizeBlocks();
+
+    // This fills the element of numericBlockSets at setIndex from the text of
+    // the blocks with the name of the block set at setIndex.
+    void TokenizeBlockSet( size_t const setIndex );
+
+    // This sets the elements of entrySlotBlockSets for the slots of the
+    // blocks with name uppercaseBlockName to setIndex if blockSetExists is
+    // true, or marks them as having no blocks otherwise.
+    void SetEntrySlotBlockSets( std::string const& uppercaseBlockName,
+                                bool const blockSetExists,
+                                size_t const setIndex );
+
+    // This fills the slots of numericBlock given by slotsForIndices from a
+    // single line. The value of each word is mapped to by the indices of the
+    // words before it, so lineIndices only needs to cover all but the last
+    // word of the line. A slot which is already filled is not overwritten,
+    // as the first line matching a set of indices is the one which is used.
+    static void
+    AddNumericLine( std::vector< int > const& lineIndices,
+                    std::vector< double > const& lineValues,
+            std::map< std::vector< int >, size_t > const& slotsForIndices,
+                    NumericBlock& numericBlock );
+
+    // This splits contentLine into words and puts each word interpreted as an
+    // integer into lineIndices and as a double into lineValues.
+    static void TokenizeLine( std::string const& contentLine,
+                              std::vector< int >& lineIndices,
+                              std::vector< double >& lineValues );
   };
 
   // This opens the file with name fileName and parses it into blocks.
@@ -68,6 +178,7 @@ namespace VevaciousPlusPlus
        ParseLine( readLine );
      }
      fileStream.close();
+     TokenizeBlocks();
     }
   }
   
@@ -76,6 +187,10 @@ namespace VevaciousPlusPlus
   inline void VirtualSimpleLhaParser::DeleteBlocks()
   {
    ResetForNewFile();
+   numericBlockSets.clear();
+   entrySlotBlockSets.assign( entrySlotBlockSets.size(),
+                              std::pair< bool, size_t >( false,
+                                                         0 ) );
   }
   
 // This reads a block and creates the appropriate LhaBlock object storing that value. 
@@ -90,13 +205,55 @@ namespace VevaciousPlusPlus
   { 
    currentBlockSet = BlockSetForName( uppercaseBlockName );
    currentBlock = AddNewBlockWithExplicitScale( scale );
+   // The numbers of the registered entries are also stored directly, at full
+   // precision, so that they do not have to be converted back from the text
+   // of the lines.
+   std::map< std::string, size_t >::const_iterator
+   nameToIndex( blockNamesToIndices.find( uppercaseBlockName ) );
+   if( nameToIndex == blockNamesToIndices.end() )
+   {
+     std::stringstream errorBuilder;
+     errorBuilder << "Could not find the block set for \""
+     << uppercaseBlockName << "\" after creating it.";
+     throw std::runtime_error( errorBuilder.str() );
+   }
+   numericBlockSets.resize( blocksInFirstInstanceReadOrder.size() );
+   SetEntrySlotBlockSets( uppercaseBlockName,
+                          true,
+                          nameToIndex->second );
+   std::vector< NumericBlock >&
+   numericBlocks( numericBlockSets[ nameToIndex->second ] );
+   numericBlocks.push_back( NumericBlock( true,
+                                          scale,
+                                          entrySlotBlockSets.size() ) );
+   std::map< std::string,
+             std::map< std::vector< int >, size_t > >::const_iterator
+   slotsForBlock( entrySlotsByBlockName.find( uppercaseBlockName ) );
+   std::vector< int > lineIndices( 2,
+                                   0 );
+   std::vector< double > lineValues( 3,
+                                     0.0 );
    std::string linetopushback;
+   // The values are written with 17 significant digits so that the text of
+   // the lines also holds them at full double precision.
    if (dimension == 1)
    {
      for(unsigned int currentParameter=0;currentParameter < parameters.size(); currentParameter=currentParameter+1 ) 
     {
-    linetopushback = (boost::format("%s %s") % parameters[currentParameter].first % parameters[currentParameter].second).str();  
+    linetopushback = (boost::format("%d %.17g") % parameters[currentParameter].first % parameters[currentParameter].second).str();  
     currentBlock->AddLine( linetopushback ); 
+    if( slotsForBlock != entrySlotsByBlockName.end() )
+    {
+      lineIndices.assign( 1,
+                          parameters[ currentParameter ].first );
+      lineValues.assign( 1,
+                         parameters[ currentParameter ].first );
+      lineValues.push_back( parameters[ currentParameter ].second );
+      AddNumericLine( lineIndices,
+                      lineValues,
+                      slotsForBlock->second,
+                      numericBlocks.back() );
+    }
     }
    } 
    else
@@ -107,12 +264,321 @@ namespace VevaciousPlusPlus
     {
  	row = parameters[currentParameter].first / 10; // Get first digit 
  	column= parameters[currentParameter].first % 10; // Get second digit
-    linetopushback = (boost::format("%s %s %s") %  row % column % parameters[currentParameter].second).str();  
+    linetopushback = (boost::format("%d %d %.17g") %  row % column % parameters[currentParameter].second).str();  
     currentBlock->AddLine( linetopushback ); 
+    if( slotsForBlock != entrySlotsByBlockName.end() )
+    {
+      lineIndices.assign( 1,
+                          row );
+      lineIndices.push_back( column );
+      lineValues.assign( 1,
+                         row );
+      lineValues.push_back( column );
+      lineValues.push_back( parameters[ currentParameter ].second );
+      AddNumericLine( lineIndices,
+                      lineValues,
+                      slotsForBlock->second,
+                      numericBlocks.back() );
+    }
     }
    }
   }
- 
+
+  // This returns the slot for the entry with indices entryIndices in the
+  // blocks with name uppercaseBlockName, registering it if it has not
+  // already been registered. The value of the entry is then stored in that
+  // slot of each block with the name whenever blocks are read, so that it
+  // can be read for each new parameter point without looking up the block
+  // name or the indices.
+  inline size_t VirtualSimpleLhaParser::RegisterEntrySlot(
+                                         std::string const& uppercaseBlockName,
+                                       std::vector< int > const& entryIndices )
+  {
+    std::map< std::vector< int >, size_t >&
+    slotsForIndices( entrySlotsByBlockName[ uppercaseBlockName ] );
+    std::map< std::vector< int >, size_t >::const_iterator
+    existingSlot( slotsForIndices.find( entryIndices ) );
+    if( existingSlot != slotsForIndices.end() )
+    {
+      return existingSlot->second;
+    }
+    size_t const entrySlot( entrySlotBlockSets.size() );
+    slotsForIndices.insert( std::pair< std::vector< int >, size_t >(
+                                                                  entryIndices,
+                                                               entrySlot ) );
+    std::map< std::string, size_t >::const_iterator
+    nameToIndex( blockNamesToIndices.find( uppercaseBlockName ) );
+    bool const blockSetExists( ( nameToIndex != blockNamesToIndices.end() )
+                               &&
+                           ( nameToIndex->second < numericBlockSets.size() ) );
+    entrySlotBlockSets.push_back( std::pair< bool, size_t >( blockSetExists,
+                                            ( blockSetExists ?
+                                              nameToIndex->second :
+                                              0 ) ) );
+    // Blocks which have already been read need the new slot to be filled.
+    if( blockSetExists )
+    {
+      TokenizeBlockSet( nameToIndex->second );
+    }
+    return entrySlot;
+  }
+
+  // This fills entriesAtScales with the value of the entry registered with
+  // slot entrySlot from each block with its name, paired with the scale of
+  // the block, in the same way as the operator() of LHPC::SimpleLhaParser
+  // but from the numbers stored when the blocks were read. If a block has
+  // no explicit scale, it is ignored if onlyWithExplicitScale is true, or
+  // else its entry is paired with implicitScale.
+  inline void VirtualSimpleLhaParser::NumericEntries( size_t const entrySlot,
+                   std::vector< std::pair< double, double > >& entriesAtScales,
+                                              bool const onlyWithExplicitScale,
+                                            double const implicitScale ) const
+  {
+    if( !( entrySlot < entrySlotBlockSets.size() )
+        ||
+        !(entrySlotBlockSets[ entrySlot ].first) )
+    {
+      return;
+    }
+    std::vector< NumericBlock > const&
+    numericBlocks( numericBlockSets[ entrySlotBlockSets[ entrySlot ].second ] );
+    for( std::vector< NumericBlock >::const_iterator
+         numericBlock( numericBlocks.begin() );
+         numericBlock != numericBlocks.end();
+         ++numericBlock )
+    {
+      if( !onlyWithExplicitScale
+          ||
+          numericBlock->hasExplicitScale )
+      {
+        entriesAtScales.push_back( std::pair< double, double >(
+                             ( ( entrySlot < numericBlock->slotValues.size() ) ?
+                               numericBlock->slotValues[ entrySlot ] :
+                               0.0 ),
+                                             ( numericBlock->hasExplicitScale ?
+                                               numericBlock->scaleValue :
+                                               implicitScale ) ) );
+      }
+    }
+  }
+
+  // This fills entriesAtScales in the same way as the version which takes
+  // a slot, but for an entry which has not been registered, by tokenizing
+  // the lines of each block with name uppercaseBlockName. It is meant for
+  // once-off look-ups through a const parser.
+  inline void VirtualSimpleLhaParser::NumericEntries(
+                                         std::string const& uppercaseBlockName,
+                                        std::vector< int > const& entryIndices,
+                   std::vector< std::pair< double, double > >& entriesAtScales,
+                                              bool const onlyWithExplicitScale,
+                                            double const implicitScale ) const
+  {
+    std::map< std::string, size_t >::const_iterator
+    nameToIndex( blockNamesToIndices.find( uppercaseBlockName ) );
+    if( nameToIndex == blockNamesToIndices.end() )
+    {
+      return;
+    }
+    std::map< std::vector< int >, size_t > slotsForIndices;
+    slotsForIndices.insert( std::pair< std::vector< int >, size_t >(
+                                                                  entryIndices,
+                                                                       0 ) );
+    std::vector< int > lineIndices;
+    std::vector< double > lineValues;
+    std::vector< LHPC::LhaBlockAtSingleScale > const&
+    blocksAtScales( blocksInFirstInstanceReadOrder[ nameToIndex->second
+                                                      ].BlocksInReadOrder() );
+    for( std::vector< LHPC::LhaBlockAtSingleScale >::const_iterator
+         blockAtScale( blocksAtScales.begin() );
+         blockAtScale != blocksAtScales.end();
+         ++blockAtScale )
+    {
+      if( onlyWithExplicitScale
+          &&
+          !(blockAtScale->HasExplicitScale()) )
+      {
+        continue;
+      }
+      NumericBlock numericBlock( blockAtScale->HasExplicitScale(),
+                                 blockAtScale->ScaleValue(),
+                                 1 );
+      for( std::vector< std::string >::const_iterator
+           contentLine( blockAtScale->ContentLines().begin() );
+           ( contentLine != blockAtScale->ContentLines().end() )
+           &&
+           !(numericBlock.slotIsFilled[ 0 ]);
+           ++contentLine )
+      {
+        TokenizeLine( *contentLine,
+                      lineIndices,
+                      lineValues );
+        AddNumericLine( lineIndices,
+                        lineValues,
+                        slotsForIndices,
+                        numericBlock );
+      }
+      entriesAtScales.push_back( std::pair< double, double >(
+                                                 numericBlock.slotValues[ 0 ],
+                                              ( numericBlock.hasExplicitScale ?
+                                                numericBlock.scaleValue :
+                                                implicitScale ) ) );
+    }
+  }
+
+  // This fills numericBlockSets from the text of all the blocks which have
+  // been read.
+  inline void VirtualSimpleLhaParser::TokenizeBlocks()
+  {
+    numericBlockSets.assign( blocksInFirstInstanceReadOrder.size(),
+                             std::vector< NumericBlock >() );
+    for( size_t setIndex( 0 );
+         setIndex < blocksInFirstInstanceReadOrder.size();
+         ++setIndex )
+    {
+      TokenizeBlockSet( setIndex );
+    }
+    for( std::map< std::string,
+                   std::map< std::vector< int >, size_t > >::const_iterator
+         slotsForBlock( entrySlotsByBlockName.begin() );
+         slotsForBlock != entrySlotsByBlockName.end();
+         ++slotsForBlock )
+    {
+      std::map< std::string, size_t >::const_iterator
+      nameToIndex( blockNamesToIndices.find( slotsForBlock->first ) );
+      SetEntrySlotBlockSets( slotsForBlock->first,
+                             ( nameToIndex != blockNamesToIndices.end() ),
+                             ( ( nameToIndex != blockNamesToIndices.end() ) ?
+                               nameToIndex->second :
+                               0 ) );
+    }
+  }
+
+  // This fills the element of numericBlockSets at setIndex from the text of
+  // the blocks with the name of the block set at setIndex.
+  inline void VirtualSimpleLhaParser::TokenizeBlockSet( size_t const setIndex )
+  {
+    LHPC::LhaBlockSet const&
+    blockSet( blocksInFirstInstanceReadOrder[ setIndex ] );
+    std::vector< NumericBlock >& numericBlocks( numericBlockSets[ setIndex ] );
+    numericBlocks.clear();
+    std::map< std::string,
+              std::map< std::vector< int >, size_t > >::const_iterator
+    slotsForBlock( entrySlotsByBlockName.find( blockSet.UppercaseName() ) );
+    std::vector< int > lineIndices;
+    std::vector< double > lineValues;
+    for( std::vector< LHPC::LhaBlockAtSingleScale >::const_iterator
+         blockAtScale( blockSet.BlocksInReadOrder().begin() );
+         blockAtScale != blockSet.BlocksInReadOrder().end();
+         ++blockAtScale )
+    {
+      numericBlocks.push_back( NumericBlock( blockAtScale->HasExplicitScale(),
+                                             blockAtScale->ScaleValue(),
+                                                entrySlotBlockSets.size() ) );
+      // Blocks without any registered entries do not need to be tokenized.
+      if( slotsForBlock == entrySlotsByBlockName.end() )
+      {
+        continue;
+      }
+      for( std::vector< std::string >::const_iterator
+           contentLine( blockAtScale->ContentLines().begin() );
+           contentLine != blockAtScale->ContentLines().end();
+           ++contentLine )
+      {
+        TokenizeLine( *contentLine,
+                      lineIndices,
+                      lineValues );
+        AddNumericLine( lineIndices,
+                        lineValues,
+                        slotsForBlock->second,
+                        numericBlocks.back() );
+      }
+    }
+  }
+
+  // This sets the elements of entrySlotBlockSets for the slots of the
+  // blocks with name uppercaseBlockName to setIndex if blockSetExists is
+  // true, or marks them as having no blocks otherwise.
+  inline void VirtualSimpleLhaParser::SetEntrySlotBlockSets(
+                                         std::string const& uppercaseBlockName,
+                                                   bool const blockSetExists,
+                                                    size_t const setIndex )
+  {
+    std::map< std::string,
+              std::map< std::vector< int >, size_t > >::const_iterator
+    slotsForBlock( entrySlotsByBlockName.find( uppercaseBlockName ) );
+    if( slotsForBlock == entrySlotsByBlockName.end() )
+    {
+      return;
+    }
+    for( std::map< std::vector< int >, size_t >::const_iterator
+         slotForIndices( slotsForBlock->second.begin() );
+         slotForIndices != slotsForBlock->second.end();
+         ++slotForIndices )
+    {
+      entrySlotBlockSets[ slotForIndices->second ].first = blockSetExists;
+      entrySlotBlockSets[ slotForIndices->second ].second = setIndex;
+    }
+  }
+
+  // This fills the slots of numericBlock given by slotsForIndices from a
+  // single line. The value of each word is mapped to by the indices of the
+  // words before it, so lineIndices only needs to cover all but the last
+  // word of the line. A slot which is already filled is not overwritten,
+  // as the first line matching a set of indices is the one which is used.
+  inline void VirtualSimpleLhaParser::AddNumericLine(
+                                         std::vector< int > const& lineIndices,
+                                       std::vector< double > const& lineValues,
+                 std::map< std::vector< int >, size_t > const& slotsForIndices,
+                                                   NumericBlock& numericBlock )
+  {
+    std::vector< int > entryIndices;
+    for( size_t wordIndex( 0 );
+         wordIndex < lineValues.size();
+         ++wordIndex )
+    {
+      std::map< std::vector< int >, size_t >::const_iterator
+      slotForIndices( slotsForIndices.find( entryIndices ) );
+      if( ( slotForIndices != slotsForIndices.end() )
+          &&
+          ( slotForIndices->second < numericBlock.slotValues.size() )
+          &&
+          !(numericBlock.slotIsFilled[ slotForIndices->second ]) )
+      {
+        numericBlock.slotValues[ slotForIndices->second ]
+        = lineValues[ wordIndex ];
+        numericBlock.slotIsFilled[ slotForIndices->second ] = true;
+      }
+      if( wordIndex < lineIndices.size() )
+      {
+        entryIndices.push_back( lineIndices[ wordIndex ] );
+      }
+    }
+  }
+
+  // This splits contentLine into words and puts each word interpreted as an
+  // integer into lineIndices and as a double into lineValues.
+  inline void
+  VirtualSimpleLhaParser::TokenizeLine( std::string const& contentLine,
+                                        std::vector< int >& lineIndices,
+                                        std::vector< double >& lineValues )
+  {
+    std::vector< std::string > const
+    lineWords( LHPC::ParsingUtilities::SplitBySubstrings( contentLine,
+                                 LHPC::ParsingUtilities::WhitespaceChars() ) );
+    lineIndices.clear();
+    lineValues.clear();
+    for( std::vector< std::string >::const_iterator
+         lineWord( lineWords.begin() );
+         lineWord != lineWords.end();
+         ++lineWord )
+    {
+      lineIndices.push_back(
+                    LHPC::ParsingUtilities::BaseTenStringToInt( *lineWord ) );
+      lineValues.push_back(
+                        LHPC::ParsingUtilities::StringToDouble( *lineWord ) );
+    }
+  }
+
 } /* namespace VevaciousPlusPlus */
 
 #endif /* VIRTUALSIMPLELHAPARSER_HPP_ */
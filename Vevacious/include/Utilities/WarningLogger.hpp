@@ -14,43 +14,87 @@
 #include <sstream>
 #include <cstddef>
 #include <iomanip>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace VevaciousPlusPlus
 {
 
+  // Each thread has its own record for warnings, so that several
+  // VevaciousPlusPlus objects can run on separate threads at the same time,
+  // each recording its own warnings. The record set outside of any parallel
+  // region is also used by threads which have not set their own record, so
+  // that warnings from the threads of parallel loops within a single
+  // VevaciousPlusPlus object still reach its record.
   class WarningLogger
   {
   public:
+    // This sets warningMessages as the record for warnings on construction
+    // in the same way as SetWarningRecord, and unsets it again on
+    // destruction, even if an exception is being thrown.
+    class ScopedRecord
+    {
+    public:
+      ScopedRecord( std::vector< std::string >& warningMessages )
+      { SetWarningRecord( &warningMessages ); }
+
+      ~ScopedRecord() { SetWarningRecord( NULL ); }
+    };
+
+
+    // This sets the record for warnings logged by the calling thread, and
+    // also for threads without their own record if not called from within a
+    // parallel region.
     static void
     SetWarningRecord( std::vector< std::string >* const warningDestination );
 
     // This prints the warning to std::cout and also stores it for later
-    // recall.
+    // recall. Warnings may be logged from several threads at once, so this is
+    // done in a critical section.
     static void LogWarning( std::string const& warningMessage );
 
 
   private:
-    static std::vector< std::string >* warningMessages;
+    static std::vector< std::string >* sharedWarningMessages;
+    static thread_local std::vector< std::string >* threadWarningMessages;
   };
 
 
 
 
+  // This sets the record for warnings logged by the calling thread, and also
+  // for threads without their own record if not called from within a
+  // parallel region.
   inline void WarningLogger::SetWarningRecord(
                          std::vector< std::string >* const warningDestination )
   {
-    warningMessages = warningDestination;
+    threadWarningMessages = warningDestination;
+#ifdef _OPENMP
+    if( omp_in_parallel() )
+    {
+      return;
+    }
+#endif
+    sharedWarningMessages = warningDestination;
   }
 
   // This prints the warning to std::cout and also stores it for later
-  // recall.
+  // recall. Warnings may be logged from several threads at once, so this is
+  // done in a critical section.
   inline void WarningLogger::LogWarning( std::string const& warningMessage )
   {
-    if( warningMessages != NULL )
+    std::vector< std::string >* const
+    warningMessages( ( threadWarningMessages != NULL ) ?
+                     threadWarningMessages : sharedWarningMessages );
+#pragma omp critical( WarningLogging )
     {
-      warningMessages->push_back( warningMessage );
+      if( warningMessages != NULL )
+      {
+        warningMessages->push_back( warningMessage );
+      }
+      std::cout << "Warning: " << warningMessage << std::endl;
     }
-    std::cout << "Warning: " << warningMessage << std::endl;
   }
 
 }
@@ -24,10 +24,12 @@
 #include "PotentialMinimization/StartingPointGeneration/PolynomialSystemSolver.hpp"
 #include "PotentialMinimization/HomotopyContinuation/Hom4ps2Runner.hpp"
 #include "PotentialMinimization/HomotopyContinuation/PHCRunner.hpp"
+#include "PotentialMinimization/HomotopyContinuation/TotalDegreeHomotopySolver.hpp"
 #include "PotentialMinimization/GradientMinimizer.hpp"
 #include "PotentialEvaluation/PotentialFunction.hpp"
 #include "PotentialMinimization/GradientBasedMinimization/MinuitPotentialMinimizer.hpp"
 #include "TunnelingCalculation/BounceActionTunneling/CosmoTransitionsRunner.hpp"
+#include "TunnelingCalculation/BounceActionTunneling/PathDeformationTunneler.hpp"
 #include "TunnelingCalculation/BounceActionTunneling/BounceAlongPathWithThreshold.hpp"
 #include "BounceActionEvaluation/BouncePathFinder.hpp"
 #include "BounceActionEvaluation/BounceActionPathFinding/MinuitOnPotentialOnParallelPlanes.hpp"
@@ -41,9 +43,14 @@
 #include <sstream>
 #include <stdexcept>
 #include "Utilities/WarningLogger.hpp"
+#include "Utilities/PerformanceRecord.hpp"
+#include "Utilities/PerformanceLogger.hpp"
+#include <chrono>
 #include <iostream>
 #include <vector>
 #include <cstddef>
+#include <algorithm>
+#include <exception>
 #include "LagrangianParameterManagement/SlhaCompatibleWithSarahManager.hpp"
 #include "LagrangianParameterManagement/SlhaBlocksWithSpecialCasesManager.hpp"
 #include "LagrangianParameterManagement/SARAHManager.hpp"
@@ -85,6 +92,17 @@ namespace VevaciousPlusPlus
     // allowing non-C++11-compliant compilers.
     VevaciousPlusPlus( std::string const& initializationFileName );
 
+    // This reads the initialization file in the same way as the constructor
+    // which only takes initializationFileName, but rather than reading the
+    // model file again, it copies the potential function of modelSource,
+    // binding the copy to a new Lagrangian parameter manager of its own, so
+    // that each of several objects running points on different threads has
+    // its own parameters while the model file is only parsed once.
+    // modelSource must have been created from an initialization file with
+    // the same potential function initialization file, and is not changed.
+    VevaciousPlusPlus( std::string const& initializationFileName,
+                       VevaciousPlusPlus const& modelSource );
+
     virtual ~VevaciousPlusPlus();
 
 
@@ -119,18 +137,45 @@ namespace VevaciousPlusPlus
     void AppendResultsToLhaFile( std::string const& lhaFilename,
                                  bool const writeWarnings = true );
 
+    // This gives the counters, histograms and timers of the last run.
+    PerformanceRecord const& LastRunPerformance() const
+    { return performanceRecord; }
+
+    // This sets the name of the file to which a line of JSON with the
+    // performance record of each run is appended. If it is empty, no JSON is
+    // written.
+    void SetPerformanceJsonFile( std::string const& jsonFilename )
+    { performanceJsonFilename = jsonFilename; }
+
 
   protected:
+    // This is used to order panic vacua by depth, deepest first, or by
+    // distance from the DSB vacuum, closest first.
+    enum PanicVacuumOrdering
+    {
+      OrderByDepth,
+      OrderByDistance
+    };
+
     typedef PotentialFromPolynomialWithMasses OneLoopPotential;
     typedef std::pair<std::unique_ptr <LesHouchesAccordBlockEntryManager>, std::unique_ptr <PotentialFromPolynomialWithMasses> >
             FullPotentialDescription;
 
     // This creates a new LagrangianParameterManager and a new
     // PotentialFunction according to the XML elements in the file given by
-    // potentialFunctionInitializationFilename and returns pointers to them.
-    static FullPotentialDescription CreateFullPotentialDescription(
+    // potentialFunctionInitializationFilename and returns pointers to them,
+    // recording their classes and the arguments of the manager so that
+    // CopyFullPotentialDescription can make copies of them.
+    FullPotentialDescription CreateFullPotentialDescription(
                   std::string const& potentialFunctionInitializationFilename );
 
+    // This creates a new LagrangianParameterManager of the same class and
+    // with the same arguments as that of modelSource, and a copy of the
+    // PotentialFunction of modelSource which is bound to the new manager, and
+    // returns pointers to them.
+    FullPotentialDescription
+    CopyFullPotentialDescription( VevaciousPlusPlus const& modelSource );
+
     // This reads the current element of outerParser and if its name matches
     // elementName, it puts the contents of the child element <ClassType> into
     // className and <ConstructorArguments> into constructorArguments, both
@@ -162,6 +207,14 @@ namespace VevaciousPlusPlus
                              std::string const& constructorArguments,
                       LagrangianParameterManager& lagrangianParameterManager );
 
+    // This creates a copy of potentialToCopy, which must be of the class
+    // given by classChoice, bound to lagrangianParameterManager, and returns
+    // a pointer to it.
+    static std::unique_ptr<PotentialFromPolynomialWithMasses>
+    CreatePotentialFunction( std::string const& classChoice,
+                      PotentialFromPolynomialWithMasses const& potentialToCopy,
+                      LagrangianParameterManager& lagrangianParameterManager );
+
     // This puts the content of the current element of xmlParser into
     // contentDestination, interpreted as a double represented in ASCII, if the
     // element's name matches elementName.
@@ -237,6 +290,11 @@ namespace VevaciousPlusPlus
     static std::unique_ptr<PHCRunner>
     CreatePHCRunner( std::string const& constructorArguments );
 
+    // This creates a new TotalDegreeHomotopySolver based on the given
+    // arguments and returns a pointer to it.
+    static std::unique_ptr<TotalDegreeHomotopySolver>
+    CreateTotalDegreeHomotopySolver( std::string const& constructorArguments );
+
     // This creates a new GradientMinimizer based on the given arguments and
     // returns a pointer to it.
     static std::unique_ptr<GradientMinimizer>
@@ -267,6 +325,11 @@ namespace VevaciousPlusPlus
     static std::unique_ptr<CosmoTransitionsRunner>
     CreateCosmoTransitionsRunner( std::string const& constructorArguments );
 
+    // This creates a new PathDeformationTunneler based on the given arguments
+    // and returns a pointer to it.
+    static std::unique_ptr<PathDeformationTunneler>
+    CreatePathDeformationTunneler( std::string const& constructorArguments );
+
     // This throws an exception if the survival probability threshold was
     // outside the range for a valid probability.
     static void CheckSurvivalProbabilityThreshold(
@@ -316,12 +379,86 @@ namespace VevaciousPlusPlus
 
     std::unique_ptr<LagrangianParameterManager> lagrangianParameterManager;
     std::unique_ptr<PotentialFromPolynomialWithMasses> ownedPotentialFunction;
+    // The classes of lagrangianParameterManager and ownedPotentialFunction
+    // and the arguments of lagrangianParameterManager are kept so that copies
+    // can be made for other VevaciousPlusPlus objects. They are empty if
+    // potentialMinimizer was given to the constructor.
+    std::string lagrangianParameterManagerClass;
+    std::string lagrangianParameterManagerArguments;
+    std::string potentialFunctionClass;
     std::unique_ptr<PotentialMinimizer> potentialMinimizer;
     std::unique_ptr<TunnelingCalculator> tunnelingCalculator;
+    // The class and constructor arguments of tunnelingCalculator are kept so
+    // that more instances can be created when tunneling to more than one
+    // panic vacuum. They are empty if tunnelingCalculator was given to the
+    // constructor, in which case only PanicVacuum() of potentialMinimizer is
+    // tunneled to.
+    std::string tunnelingClassChoice;
+    std::string tunnelingConstructorArguments;
+    // If numberOfPanicVacuaToTunnelTo is 1, just PanicVacuum() of
+    // potentialMinimizer is tunneled to, otherwise the first
+    // numberOfPanicVacuaToTunnelTo of the panic vacua ordered by
+    // panicVacuumOrdering are, or all of them if it is 0.
+    unsigned int numberOfPanicVacuaToTunnelTo;
+    PanicVacuumOrdering panicVacuumOrdering;
+    // Tunneling to tunnelingTargets[ 0 ] is calculated by
+    // tunnelingCalculator and to tunnelingTargets[ i ] for i > 0 by
+    // additionalTunnelingCalculators[ i - 1 ], each calculator keeping its
+    // own state so that the channels can be calculated at the same time.
+    std::vector< std::unique_ptr<TunnelingCalculator> >
+    additionalTunnelingCalculators;
+    std::vector< PotentialMinimum > tunnelingTargets;
+    size_t fastestQuantumChannel;
+    size_t fastestThermalChannel;
     std::vector< std::string > warningMessagesFromConstructor;
     std::string resultsFromLastRunAsXml;
     std::vector< std::string > warningMessagesFromLastRun;
+    // The counters, histograms and timers for the last run are recorded in
+    // performanceRecord, which is also appended as a line of JSON to the file
+    // named by performanceJsonFilename after each run, unless it is empty.
+    PerformanceRecord performanceRecord;
+    std::string performanceJsonFilename;
+
+
+    // This reads the initialization file given by initializationFileName and
+    // creates the components which it specifies, copying the potential
+    // function of modelSource rather than reading the model file if
+    // modelSource is not NULL.
+    void AssembleFromInitializationFile(
+                                    std::string const& initializationFileName,
+                               VevaciousPlusPlus const* const modelSource );
+
+    // This reads <TunnelingClass>, <NumberOfPanicVacua>, and
+    // <PanicVacuumOrdering> from the file given by
+    // tunnelingCalculatorInitializationFilename, for creating more tunneling
+    // calculators for tunneling to more than one panic vacuum.
+    void ReadTunnelingChannelOptions(
+                std::string const& tunnelingCalculatorInitializationFilename );
 
+    // This returns the panic vacua to tunnel to, according to
+    // numberOfPanicVacuaToTunnelTo and panicVacuumOrdering.
+    std::vector< PotentialMinimum > ChoosePanicVacua() const;
+
+    // This calculates tunneling from the DSB vacuum to each of the vacua
+    // chosen by ChoosePanicVacua, each with its own tunneling calculator, at
+    // the same time as far as possible, and then sets fastestQuantumChannel
+    // and fastestThermalChannel to be the indices of the channels with the
+    // shortest lifetime at zero temperature and the lowest survival
+    // probability at non-zero temperatures respectively.
+    void CalculateTunnelingToPanicVacua();
+
+    // This returns the tunneling calculator for
+    // tunnelingTargets[ channelIndex ].
+    TunnelingCalculator& ChannelCalculator( size_t const channelIndex );
+
+    // This returns the tunneling calculator of the channel with the fastest
+    // decay at zero temperature, which gives the zero-temperature results.
+    TunnelingCalculator const& QuantumResult() const;
+
+    // This returns the tunneling calculator of the channel with the fastest
+    // decay at non-zero temperatures, which gives the non-zero-temperature
+    // results.
+    TunnelingCalculator const& ThermalResult() const;
 
     // This prepares the results in XML format, stored in resultsAsXml;
     void PrepareResultsAsXml();
@@ -330,12 +467,53 @@ namespace VevaciousPlusPlus
     // warningMessagesFromConstructor with warningMessagesFromLastRun.
     std::vector< std::string > WarningMessagesToReport() const;
 
+    // This appends performanceRecord as a line of JSON to the file named by
+    // performanceJsonFilename, with pointName identifying the run. Several
+    // objects may append to the same file at once, so each line is written
+    // in a critical section in a single write.
+    void AppendPerformanceJsonLine( std::string const& pointName ) const;
+
 };
 
 
 
 
 
+  // This returns the tunneling calculator for
+  // tunnelingTargets[ channelIndex ].
+  inline TunnelingCalculator&
+  VevaciousPlusPlus::ChannelCalculator( size_t const channelIndex )
+  {
+    if( channelIndex == 0 )
+    {
+      return *tunnelingCalculator;
+    }
+    return *(additionalTunnelingCalculators[ channelIndex - 1 ]);
+  }
+
+  // This returns the tunneling calculator of the channel with the fastest
+  // decay at zero temperature, which gives the zero-temperature results.
+  inline TunnelingCalculator const& VevaciousPlusPlus::QuantumResult() const
+  {
+    if( fastestQuantumChannel == 0 )
+    {
+      return *tunnelingCalculator;
+    }
+    return *(additionalTunnelingCalculators[ fastestQuantumChannel - 1 ]);
+  }
+
+  // This returns the tunneling calculator of the channel with the fastest
+  // decay at non-zero temperatures, which gives the non-zero-temperature
+  // results.
+  inline TunnelingCalculator const& VevaciousPlusPlus::ThermalResult() const
+  {
+    if( fastestThermalChannel == 0 )
+    {
+      return *tunnelingCalculator;
+    }
+    return *(additionalTunnelingCalculators[ fastestThermalChannel - 1 ]);
+  }
+
   // This writes the results as an XML file.
   inline void
   VevaciousPlusPlus::WriteResultsAsXmlFile( std::string const& xmlFilename )
@@ -378,9 +556,9 @@ namespace VevaciousPlusPlus
      // This gives the Lifetime in seconds as output.
     inline double
     VevaciousPlusPlus::GetLifetimeInSeconds() {
-      if (tunnelingCalculator->QuantumSurvivalProbability() >= 0.0)
+      if (QuantumResult().QuantumSurvivalProbability() >= 0.0)
       {
-      return tunnelingCalculator->QuantumLifetimeInSeconds();
+      return QuantumResult().QuantumLifetimeInSeconds();
       }
     else
       {
@@ -392,9 +570,9 @@ namespace VevaciousPlusPlus
     // This gives the upper bound on the thermal survival probability as output.
     inline double
     VevaciousPlusPlus::GetThermalProbability() {
-      if (tunnelingCalculator->ThermalSurvivalProbability()  >= 0.0)
+      if (ThermalResult().ThermalSurvivalProbability()  >= 0.0)
       {
-        return tunnelingCalculator->ThermalSurvivalProbability();
+        return ThermalResult().ThermalSurvivalProbability();
       }
       else
       {
@@ -556,12 +734,18 @@ namespace VevaciousPlusPlus
     {
       return std::move(CreatePHCRunner( constructorArguments ));
     }
+    else if( classChoice == "TotalDegreeHomotopySolver" )
+    {
+      return std::move(CreateTotalDegreeHomotopySolver(
+                                                      constructorArguments ));
+    }
     else
     {
       std::stringstream errorStream;
       errorStream
       << "<PolynomialSystemSolver> was not a recognized class! The only"
-      << " options currently valid are \"Hom4ps2Runner\" or \"PHCRunner\"." << std::endl;
+      << " options currently valid are \"Hom4ps2Runner\", \"PHCRunner\" or"
+      << " \"TotalDegreeHomotopySolver\"." << std::endl;
 	  errorStream << "Classchoice: " << classChoice << std::endl << "Constructorarguments:" << constructorArguments<< std::endl;
       throw std::runtime_error( errorStream.str() );
     }
@@ -617,6 +801,37 @@ namespace VevaciousPlusPlus
     return Utils::make_unique<PHCRunner>(  pathToPHC, resolutionSize, taskcount);
   }
 
+  // This creates a new TotalDegreeHomotopySolver based on the given
+  // arguments and returns a pointer to it.
+  inline std::unique_ptr<TotalDegreeHomotopySolver>
+  VevaciousPlusPlus::CreateTotalDegreeHomotopySolver(
+                                      std::string const& constructorArguments )
+  {
+    LHPC::RestrictedXmlParser xmlParser;
+    xmlParser.LoadString( constructorArguments );
+    double resolutionSize( 1.0 );
+    unsigned int numberOfThreads( 1 );
+    unsigned int maximumStepsPerPath( 10000 );
+    // The <ConstructorArguments> for this class can have child elements
+    // <ResolutionSize>, <NumberOfThreads> (with 0 meaning as many as OpenMP
+    // would use by default) and <MaximumStepsPerPath>.
+    while( xmlParser.ReadNextElement() )
+    {
+      InterpretElementIfNameMatches( xmlParser,
+                                     "ResolutionSize",
+                                     resolutionSize );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfThreads",
+                                     numberOfThreads );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "MaximumStepsPerPath",
+                                     maximumStepsPerPath );
+    }
+    return Utils::make_unique<TotalDegreeHomotopySolver>( resolutionSize,
+                                                          numberOfThreads,
+                                                       maximumStepsPerPath );
+  }
+
   // This creates a new GradientMinimizer based on the given arguments and
   // returns a pointer to it.
   inline std::unique_ptr<GradientMinimizer> VevaciousPlusPlus::CreateGradientMinimizer(
@@ -671,6 +886,10 @@ namespace VevaciousPlusPlus
     {
       return std::move(CreateCosmoTransitionsRunner( constructorArguments ));
     }
+    else if( classChoice == "PathDeformationTunneler" )
+    {
+      return std::move(CreatePathDeformationTunneler( constructorArguments ));
+    }
     else if( classChoice == "BounceAlongPathWithThreshold" )
     {
       return std::move(CreateBounceAlongPathWithThreshold( constructorArguments ));
@@ -680,8 +899,8 @@ namespace VevaciousPlusPlus
       std::stringstream errorStream;
       errorStream
       << "<TunnelingClass> was not a recognized class! The only"
-      << " options currently valid are \"BounceAlongPathWithThreshold\" or"
-      << " \"CosmoTransitionsRunner\".";
+      << " options currently valid are \"BounceAlongPathWithThreshold\","
+      << " \"CosmoTransitionsRunner\", or \"PathDeformationTunneler\".";
       throw std::runtime_error( errorStream.str() );
     }
   }
@@ -760,8 +979,15 @@ namespace VevaciousPlusPlus
   VevaciousPlusPlus::CreateBubbleShootingOnPathInFieldSpace(
                                       std::string const& constructorArguments )
   {
+    // Optionally, <OdeStepper> chooses how the bubble equation of motion is
+    // integrated: "OdeintDefault" (the default) keeps the original
+    // integration, while "DormandPrince" or "Rosenbrock" use a dense-output
+    // stepper with error control at <StepperTolerance>, also integrating the
+    // bounce action and stopping each shot as soon as it is decided.
     double lengthScaleResolutionForBounce( 0.05 );
     unsigned int shootAttemptsForBounce( 32 );
+    std::string odeStepperName( "OdeintDefault" );
+    double stepperTolerance( 1.0e-6 );
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.LoadString( constructorArguments );
     while( xmlParser.ReadNextElement() )
@@ -772,10 +998,36 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "NumberShootAttemptsAllowed",
                                      shootAttemptsForBounce );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "OdeStepper",
+                                     odeStepperName );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "StepperTolerance",
+                                     stepperTolerance );
+    }
+    UndershootOvershootBubble::OdeStepperChoice
+    odeStepperChoice( UndershootOvershootBubble::OdeintDefault );
+    if( odeStepperName == "DormandPrince" )
+    {
+      odeStepperChoice = UndershootOvershootBubble::DormandPrinceDense;
+    }
+    else if( odeStepperName == "Rosenbrock" )
+    {
+      odeStepperChoice = UndershootOvershootBubble::RosenbrockDense;
+    }
+    else if( odeStepperName != "OdeintDefault" )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "\"" << odeStepperName << "\" is not a valid choice for"
+      << " <OdeStepper>. Valid options are \"OdeintDefault\","
+      << " \"DormandPrince\", or \"Rosenbrock\".";
+      throw std::runtime_error( errorBuilder.str() );
     }
     return
     Utils::make_unique<BubbleShootingOnPathInFieldSpace>( lengthScaleResolutionForBounce,
-                                          shootAttemptsForBounce );
+                                          shootAttemptsForBounce,
+                                          odeStepperChoice,
+                                          stepperTolerance );
   }
 
   // This returns a vector which is the union of
@@ -0,0 +1,468 @@
+/*
+ * AdaptiveSplinePotential.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "BounceActionEvaluation/AdaptiveSplinePotential.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  AdaptiveSplinePotential::AdaptiveSplinePotential(
+                                    PotentialFunction const& potentialFunction,
+                                                  TunnelPath const& tunnelPath,
+                                    unsigned int const numberOfInitialSegments,
+                                    unsigned int const maximumNumberOfSegments,
+                                               double const relativeTolerance,
+                         double const minimumSquareDistanceBetweenPathVacua ) :
+    OneDimensionalPotentialAlongPath(),
+    potentialFunction( potentialFunction ),
+    tunnelPath( tunnelPath ),
+    pathTemperature( tunnelPath.TemperatureValue() ),
+    sampleAuxiliaries(),
+    samplePotentials(),
+    nodeAuxiliaries(),
+    nodePotentials(),
+    nodeSlopes(),
+    firstSegmentQuadratic( -1.0 ),
+    finalPotential( 0.0 ),
+    lastSegmentQuadratic( -1.0 ),
+    energyBarrierWasResolved( false )
+  {
+    SampleAdaptively( numberOfInitialSegments,
+                      maximumNumberOfSegments,
+                      relativeTolerance );
+    size_t falseIndex( 0 );
+    size_t panicIndex( 0 );
+    energyBarrierWasResolved
+    = FindPathVacua( minimumSquareDistanceBetweenPathVacua,
+                     falseIndex,
+                     panicIndex );
+    if( energyBarrierWasResolved )
+    {
+      SetUpInterpolation( falseIndex,
+                          panicIndex );
+    }
+  }
+
+  AdaptiveSplinePotential::~AdaptiveSplinePotential()
+  {
+    // This does nothing.
+  }
+
+
+  // This returns the value of the potential at auxiliaryValue, by finding the
+  // correct segment and then returning its value at that point.
+  double AdaptiveSplinePotential::operator()( double auxiliaryValue ) const
+  {
+    if( auxiliaryValue >= auxiliaryOfPathPanicVacuum )
+    {
+      return finalPotential;
+    }
+    if( auxiliaryValue <= auxiliaryOfPathFalseVacuum )
+    {
+      return 0.0;
+    }
+    size_t const segmentIndex( SegmentIndex( auxiliaryValue ) );
+    if( segmentIndex == 0 )
+    {
+      double const
+      differenceFromFalseVacuum( auxiliaryValue - auxiliaryOfPathFalseVacuum );
+      return ( differenceFromFalseVacuum * differenceFromFalseVacuum
+               * firstSegmentQuadratic );
+    }
+    if( segmentIndex == ( nodeAuxiliaries.size() - 2 ) )
+    {
+      double const
+      differenceFromPanicVacuum( auxiliaryValue - auxiliaryOfPathPanicVacuum );
+      return ( finalPotential
+               + ( differenceFromPanicVacuum * differenceFromPanicVacuum
+                   * lastSegmentQuadratic ) );
+    }
+    return HermiteValue( auxiliaryValue,
+                         nodeAuxiliaries[ segmentIndex ],
+                         nodeAuxiliaries[ segmentIndex + 1 ],
+                         nodePotentials[ segmentIndex ],
+                         nodePotentials[ segmentIndex + 1 ],
+                         nodeSlopes[ segmentIndex ],
+                         nodeSlopes[ segmentIndex + 1 ] );
+  }
+
+  // This returns the value of the first derivative of the potential at
+  // auxiliaryValue, by finding the correct segment and then returning its
+  // slope at that point.
+  double AdaptiveSplinePotential::FirstDerivative(
+                                           double const auxiliaryValue ) const
+  {
+    if( ( auxiliaryValue <= auxiliaryOfPathFalseVacuum )
+        ||
+        ( auxiliaryValue >= auxiliaryOfPathPanicVacuum ) )
+    {
+      return 0.0;
+    }
+    size_t const segmentIndex( SegmentIndex( auxiliaryValue ) );
+    if( segmentIndex == 0 )
+    {
+      return ( 2.0 * ( auxiliaryValue - auxiliaryOfPathFalseVacuum )
+                   * firstSegmentQuadratic );
+    }
+    if( segmentIndex == ( nodeAuxiliaries.size() - 2 ) )
+    {
+      return FirstDerivativeNearPathPanic( auxiliaryValue
+                                           - auxiliaryOfPathPanicVacuum );
+    }
+    return HermiteSlope( auxiliaryValue,
+                         nodeAuxiliaries[ segmentIndex ],
+                         nodeAuxiliaries[ segmentIndex + 1 ],
+                         nodePotentials[ segmentIndex ],
+                         nodePotentials[ segmentIndex + 1 ],
+                         nodeSlopes[ segmentIndex ],
+                         nodeSlopes[ segmentIndex + 1 ] );
+  }
+
+  // This fills sampleAuxiliaries and samplePotentials by halving segments of
+  // the path until the interpolation is within relativeTolerance of the
+  // potential at the middle of each segment, or the segment has reached the
+  // minimum length.
+  void AdaptiveSplinePotential::SampleAdaptively(
+                                    unsigned int const numberOfInitialSegments,
+                                    unsigned int const maximumNumberOfSegments,
+                                               double const relativeTolerance )
+  {
+    // There have to be at least 2 segments for there to be a point which
+    // could be on top of an energy barrier.
+    unsigned int const
+    initialSegments( std::max( numberOfInitialSegments,
+                               static_cast< unsigned int >( 2 ) ) );
+    // The segment lengths are all powers of 2 times the initial length, so
+    // the comparison with the minimum length allows for a little rounding.
+    double const minimumHalfLength( ( 1.0 - 1.0e-6 )
+                                    / std::max( maximumNumberOfSegments,
+                                                initialSegments ) );
+    sampleAuxiliaries.resize( initialSegments + 1 );
+    for( size_t sampleIndex( 0 );
+         sampleIndex <= initialSegments;
+         ++sampleIndex )
+    {
+      sampleAuxiliaries[ sampleIndex ]
+      = ( static_cast< double >( sampleIndex ) / initialSegments );
+    }
+    EvaluateAlongPath( sampleAuxiliaries,
+                       samplePotentials );
+
+    // Each round looks at the segments which start at the auxiliary values in
+    // segmentStarts, evaluating the potential at their middles as a batch.
+    std::vector< double > segmentStarts( sampleAuxiliaries.begin(),
+                                         ( sampleAuxiliaries.end() - 1 ) );
+    std::vector< double > sampleSlopes;
+    std::vector< double > middleAuxiliaries;
+    std::vector< double > halfLengths;
+    std::vector< double > predictedPotentials;
+    std::vector< double > middlePotentials;
+    std::vector< std::pair< double, double > > mergedSamples;
+    while( !(segmentStarts.empty()) )
+    {
+      SetMonotonicSlopes( sampleAuxiliaries,
+                          samplePotentials,
+                          sampleSlopes );
+      middleAuxiliaries.clear();
+      halfLengths.clear();
+      predictedPotentials.clear();
+      for( std::vector< double >::const_iterator
+           segmentStart( segmentStarts.begin() );
+           segmentStart < segmentStarts.end();
+           ++segmentStart )
+      {
+        size_t const startIndex( std::lower_bound( sampleAuxiliaries.begin(),
+                                                   sampleAuxiliaries.end(),
+                                                   *segmentStart )
+                                 - sampleAuxiliaries.begin() );
+        double const halfLength( 0.5 * ( sampleAuxiliaries[ startIndex + 1 ]
+                                         - *segmentStart ) );
+        if( halfLength < minimumHalfLength )
+        {
+          continue;
+        }
+        middleAuxiliaries.push_back( *segmentStart + halfLength );
+        halfLengths.push_back( halfLength );
+        predictedPotentials.push_back( HermiteValue( middleAuxiliaries.back(),
+                                                     *segmentStart,
+                                       sampleAuxiliaries[ startIndex + 1 ],
+                                       samplePotentials[ startIndex ],
+                                       samplePotentials[ startIndex + 1 ],
+                                       sampleSlopes[ startIndex ],
+                                       sampleSlopes[ startIndex + 1 ] ) );
+      }
+      if( middleAuxiliaries.empty() )
+      {
+        break;
+      }
+      EvaluateAlongPath( middleAuxiliaries,
+                         middlePotentials );
+
+      // The tolerance is relative to the range of the potential along the
+      // path as sampled so far.
+      double const
+      absoluteTolerance( relativeTolerance
+                         * ( *std::max_element( samplePotentials.begin(),
+                                                samplePotentials.end() )
+                             - *std::min_element( samplePotentials.begin(),
+                                                  samplePotentials.end() ) ) );
+      segmentStarts.clear();
+      mergedSamples.clear();
+      for( size_t middleIndex( 0 );
+           middleIndex < middleAuxiliaries.size();
+           ++middleIndex )
+      {
+        if( fabs( middlePotentials[ middleIndex ]
+                  - predictedPotentials[ middleIndex ] ) > absoluteTolerance )
+        {
+          segmentStarts.push_back( middleAuxiliaries[ middleIndex ]
+                                   - halfLengths[ middleIndex ] );
+          segmentStarts.push_back( middleAuxiliaries[ middleIndex ] );
+        }
+        mergedSamples.push_back(
+                             std::make_pair( middleAuxiliaries[ middleIndex ],
+                                          middlePotentials[ middleIndex ] ) );
+      }
+      for( size_t sampleIndex( 0 );
+           sampleIndex < sampleAuxiliaries.size();
+           ++sampleIndex )
+      {
+        mergedSamples.push_back(
+                             std::make_pair( sampleAuxiliaries[ sampleIndex ],
+                                          samplePotentials[ sampleIndex ] ) );
+      }
+      std::sort( mergedSamples.begin(),
+                 mergedSamples.end() );
+      sampleAuxiliaries.resize( mergedSamples.size() );
+      samplePotentials.resize( mergedSamples.size() );
+      for( size_t sampleIndex( 0 );
+           sampleIndex < mergedSamples.size();
+           ++sampleIndex )
+      {
+        sampleAuxiliaries[ sampleIndex ] = mergedSamples[ sampleIndex ].first;
+        samplePotentials[ sampleIndex ] = mergedSamples[ sampleIndex ].second;
+      }
+    }
+  }
+
+  // This evaluates the potential at each of the points on tunnelPath given by
+  // pathAuxiliaries as a single batch, putting the values in potentialValues.
+  void AdaptiveSplinePotential::EvaluateAlongPath(
+                                  std::vector< double > const& pathAuxiliaries,
+                                std::vector< double >& potentialValues ) const
+  {
+    std::vector< double > pathConfigurations;
+    tunnelPath.PutOnPathAt( pathConfigurations,
+                            pathAuxiliaries );
+    potentialFunction.EvaluateBatch( pathConfigurations,
+                                     pathTemperature,
+                                     potentialValues );
+  }
+
+  // This goes along the sampled points in the same way as SplinePotential goes
+  // along the ends of its segments, to find the path false vacuum, the end of
+  // the energy barrier, and the path panic vacuum, repeating if the path
+  // panic vacuum is too close to the false vacuum end of the path. It returns
+  // true and sets falseIndex and panicIndex to be the indices of the sampled
+  // points of the path vacua if it finds an energy barrier which is resolved,
+  // and returns false otherwise.
+  bool AdaptiveSplinePotential::FindPathVacua(
+                            double const minimumSquareDistanceBetweenPathVacua,
+                                               size_t& falseIndex,
+                                               size_t& panicIndex )
+  {
+    size_t const numberOfFields( potentialFunction.NumberOfFieldVariables() );
+    std::vector< double > pathFalseEndConfiguration( numberOfFields );
+    tunnelPath.PutOnPathAt( pathFalseEndConfiguration,
+                            sampleAuxiliaries.front() );
+    std::vector< double > panicConfiguration( numberOfFields );
+    size_t const lastIndex( sampleAuxiliaries.size() - 1 );
+    falseIndex = 0;
+    bool pathVacuaAreSeparated( false );
+    while( !pathVacuaAreSeparated )
+    {
+      // The path false vacuum cannot be either of the last 2 points, as the
+      // segment ending in the path panic vacuum cannot start with the path
+      // false vacuum.
+      bool risesFromFalseVacuum( false );
+      while( ( falseIndex + 2 ) <= lastIndex )
+      {
+        if( samplePotentials[ falseIndex + 1 ]
+            > samplePotentials[ falseIndex ] )
+        {
+          risesFromFalseVacuum = true;
+          break;
+        }
+        ++falseIndex;
+      }
+      if( !risesFromFalseVacuum )
+      {
+        return false;
+      }
+
+      // Next we find the first point after the barrier where the potential is
+      // lower than at the path false vacuum.
+      panicIndex = ( falseIndex + 2 );
+      while( ( panicIndex <= lastIndex )
+             &&
+             !( samplePotentials[ panicIndex ]
+                < samplePotentials[ falseIndex ] ) )
+      {
+        ++panicIndex;
+      }
+      if( panicIndex > lastIndex )
+      {
+        return false;
+      }
+      definiteUndershootAuxiliary = sampleAuxiliaries[ panicIndex - 1 ];
+
+      // Then we roll down to the path panic vacuum.
+      while( ( panicIndex < lastIndex )
+             &&
+             ( samplePotentials[ panicIndex + 1 ]
+               < samplePotentials[ panicIndex ] ) )
+      {
+        ++panicIndex;
+      }
+
+      // As in SplinePotential, the path panic vacuum has to be sufficiently
+      // far from the false vacuum end of the path for the barrier not to be
+      // taken as a numerical artifact. Otherwise it becomes the path false
+      // vacuum for the next iteration.
+      tunnelPath.PutOnPathAt( panicConfiguration,
+                              sampleAuxiliaries[ panicIndex ] );
+      double vacuaSeparationSquared( 0.0 );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        double const fieldDifference( pathFalseEndConfiguration[ fieldIndex ]
+                                      - panicConfiguration[ fieldIndex ] );
+        vacuaSeparationSquared += ( fieldDifference * fieldDifference );
+      }
+      pathVacuaAreSeparated
+      = ( vacuaSeparationSquared >= minimumSquareDistanceBetweenPathVacua );
+      if( !pathVacuaAreSeparated )
+      {
+        falseIndex = panicIndex;
+      }
+    }
+    return true;
+  }
+
+  // This copies the sampled points from falseIndex to panicIndex into the
+  // node vectors and sets up the quadratic end segments and the slopes for
+  // the cubic segments in between.
+  void AdaptiveSplinePotential::SetUpInterpolation( size_t const falseIndex,
+                                                    size_t const panicIndex )
+  {
+    nodeAuxiliaries.assign( ( sampleAuxiliaries.begin() + falseIndex ),
+                            ( sampleAuxiliaries.begin() + panicIndex + 1 ) );
+    nodePotentials.assign( ( samplePotentials.begin() + falseIndex ),
+                           ( samplePotentials.begin() + panicIndex + 1 ) );
+    double const pathFalsePotential( nodePotentials.front() );
+    for( std::vector< double >::iterator
+         nodePotential( nodePotentials.begin() );
+         nodePotential < nodePotentials.end();
+         ++nodePotential )
+    {
+      *nodePotential -= pathFalsePotential;
+    }
+    auxiliaryOfPathFalseVacuum = nodeAuxiliaries.front();
+    auxiliaryOfPathPanicVacuum = nodeAuxiliaries.back();
+    finalPotential = nodePotentials.back();
+
+    // FindPathVacua ensures that there are at least 3 nodes, so that the
+    // first and last segments are different.
+    size_t const lastNode( nodeAuxiliaries.size() - 1 );
+    double const firstLength( nodeAuxiliaries[ 1 ]
+                              - nodeAuxiliaries.front() );
+    firstSegmentQuadratic
+    = ( nodePotentials[ 1 ] / ( firstLength * firstLength ) );
+    double const lastLength( nodeAuxiliaries.back()
+                             - nodeAuxiliaries[ lastNode - 1 ] );
+    lastSegmentQuadratic
+    = ( ( nodePotentials[ lastNode - 1 ] - finalPotential )
+        / ( lastLength * lastLength ) );
+    thresholdForNearPathPanic = nodeAuxiliaries[ lastNode - 1 ];
+
+    SetMonotonicSlopes( nodeAuxiliaries,
+                        nodePotentials,
+                        nodeSlopes );
+    // Where the cubic segments meet the quadratic segments at the ends, the
+    // slopes are taken from the quadratics as far as the cubic segments can
+    // stay monotonic.
+    if( lastNode > 2 )
+    {
+      nodeSlopes[ 1 ]
+      = LimitedSlope( ( 2.0 * firstSegmentQuadratic * firstLength ),
+                      ( ( nodePotentials[ 2 ] - nodePotentials[ 1 ] )
+                        / ( nodeAuxiliaries[ 2 ] - nodeAuxiliaries[ 1 ] ) ) );
+      nodeSlopes[ lastNode - 1 ]
+      = LimitedSlope( ( -2.0 * lastSegmentQuadratic * lastLength ),
+                      ( ( nodePotentials[ lastNode - 1 ]
+                          - nodePotentials[ lastNode - 2 ] )
+                        / ( nodeAuxiliaries[ lastNode - 1 ]
+                            - nodeAuxiliaries[ lastNode - 2 ] ) ) );
+    }
+  }
+
+  // This fills pointSlopes with slopes at each of the points given by
+  // pointAuxiliaries and pointValues which keep a cubic Hermite interpolation
+  // monotonic between the points, taking the slope of the straight line to
+  // the neighboring point for the first and last points.
+  void AdaptiveSplinePotential::SetMonotonicSlopes(
+                                 std::vector< double > const& pointAuxiliaries,
+                                     std::vector< double > const& pointValues,
+                                           std::vector< double >& pointSlopes )
+  {
+    size_t const numberOfPoints( pointAuxiliaries.size() );
+    pointSlopes.assign( numberOfPoints,
+                        0.0 );
+    if( numberOfPoints < 2 )
+    {
+      return;
+    }
+    pointSlopes.front() = ( ( pointValues[ 1 ] - pointValues.front() )
+                            / ( pointAuxiliaries[ 1 ]
+                                - pointAuxiliaries.front() ) );
+    pointSlopes.back() = ( ( pointValues.back()
+                             - pointValues[ numberOfPoints - 2 ] )
+                           / ( pointAuxiliaries.back()
+                               - pointAuxiliaries[ numberOfPoints - 2 ] ) );
+    // The slopes at the other points are the Fritsch-Butland weighted
+    // harmonic means of the slopes of the straight lines to the neighboring
+    // points, (w1 + w2) / ( w1 / slopeBefore + w2 / slopeAfter ) with
+    // w1 = 2 lengthAfter + lengthBefore and w2 = lengthAfter + 2 lengthBefore,
+    // or zero at local extrema, which keeps each segment monotonic.
+    for( size_t pointIndex( 1 );
+         pointIndex < ( numberOfPoints - 1 );
+         ++pointIndex )
+    {
+      double const lengthBefore( pointAuxiliaries[ pointIndex ]
+                                 - pointAuxiliaries[ pointIndex - 1 ] );
+      double const lengthAfter( pointAuxiliaries[ pointIndex + 1 ]
+                                - pointAuxiliaries[ pointIndex ] );
+      double const slopeBefore( ( pointValues[ pointIndex ]
+                                  - pointValues[ pointIndex - 1 ] )
+                                / lengthBefore );
+      double const slopeAfter( ( pointValues[ pointIndex + 1 ]
+                                 - pointValues[ pointIndex ] )
+                               / lengthAfter );
+      if( !( ( slopeBefore * slopeAfter ) > 0.0 ) )
+      {
+        continue;
+      }
+      double const weightBefore( ( 2.0 * lengthAfter ) + lengthBefore );
+      double const weightAfter( lengthAfter + ( 2.0 * lengthBefore ) );
+      pointSlopes[ pointIndex ] = ( ( weightBefore + weightAfter )
+                                    / ( ( weightBefore / slopeBefore )
+                                        + ( weightAfter / slopeAfter ) ) );
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -78,11 +78,14 @@ namespace VevaciousPlusPlus
                                trueVacuum );
   }
 
-  // This sets up reflectionMatrix to be the Householder reflection matrix
-  // which reflects the axis of field 0 to be parallel to
-  // currentParallelComponent.
-  void MinuitOnHypersurfaces::SetUpHouseholderReflection()
+  // This sets up hyperplaneReflection to be the Householder reflection
+  // matrix which reflects the axis of field 0 to be parallel to
+  // parallelComponent.
+  void MinuitOnHypersurfaces::SetUpHouseholderReflection(
+                                      Eigen::VectorXd const& parallelComponent,
+                                        Eigen::MatrixXd& hyperplaneReflection )
   {
+    size_t const numberOfFields( parallelComponent.rows() );
     // First we check that targetVector doesn't already lie on the axis of the
     // field with index 0.
     bool alreadyParallel( true );
@@ -90,7 +93,7 @@ namespace VevaciousPlusPlus
          fieldIndex < numberOfFields;
          ++fieldIndex )
     {
-      if( currentParallelComponent( fieldIndex ) != 0.0 )
+      if( parallelComponent( fieldIndex ) != 0.0 )
       {
         alreadyParallel = false;
         break;
@@ -98,10 +101,10 @@ namespace VevaciousPlusPlus
     }
     if( alreadyParallel )
     {
-      reflectionMatrix = Eigen::MatrixXd::Identity( numberOfFields,
-                                                    numberOfFields );
-      reflectionMatrix( 0,
-                        0 ) = -1.0;
+      hyperplaneReflection = Eigen::MatrixXd::Identity( numberOfFields,
+                                                        numberOfFields );
+      hyperplaneReflection( 0,
+                            0 ) = -1.0;
     }
     else
     {
@@ -110,19 +113,19 @@ namespace VevaciousPlusPlus
            fieldIndex < numberOfFields;
            ++fieldIndex )
       {
-        targetLengthSquared += ( currentParallelComponent( fieldIndex )
-                                 * currentParallelComponent( fieldIndex ) );
+        targetLengthSquared += ( parallelComponent( fieldIndex )
+                                 * parallelComponent( fieldIndex ) );
       }
       double const targetNormalization( 1.0 / sqrt( targetLengthSquared ) );
       double const minusInverseOfOneMinusDotProduct( 1.0 /
-           ( ( currentParallelComponent( 0 ) * targetNormalization ) - 1.0 ) );
-      reflectionMatrix = Eigen::MatrixXd::Zero( numberOfFields,
-                                                numberOfFields );
+           ( ( parallelComponent( 0 ) * targetNormalization ) - 1.0 ) );
+      hyperplaneReflection = Eigen::MatrixXd::Zero( numberOfFields,
+                                                    numberOfFields );
       for( size_t rowIndex( 0 );
            rowIndex < numberOfFields;
            ++rowIndex )
       {
-        double rowIndexPart( currentParallelComponent( rowIndex )
+        double rowIndexPart( parallelComponent( rowIndex )
                              * targetNormalization );
         if( rowIndex == 0 )
         {
@@ -132,24 +135,27 @@ namespace VevaciousPlusPlus
              columnIndex < numberOfFields;
              ++columnIndex )
         {
-          double columnIndexPart( currentParallelComponent( columnIndex )
+          double columnIndexPart( parallelComponent( columnIndex )
                                   * targetNormalization );
           if( columnIndex == 0 )
           {
             columnIndexPart -= 1.0;
           }
-          reflectionMatrix( rowIndex,
-                            columnIndex ) = ( rowIndexPart * columnIndexPart
-                                          * minusInverseOfOneMinusDotProduct );
-          reflectionMatrix( columnIndex,
-                            rowIndex ) = ( rowIndexPart * columnIndexPart
-                                          * minusInverseOfOneMinusDotProduct );
+          hyperplaneReflection( rowIndex,
+                                columnIndex )
+          = ( rowIndexPart * columnIndexPart
+              * minusInverseOfOneMinusDotProduct );
+          hyperplaneReflection( columnIndex,
+                                rowIndex )
+          = ( rowIndexPart * columnIndexPart
+              * minusInverseOfOneMinusDotProduct );
           // The reflection matrix is symmetric, and we set the diagonal
           // elements outside this loop.
         }
-        reflectionMatrix( rowIndex,
-                          rowIndex ) = ( 1.0 + ( rowIndexPart * rowIndexPart
-                                        * minusInverseOfOneMinusDotProduct ) );
+        hyperplaneReflection( rowIndex,
+                              rowIndex )
+        = ( 1.0 + ( rowIndexPart * rowIndexPart
+                    * minusInverseOfOneMinusDotProduct ) );
       }
     }
   }
@@ -187,4 +193,47 @@ namespace VevaciousPlusPlus
     return ( reflectionMatrix * minuitResultAsUntransformedVector );
   }
 
+  // This creates and runs a Minuit2 MnMigrad object on a
+  // NodeHyperplanePotential for the hyperplane through hyperplaneOrigin
+  // which is perpendicular to parallelComponent, and returns the result as a
+  // displacement from hyperplaneOrigin, or a zero displacement if Minuit2
+  // did not find a lower value than at hyperplaneOrigin. It does not change
+  // any member variables, so it can be called from several threads at once.
+  Eigen::VectorXd MinuitOnHypersurfaces::HyperplaneMinimumDisplacement(
+                                       Eigen::VectorXd const& hyperplaneOrigin,
+                               Eigen::VectorXd const& parallelComponent ) const
+  {
+    Eigen::MatrixXd hyperplaneReflection;
+    SetUpHouseholderReflection( parallelComponent,
+                                hyperplaneReflection );
+    NodeHyperplanePotential const hyperplanePotential( *this,
+                                                       hyperplaneReflection,
+                                                       hyperplaneOrigin );
+    std::vector< double > const
+    initialSteps( ( numberOfFields - 1 ),
+                  ( 0.1 * parallelComponent.norm() ) );
+    ROOT::Minuit2::MnMigrad mnMigrad( hyperplanePotential,
+                                      nodeZeroParameterization,
+                                      initialSteps,
+                                      minuitStrategy );
+    ROOT::Minuit2::FunctionMinimum const minuitResult( mnMigrad( 0,
+                                                    currentMinuitTolerance ) );
+    if( minuitResult.Fval() > hyperplanePotential( nodeZeroParameterization ) )
+    {
+      return Eigen::VectorXd::Zero( numberOfFields );
+    }
+    ROOT::Minuit2::MnUserParameters const&
+    userParameters( minuitResult.UserParameters() );
+    Eigen::VectorXd untransformedResult( Eigen::VectorXd::Zero(
+                                                            numberOfFields ) );
+    for( size_t variableIndex( 1 );
+         variableIndex < numberOfFields;
+         ++variableIndex )
+    {
+      untransformedResult( variableIndex )
+      = userParameters.Value( variableIndex - 1 );
+    }
+    return ( hyperplaneReflection * untransformedResult );
+  }
+
 } /* namespace VevaciousPlusPlus */
@@ -6,6 +6,11 @@
  */
 
 #include "BounceActionEvaluation/BounceActionPathFinding/MinuitOnPotentialPerpendicularToPath.hpp"
+#include <string>
+#include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace VevaciousPlusPlus
 {
@@ -17,7 +22,8 @@ namespace VevaciousPlusPlus
                                                     double const dampingFactor,
                        std::vector< double > const neighborDisplacementWeights,
                                              unsigned int const minuitStrategy,
-                                       double const minuitToleranceFraction ) :
+                                         double const minuitToleranceFraction,
+                                        unsigned int const numberOfThreads ) :
      MinuitOnHypersurfaces( numberOfPathSegments,
                             minuitStrategy,
                             minuitToleranceFraction ),
@@ -30,7 +36,8 @@ namespace VevaciousPlusPlus
      lastPathNodes(),
      nodeDisplacements(),
      bounceBeforeLastPath( FunctionValueForNanInput() ),
-     nodesConverged( false )
+     nodesConverged( false ),
+     numberOfThreads( numberOfThreads )
   {
     // This constructor is just an initialization list.
     // The factor of 0.25 in nodeMovementThresholdFractionSquared is to account
@@ -53,49 +60,69 @@ namespace VevaciousPlusPlus
   // are all sufficiently close to their starting points from lastPath,
   // nodesConverged is set to true. (The bubble profile from the last path is
   // ignored, but there is an empty hook in the loop to allow derived classes
-  // to use it.)
+  // to use it.) If numberOfThreads is not 1, the minimizations for the nodes
+  // are shared out among that many threads (or the OpenMP default if it is
+  // 0), each node with its own hyperplane and Minuit2 function, as each only
+  // depends on lastPath. In that case, AccountForBubbleProfileAroundNode is
+  // not called and operator() is not used, so derived classes which
+  // over-ride either should be constructed with numberOfThreads = 1.
   TunnelPath const* MinuitOnPotentialPerpendicularToPath::TryToImprovePath(
                                                     TunnelPath const& lastPath,
                                       BubbleProfile const& bubbleFromLastPath )
   {
     // First we set up the nodes corresponding to the last path, ignoring the
     // ends, which should have been set correctly by SetNodesForInitialPath.
+    // All the nodes are put on the path as a single batch, and then copied
+    // into the Eigen vectors.
+    std::vector< double > nodeAuxiliaries( numberOfVaryingNodes );
     for( size_t nodeIndex( 1 );
          nodeIndex <= numberOfVaryingNodes;
          ++nodeIndex )
     {
-      lastPath.PutOnPathAt( lastPathNodes[ nodeIndex ],
-                            ( nodeIndex * segmentAuxiliaryLength ) );
+      nodeAuxiliaries[ nodeIndex - 1 ]
+      = ( nodeIndex * segmentAuxiliaryLength );
+    }
+    std::vector< double > nodeConfigurations;
+    lastPath.PutOnPathAt( nodeConfigurations,
+                          nodeAuxiliaries );
+    size_t const numberOfFields( lastPath.NumberOfFields() );
+    for( size_t nodeIndex( 1 );
+         nodeIndex <= numberOfVaryingNodes;
+         ++nodeIndex )
+    {
+      double const* const
+      nodeConfiguration( &(nodeConfigurations[ ( nodeIndex - 1 )
+                                               * numberOfFields ]) );
+      lastPathNodes[ nodeIndex ]
+      = Eigen::Map< Eigen::VectorXd const >( nodeConfiguration,
+                                             numberOfFields );
     }
-
-    // We assume that the nodes will converge with this call, and note if they
-    // don't.
-    nodesConverged = true;
 
     // Next we calculate and store the displacements, ignoring the ends, which
     // should not get displaced.
+    if( numberOfThreads == 1 )
+    {
+      SetNodeDisplacementsSerially( bubbleFromLastPath );
+    }
+    else
+    {
+      SetNodeDisplacementsInParallel();
+    }
+
+    // The nodes are taken to have converged if none of them moved further
+    // than the threshold fraction of the distance between its neighbors.
+    nodesConverged = true;
     for( size_t nodeIndex( 1 );
          nodeIndex <= numberOfVaryingNodes;
          ++nodeIndex )
     {
-      currentHyperplaneOrigin = lastPathNodes[ nodeIndex ];
-      SetParallelVector( lastPathNodes[ nodeIndex - 1 ],
-                         lastPathNodes[ nodeIndex + 1 ] );
-      SetCurrentMinuitSteps( 0.1 );
-      // The starting step sizes for Minuit2 are set to be a tenth of the
-      // Euclidean length of the difference between
-      // lastPathNodes[ nodeIndex - 1 ] and lastPathNodes[ nodeIndex + 1 ],
-      // times whatever internal factor Minuit2 uses (seems to be 0.1 or 0.01),
-      // but the sizes are adapted as the minimization proceeds anyway.
-      SetUpHouseholderReflection();
-      AccountForBubbleProfileAroundNode( nodeIndex,
-                                         bubbleFromLastPath );
-      nodeDisplacements[ nodeIndex ] = RunMigradAndReturnDisplacement();
       if( nodeDisplacements[ nodeIndex ].squaredNorm()
           > ( nodeMovementThresholdFractionSquared
-              * currentParallelComponent.squaredNorm() ) )
+              * ( lastPathNodes[ nodeIndex + 1 ]
+                  - lastPathNodes[ nodeIndex - 1 ] ).squaredNorm() ) )
       {
         nodesConverged = false;
+        break;
       }
     }
 
@@ -164,4 +191,78 @@ namespace VevaciousPlusPlus
                                          pathTemperature );
   }
 
+  // This sets nodeDisplacements[ nodeIndex ] for each varying node by running
+  // Minuit2 on the hyperplane for each node in turn through reflectionMatrix
+  // and currentHyperplaneOrigin, calling AccountForBubbleProfileAroundNode
+  // before each.
+  void MinuitOnPotentialPerpendicularToPath::SetNodeDisplacementsSerially(
+                                      BubbleProfile const& bubbleFromLastPath )
+  {
+    for( size_t nodeIndex( 1 );
+         nodeIndex <= numberOfVaryingNodes;
+         ++nodeIndex )
+    {
+      currentHyperplaneOrigin = lastPathNodes[ nodeIndex ];
+      SetParallelVector( lastPathNodes[ nodeIndex - 1 ],
+                         lastPathNodes[ nodeIndex + 1 ] );
+      SetCurrentMinuitSteps( 0.1 );
+      // The starting step sizes for Minuit2 are set to be a tenth of the
+      // Euclidean length of the difference between
+      // lastPathNodes[ nodeIndex - 1 ] and lastPathNodes[ nodeIndex + 1 ],
+      // times whatever internal factor Minuit2 uses (seems to be 0.1 or 0.01),
+      // but the sizes are adapted as the minimization proceeds anyway.
+      SetUpHouseholderReflection();
+      AccountForBubbleProfileAroundNode( nodeIndex,
+                                         bubbleFromLastPath );
+      nodeDisplacements[ nodeIndex ] = RunMigradAndReturnDisplacement();
+    }
+  }
+
+  // This sets nodeDisplacements[ nodeIndex ] for each varying node by running
+  // Minuit2 on a separate NodeHyperplanePotential for each node, with the
+  // nodes shared out among numberOfThreads threads.
+  void MinuitOnPotentialPerpendicularToPath::SetNodeDisplacementsInParallel()
+  {
+    int threadsToUse( static_cast< int >( numberOfThreads ) );
+#ifdef _OPENMP
+    if( threadsToUse < 1 )
+    {
+      threadsToUse = omp_get_max_threads();
+    }
+#endif
+    // Exceptions cannot propagate out of an OpenMP region, so each node notes
+    // any error message and the first is thrown once all the threads have
+    // finished.
+    std::vector< std::string > nodeErrors( numberOfVaryingNodes + 2 );
+#pragma omp parallel for schedule( dynamic ) num_threads( threadsToUse )
+    for( size_t nodeIndex = 1;
+         nodeIndex <= numberOfVaryingNodes;
+         ++nodeIndex )
+    {
+      try
+      {
+        Eigen::VectorXd const
+        parallelComponent( lastPathNodes[ nodeIndex + 1 ]
+                           - lastPathNodes[ nodeIndex - 1 ] );
+        nodeDisplacements[ nodeIndex ]
+        = HyperplaneMinimumDisplacement( lastPathNodes[ nodeIndex ],
+                                         parallelComponent );
+      }
+      catch( std::exception const& caughtException )
+      {
+        nodeErrors[ nodeIndex ] = caughtException.what();
+      }
+    }
+    for( std::vector< std::string >::const_iterator
+         nodeError( nodeErrors.begin() );
+         nodeError < nodeErrors.end();
+         ++nodeError )
+    {
+      if( !(nodeError->empty()) )
+      {
+        throw std::runtime_error( *nodeError );
+      }
+    }
+  }
+
 } /* namespace VevaciousPlusPlus */
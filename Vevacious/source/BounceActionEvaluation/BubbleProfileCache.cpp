@@ -0,0 +1,204 @@
+/*
+ * BubbleProfileCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "BounceActionEvaluation/BubbleProfileCache.hpp"
+
+namespace VevaciousPlusPlus
+{
+  double const BubbleProfileCache::maximumQuantizedMagnitude( 1.0E+18 );
+
+  BubbleProfileCache::BubbleProfileCache(
+                                         size_t const maximumNumberOfProfiles,
+                                         double const quantizationFraction ) :
+    maximumNumberOfProfiles( maximumNumberOfProfiles ),
+    quantizationFraction( quantizationFraction ),
+    profilesByUse(),
+    profileLookup(),
+    numberOfHits( 0 ),
+    numberOfMisses( 0 )
+  {
+    // This constructor is just an initialization list.
+  }
+
+  BubbleProfileCache::~BubbleProfileCache()
+  {
+    // This does nothing.
+  }
+
+
+  // This sets how many profiles may be kept, dropping the least recently
+  // used profiles if there are already more than maximumNumberOfProfiles, and
+  // the fraction used to quantize the keys. A maximumNumberOfProfiles of 0
+  // turns off the cache.
+  void BubbleProfileCache::SetLimits( size_t const maximumNumberOfProfiles,
+                                      double const quantizationFraction )
+  {
+#pragma omp critical( BubbleProfileCacheAccess )
+    {
+      this->maximumNumberOfProfiles = maximumNumberOfProfiles;
+      this->quantizationFraction = quantizationFraction;
+      DropExcessProfiles();
+    }
+  }
+
+  // This returns the key for the bubble profile for tunneling from
+  // falseVacuum to trueVacuum along tunnelPath at the temperature of
+  // tunnelPath, using the values of the potential which were found along with
+  // the vacua (which must be the minima at the temperature of tunnelPath). If
+  // the cache is turned off, it just returns an empty key without doing any
+  // work.
+  BubbleProfileCache::CacheKey
+  BubbleProfileCache::Key( PotentialMinimum const& falseVacuum,
+                           PotentialMinimum const& trueVacuum,
+                           TunnelPath const& tunnelPath ) const
+  {
+    if( !IsTurnedOn() )
+    {
+      return CacheKey();
+    }
+    // The quanta are kept away from zero so that the division by them is
+    // safe even for degenerate vacua.
+    double const fieldQuantum( std::max( ( quantizationFraction
+                                 * sqrt( falseVacuum.SquareDistanceTo(
+                                                           trueVacuum ) ) ),
+                                    std::numeric_limits< double >::min() ) );
+    double const tunnelingTemperature( tunnelPath.TemperatureValue() );
+    std::vector< double > vacuumPotentials( 2 );
+    vacuumPotentials.front() = falseVacuum.PotentialValue();
+    vacuumPotentials.back() = trueVacuum.PotentialValue();
+    double const potentialQuantum( std::max( ( quantizationFraction
+                                            * fabs( vacuumPotentials.front()
+                                                 - vacuumPotentials.back() ) ),
+                                    std::numeric_limits< double >::min() ) );
+
+    CacheKey cacheKey( 1,
+                    static_cast< long long >( tunnelPath.NumberOfFields() ) );
+    AppendQuantized( falseVacuum.FieldConfiguration(),
+                     fieldQuantum,
+                     cacheKey );
+    AppendQuantized( trueVacuum.FieldConfiguration(),
+                     fieldQuantum,
+                     cacheKey );
+    AppendQuantized( std::vector< double >( 1,
+                                            tunnelingTemperature ),
+                     fieldQuantum,
+                     cacheKey );
+    AppendQuantized( vacuumPotentials,
+                     potentialQuantum,
+                     cacheKey );
+    std::vector< double > pathDefinition;
+    tunnelPath.AppendPathDefinition( pathDefinition );
+    AppendQuantized( pathDefinition,
+                     fieldQuantum,
+                     cacheKey );
+    return cacheKey;
+  }
+
+  // This returns the profile kept for cacheKey, marking it as the most
+  // recently used, or an empty pointer if there is no profile for cacheKey,
+  // counting a hit or a miss respectively if the cache is turned on.
+  std::shared_ptr< BubbleProfile const >
+  BubbleProfileCache::Find( CacheKey const& cacheKey )
+  {
+    std::shared_ptr< BubbleProfile const > cachedProfile;
+#pragma omp critical( BubbleProfileCacheAccess )
+    {
+      if( IsTurnedOn() )
+      {
+        std::map< CacheKey, std::list< KeyedProfile >::iterator >::iterator
+        lookupEntry( profileLookup.find( cacheKey ) );
+        if( lookupEntry == profileLookup.end() )
+        {
+          ++numberOfMisses;
+        }
+        else
+        {
+          ++numberOfHits;
+          profilesByUse.splice( profilesByUse.begin(),
+                                profilesByUse,
+                                lookupEntry->second );
+          cachedProfile = lookupEntry->second->second;
+        }
+      }
+    }
+    return cachedProfile;
+  }
+
+  // This takes ownership of newProfile, detaching it from its calculator and
+  // keeping it for cacheKey if the cache is turned on, and returns a pointer
+  // sharing ownership of it.
+  std::shared_ptr< BubbleProfile const >
+  BubbleProfileCache::Insert( CacheKey const& cacheKey,
+                              BubbleProfile* newProfile )
+  {
+    if( !IsTurnedOn() )
+    {
+      return std::shared_ptr< BubbleProfile const >( newProfile );
+    }
+    // Another thread might delete the profile once it is dropped from the
+    // cache, so it cannot give its memory back to the calculator which
+    // created it.
+    newProfile->DetachFromCalculator();
+    std::shared_ptr< BubbleProfile const > sharedProfile( newProfile );
+#pragma omp critical( BubbleProfileCacheAccess )
+    {
+      std::map< CacheKey, std::list< KeyedProfile >::iterator >::iterator
+      lookupEntry( profileLookup.find( cacheKey ) );
+      if( lookupEntry == profileLookup.end() )
+      {
+        profilesByUse.push_front( KeyedProfile( cacheKey,
+                                                sharedProfile ) );
+        profileLookup[ cacheKey ] = profilesByUse.begin();
+        DropExcessProfiles();
+      }
+      else
+      {
+        // If another thread put a profile in for the same key in the
+        // meantime, the newer one replaces it.
+        lookupEntry->second->second = sharedProfile;
+        profilesByUse.splice( profilesByUse.begin(),
+                              profilesByUse,
+                              lookupEntry->second );
+      }
+    }
+    return sharedProfile;
+  }
+
+  // This sets the counts of hits and misses back to zero without dropping any
+  // profiles.
+  void BubbleProfileCache::ResetCounters()
+  {
+#pragma omp critical( BubbleProfileCacheAccess )
+    {
+      numberOfHits = 0;
+      numberOfMisses = 0;
+    }
+  }
+
+  // This drops all the profiles.
+  void BubbleProfileCache::Clear()
+  {
+#pragma omp critical( BubbleProfileCacheAccess )
+    {
+      profileLookup.clear();
+      profilesByUse.clear();
+    }
+  }
+
+  // This drops the least recently used profiles until there are no more than
+  // maximumNumberOfProfiles. It should only be called from within the
+  // critical section for the cache.
+  void BubbleProfileCache::DropExcessProfiles()
+  {
+    while( profilesByUse.size() > maximumNumberOfProfiles )
+    {
+      profileLookup.erase( profilesByUse.back().first );
+      profilesByUse.pop_back();
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -14,13 +14,19 @@ namespace VevaciousPlusPlus
 
   BubbleShootingOnPathInFieldSpace::BubbleShootingOnPathInFieldSpace(
                                             double const lengthScaleResolution,
-                                           unsigned int const shootAttempts ) :
+                                             unsigned int const shootAttempts,
+            UndershootOvershootBubble::OdeStepperChoice const odeStepperChoice,
+                                           double const stepperTolerance ) :
     BounceActionCalculator(),
     lengthScaleResolution( lengthScaleResolution ),
     radialStepSize( -1.0 ),
     estimatedRadialMaximum( -1.0 ),
     shootAttempts( shootAttempts ),
-    auxiliaryThreshold( 1.0E-6 )
+    auxiliaryThreshold( 1.0E-6 ),
+    odeStepperChoice( odeStepperChoice ),
+    stepperTolerance( stepperTolerance ),
+    bufferPool(),
+    lastBubbleCenterAuxiliary( -1.0 )
   {
     // This constructor is just an initialization list.
   }
@@ -37,7 +43,10 @@ namespace VevaciousPlusPlus
   // bounce action integrated over four dimensions, or S_3(T), the dimensionful
   // (in GeV) thermal bounce action integrated over three dimensions at
   // temperature T, is calculated: S_3(T) if the temperature T given by
-  // tunnelPath is greater than 0.0, S_4 otherwise.
+  // tunnelPath is greater than 0.0, S_4 otherwise. The shooting starts from
+  // the bubble center of the last path since the last call of ResetVacua, as
+  // successive paths are usually small changes of each other, and the bubble
+  // profile takes its memory from bufferPool.
   BubbleProfile*
   BubbleShootingOnPathInFieldSpace::operator()( TunnelPath const& tunnelPath,
                   OneDimensionalPotentialAlongPath const& pathPotential ) const
@@ -46,9 +55,14 @@ namespace VevaciousPlusPlus
     bubbleProfile( new UndershootOvershootBubble( radialStepSize,
                                                   estimatedRadialMaximum,
                                                   shootAttempts,
-                                                  auxiliaryThreshold ) );
+                                                  auxiliaryThreshold,
+                                                  lastBubbleCenterAuxiliary,
+                                                  &bufferPool,
+                                                  odeStepperChoice,
+                                                  stepperTolerance ) );
     bubbleProfile->CalculateProfile( tunnelPath,
                                      pathPotential );
+    lastBubbleCenterAuxiliary = bubbleProfile->AuxiliaryAtBubbleCenter();
 
     bool const nonZeroTemperature( tunnelPath.NonZeroTemperature() );
     std::vector< BubbleRadialValueDescription > const&
@@ -117,8 +131,22 @@ namespace VevaciousPlusPlus
                                                tunnelPath,
                                               auxiliaryProfile.front() ) ) ) );
 
+    // If the bounce action was integrated along with the bubble profile with
+    // error control, that replaces the sum over the shells (doubled to match
+    // leaving the common factor of 0.5 until the end), so the loop is skipped
+    // apart from setting the radial values for the last shell.
+    size_t const shellsToSum( bubbleProfile->ActionIsIntegrated() ?
+                              1 :
+                              ( auxiliaryProfile.size() - 1 ) );
+    if( bubbleProfile->ActionIsIntegrated() )
+    {
+      bounceAction = ( 2.0 * bubbleProfile->IntegratedActionToProfileEnd() );
+      // The last shell then has zero width.
+      currentRadius = auxiliaryProfile.back().radialValue;
+      nextRadius = currentRadius;
+    }
     for( size_t radiusIndex( 1 );
-         radiusIndex < ( auxiliaryProfile.size() - 1 );
+         radiusIndex < shellsToSum;
          ++radiusIndex )
     {
       previousRadius = currentRadius;
@@ -18,7 +18,10 @@ namespace VevaciousPlusPlus
                 pathParameterization,
                 pathTemperature ),
     pathSegments( pathNodes.size() - 1 ),
-    slopeSquared( -1.0 )
+    slopeSquared( -1.0 ),
+    segmentStarts( pathNodes.size() ),
+    segmentsAreUniform( true ),
+    inverseUniformSegmentLength( static_cast< double >( pathSegments.size() ) )
   {
     std::vector< double > segmentLengths( pathSegments.size() );
     double totalLength( 0.0 );
@@ -55,6 +58,27 @@ namespace VevaciousPlusPlus
       = LinearSplinePathSegment( pathNodes[ segmentIndex ],
                                  pathNodes[ segmentIndex + 1 ],
                      ( segmentLengths[ segmentIndex ] * inverseTotalLength ) );
+      segmentStarts[ segmentIndex + 1 ]
+      = ( segmentStarts[ segmentIndex ]
+          + pathSegments[ segmentIndex ].SegmentLength() );
+    }
+
+    // Dividing by the length of the segments is only safe if every segment
+    // starts within a tiny fraction of a segment length of where it would if
+    // all the segments were of equal length.
+    double const
+    uniformTolerance( 1.0e-12 / static_cast< double >( pathSegments.size() ) );
+    for( size_t segmentIndex( 1 );
+         segmentIndex < pathSegments.size();
+         ++segmentIndex )
+    {
+      if( fabs( segmentStarts[ segmentIndex ]
+                - ( static_cast< double >( segmentIndex )
+                    / inverseUniformSegmentLength ) ) > uniformTolerance )
+      {
+        segmentsAreUniform = false;
+        break;
+      }
     }
   }
 
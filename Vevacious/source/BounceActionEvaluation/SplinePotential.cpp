@@ -30,19 +30,20 @@ namespace VevaciousPlusPlus
     lastSegmentQuadratic( -1.0 ),
     energyBarrierWasResolved( false ),
     tunnelingPossibleOnPath( false ),
-    fieldConfiguration( potentialFunction.NumberOfFieldVariables() ),
     potentialFunction( potentialFunction ),
     tunnelPath( tunnelPath ),
-    pathTemperature( tunnelPath.TemperatureValue() )
+    pathTemperature( tunnelPath.TemperatureValue() ),
+    sampledConfigurations(),
+    sampledPotentials()
   {
+    // The potential is needed at most of the segment ends in the scans below,
+    // so all of them are evaluated together up front.
+    SamplePotentialAlongPath( numberOfPotentialSegments );
+
     // First we have to find the path false minimum. The base constructor
     // already set auxiliaryOfPathPanicVacuum to zero.
-    tunnelPath.PutOnPathAt( fieldConfiguration,
-                            auxiliaryOfPathFalseVacuum );
-    std::vector< double > const
-    pathFalseEndConfiguration( fieldConfiguration );
-    pathFalsePotential = potentialFunction( pathFalseEndConfiguration,
-                                            pathTemperature );
+    size_t const numberOfFields( potentialFunction.NumberOfFieldVariables() );
+    pathFalsePotential = sampledPotentials.front();
 
     // We start at the assumed path false vacuum, then move along the resolved
     // segment ends to find any that are lower which are not separated by an
@@ -66,8 +67,7 @@ namespace VevaciousPlusPlus
 
       // The return value of RollForwardToLocalMinimum is false if it moves all
       // the way to the true vacuum end of the path without the potential ever
-      // increasing. Here fieldConfiguration is being used as the field
-      // configuration of the path false vacuum.
+      // increasing.
       tunnelingPossibleOnPath
       = RollForwardToPathFalseVacuum( maximumIndexBeforeGivenTrueVauum );
       if( !tunnelingPossibleOnPath )
@@ -107,12 +107,16 @@ namespace VevaciousPlusPlus
       // path.
       double vacuaSeparationSquared( 0.0 );
       double fieldDifference( 0.0 );
+      double const* const
+      panicConfiguration( sampledConfigurations.data()
+                          + ( numberOfFields
+                              * SampleIndex( auxiliaryOfPathPanicVacuum ) ) );
       for( size_t fieldIndex( 0 );
-           fieldIndex < potentialFunction.NumberOfFieldVariables();
+           fieldIndex < numberOfFields;
            ++fieldIndex )
       {
-        fieldDifference = ( pathFalseEndConfiguration[ fieldIndex ]
-                            - fieldConfiguration[ fieldIndex ] );
+        fieldDifference = ( sampledConfigurations[ fieldIndex ]
+                            - panicConfiguration[ fieldIndex ] );
         vacuaSeparationSquared += ( fieldDifference * fieldDifference );
       }
       energyBarrierWasResolved
@@ -171,6 +175,28 @@ namespace VevaciousPlusPlus
   }
 
 
+  // This fills sampledConfigurations with the field configurations at the
+  // ( numberOfPotentialSegments + 1 ) segment ends along tunnelPath and
+  // sampledPotentials with the potential at each of them.
+  void SplinePotential::SamplePotentialAlongPath(
+                                 unsigned int const numberOfPotentialSegments )
+  {
+    size_t const numberOfSamples( numberOfPotentialSegments + 1 );
+    std::vector< double > sampleAuxiliaries( numberOfSamples );
+    for( size_t sampleIndex( 0 );
+         sampleIndex < numberOfSamples;
+         ++sampleIndex )
+    {
+      sampleAuxiliaries[ sampleIndex ] = ( sampleIndex * auxiliaryStep );
+    }
+    tunnelPath.PutOnPathAt( sampledConfigurations,
+                            sampleAuxiliaries );
+    potentialFunction.EvaluateBatch( sampledConfigurations,
+                                     pathTemperature,
+                                     sampledPotentials );
+  }
+
+
   // This returns the value of the potential at auxiliaryValue, by finding the
   // correct segment and then returning its value at that point.
   double SplinePotential::operator()( double auxiliaryValue ) const
@@ -329,7 +355,7 @@ namespace VevaciousPlusPlus
     << ", lastSegmentQuadratic = " << lastSegmentQuadratic
     << ", energyBarrierWasResolved = " << energyBarrierWasResolved
     << ", tunnelingPossibleOnPath = " << tunnelingPossibleOnPath
-    << ", fieldConfiguration not really relevant"
+    << ", sampledConfigurations not really relevant"
     << ", potentialFunction not really printable" << std::endl;
     returnStream << std::endl;
     returnStream << "tunnelPath = " << tunnelPath.AsDebuggingString()
@@ -16,7 +16,11 @@ namespace VevaciousPlusPlus
                                        double const initialIntegrationStepSize,
                                       double const initialIntegrationEndRadius,
                                       unsigned int const allowShootingAttempts,
-                                             double const shootingThreshold ) :
+                                               double const shootingThreshold,
+                                              double const warmStartAuxiliary,
+                                     BubbleProfileBufferPool* const bufferPool,
+                                   OdeStepperChoice const odeStepperChoice,
+                                             double const stepperTolerance ) :
     BubbleProfile(),
     auxiliaryProfile(),
     auxiliaryAtBubbleCenter( -1.0 ),
@@ -34,14 +38,34 @@ namespace VevaciousPlusPlus
     allowShootingAttempts( allowShootingAttempts ),
     worthIntegratingFurther( true ),
     currentShotGoodEnough( false ),
-    tunnelPath( NULL )
+    tunnelPath( NULL ),
+    warmStartAuxiliary( warmStartAuxiliary ),
+    bufferPool( bufferPool ),
+    falseConfiguration(),
+    currentConfiguration(),
+    initialConfiguration(),
+    odeStepperChoice( odeStepperChoice ),
+    stepperTolerance( stepperTolerance ),
+    odeintActionIntegrals(),
+    integratedActionToProfileEnd( 0.0 ),
+    actionScale( 1.0 )
   {
-    // This constructor is just an initialization list.
+    if( bufferPool != NULL )
+    {
+      bufferPool->TakeBuffer( auxiliaryProfile );
+      bufferPool->TakeBuffer( odeintProfile );
+    }
   }
 
   UndershootOvershootBubble::~UndershootOvershootBubble()
   {
-    // This does nothing.
+    // The buffers go back to the pool so that the next bubble profile does
+    // not have to allocate memory for them again.
+    if( bufferPool != NULL )
+    {
+      bufferPool->ReturnBuffer( auxiliaryProfile );
+      bufferPool->ReturnBuffer( odeintProfile );
+    }
   }
 
 
@@ -58,6 +82,8 @@ namespace VevaciousPlusPlus
   UndershootOvershootBubble::CalculateProfile( TunnelPath const& tunnelPath,
                         OneDimensionalPotentialAlongPath const& pathPotential )
   {
+    PerformanceLogger::ScopedTimer
+    shootingTimer( PerformanceRecord::BubbleShootingTimer );
     auxiliaryAtRadialInfinity = pathPotential.AuxiliaryOfPathFalseVacuum();
     double twoPlusTwiceDampingFactor( 8.0 );
     if( tunnelPath.NonZeroTemperature() )
@@ -67,6 +93,21 @@ namespace VevaciousPlusPlus
 
     unsigned int shootAttemptsLeft( allowShootingAttempts );
 
+    // If the bounce action is integrated along with the bubble profile, it is
+    // scaled to be roughly of order 1 so that the error control treats it
+    // like the auxiliary variable.
+    if( ActionIsIntegrated() )
+    {
+      actionScale
+      = ( fabs( pathPotential( pathPotential.AuxiliaryOfPathPanicVacuum() ) )
+          * pow( integrationEndRadius,
+                 ( 0.5 * twoPlusTwiceDampingFactor ) ) );
+      if( !( actionScale > 0.0 ) )
+      {
+        actionScale = 1.0;
+      }
+    }
+
     undershootAuxiliary = pathPotential.DefiniteUndershootAuxiliary();
     overshootAuxiliary = pathPotential.AuxiliaryOfPathPanicVacuum();
 
@@ -83,17 +124,75 @@ namespace VevaciousPlusPlus
       overshootAuxiliary -= pathPotential.AuxiliaryOfPathPanicVacuum();
     }
 
+    // If there is an auxiliary value from a similar path, the first shot is
+    // from there, then shots are taken at doubling distances from there in
+    // the direction of the perfect shot until it is bracketed (which is when
+    // the next shot would be outside the bracket). The initial step is the
+    // width of the bracket after half of the allowed bisections of the whole
+    // range.
+    double const
+    targetBracketWidth( ldexp( BracketWidth( pathPotential ),
+                            -static_cast< int >( allowShootingAttempts ) ) );
+    if( ( warmStartAuxiliary > pathPotential.DefiniteUndershootAuxiliary() )
+        &&
+        ( warmStartAuxiliary < pathPotential.AuxiliaryOfPathPanicVacuum() ) )
+    {
+      double warmStartStep( ldexp( BracketWidth( pathPotential ),
+                  -static_cast< int >( ( allowShootingAttempts + 1 ) / 2 ) ) );
+      double nextShot( warmStartAuxiliary );
+      while( !currentShotGoodEnough
+             &&
+             ( shootAttemptsLeft > 0 ) )
+      {
+        initialAuxiliary = ShotAuxiliary( nextShot,
+                                          pathPotential );
+        ShootFromInitialAuxiliary( tunnelPath,
+                                   pathPotential,
+                                   twoPlusTwiceDampingFactor );
+        --shootAttemptsLeft;
+
+        // An overshoot means that the perfect shot is closer to the path
+        // false vacuum, an undershoot that it is closer to the path panic
+        // vacuum.
+        if( overshootAuxiliary == initialAuxiliary )
+        {
+          nextShot -= warmStartStep;
+        }
+        else
+        {
+          nextShot += warmStartStep;
+        }
+        warmStartStep += warmStartStep;
+        double undershootAlongPath( undershootAuxiliary );
+        if( undershootAlongPath <= 0.0 )
+        {
+          undershootAlongPath += pathPotential.AuxiliaryOfPathPanicVacuum();
+        }
+        double overshootAlongPath( overshootAuxiliary );
+        if( overshootAlongPath <= 0.0 )
+        {
+          overshootAlongPath += pathPotential.AuxiliaryOfPathPanicVacuum();
+        }
+        if( !( ( nextShot > undershootAlongPath )
+               &&
+               ( nextShot < overshootAlongPath ) ) )
+        {
+          break;
+        }
+      }
+    }
+
     // This loop is broken out of if the shoot attempt seems to have been close
     // enough that the integration would take too long to find an overshoot or
-    // undershoot, or that the shot was dead on.
+    // undershoot, or that the shot was dead on, or if the bracket is as narrow
+    // as it would be after allowShootingAttempts bisections of the whole
+    // range.
     while( !currentShotGoodEnough
            &&
-           ( shootAttemptsLeft > 0 ) )
+           ( shootAttemptsLeft > 0 )
+           &&
+           ( BracketWidth( pathPotential ) > targetBracketWidth ) )
     {
-      worthIntegratingFurther = true;
-      auxiliaryProfile.clear();
-      integrationStartRadius = integrationStepSize;
-
       // It shouldn't ever happen that undershootAuxiliary is negative while
       // overshootAuxiliary is positive, as then the undershoot would be at a
       // larger auxiliary value than the overshoot.
@@ -115,169 +214,23 @@ namespace VevaciousPlusPlus
         = ( 0.5 * ( undershootAuxiliary + overshootAuxiliary ) );
       }
 
-      // We cannot start at r = 0, as the damping term is proportional to 1/r,
-      // so the initial conditions are set by a Euler step assuming that near
-      // r = 0, p goes as p_0 + p_2 r^2 (as the bubble should have smooth
-      // fields at its center); hence d^2p/dr^2 (= 2 p_2) at r = 0 is
-      // ( dV/dp ) / ( ( 1 + dampingFactor ) |df/dp|^2 ).
-      // The initial step should be big enough that the initial conditions for
-      // Boost::odeint will not suffer from precision problems from being too
-      // close to the path panic minimum.
-      if( initialAuxiliary <= 0.0 )
-      {
-        // If we're close to the path panic minimum, we go with a full solution
-        // of the equation linearized in p:
-        // [d^2/dr^2 + (dampingFactor/r)d/dr - ((d^2V/dp^2)/(|df/dp|^2))] p = 0
-        // assuming that p is close enough to a minimum that dV/dp is
-        // proportional to p and that dp/dr is small enough that we can neglect
-        // the (dp/dr)^2 (df/dp).(d^2f/dp^2) part of (df/dp).(d^2f/dr^2).
-        // The solutions are actually quite neat:
-        // T = 0: p - p_0 = (p_i - p_0) * ( [ (4 * I_1(b*r)) / (b*r) ] - 1 )
-        // T != 0: p - p_0 = (p_i - p_0) * ( [ (2 * sinh(b*r)) / (b*r) ] - 1 )
-        // where I_1 is the modified Bessel function of the 1st kind,
-        // b^2 = ((d^2V/dp^2)/(|df/dp|^2), p_0 is the auxiliary value at the
-        // path panic minimum, and p_i is the initial value of the auxiliary
-        // variable for the shoot.
-
-        // We need the value of r such that |dp/dr| is larger than
-        // auxiliaryPrecisionResolution but not much larger. We start assuming
-        // that r is small and that we can expand out p(r) as p_0 + p_2 r^2,
-        // which gives the same result as in the else statement complementary
-        // to this branch, but here dV/dp = 2 * (p-p_0) * d^2V/dp^2.
-        double const initialPositiveAuxiliary( initialAuxiliary
-                                + pathPotential.AuxiliaryOfPathPanicVacuum() );
-        double const scaledSecondDerivative(
-                pathPotential.SecondDerivativeNearPathPanic( initialAuxiliary )
-                       / tunnelPath.SlopeSquared( initialPositiveAuxiliary ) );
-        double const
-        initialQuadraticCoefficient( 2.0 * initialAuxiliary
-                                         * scaledSecondDerivative );
-
-        // Because the potential is simply 2 minima with a maximum in between
-        // (either originally so or truncated to it), and because
-        // undershootAuxiliary is already past the maximum, the slope of the
-        // potential at initialAuxiliary must be negative (in this case, a
-        // negative initialAuxiliary times a positive second derivative), hence
-        // the negative numerator.
-        integrationStartRadius = ( -auxiliaryPrecisionResolution
-               / ( 2.0 * initialQuadraticCoefficient * integrationStepSize ) );
-
-        if( integrationStartRadius <= integrationStepSize )
-        {
-          // If integrationStartRadius turns out to be relatively small, we
-          // carry on with the Euler step from the small-r approximation.
-          initialConditions[ 0 ] = ( initialPositiveAuxiliary
-                                     + ( initialQuadraticCoefficient
-                                         * integrationStartRadius
-                                         * integrationStartRadius ) );
-          initialConditions[ 1 ] = ( 2.0 * initialQuadraticCoefficient
-                                         * integrationStartRadius );
-        }
-        else
-        {
-          // If it turns out that maybe the initial step is too large to
-          // consider the small-r expansion valid, we use the better
-          // Bessel/sinh approximation mentioned above.
-          double const inverseRadialScale( sqrt( scaledSecondDerivative ) );
-          double const minimumScaledSlope( -auxiliaryPrecisionResolution
-                                 / ( initialAuxiliary * inverseRadialScale ) );
-          double scaledRadius( std::max( log( minimumScaledSlope ),
-                              ( inverseRadialScale * integrationStepSize ) ) );
-          double scaledSlope( sinhOrBesselScaledSlope(
-                                               tunnelPath.NonZeroTemperature(),
-                                                       scaledRadius ) );
-          while( ( scaledSlope > ( 2.0 * minimumScaledSlope ) )
-                 &&
-                 ( scaledSlope > auxiliaryPrecisionResolution ) )
-          {
-            scaledRadius *= 0.5;
-            scaledSlope
-            = sinhOrBesselScaledSlope( tunnelPath.NonZeroTemperature(),
-                                       scaledRadius );
-          }
-          while( scaledSlope < minimumScaledSlope )
-          {
-            scaledRadius = std::min( ( 2.0 * scaledRadius ),
-                                     ( scaledRadius + 1.0 ) );
-            scaledSlope
-            = sinhOrBesselScaledSlope( tunnelPath.NonZeroTemperature(),
-                                       scaledRadius );
-          }
-          // At this point, the slope of p(r) at
-          // r = ( inverseRadialScale * scaledSlope ) should be large enough
-          // that the magnitude of its product with integrationStepSize should
-          // be larger than auxiliaryPrecisionResolution and thus the numeric
-          // integration should be able to proceed normally.
-          double sinhOrBesselPart( -2.0 );
-          if( tunnelPath.NonZeroTemperature() )
-          {
-            sinhOrBesselPart = ( sinh( scaledRadius ) / scaledRadius );
-          }
-          else
-          {
-            sinhOrBesselPart = ( ( 2.0 * boost::math::cyl_bessel_i( (int)1,
-                                                               scaledRadius ) )
-                                 / scaledRadius );
-          }
-          // As above:
-          // p - p_0 = (p_i - p_0) * ( [ (4 * I_1(b*r)) / (b*r) ] - 1 )
-          // or p - p_0 = (p_i - p_0) * ( [ (2 * sinh(b*r)) / (b*r) ] - 1 )
-          initialConditions[ 0 ] = ( pathPotential.AuxiliaryOfPathPanicVacuum()
-                                     + ( initialAuxiliary
-                                    * ( ( 2.0 * sinhOrBesselPart ) - 1.0 ) ) );
-          initialConditions[ 1 ]
-          = ( initialAuxiliary * inverseRadialScale * scaledSlope );
-          integrationStartRadius = ( scaledRadius / inverseRadialScale );
-        }
-      }
-      else
-      {
-        // If we're not starting in the last segment, we should not be
-        // suffering from any of the problems due to having to roll very slowly
-        // for a long r.
-        double const initialPotentialDerivative( pathPotential.FirstDerivative(
-                                                          initialAuxiliary ) );
-        double const initialQuadraticCoefficient( initialPotentialDerivative
-                                                  / ( twoPlusTwiceDampingFactor
-                             * tunnelPath.SlopeSquared( initialAuxiliary ) ) );
-
-        // Because the potential is simply 2 minima with a maximum in between
-        // (either originally so or truncated to it), and because
-        // undershootAuxiliary is already past the maximum, the slope of the
-        // potential at initialAuxiliary must be negative, hence the negative
-        // numerator.
-        integrationStartRadius = ( -auxiliaryPrecisionResolution
-               / ( 2.0 * initialQuadraticCoefficient * integrationStepSize ) );
-
-        initialConditions[ 0 ] = ( initialAuxiliary
-                                   + ( initialQuadraticCoefficient
-                                       * integrationStartRadius
-                                       * integrationStartRadius ) );
-        initialConditions[ 1 ] = ( 2.0 * initialQuadraticCoefficient
-                                       * integrationStartRadius );
-      }
-
-      // We have to ensure that the end radius is larger than the start radius.
-      integrationEndRadius = std::max( integrationEndRadius,
-                                       ( 2.0 * integrationStartRadius ) );
-      ShootFromInitialConditions( tunnelPath,
-                                  pathPotential );
-
-      while( worthIntegratingFurther )
-      {
-        integrationStartRadius = auxiliaryProfile.back().radialValue;
-        initialConditions[ 0 ] = auxiliaryProfile.back().auxiliaryValue;
-        initialConditions[ 1 ] = auxiliaryProfile.back().auxiliarySlope;
-        integrationEndRadius = ( 2.0 * integrationStartRadius );
-        ShootFromInitialConditions( tunnelPath,
-                                    pathPotential );
-      }
+      ShootFromInitialAuxiliary( tunnelPath,
+                                 pathPotential,
+                                 twoPlusTwiceDampingFactor );
       --shootAttemptsLeft;
     }
     // At the end of the loop, initialAuxiliary is either within
     // 2^(-undershootOvershootAttempts) of p_crit, or was close enough that the
     // integration to decide if it was an undershoot or overshoot would take
     // too long.
+    unsigned int const
+    shootingAttempts( allowShootingAttempts - shootAttemptsLeft );
+    PerformanceLogger::IncrementCounter( PerformanceRecord::BubbleProfiles );
+    PerformanceLogger::IncrementCounter( PerformanceRecord::ShootingAttempts,
+                                         shootingAttempts );
+    PerformanceLogger::AddToHistogram(
+                           PerformanceRecord::ShootingAttemptsPerBubbleProfile,
+                                       shootingAttempts );
 
     if( initialAuxiliary < 0.0 )
     {
@@ -290,6 +243,190 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This sets up initialConditions for a shot from initialAuxiliary and then
+  // integrates until the shot is definitely an undershoot or an overshoot, or
+  // is close enough to the false vacuum.
+  void UndershootOvershootBubble::ShootFromInitialAuxiliary(
+                                                  TunnelPath const& tunnelPath,
+                         OneDimensionalPotentialAlongPath const& pathPotential,
+                                      double const twoPlusTwiceDampingFactor )
+  {
+    worthIntegratingFurther = true;
+    auxiliaryProfile.clear();
+    integrationStartRadius = integrationStepSize;
+
+    // We cannot start at r = 0, as the damping term is proportional to 1/r,
+    // so the initial conditions are set by a Euler step assuming that near
+    // r = 0, p goes as p_0 + p_2 r^2 (as the bubble should have smooth
+    // fields at its center); hence d^2p/dr^2 (= 2 p_2) at r = 0 is
+    // ( dV/dp ) / ( ( 1 + dampingFactor ) |df/dp|^2 ).
+    // The initial step should be big enough that the initial conditions for
+    // Boost::odeint will not suffer from precision problems from being too
+    // close to the path panic minimum.
+    if( initialAuxiliary <= 0.0 )
+    {
+      // If we're close to the path panic minimum, we go with a full solution
+      // of the equation linearized in p:
+      // [d^2/dr^2 + (dampingFactor/r)d/dr - ((d^2V/dp^2)/(|df/dp|^2))] p = 0
+      // assuming that p is close enough to a minimum that dV/dp is
+      // proportional to p and that dp/dr is small enough that we can neglect
+      // the (dp/dr)^2 (df/dp).(d^2f/dp^2) part of (df/dp).(d^2f/dr^2).
+      // The solutions are actually quite neat:
+      // T = 0: p - p_0 = (p_i - p_0) * ( [ (4 * I_1(b*r)) / (b*r) ] - 1 )
+      // T != 0: p - p_0 = (p_i - p_0) * ( [ (2 * sinh(b*r)) / (b*r) ] - 1 )
+      // where I_1 is the modified Bessel function of the 1st kind,
+      // b^2 = ((d^2V/dp^2)/(|df/dp|^2), p_0 is the auxiliary value at the
+      // path panic minimum, and p_i is the initial value of the auxiliary
+      // variable for the shoot.
+
+      // We need the value of r such that |dp/dr| is larger than
+      // auxiliaryPrecisionResolution but not much larger. We start assuming
+      // that r is small and that we can expand out p(r) as p_0 + p_2 r^2,
+      // which gives the same result as in the else statement complementary
+      // to this branch, but here dV/dp = 2 * (p-p_0) * d^2V/dp^2.
+      double const initialPositiveAuxiliary( initialAuxiliary
+                              + pathPotential.AuxiliaryOfPathPanicVacuum() );
+      double const scaledSecondDerivative(
+              pathPotential.SecondDerivativeNearPathPanic( initialAuxiliary )
+                     / tunnelPath.SlopeSquared( initialPositiveAuxiliary ) );
+      double const
+      initialQuadraticCoefficient( 2.0 * initialAuxiliary
+                                       * scaledSecondDerivative );
+
+      // Because the potential is simply 2 minima with a maximum in between
+      // (either originally so or truncated to it), and because
+      // undershootAuxiliary is already past the maximum, the slope of the
+      // potential at initialAuxiliary must be negative (in this case, a
+      // negative initialAuxiliary times a positive second derivative), hence
+      // the negative numerator.
+      integrationStartRadius = ( -auxiliaryPrecisionResolution
+             / ( 2.0 * initialQuadraticCoefficient * integrationStepSize ) );
+
+      if( integrationStartRadius <= integrationStepSize )
+      {
+        // If integrationStartRadius turns out to be relatively small, we
+        // carry on with the Euler step from the small-r approximation.
+        initialConditions[ 0 ] = ( initialPositiveAuxiliary
+                                   + ( initialQuadraticCoefficient
+                                       * integrationStartRadius
+                                       * integrationStartRadius ) );
+        initialConditions[ 1 ] = ( 2.0 * initialQuadraticCoefficient
+                                       * integrationStartRadius );
+      }
+      else
+      {
+        // If it turns out that maybe the initial step is too large to
+        // consider the small-r expansion valid, we use the better
+        // Bessel/sinh approximation mentioned above.
+        double const inverseRadialScale( sqrt( scaledSecondDerivative ) );
+        double const minimumScaledSlope( -auxiliaryPrecisionResolution
+                               / ( initialAuxiliary * inverseRadialScale ) );
+        double scaledRadius( std::max( log( minimumScaledSlope ),
+                            ( inverseRadialScale * integrationStepSize ) ) );
+        double scaledSlope( sinhOrBesselScaledSlope(
+                                             tunnelPath.NonZeroTemperature(),
+                                                     scaledRadius ) );
+        while( ( scaledSlope > ( 2.0 * minimumScaledSlope ) )
+               &&
+               ( scaledSlope > auxiliaryPrecisionResolution ) )
+        {
+          scaledRadius *= 0.5;
+          scaledSlope
+          = sinhOrBesselScaledSlope( tunnelPath.NonZeroTemperature(),
+                                     scaledRadius );
+        }
+        while( scaledSlope < minimumScaledSlope )
+        {
+          scaledRadius = std::min( ( 2.0 * scaledRadius ),
+                                   ( scaledRadius + 1.0 ) );
+          scaledSlope
+          = sinhOrBesselScaledSlope( tunnelPath.NonZeroTemperature(),
+                                     scaledRadius );
+        }
+        // At this point, the slope of p(r) at
+        // r = ( inverseRadialScale * scaledSlope ) should be large enough
+        // that the magnitude of its product with integrationStepSize should
+        // be larger than auxiliaryPrecisionResolution and thus the numeric
+        // integration should be able to proceed normally.
+        double sinhOrBesselPart( -2.0 );
+        if( tunnelPath.NonZeroTemperature() )
+        {
+          sinhOrBesselPart = ( sinh( scaledRadius ) / scaledRadius );
+        }
+        else
+        {
+          sinhOrBesselPart = ( ( 2.0 * boost::math::cyl_bessel_i( (int)1,
+                                                             scaledRadius ) )
+                               / scaledRadius );
+        }
+        // As above:
+        // p - p_0 = (p_i - p_0) * ( [ (4 * I_1(b*r)) / (b*r) ] - 1 )
+        // or p - p_0 = (p_i - p_0) * ( [ (2 * sinh(b*r)) / (b*r) ] - 1 )
+        initialConditions[ 0 ] = ( pathPotential.AuxiliaryOfPathPanicVacuum()
+                                   + ( initialAuxiliary
+                                  * ( ( 2.0 * sinhOrBesselPart ) - 1.0 ) ) );
+        initialConditions[ 1 ]
+        = ( initialAuxiliary * inverseRadialScale * scaledSlope );
+        integrationStartRadius = ( scaledRadius / inverseRadialScale );
+      }
+    }
+    else
+    {
+      // If we're not starting in the last segment, we should not be
+      // suffering from any of the problems due to having to roll very slowly
+      // for a long r.
+      double const initialPotentialDerivative( pathPotential.FirstDerivative(
+                                                        initialAuxiliary ) );
+      double const initialQuadraticCoefficient( initialPotentialDerivative
+                                                / ( twoPlusTwiceDampingFactor
+                           * tunnelPath.SlopeSquared( initialAuxiliary ) ) );
+
+      // Because the potential is simply 2 minima with a maximum in between
+      // (either originally so or truncated to it), and because
+      // undershootAuxiliary is already past the maximum, the slope of the
+      // potential at initialAuxiliary must be negative, hence the negative
+      // numerator.
+      integrationStartRadius = ( -auxiliaryPrecisionResolution
+             / ( 2.0 * initialQuadraticCoefficient * integrationStepSize ) );
+
+      initialConditions[ 0 ] = ( initialAuxiliary
+                                 + ( initialQuadraticCoefficient
+                                     * integrationStartRadius
+                                     * integrationStartRadius ) );
+      initialConditions[ 1 ] = ( 2.0 * initialQuadraticCoefficient
+                                     * integrationStartRadius );
+    }
+
+    // We have to ensure that the end radius is larger than the start radius.
+    integrationEndRadius = std::max( integrationEndRadius,
+                                     ( 2.0 * integrationStartRadius ) );
+
+    // If the bounce action is integrated along with the bubble profile, the
+    // contribution from inside integrationStartRadius is taken as just the
+    // potential energy at the center of the bubble, as the kinetic term
+    // vanishes at the center.
+    if( ActionIsIntegrated() )
+    {
+      double const volumePower( 0.5 * ( twoPlusTwiceDampingFactor - 2.0 ) );
+      integratedActionToProfileEnd = ( pathPotential( initialConditions[ 0 ] )
+                                       * pow( integrationStartRadius,
+                                              volumePower )
+                                       / volumePower );
+    }
+    ShootFromInitialConditions( tunnelPath,
+                                pathPotential );
+
+    while( worthIntegratingFurther )
+    {
+      integrationStartRadius = auxiliaryProfile.back().radialValue;
+      initialConditions[ 0 ] = auxiliaryProfile.back().auxiliaryValue;
+      initialConditions[ 1 ] = auxiliaryProfile.back().auxiliarySlope;
+      integrationEndRadius = ( 2.0 * integrationStartRadius );
+      ShootFromInitialConditions( tunnelPath,
+                                  pathPotential );
+    }
+  }
+
   // This looks through odeintProfile to see if there was a definite
   // undershoot or overshoot, setting undershootAuxiliary or
   // overshootAuxiliary respectively, as well as setting
@@ -334,6 +471,11 @@ namespace VevaciousPlusPlus
         auxiliaryProfile.insert( auxiliaryProfile.end(),
                                  ( odeintProfile.begin() + 1 ),
                                  ( odeintProfile.begin() + radialIndex ) );
+        if( ActionIsIntegrated() )
+        {
+          integratedActionToProfileEnd
+          = odeintActionIntegrals[ radialIndex - 1 ];
+        }
       }
     }
     else
@@ -341,22 +483,31 @@ namespace VevaciousPlusPlus
       auxiliaryProfile.insert( auxiliaryProfile.end(),
                                ( odeintProfile.begin() + 1 ),
                                odeintProfile.end() );
+      if( ActionIsIntegrated()
+          &&
+          ( odeintProfile.size() > 1 ) )
+      {
+        integratedActionToProfileEnd = odeintActionIntegrals.back();
+      }
     }
     odeintProfile.clear();
+    odeintActionIntegrals.clear();
 
     // If there wasn't an undershoot or overshoot, currentShotGoodEnough
     // has to be set based on whether the shot got close enough to the false
     // vacuum.
     if( worthIntegratingFurther )
     {
+      // The configuration vectors are kept between calls so that they only
+      // have to be allocated once per bubble profile.
       size_t const numberOfFields( tunnelPath.NumberOfFields() );
-      std::vector< double > falseConfiguration( numberOfFields );
+      falseConfiguration.resize( numberOfFields );
       tunnelPath.PutOnPathAt( falseConfiguration,
                               auxiliaryAtRadialInfinity );
-      std::vector< double > currentConfiguration( falseConfiguration.size() );
+      currentConfiguration.resize( numberOfFields );
       tunnelPath.PutOnPathAt( currentConfiguration,
                               auxiliaryProfile.back().auxiliaryValue );
-      std::vector< double > initialConfiguration( falseConfiguration.size() );
+      initialConfiguration.resize( numberOfFields );
       tunnelPath.PutOnPathAt( initialConfiguration,
                               initialAuxiliary );
       double initialDistanceSquared( 0.0 );
@@ -382,4 +533,138 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This integrates the bubble equation of motion and the bounce action from
+  // initialConditions and integratedActionToProfileEnd with the dense-output
+  // stepper given by odeStepperChoice, filling odeintProfile and
+  // odeintActionIntegrals.
+  void UndershootOvershootBubble::ShootWithDenseOutput(
+                                                  TunnelPath const& tunnelPath,
+                        OneDimensionalPotentialAlongPath const& pathPotential )
+  {
+    odeintProfile.clear();
+    odeintActionIntegrals.clear();
+    OdeintBubbleActionDerivatives bubbleActionDerivatives( pathPotential,
+                                                           tunnelPath,
+                                                           actionScale );
+    if( odeStepperChoice == RosenbrockDense )
+    {
+      OdeintBubbleActionJacobian
+      bubbleActionJacobian( bubbleActionDerivatives );
+      OdeintBubbleActionJacobian::StateVector integrationState( 3 );
+      integrationState[ 0 ] = initialConditions[ 0 ];
+      integrationState[ 1 ] = initialConditions[ 1 ];
+      integrationState[ 2 ] = ( integratedActionToProfileEnd / actionScale );
+      typedef boost::numeric::odeint::rosenbrock4< double > RosenbrockStepper;
+      boost::numeric::odeint::result_of::make_dense_output<
+                                                    RosenbrockStepper >::type
+      denseStepper( boost::numeric::odeint::make_dense_output(
+                                                              stepperTolerance,
+                                                              stepperTolerance,
+                                                       RosenbrockStepper() ) );
+      IntegrateToEvent( denseStepper,
+                        std::make_pair( bubbleActionDerivatives,
+                                        bubbleActionJacobian ),
+                        integrationState );
+    }
+    else
+    {
+      typedef
+      boost::numeric::odeint::runge_kutta_dopri5< std::vector< double > >
+      DormandPrinceStepper;
+      std::vector< double > integrationState( 3 );
+      integrationState[ 0 ] = initialConditions[ 0 ];
+      integrationState[ 1 ] = initialConditions[ 1 ];
+      integrationState[ 2 ] = ( integratedActionToProfileEnd / actionScale );
+      boost::numeric::odeint::result_of::make_dense_output<
+                                                 DormandPrinceStepper >::type
+      denseStepper( boost::numeric::odeint::make_dense_output(
+                                                              stepperTolerance,
+                                                              stepperTolerance,
+                                                    DormandPrinceStepper() ) );
+      IntegrateToEvent( denseStepper,
+                        bubbleActionDerivatives,
+                        integrationState );
+    }
+  }
+
+  // This steps denseStepper from integrationStartRadius until
+  // integrationEndRadius, or until the shot is definitely an undershoot or an
+  // overshoot, in which case the radial value where that first happens is
+  // found by bisection using the dense output. The state at the end of each
+  // step is recorded in odeintProfile and odeintActionIntegrals, and if the
+  // integration stopped early, the last 2 points recorded are just before and
+  // just after the shot was decided.
+  template< class DenseStepper, class SystemType, class StateType >
+  void UndershootOvershootBubble::IntegrateToEvent( DenseStepper& denseStepper,
+                                                    SystemType bubbleSystem,
+                                                  StateType& integrationState )
+  {
+    RecordDenseOutputPoint( integrationStartRadius,
+                            integrationState );
+    denseStepper.initialize( integrationState,
+                             integrationStartRadius,
+                             integrationStepSize );
+    while( denseStepper.current_time() < integrationEndRadius )
+    {
+      denseStepper.do_step( bubbleSystem );
+      double const stepEndRadius( std::min( denseStepper.current_time(),
+                                            integrationEndRadius ) );
+      denseStepper.calc_state( stepEndRadius,
+                               integrationState );
+      if( !(ShotIsDecided( integrationState )) )
+      {
+        RecordDenseOutputPoint( stepEndRadius,
+                                integrationState );
+        continue;
+      }
+
+      // The shot was decided somewhere in the last step, so the radial value
+      // where it was decided is bracketed by bisection until the bracket is
+      // narrower than stepperTolerance relative to the radial value.
+      double undecidedRadius( denseStepper.previous_time() );
+      double decidedRadius( stepEndRadius );
+      while( ( decidedRadius - undecidedRadius )
+             > ( stepperTolerance * decidedRadius ) )
+      {
+        double const middleRadius( 0.5 * ( undecidedRadius + decidedRadius ) );
+        denseStepper.calc_state( middleRadius,
+                                 integrationState );
+        if( ShotIsDecided( integrationState ) )
+        {
+          decidedRadius = middleRadius;
+        }
+        else
+        {
+          undecidedRadius = middleRadius;
+        }
+      }
+      // The start of the step has already been recorded.
+      if( undecidedRadius > denseStepper.previous_time() )
+      {
+        denseStepper.calc_state( undecidedRadius,
+                                 integrationState );
+        RecordDenseOutputPoint( undecidedRadius,
+                                integrationState );
+      }
+      denseStepper.calc_state( decidedRadius,
+                               integrationState );
+      RecordDenseOutputPoint( decidedRadius,
+                              integrationState );
+      return;
+    }
+  }
+
+  // This records the point given by radialValue and integrationState in
+  // odeintProfile and odeintActionIntegrals.
+  template< class StateType >
+  void UndershootOvershootBubble::RecordDenseOutputPoint(
+                                                     double const radialValue,
+                                            StateType const& integrationState )
+  {
+    odeintProfile.push_back( BubbleRadialValueDescription( radialValue,
+                                                         integrationState[ 0 ],
+                                                   integrationState[ 1 ] ) );
+    odeintActionIntegrals.push_back( integrationState[ 2 ] * actionScale );
+  }
+
 } /* namespace VevaciousPlusPlus */
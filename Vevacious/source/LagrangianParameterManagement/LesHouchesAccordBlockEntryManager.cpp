@@ -27,6 +27,7 @@ namespace VevaciousPlusPlus
     activeParametersToIndices(),
     referenceSafeActiveParameters(),
     referenceUnsafeActiveParameters(),
+    sharedScaleTable(),
     validBlocks(),
     lhaParser(),
     minimumScaleType( minimumScaleType ),
@@ -52,6 +53,7 @@ namespace VevaciousPlusPlus
     activeParametersToIndices(),
     referenceSafeActiveParameters(),
     referenceUnsafeActiveParameters(),
+    sharedScaleTable(),
     validBlocks( validBlocksSet ),
     lhaParser(),
     minimumScaleType( minimumScaleType ),
@@ -71,6 +73,7 @@ namespace VevaciousPlusPlus
     activeParametersToIndices(),
     referenceSafeActiveParameters(),
     referenceUnsafeActiveParameters(),
+    sharedScaleTable(),
     validBlocks(),
     lhaParser(),
     minimumScaleType( "FixedNumber" ),
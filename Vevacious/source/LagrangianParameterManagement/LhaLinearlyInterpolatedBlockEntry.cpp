@@ -12,7 +12,7 @@ namespace VevaciousPlusPlus
 
   LhaLinearlyInterpolatedBlockEntry::LhaLinearlyInterpolatedBlockEntry(
                                               size_t const indexInValuesVector,
-                                        LHPC::SimpleLhaParser const& lhaParser,
+                                       VirtualSimpleLhaParser const& lhaParser,
                                            std::string const& parameterName ) :
     LhaInterpolatedParameterFunctionoid( indexInValuesVector,
                                           lhaParser,
@@ -42,10 +42,9 @@ namespace VevaciousPlusPlus
   // block's scale according to the current status of the block.
   void LhaLinearlyInterpolatedBlockEntry::UpdateForNewLhaParameters()
   {
-    std::list< std::pair< std::string, double > > entriesAtScales;
-    (*lhaParser)( parameterName,
-                  entriesAtScales,
-                  true );
+    std::vector< std::pair< double, double > > entriesAtScales;
+    NumericEntries( entriesAtScales,
+                    true );
     size_t const numberOfScales( entriesAtScales.size() );
 
     // First we guard against no block found (in which case the value is set
@@ -63,26 +62,21 @@ namespace VevaciousPlusPlus
         // If there were no entries with explicit scales, we check for entries
         // in blocks without scales, which will be assumed to be constant over
         // all scales.
-        (*lhaParser)( parameterName,
-                      entriesAtScales,
-                      false );
+        NumericEntries( entriesAtScales,
+                        false );
         if( entriesAtScales.empty() )
         {
           logScalesWithValues[ 0 ].second = 0.0;
         }
         else
         {
-          logScalesWithValues[ 0 ].second
-          = LHPC::ParsingUtilities::StringToDouble(
-                                                entriesAtScales.back().first );
+          logScalesWithValues[ 0 ].second = entriesAtScales.back().first;
         }
         logScalesWithValues[ 1 ].second = logScalesWithValues[ 0 ].second;
       }
       else
       {
-        logScalesWithValues[ 0 ].second
-        = LHPC::ParsingUtilities::StringToDouble(
-                                               entriesAtScales.front().first );
+        logScalesWithValues[ 0 ].second = entriesAtScales.front().first;
         logScalesWithValues[ 1 ].second = logScalesWithValues[ 0 ].second;
       }
     }
@@ -90,17 +84,20 @@ namespace VevaciousPlusPlus
     {
       // The blocks are ordered as they were read from the SLHA file, which
       // may not necessarily be in ascending order with respect to the scale.
-      entriesAtScales.sort( &(FirstPairDotSecondIsLower< std::string >) );
+      // A stable sort keeps blocks with equal scales in the order in which
+      // they were read, as sorting the list used to.
+      std::stable_sort( entriesAtScales.begin(),
+                        entriesAtScales.end(),
+                        &(FirstPairDotSecondIsLower< double >) );
       logScalesWithValues.resize( numberOfScales );
-      size_t scaleIndex( 0 );
-      std::list< std::pair< std::string, double > >::const_iterator
-      listIterator( entriesAtScales.begin() );
-      while( scaleIndex < numberOfScales )
+      for( size_t scaleIndex( 0 );
+           scaleIndex < numberOfScales;
+           ++scaleIndex )
       {
-        logScalesWithValues[ scaleIndex ].first = log( listIterator->second );
-        logScalesWithValues[ scaleIndex++ ].second
-        = LHPC::ParsingUtilities::StringToDouble( (listIterator++)->first );
-        // Post-increments on last use of each variable. Yey terseness.
+        logScalesWithValues[ scaleIndex ].first
+        = log( entriesAtScales[ scaleIndex ].second );
+        logScalesWithValues[ scaleIndex ].second
+        = entriesAtScales[ scaleIndex ].first;
       }
       lastIndex = ( numberOfScales - 1 );
     }
@@ -12,7 +12,7 @@ namespace VevaciousPlusPlus
 
   LhaPolynomialFitBlockEntry::LhaPolynomialFitBlockEntry(
                                               size_t const indexInValuesVector,
-                                        LHPC::SimpleLhaParser const& lhaParser,
+                                       VirtualSimpleLhaParser const& lhaParser,
                                           std::string const& parameterName  ) :
     LhaInterpolatedParameterFunctionoid( indexInValuesVector,
                                          lhaParser,
@@ -45,10 +45,9 @@ namespace VevaciousPlusPlus
     // We set up a matrix equation for the coefficients of the polynomial in
     // the logarithm of the scale based on how many explicit values of the
     // parameter at different scales we have.
-    std::list< std::pair< std::string, double > > entriesAtScales;
-    (*lhaParser)( parameterName,
-                  entriesAtScales,
-                  true );
+    std::vector< std::pair< double, double > > entriesAtScales;
+    NumericEntries( entriesAtScales,
+                    true );
     size_t const numberOfScales( entriesAtScales.size() );
 
     // First we guard against no block found (in which case the value is set
@@ -59,22 +58,19 @@ namespace VevaciousPlusPlus
       double constantValue( 0.0 );
       if( !(entriesAtScales.empty()) )
       {
-        constantValue = LHPC::ParsingUtilities::StringToDouble(
-                                              entriesAtScales.back().first );
+        constantValue = entriesAtScales.back().first;
       }
       else
       {
         // If there were no entries with explicit scales, we check for entries
         // in blocks without scales, which will be assumed to be constant over
         // all scales.
-        (*lhaParser)( parameterName,
-                      entriesAtScales,
-                      false );
+        NumericEntries( entriesAtScales,
+                        false );
 
         if( !(entriesAtScales.empty()) )
         {
-          constantValue = LHPC::ParsingUtilities::StringToDouble(
-                                                entriesAtScales.back().first );
+          constantValue = entriesAtScales.back().first;
         }
       }
 
@@ -91,12 +87,11 @@ namespace VevaciousPlusPlus
                                              numberOfScales );
       Eigen::VectorXd scaleDependenceVector( numberOfScales );
       double logarithmOfScale;
-      size_t scaleIndex( 0 );
-      std::list< std::pair< std::string, double > >::const_iterator
-      listIterator( entriesAtScales.begin() );
-      while( scaleIndex < numberOfScales )
+      for( size_t scaleIndex( 0 );
+           scaleIndex < numberOfScales;
+           ++scaleIndex )
       {
-        logarithmOfScale = log( listIterator->second );
+        logarithmOfScale = log( entriesAtScales[ scaleIndex ].second );
         scaleDependenceMatrix( scaleIndex,
                                0 ) = 1.0;
         scaleDependenceMatrix( scaleIndex,
@@ -109,9 +104,8 @@ namespace VevaciousPlusPlus
                                  powerIndex ) = pow( logarithmOfScale,
                                                      powerIndex );
         }
-        scaleDependenceVector( scaleIndex++ )
-        = LHPC::ParsingUtilities::StringToDouble( (listIterator++)->first );
-        // Post-increments on last use of each variable. Yey terseness.
+        scaleDependenceVector( scaleIndex )
+        = entriesAtScales[ scaleIndex ].first;
       }
 
       // Now we solve for the coefficients:
@@ -0,0 +1,95 @@
+/*
+ * LhaScaleInterpolationTable.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "LagrangianParameterManagement/LhaScaleInterpolationTable.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  LhaScaleInterpolationTable::LhaScaleInterpolationTable() :
+    numberOfEntries( 0 ),
+    destinationIndices(),
+    logScales(),
+    valuesAtScales(),
+    slopesBelowScales()
+  {
+    // This constructor is just an initialization list.
+  }
+
+  LhaScaleInterpolationTable::~LhaScaleInterpolationTable()
+  {
+    // This does nothing.
+  }
+
+
+  // This sets up the shared set of logarithms of scales from the scales of
+  // all the entries in blockEntries, and the values and slopes of each entry
+  // at each of those logarithms of scales.
+  void LhaScaleInterpolationTable::SetEntries(
+         std::vector< LhaLinearlyInterpolatedBlockEntry > const& blockEntries )
+  {
+    numberOfEntries = blockEntries.size();
+    destinationIndices.resize( numberOfEntries );
+    logScales.clear();
+    for( size_t entryIndex( 0 );
+         entryIndex < numberOfEntries;
+         ++entryIndex )
+    {
+      destinationIndices[ entryIndex ]
+      = blockEntries[ entryIndex ].IndexInValuesVector();
+      std::vector< std::pair< double, double > > const&
+      logScalesWithValues( blockEntries[ entryIndex ].LogScalesWithValues() );
+      for( std::vector< std::pair< double, double > >::const_iterator
+           logScaleWithValue( logScalesWithValues.begin() );
+           logScaleWithValue < logScalesWithValues.end();
+           ++logScaleWithValue )
+      {
+        logScales.push_back( logScaleWithValue->first );
+      }
+    }
+    std::sort( logScales.begin(),
+               logScales.end() );
+    logScales.erase( std::unique( logScales.begin(),
+                                  logScales.end() ),
+                     logScales.end() );
+
+    // There have to be at least 2 scales so that there is always a segment,
+    // even if every block was given at the same single scale.
+    while( logScales.size() < 2 )
+    {
+      logScales.push_back( logScales.empty() ?
+                           0.0 :
+                           ( logScales.back() + 1.0 ) );
+    }
+
+    size_t const numberOfScales( logScales.size() );
+    valuesAtScales.resize( numberOfScales * numberOfEntries );
+    slopesBelowScales.assign( ( numberOfScales * numberOfEntries ),
+                              0.0 );
+    for( size_t scaleIndex( 0 );
+         scaleIndex < numberOfScales;
+         ++scaleIndex )
+    {
+      size_t const rowStart( scaleIndex * numberOfEntries );
+      for( size_t entryIndex( 0 );
+           entryIndex < numberOfEntries;
+           ++entryIndex )
+      {
+        valuesAtScales[ rowStart + entryIndex ]
+        = blockEntries[ entryIndex ]( logScales[ scaleIndex ] );
+        if( scaleIndex > 0 )
+        {
+          slopesBelowScales[ rowStart + entryIndex ]
+          = ( ( valuesAtScales[ rowStart + entryIndex ]
+                - valuesAtScales[ rowStart - numberOfEntries + entryIndex ] )
+              / ( logScales[ scaleIndex ] - logScales[ scaleIndex - 1 ] ) );
+        }
+      }
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
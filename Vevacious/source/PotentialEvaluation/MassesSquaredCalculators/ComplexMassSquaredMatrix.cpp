@@ -37,16 +37,17 @@ namespace VevaciousPlusPlus
     // This does nothing.
   }
 
-  // This returns a matrix of the values of the elements for a field
+  // This fills valuesMatrix with the values of the elements for a field
    // configuration given by fieldConfiguration, using the values for the
    // Lagrangian parameters found in parameterValues.
-  Eigen::MatrixXcd ComplexMassSquaredMatrix::CurrentValues(
+  void ComplexMassSquaredMatrix::SetCurrentValues(
                                   std::vector< double > const& parameterValues,
-                        std::vector< double > const& fieldConfiguration ) const
+                               std::vector< double > const& fieldConfiguration,
+                                         Eigen::MatrixXcd& valuesMatrix ) const
   {
     size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
+    valuesMatrix.resize( numberOfRows,
+                         numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
@@ -74,18 +75,19 @@ namespace VevaciousPlusPlus
                              rowIndex ).imag(0.0);
       rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
   }
 
-  // This returns a matrix of the values of the elements for a field
-  // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters from the last call of UpdateForFixedScale.
-  Eigen::MatrixXcd ComplexMassSquaredMatrix::CurrentValues(
-                        std::vector< double > const& fieldConfiguration ) const
+  // This fills valuesMatrix with the values of the elements for a field
+  // configuration given by fieldConfiguration, using the Lagrangian parameters
+  // at the fixed scale of coefficientSnapshot.
+  void ComplexMassSquaredMatrix::SetCurrentValues(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                         Eigen::MatrixXcd& valuesMatrix ) const
   {
     size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
+    valuesMatrix.resize( numberOfRows,
+                         numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
@@ -96,9 +98,11 @@ namespace VevaciousPlusPlus
       {
         valuesMatrix.coeffRef( rowIndex,
                                columnIndex ).real(matrixElements[ rowsTimesLength + columnIndex ].first(
+                                                           coefficientSnapshot,
                                                           fieldConfiguration ));
         valuesMatrix.coeffRef( rowIndex,
                                columnIndex ).imag(matrixElements[ rowsTimesLength + columnIndex ].second(
+                                                           coefficientSnapshot,
                                                           fieldConfiguration ));
         // The Eigen routines don't bother looking at elements of valuesMatrix
         // where columnIndex > rowIndex, so we don't even bother filling them
@@ -106,12 +110,126 @@ namespace VevaciousPlusPlus
       }
       valuesMatrix.coeffRef( rowIndex,
                              rowIndex ).real(matrixElements[ rowsTimesLength + rowIndex ].first(
+                                                           coefficientSnapshot,
                                                           fieldConfiguration ));
       valuesMatrix.coeffRef( rowIndex,
                              rowIndex ).imag(0.0);
       rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
+  }
+
+  // This puts the matrices of the partial derivatives of the elements with
+  // respect to each field into derivativeMatrices, using the values for the
+  // Lagrangian parameters found in parameterValues. Fields on which no element
+  // depends get an empty matrix.
+  void ComplexMassSquaredMatrix::FieldDerivativeValues(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const
+  {
+    derivativeMatrices.resize( fieldDerivativeElements.size() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldDerivativeElements.size();
+         ++fieldIndex )
+    {
+      std::vector< ComplexParametersAndFieldsProductSum > const&
+      derivativeElements( fieldDerivativeElements[ fieldIndex ] );
+      if( derivativeElements.empty() )
+      {
+        derivativeMatrices[ fieldIndex ].resize( 0,
+                                                 0 );
+        continue;
+      }
+      Eigen::MatrixXcd& derivativeMatrix( derivativeMatrices[ fieldIndex ] );
+      derivativeMatrix.resize( numberOfRows,
+                               numberOfRows );
+      size_t rowsTimesLength( 0 );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        // As in SetCurrentValues, only the lower triangle is filled, and the
+        // diagonal is taken to be purely real.
+        for( size_t columnIndex( 0 );
+             columnIndex < rowIndex;
+             ++columnIndex )
+        {
+          ComplexParametersAndFieldsProductSum const&
+          derivativeElement( derivativeElements[ rowsTimesLength
+                                                 + columnIndex ] );
+          derivativeMatrix.coeffRef( rowIndex,
+                                     columnIndex )
+          = std::complex< double >( derivativeElement.first( parameterValues,
+                                                          fieldConfiguration ),
+                                    derivativeElement.second( parameterValues,
+                                                        fieldConfiguration ) );
+        }
+        derivativeMatrix.coeffRef( rowIndex,
+                                   rowIndex )
+        = derivativeElements[ rowsTimesLength + rowIndex ].first(
+                                                               parameterValues,
+                                                          fieldConfiguration );
+        rowsTimesLength += numberOfRows;
+      }
+    }
+  }
+
+  // This puts the matrices of the partial derivatives of the elements with
+  // respect to each field into derivativeMatrices, using the Lagrangian
+  // parameters at the fixed scale of coefficientSnapshot. Fields on which no
+  // element depends get an empty matrix.
+  void ComplexMassSquaredMatrix::FieldDerivativeValues(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const
+  {
+    derivativeMatrices.resize( fieldDerivativeElements.size() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldDerivativeElements.size();
+         ++fieldIndex )
+    {
+      std::vector< ComplexParametersAndFieldsProductSum > const&
+      derivativeElements( fieldDerivativeElements[ fieldIndex ] );
+      if( derivativeElements.empty() )
+      {
+        derivativeMatrices[ fieldIndex ].resize( 0,
+                                                 0 );
+        continue;
+      }
+      Eigen::MatrixXcd& derivativeMatrix( derivativeMatrices[ fieldIndex ] );
+      derivativeMatrix.resize( numberOfRows,
+                               numberOfRows );
+      size_t rowsTimesLength( 0 );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        // As in SetCurrentValues, only the lower triangle is filled, and the
+        // diagonal is taken to be purely real.
+        for( size_t columnIndex( 0 );
+             columnIndex < rowIndex;
+             ++columnIndex )
+        {
+          ComplexParametersAndFieldsProductSum const&
+          derivativeElement( derivativeElements[ rowsTimesLength
+                                                 + columnIndex ] );
+          derivativeMatrix.coeffRef( rowIndex,
+                                     columnIndex )
+          = std::complex< double >( derivativeElement.first(
+                                                           coefficientSnapshot,
+                                                          fieldConfiguration ),
+                                    derivativeElement.second(
+                                                           coefficientSnapshot,
+                                                        fieldConfiguration ) );
+        }
+        derivativeMatrix.coeffRef( rowIndex,
+                                   rowIndex )
+        = derivativeElements[ rowsTimesLength + rowIndex ].first(
+                                                           coefficientSnapshot,
+                                                          fieldConfiguration );
+        rowsTimesLength += numberOfRows;
+      }
+    }
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -15,7 +15,8 @@ namespace VevaciousPlusPlus
     MassesSquaredFromMatrix< double >( numberOfRows,
                                        attributeMap ),
     matrixElements( ( numberOfRows * numberOfRows ),
-                    ParametersAndFieldsProductSum() )
+                    ParametersAndFieldsProductSum() ),
+    fieldDerivativeElements()
   {
     // This constructor is just an initialization list.
   }
@@ -23,14 +24,16 @@ namespace VevaciousPlusPlus
   RealMassesSquaredMatrix::RealMassesSquaredMatrix(
                                   RealMassesSquaredMatrix const& copySource ) :
     MassesSquaredFromMatrix< double >( copySource ),
-    matrixElements( copySource.matrixElements )
+    matrixElements( copySource.matrixElements ),
+    fieldDerivativeElements( copySource.fieldDerivativeElements )
   {
     // This constructor is just an initialization list.
   }
 
   RealMassesSquaredMatrix::RealMassesSquaredMatrix() :
     MassesSquaredFromMatrix< double >(),
-    matrixElements()
+    matrixElements(),
+    fieldDerivativeElements()
   {
     // This constructor is just an initialization list.
   }
@@ -41,16 +44,17 @@ namespace VevaciousPlusPlus
   }
 
 
-  // This returns a matrix of the values of the elements for a field
+  // This fills valuesMatrix with the values of the elements for a field
   // configuration given by fieldConfiguration, using the values for the
   // Lagrangian parameters found in parameterValues.
-  Eigen::MatrixXd RealMassesSquaredMatrix::CurrentValues(
+  void RealMassesSquaredMatrix::SetCurrentValues(
                                   std::vector< double > const& parameterValues,
-                        std::vector< double > const& fieldConfiguration ) const
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXd& valuesMatrix ) const
   {
     size_t rowsTimesLength( 0 );
-    Eigen::MatrixXd valuesMatrix( numberOfRows,
-                                  numberOfRows );
+    valuesMatrix.resize( numberOfRows,
+                         numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
@@ -73,32 +77,34 @@ namespace VevaciousPlusPlus
       }
       rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
   }
 
-  // This returns a matrix of the values of the elements for a field
-  // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters from the last call of UpdateForFixedScale.
-  Eigen::MatrixXd RealMassesSquaredMatrix::CurrentValues(
-                        std::vector< double > const& fieldConfiguration ) const
+  // This fills valuesMatrix with the values of the elements for a field
+  // configuration given by fieldConfiguration, using the Lagrangian parameters
+  // at the fixed scale of coefficientSnapshot.
+  void RealMassesSquaredMatrix::SetCurrentValues(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXd& valuesMatrix ) const
   {
     size_t rowsTimesLength( 0 );
-    Eigen::MatrixXd valuesMatrix( numberOfRows,
-                                  numberOfRows );
+    valuesMatrix.resize( numberOfRows,
+                         numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
     {
       valuesMatrix.coeffRef( rowIndex,
                              rowIndex )
-      = matrixElements[ rowsTimesLength + rowIndex ]( fieldConfiguration );
+      = matrixElements[ rowsTimesLength + rowIndex ]( coefficientSnapshot,
+                                                      fieldConfiguration );
       for( size_t columnIndex( rowIndex + 1 );
            columnIndex < numberOfRows;
            ++columnIndex )
       {
         valuesMatrix.coeffRef( rowIndex,
                                columnIndex )
-        = matrixElements[ rowsTimesLength + columnIndex ](
+        = matrixElements[ rowsTimesLength + columnIndex ]( coefficientSnapshot,
                                                           fieldConfiguration );
         valuesMatrix.coeffRef( columnIndex,
                                rowIndex ) = valuesMatrix.coeff( rowIndex,
@@ -106,7 +112,102 @@ namespace VevaciousPlusPlus
       }
       rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
+  }
+
+  // This puts the matrices of the partial derivatives of the elements with
+  // respect to each field into derivativeMatrices, using the values for the
+  // Lagrangian parameters found in parameterValues. Fields on which no element
+  // depends get an empty matrix.
+  void RealMassesSquaredMatrix::FieldDerivativeValues(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXd >& derivativeMatrices ) const
+  {
+    derivativeMatrices.resize( fieldDerivativeElements.size() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldDerivativeElements.size();
+         ++fieldIndex )
+    {
+      std::vector< ParametersAndFieldsProductSum > const&
+      derivativeElements( fieldDerivativeElements[ fieldIndex ] );
+      if( derivativeElements.empty() )
+      {
+        derivativeMatrices[ fieldIndex ].resize( 0,
+                                                 0 );
+        continue;
+      }
+      Eigen::MatrixXd& derivativeMatrix( derivativeMatrices[ fieldIndex ] );
+      derivativeMatrix.resize( numberOfRows,
+                               numberOfRows );
+      size_t rowsTimesLength( 0 );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        // As in SetCurrentValues, the elements with column index >= row index
+        // are taken as defining the symmetric matrix, and only the lower
+        // triangle of the derivative matrix is needed.
+        for( size_t columnIndex( rowIndex );
+             columnIndex < numberOfRows;
+             ++columnIndex )
+        {
+          derivativeMatrix.coeffRef( columnIndex,
+                                     rowIndex )
+          = derivativeElements[ rowsTimesLength + columnIndex ](
+                                                               parameterValues,
+                                                          fieldConfiguration );
+        }
+        rowsTimesLength += numberOfRows;
+      }
+    }
+  }
+
+  // This puts the matrices of the partial derivatives of the elements with
+  // respect to each field into derivativeMatrices, using the Lagrangian
+  // parameters at the fixed scale of coefficientSnapshot. Fields on which no
+  // element depends get an empty matrix.
+  void RealMassesSquaredMatrix::FieldDerivativeValues(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXd >& derivativeMatrices ) const
+  {
+    derivativeMatrices.resize( fieldDerivativeElements.size() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldDerivativeElements.size();
+         ++fieldIndex )
+    {
+      std::vector< ParametersAndFieldsProductSum > const&
+      derivativeElements( fieldDerivativeElements[ fieldIndex ] );
+      if( derivativeElements.empty() )
+      {
+        derivativeMatrices[ fieldIndex ].resize( 0,
+                                                 0 );
+        continue;
+      }
+      Eigen::MatrixXd& derivativeMatrix( derivativeMatrices[ fieldIndex ] );
+      derivativeMatrix.resize( numberOfRows,
+                               numberOfRows );
+      size_t rowsTimesLength( 0 );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        // As in SetCurrentValues, the elements with column index >= row index
+        // are taken as defining the symmetric matrix, and only the lower
+        // triangle of the derivative matrix is needed.
+        for( size_t columnIndex( rowIndex );
+             columnIndex < numberOfRows;
+             ++columnIndex )
+        {
+          derivativeMatrix.coeffRef( columnIndex,
+                                     rowIndex )
+          = derivativeElements[ rowsTimesLength + columnIndex ](
+                                                           coefficientSnapshot,
+                                                          fieldConfiguration );
+        }
+        rowsTimesLength += numberOfRows;
+      }
+    }
   }
 
 } /* namespace VevaciousPlusPlus */
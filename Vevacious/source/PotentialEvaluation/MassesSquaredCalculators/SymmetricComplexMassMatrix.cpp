@@ -38,16 +38,18 @@ namespace VevaciousPlusPlus
   }
 
 
-  // This returns a matrix of the values of the elements for a field
-  // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters found in parameterValues.
-  Eigen::MatrixXcd SymmetricComplexMassMatrix::MatrixToSquare(
+  // This fills valuesMatrix with the values of the elements of the mass
+  // matrix (which is then squared) for a field configuration given by
+  // fieldConfiguration, using the values for the Lagrangian parameters
+  // found in parameterValues.
+  void SymmetricComplexMassMatrix::SetMatrixToSquare(
                                   std::vector< double > const& parameterValues,
-                        std::vector< double > const& fieldConfiguration ) const
+                               std::vector< double > const& fieldConfiguration,
+                                 Eigen::MatrixXcd& valuesMatrix ) const
   {
     size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
+    valuesMatrix.resize( numberOfRows,
+                         numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
@@ -78,18 +80,20 @@ namespace VevaciousPlusPlus
                                                           fieldConfiguration ));
       rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
   }
 
-  // This returns a matrix of the values of the elements for a field
-  // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters from the last call of UpdateForFixedScale.
-  Eigen::MatrixXcd SymmetricComplexMassMatrix::MatrixToSquare(
-                        std::vector< double > const& fieldConfiguration ) const
+  // This fills valuesMatrix with the values of the elements of the mass
+  // matrix (which is then squared) for a field configuration given by
+  // fieldConfiguration, using the Lagrangian parameters at the fixed scale of
+  // coefficientSnapshot.
+  void SymmetricComplexMassMatrix::SetMatrixToSquare(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                                 Eigen::MatrixXcd& valuesMatrix ) const
   {
     size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
+    valuesMatrix.resize( numberOfRows,
+                         numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
@@ -100,9 +104,11 @@ namespace VevaciousPlusPlus
       {
         valuesMatrix.coeffRef( rowIndex,
                                columnIndex ).real(matrixElements[ rowsTimesLength + columnIndex ].first(
+                                                           coefficientSnapshot,
                                                           fieldConfiguration ));
         valuesMatrix.coeffRef( rowIndex,
                                columnIndex ).imag(matrixElements[ rowsTimesLength + columnIndex ].second(
+                                                           coefficientSnapshot,
                                                           fieldConfiguration ));
         // We use the fact that the matrix is symmetric.
         valuesMatrix.coeffRef( columnIndex,
@@ -112,22 +118,24 @@ namespace VevaciousPlusPlus
       }
       valuesMatrix.coeffRef( rowIndex,
                              rowIndex ).real(matrixElements[ rowsTimesLength + rowIndex ].first(
+                                                           coefficientSnapshot,
                                                           fieldConfiguration ));
       valuesMatrix.coeffRef( rowIndex,
                              rowIndex ).imag(matrixElements[ rowsTimesLength + rowIndex ].second(
+                                                           coefficientSnapshot,
                                                           fieldConfiguration ));
       rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
   }
 
-  // This returns a matrix that is the lower-triangular part (only column
-  // index <= row index) of the square of matrixToSquare.
-  Eigen::MatrixXcd SymmetricComplexMassMatrix::LowerTriangleOfSquareMatrix(
-                                 Eigen::MatrixXcd const& matrixToSquare ) const
+  // This fills the lower-triangular part (only column index <= row index) of
+  // valuesSquaredMatrix with the square of matrixToSquare.
+  void SymmetricComplexMassMatrix::SetLowerTriangleOfSquare(
+                                        Eigen::MatrixXcd const& matrixToSquare,
+                                  Eigen::MatrixXcd& valuesSquaredMatrix ) const
   {
-    Eigen::MatrixXcd valuesSquaredMatrix( numberOfRows,
-                                          numberOfRows );
+    valuesSquaredMatrix.resize( numberOfRows,
+                                numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
@@ -173,7 +181,180 @@ namespace VevaciousPlusPlus
         }
       }
     }
-    return valuesSquaredMatrix;
+  }
+
+  // This puts the matrices of the partial derivatives of the square of the
+  // mass matrix with respect to each field into derivativeMatrices, using the
+  // values for the Lagrangian parameters found in parameterValues. Fields on
+  // which no element depends get an empty matrix.
+  void SymmetricComplexMassMatrix::FieldDerivativeValues(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const
+  {
+    Eigen::MatrixXcd& matrixToSquare( ThreadBuffers().workingMatrix );
+    SetMatrixToSquare( parameterValues,
+                       fieldConfiguration,
+                       matrixToSquare );
+    DerivativesOfMatrixToSquare( parameterValues,
+                                 fieldConfiguration,
+                                 derivativeMatrices );
+    DerivativesOfSquare( matrixToSquare,
+                         derivativeMatrices );
+  }
+
+  // This puts the matrices of the partial derivatives of the square of the
+  // mass matrix with respect to each field into derivativeMatrices, using the
+  // Lagrangian parameters at the fixed scale of coefficientSnapshot. Fields on
+  // which no element depends get an empty matrix.
+  void SymmetricComplexMassMatrix::FieldDerivativeValues(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const
+  {
+    Eigen::MatrixXcd& matrixToSquare( ThreadBuffers().workingMatrix );
+    SetMatrixToSquare( coefficientSnapshot,
+                       fieldConfiguration,
+                       matrixToSquare );
+    DerivativesOfMatrixToSquare( coefficientSnapshot,
+                                 fieldConfiguration,
+                                 derivativeMatrices );
+    DerivativesOfSquare( matrixToSquare,
+                         derivativeMatrices );
+  }
+
+  // This puts the matrices of the partial derivatives of the mass matrix
+  // (rather than its square) with respect to each field into
+  // derivativeMatrices, using the values for the Lagrangian parameters found
+  // in parameterValues. Fields on which no element depends get an empty
+  // matrix.
+  void SymmetricComplexMassMatrix::DerivativesOfMatrixToSquare(
+                                  std::vector< double > const& parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const
+  {
+    derivativeMatrices.resize( fieldDerivativeElements.size() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldDerivativeElements.size();
+         ++fieldIndex )
+    {
+      std::vector< ComplexParametersAndFieldsProductSum > const&
+      derivativeElements( fieldDerivativeElements[ fieldIndex ] );
+      if( derivativeElements.empty() )
+      {
+        derivativeMatrices[ fieldIndex ].resize( 0,
+                                                 0 );
+        continue;
+      }
+      Eigen::MatrixXcd& derivativeMatrix( derivativeMatrices[ fieldIndex ] );
+      derivativeMatrix.resize( numberOfRows,
+                               numberOfRows );
+      size_t rowsTimesLength( 0 );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        for( size_t columnIndex( 0 );
+             columnIndex <= rowIndex;
+             ++columnIndex )
+        {
+          ComplexParametersAndFieldsProductSum const&
+          derivativeElement( derivativeElements[ rowsTimesLength
+                                                 + columnIndex ] );
+          derivativeMatrix.coeffRef( rowIndex,
+                                     columnIndex )
+          = std::complex< double >( derivativeElement.first( parameterValues,
+                                                          fieldConfiguration ),
+                                    derivativeElement.second( parameterValues,
+                                                        fieldConfiguration ) );
+          // We use the fact that the matrix is symmetric.
+          derivativeMatrix.coeffRef( columnIndex,
+                                     rowIndex )
+          = derivativeMatrix.coeff( rowIndex,
+                                    columnIndex );
+        }
+        rowsTimesLength += numberOfRows;
+      }
+    }
+  }
+
+  // This puts the matrices of the partial derivatives of the mass matrix
+  // (rather than its square) with respect to each field into
+  // derivativeMatrices, using the Lagrangian parameters at the fixed scale of
+  // coefficientSnapshot. Fields on which no element depends get an empty
+  // matrix.
+  void SymmetricComplexMassMatrix::DerivativesOfMatrixToSquare(
+                             FixedScaleCoefficients const& coefficientSnapshot,
+                               std::vector< double > const& fieldConfiguration,
+                std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const
+  {
+    derivativeMatrices.resize( fieldDerivativeElements.size() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldDerivativeElements.size();
+         ++fieldIndex )
+    {
+      std::vector< ComplexParametersAndFieldsProductSum > const&
+      derivativeElements( fieldDerivativeElements[ fieldIndex ] );
+      if( derivativeElements.empty() )
+      {
+        derivativeMatrices[ fieldIndex ].resize( 0,
+                                                 0 );
+        continue;
+      }
+      Eigen::MatrixXcd& derivativeMatrix( derivativeMatrices[ fieldIndex ] );
+      derivativeMatrix.resize( numberOfRows,
+                               numberOfRows );
+      size_t rowsTimesLength( 0 );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        for( size_t columnIndex( 0 );
+             columnIndex <= rowIndex;
+             ++columnIndex )
+        {
+          ComplexParametersAndFieldsProductSum const&
+          derivativeElement( derivativeElements[ rowsTimesLength
+                                                 + columnIndex ] );
+          derivativeMatrix.coeffRef( rowIndex,
+                                     columnIndex )
+          = std::complex< double >( derivativeElement.first(
+                                                           coefficientSnapshot,
+                                                          fieldConfiguration ),
+                                    derivativeElement.second(
+                                                           coefficientSnapshot,
+                                                        fieldConfiguration ) );
+          // We use the fact that the matrix is symmetric.
+          derivativeMatrix.coeffRef( columnIndex,
+                                     rowIndex )
+          = derivativeMatrix.coeff( rowIndex,
+                                    columnIndex );
+        }
+        rowsTimesLength += numberOfRows;
+      }
+    }
+  }
+
+  // This replaces each non-empty derivative dM in derivativeMatrices with the
+  // corresponding derivative of the square of matrixToSquare, which is
+  // dM^dagger M + M^dagger dM for M being matrixToSquare.
+  void SymmetricComplexMassMatrix::DerivativesOfSquare(
+                                        Eigen::MatrixXcd const& matrixToSquare,
+                std::vector< Eigen::MatrixXcd >& derivativeMatrices ) const
+  {
+    for( std::vector< Eigen::MatrixXcd >::iterator
+         derivativeMatrix( derivativeMatrices.begin() );
+         derivativeMatrix < derivativeMatrices.end();
+         ++derivativeMatrix )
+    {
+      if( derivativeMatrix->size() != 0 )
+      {
+        Eigen::MatrixXcd const
+        adjointTimesMatrix( derivativeMatrix->adjoint() * matrixToSquare );
+        *derivativeMatrix
+        = ( adjointTimesMatrix + adjointTimesMatrix.adjoint() );
+      }
+    }
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -18,8 +18,8 @@ namespace VevaciousPlusPlus
                                        assumedPositiveOrNegativeTolerance,
                                        lagrangianParameterManager ),
     LHPC::BasicObserver(),
-    renormalizationScale( -1.0 ),
-    inverseRenormalizationScaleSquared( -1.0 )
+    fixedScaleCoefficients( new FixedScaleCoefficients( -1.0,
+                                            numberOfFixedScaleCoefficients ) )
   {
     lagrangianParameterManager.RegisterObserver( this );
   }
@@ -28,8 +28,20 @@ namespace VevaciousPlusPlus
                    PotentialFromPolynomialWithMasses const& potentialToCopy ) :
     PotentialFromPolynomialWithMasses( potentialToCopy ),
     LHPC::BasicObserver(),
-    renormalizationScale( -1.0 ),
-    inverseRenormalizationScaleSquared( -1.0 )
+    fixedScaleCoefficients( new FixedScaleCoefficients( -1.0,
+                                            numberOfFixedScaleCoefficients ) )
+  {
+    lagrangianParameterManager.RegisterObserver( this );
+  }
+
+  FixedScaleOneLoopPotential::FixedScaleOneLoopPotential(
+                      PotentialFromPolynomialWithMasses const& potentialToCopy,
+                     LagrangianParameterManager& lagrangianParameterManager ) :
+    PotentialFromPolynomialWithMasses( potentialToCopy,
+                                       lagrangianParameterManager ),
+    LHPC::BasicObserver(),
+    fixedScaleCoefficients( new FixedScaleCoefficients( -1.0,
+                                            numberOfFixedScaleCoefficients ) )
   {
     lagrangianParameterManager.RegisterObserver( this );
   }
@@ -40,53 +52,117 @@ namespace VevaciousPlusPlus
   }
 
 
-  // This updates the scale used for the loop corrections based on the
-  // appropriate scale from lagrangianParameterManager, and updates all
-  // components used to evaluate the potential to use the Lagrangian
-  // parameters evaluated at that scale.
-  void FixedScaleOneLoopPotential::RespondToObservedSignal()
+  // This puts the values of the potential at temperatureValue for each of the
+  // field configurations packed into fieldConfigurations into
+  // potentialValues. The polynomial parts are evaluated term by term for the
+  // whole batch at once, and then the mass-squared matrices are diagonalized
+  // for each configuration in turn.
+  void FixedScaleOneLoopPotential::EvaluateBatch(
+                              std::vector< double > const& fieldConfigurations,
+                                                 double const temperatureValue,
+                                std::vector< double >& potentialValues ) const
   {
-    renormalizationScale
-    = lagrangianParameterManager.AppropriateSingleFixedScale();
-    inverseRenormalizationScaleSquared
-    = ( 1.0 / ( renormalizationScale * renormalizationScale ) );
-    std::vector< double > fixedParameterValues;
-    lagrangianParameterManager.ParameterValues( log( renormalizationScale ),
-                                                fixedParameterValues );
-    UpdateDsbValues( log( renormalizationScale ) );
-
-    treeLevelPotential.UpdateForFixedScale( fixedParameterValues );
-    polynomialLoopCorrections.UpdateForFixedScale( fixedParameterValues );
-    for( std::vector< RealMassesSquaredMatrix >::iterator
-         massMatrix( scalarMassSquaredMatrices.begin() );
-         massMatrix < scalarMassSquaredMatrices.end();
-         ++massMatrix )
+    size_t const numberOfConfigurations( ( numberOfFields > 0 ) ?
+                              ( fieldConfigurations.size() / numberOfFields ) :
+                                         0 );
+    potentialValues.assign( numberOfConfigurations,
+                            0.0 );
+    if( numberOfConfigurations == 0 )
     {
-      massMatrix->UpdateForFixedScale( fixedParameterValues );
+      return;
     }
-    for( std::vector< SymmetricComplexMassMatrix >::iterator
-         massMatrix( fermionMassMatrices.begin() );
-         massMatrix < fermionMassMatrices.end();
-         ++massMatrix )
-    {
-      massMatrix->UpdateForFixedScale( fixedParameterValues );
-    }
-    for( std::vector< ComplexMassSquaredMatrix >::iterator
-         massMatrix( fermionMassSquaredMatrices.begin() );
-         massMatrix < fermionMassSquaredMatrices.end();
-         ++massMatrix )
+    PerformanceLogger::IncrementCounter(
+                                       PerformanceRecord::PotentialEvaluations,
+                                         numberOfConfigurations );
+    EvaluationContext const evaluationContext( *fixedScaleCoefficients,
+                                               temperatureValue,
+                                               ThreadWorkspace() );
+    FixedScaleCoefficients const&
+    coefficientSnapshot( evaluationContext.coefficientSnapshot );
+    EvaluationWorkspace& threadWorkspace( evaluationContext.threadWorkspace );
+
+    // The field values are re-arranged field by field so that the polynomial
+    // terms can be evaluated over contiguous memory for the whole batch.
+    std::vector< double >& fieldValuesByField(
+                                           threadWorkspace.batchFieldValues );
+    fieldValuesByField.resize( numberOfConfigurations * numberOfFields );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < numberOfConfigurations;
+         ++configurationIndex )
     {
-      massMatrix->UpdateForFixedScale( fixedParameterValues );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        fieldValuesByField[ ( fieldIndex * numberOfConfigurations )
+                            + configurationIndex ]
+        = fieldConfigurations[ ( configurationIndex * numberOfFields )
+                               + fieldIndex ];
+      }
     }
-    for( std::vector< RealMassesSquaredMatrix >::iterator
-         massMatrix( vectorMassSquaredMatrices.begin() );
-         massMatrix < vectorMassSquaredMatrices.end();
-         ++massMatrix )
+    treeLevelPotential.AddToBatchSums( coefficientSnapshot,
+                                       fieldValuesByField,
+                                       numberOfConfigurations,
+                                       threadWorkspace.batchTermProducts,
+                                       potentialValues.data() );
+    polynomialLoopCorrections.AddToBatchSums( coefficientSnapshot,
+                                              fieldValuesByField,
+                                              numberOfConfigurations,
+                                             threadWorkspace.batchTermProducts,
+                                              potentialValues.data() );
+
+    std::vector< double >&
+    fieldConfiguration( threadWorkspace.fieldConfiguration );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < numberOfConfigurations;
+         ++configurationIndex )
     {
-      massMatrix->UpdateForFixedScale( fixedParameterValues );
+      std::vector< double >::const_iterator const configurationStart(
+                                                   fieldConfigurations.begin()
+                                   + ( configurationIndex * numberOfFields ) );
+      fieldConfiguration.assign( configurationStart,
+                                 configurationStart + numberOfFields );
+      SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                        fieldConfiguration,
+                                        scalarSquareMasses,
+                              threadWorkspace.scalarMassesSquaredWithFactors );
+      SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                        fieldConfiguration,
+                                        fermionSquareMasses,
+                             threadWorkspace.fermionMassesSquaredWithFactors );
+      SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                        fieldConfiguration,
+                                        vectorSquareMasses,
+                              threadWorkspace.vectorMassesSquaredWithFactors );
+      potentialValues[ configurationIndex ]
+      += LoopAndThermalCorrections(
+                                threadWorkspace.scalarMassesSquaredWithFactors,
+                               threadWorkspace.fermionMassesSquaredWithFactors,
+                                threadWorkspace.vectorMassesSquaredWithFactors,
+                                    coefficientSnapshot.InverseScaleSquared(),
+                                    evaluationContext.temperatureValue );
     }
   }
 
+  // This fills a new snapshot of the Lagrangian parameters and term
+  // coefficients at the appropriate scale from lagrangianParameterManager and
+  // makes it the current snapshot. Snapshots which were taken before are left
+  // unchanged.
+  void FixedScaleOneLoopPotential::RespondToObservedSignal()
+  {
+    double const renormalizationScale(
+                    lagrangianParameterManager.AppropriateSingleFixedScale() );
+    std::shared_ptr< FixedScaleCoefficients >
+    coefficientSnapshot( new FixedScaleCoefficients( renormalizationScale,
+                                          numberOfFixedScaleCoefficients ) );
+    double const logarithmOfScale( log( renormalizationScale ) );
+    lagrangianParameterManager.ParameterValues( logarithmOfScale,
+                                       coefficientSnapshot->ParameterValues() );
+    UpdateDsbValues( logarithmOfScale );
+    SetFixedScaleCoefficients( *coefficientSnapshot );
+    fixedScaleCoefficients = coefficientSnapshot;
+  }
+
   // This returns a string that is valid Python with no indentation to evaluate
   // the potential in three functions:
   // TreeLevelPotential( fv ), JustLoopCorrectedPotential( fv ), and
@@ -96,7 +172,8 @@ namespace VevaciousPlusPlus
      std::stringstream stringBuilder;
      stringBuilder << std::setprecision( 12 );
      stringBuilder
-     << "fixedScaleInverseSquare = " << inverseRenormalizationScaleSquared
+     << "fixedScaleInverseSquare = "
+     << fixedScaleCoefficients->InverseScaleSquared()
      << "\n"
      "\n"
      "def TreeLevelPotential( fv ):\n"
@@ -130,16 +207,21 @@ namespace VevaciousPlusPlus
                                           double const temperatureValue ) const
    {
      std::stringstream stringBuilder;
+     FixedScaleCoefficients const&
+     coefficientSnapshot( *fixedScaleCoefficients );
      std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors;
-     AddMassesSquaredWithMultiplicity( fieldConfiguration,
+     SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                       fieldConfiguration,
                                        scalarSquareMasses,
                                        scalarMassesSquaredWithFactors );
      std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors;
-     AddMassesSquaredWithMultiplicity( fieldConfiguration,
+     SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                       fieldConfiguration,
                                        fermionSquareMasses,
                                        fermionMassesSquaredWithFactors );
      std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors;
-     AddMassesSquaredWithMultiplicity( fieldConfiguration,
+     SetMassesSquaredWithMultiplicity( coefficientSnapshot,
+                                       fieldConfiguration,
                                        vectorSquareMasses,
                                        vectorMassesSquaredWithFactors );
 
@@ -205,26 +287,30 @@ namespace VevaciousPlusPlus
      stringBuilder << " }";
      stringBuilder << std::endl;
      stringBuilder << "treeLevelPotential = "
-     << treeLevelPotential( fieldConfiguration );
+     << treeLevelPotential( coefficientSnapshot,
+                            fieldConfiguration );
      stringBuilder << std::endl;
      stringBuilder << "polynomialLoopCorrections = "
-     << polynomialLoopCorrections( fieldConfiguration )
+     << polynomialLoopCorrections( coefficientSnapshot,
+                                   fieldConfiguration )
      << std::endl;
      stringBuilder << "LoopAndThermalCorrections = "
      << LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
                                    fermionMassesSquaredWithFactors,
                                    vectorMassesSquaredWithFactors,
-                                   inverseRenormalizationScaleSquared,
+                                   coefficientSnapshot.InverseScaleSquared(),
                                    temperatureValue );
      stringBuilder << std::endl;
 
      stringBuilder
-     << "Total value = " << ( treeLevelPotential( fieldConfiguration )
-                              + polynomialLoopCorrections( fieldConfiguration )
+     << "Total value = " << ( treeLevelPotential( coefficientSnapshot,
+                                                  fieldConfiguration )
+                              + polynomialLoopCorrections( coefficientSnapshot,
+                                                          fieldConfiguration )
                    + LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
                                                fermionMassesSquaredWithFactors,
                                                 vectorMassesSquaredWithFactors,
-                                            inverseRenormalizationScaleSquared,
+                                     coefficientSnapshot.InverseScaleSquared(),
                                                 temperatureValue ) );
      return stringBuilder.str();
    }
@@ -31,6 +31,12 @@ namespace VevaciousPlusPlus
                                                       "PositiveByConvention" );
   std::string const PotentialFromPolynomialWithMasses::negativeByConvention(
                                                       "NegativeByConvention" );
+  std::string const
+  PotentialFromPolynomialWithMasses::modelCacheSuffix( ".cache" );
+  std::string const PotentialFromPolynomialWithMasses::modelCacheIdentifier(
+                                               "VevaciousPlusPlusModelCache" );
+  std::uint32_t const
+  PotentialFromPolynomialWithMasses::modelCacheVersion( 1 );
 
   PotentialFromPolynomialWithMasses::PotentialFromPolynomialWithMasses(
                                               std::string const& modelFilename,
@@ -50,7 +56,445 @@ namespace VevaciousPlusPlus
     fieldsAssumedPositive(),
     fieldsAssumedNegative(),
     assumedPositiveOrNegativeTolerance( assumedPositiveOrNegativeTolerance ),
-    readImaginaryPartForRealValue( false )
+    readImaginaryPartForRealValue( false ),
+    polynomialGradient(),
+    numberOfFixedScaleCoefficients( 0 ),
+    parameterRegistrationOrder(),
+    parameterRegistrationResults(),
+    registeredParameterNames()
+  {
+    // The hash of the model file includes the type of the Lagrangian
+    // parameter manager, as that determines how the names of fields and
+    // parameters are formatted.
+    MappedFileReader modelFile( modelFilename );
+    std::string const cacheFilename( modelFilename + modelCacheSuffix );
+    std::string const
+    hashPrefix( modelCacheIdentifier
+                + typeid( lagrangianParameterManager ).name() );
+    std::uint64_t const
+    sourceHash( modelFile.ContentHash( MappedFileReader::HashBytes(
+                                                             hashPrefix.data(),
+                                                       hashPrefix.size() ) ) );
+    if( !( modelFile.IsMapped()
+           &&
+           ReadModelCache( cacheFilename,
+                           sourceHash ) ) )
+    {
+      std::vector< AttributeMap > scalarMatrixAttributes;
+      std::vector< AttributeMap > fermionMatrixAttributes;
+      std::vector< AttributeMap > fermionSquaredMatrixAttributes;
+      std::vector< AttributeMap > vectorMatrixAttributes;
+      ParseModelFile( modelFilename,
+                      scalarMatrixAttributes,
+                      fermionMatrixAttributes,
+                      fermionSquaredMatrixAttributes,
+                      vectorMatrixAttributes );
+      if( modelFile.IsMapped() )
+      {
+        WriteModelCache( cacheFilename,
+                         sourceHash,
+                         scalarMatrixAttributes,
+                         fermionMatrixAttributes,
+                         fermionSquaredMatrixAttributes,
+                         vectorMatrixAttributes );
+      }
+    }
+    // The order of the registrations is kept for copying the potential for
+    // another Lagrangian parameter manager, but the set of names is only
+    // needed while parsing.
+    registeredParameterNames.clear();
+
+    if( readImaginaryPartForRealValue )
+    {
+      std::stringstream warningBuilder;
+      warningBuilder << "At least once in \"" << modelFilename
+      << "\", an imaginary part was read for a polynomial which should be"
+      << " purely real. This imaginary part or these imaginary parts have been"
+      << " ignored, as it may be an artifact of a cancellation which is only"
+      << " apparent when there are values for the Lagrangian parameters (e.g."
+      << " soft SUSY-breaking mass-squared matrices should be Hermitian so the"
+      << " imaginary part of the sum of opposite off-diagonal elements is"
+      << " zero).";
+      WarningLogger::LogWarning( warningBuilder.str() );
+    }
+
+    // Now we can fill the MassesSquaredCalculator* vectors, as their pointers
+    // should remain valid as the other vectors do not change size any more
+    // after the constructor.
+    for( size_t pointerIndex( 0 );
+         pointerIndex < scalarMassSquaredMatrices.size();
+         ++pointerIndex )
+    {
+      scalarSquareMasses.push_back(
+                                &(scalarMassSquaredMatrices[ pointerIndex ]) );
+    }
+    for( size_t pointerIndex( 0 );
+         pointerIndex < fermionMassMatrices.size();
+         ++pointerIndex )
+    {
+      fermionSquareMasses.push_back( &(fermionMassMatrices[ pointerIndex ]) );
+    }
+    for( size_t pointerIndex( 0 );
+         pointerIndex < fermionMassSquaredMatrices.size();
+         ++pointerIndex )
+    {
+      fermionSquareMasses.push_back(
+                               &(fermionMassSquaredMatrices[ pointerIndex ]) );
+    }
+    for( size_t pointerIndex( 0 );
+         pointerIndex < vectorMassSquaredMatrices.size();
+         ++pointerIndex )
+    {
+      vectorSquareMasses.push_back(
+                                &(vectorMassSquaredMatrices[ pointerIndex ]) );
+    }
+
+    PrepareForEvaluation();
+  }
+
+  PotentialFromPolynomialWithMasses::~PotentialFromPolynomialWithMasses()
+  {
+    // This does nothing.
+  }
+
+  // This writes the potential as
+  // def PotentialFunction( fv ): return ...
+  // in pythonFilename for fv being an array of floating-point numbers in the
+  // same order as they are for the field configurations as internal to this
+  // C++ code. It uses the virtual function WriteActualPythonFunction.
+  void PotentialFromPolynomialWithMasses::WriteAsPython(
+                                      std::string const& pythonFilename ) const
+  {
+    std::ofstream pythonFile( pythonFilename.c_str() );
+    pythonFile << std::setprecision( 12 );
+    pythonFile << "# Automatically generated file! Modify at your own PERIL!\n"
+    "# This file was created by Vevacious version "
+    << VersionInformation::CurrentVersion() << "\n"
+    "from __future__ import division\n"
+    "import math\n"
+    "import numpy\n"
+    "\n"
+    "\n"
+    "# The temperature has to be held as a global variable because\n"
+    "# CosmoTransitions.fullTunneling does not pass in the temperature.\n"
+    "temperatureLinear = 0.0\n"
+    "temperatureSquare = 0.0\n"
+    "temperatureFourth = 0.0\n"
+    "temperatureInverseSquare = -1.0\n"
+    "def SetGlobalTemperature( globalTemperature ):\n"
+    "  temperatureLinear = globalTemperature\n"
+    "  temperatureSquare = ( temperatureLinear * temperatureLinear )\n"
+    "  temperatureFourth = ( temperatureSquare * temperatureSquare )\n"
+    "  if ( globalTemperature > 0.0 ):\n"
+    "    temperatureInverseSquare = ( 1.0 / temperatureSquare )\n"
+    "  else:\n"
+    "    temperatureInverseSquare = -1.0\n"
+    "\n"
+    "\n"
+    << ThermalFunctions::JFunctionsAsPython() << "\n"
+    "\n"
+    << lagrangianParameterManager.ParametersAsPython() << "\n"
+    "# The Lagrangian parameters evaluated at the appropriate scale from the\n"
+    "# C++ parameter manager are held in the following global array.\n"
+    "fixedScaleLagrangianParameters = LagrangianParameters( math.log( "
+    << lagrangianParameterManager.AppropriateSingleFixedScale()
+    << " ) )\n"
+    "\n"
+    "# In the following functions, the field configuration is given by fv\n"
+    "# and the Lagrangian parameters are given by lp.\n"
+    "def TreeLevelContribution( fv,\n"
+    "                           lp ):\n"
+    "    return ( " << treeLevelPotential.AsPython() << " )\n"
+    "\n"
+    "# The field configuration is given by fv and the Lagrangian parameters\n"
+    "# are given by lp.\n"
+    "def PolynomialLoopCorrections( fv,\n"
+    "                               lp ):\n"
+    "    return ( " << polynomialLoopCorrections.AsPython() << " )\n"
+    "\n"
+    "def JustLoopCorrection( massesSquaredWithFactors,\n"
+    "                        subtractionConstant,\n"
+    "                        invQSq ):\n"
+    "    cumulativeQuantumCorrection = 0.0\n"
+    "    for massSquaredWithFactor in massesSquaredWithFactors:\n"
+    "        currentQuantumCorrection = 0.0\n"
+    "        for MSq in massSquaredWithFactor[ 0 ]:\n"
+    "            MM = abs( MSq )\n"
+    "            if ( MM > 0.0 ):\n"
+    "                currentQuantumCorrection += ( MM**2\n"
+    "                                       * ( math.log( MM * invQSq )\n"
+    "                                           - subtractionConstant ) )\n"
+    "        cumulativeQuantumCorrection += ( massSquaredWithFactor[ 1 ]\n"
+    "                                         * currentQuantumCorrection )\n"
+    "    return cumulativeQuantumCorrection\n"
+    "\n"
+    "def LoopAndThermalCorrection( massesSquaredWithFactors,\n"
+    "                              subtractionConstant,\n"
+    "                              invQSq,\n"
+    "                              invTSq,\n"
+    "                              JFunction ):\n"
+    "    cumulativeQuantumCorrection = 0.0\n"
+    "    cumulativeThermalCorrection = 0.0\n"
+    "    for massSquaredWithFactor in massesSquaredWithFactors:\n"
+    "        currentQuantumCorrection = 0.0\n"
+    "        currentThermalCorrection = 0.0\n"
+    "        for MSq in massSquaredWithFactor[ 0 ]:\n"
+    "            MM = abs( MSq )\n"
+    "            if ( MM > 0.0 ):\n"
+    "                currentQuantumCorrection += ( MM**2\n"
+    "                                       * ( math.log( MM * invQSq )\n"
+    "                                           - subtractionConstant ) )\n"
+    "            currentThermalCorrection += JFunction( MM * invTSq )\n"
+    "        cumulativeQuantumCorrection += ( massSquaredWithFactor[ 1 ]\n"
+    "                                         * currentQuantumCorrection )\n"
+    "        cumulativeThermalCorrection += ( massSquaredWithFactor[ 1 ]\n"
+    "                                         * currentThermalCorrection )\n"
+    "    return [ cumulativeQuantumCorrection, cumulativeThermalCorrection ]\n"
+    "\n"
+    "def ScalarMassesSquaredWithFactors( fv,\n"
+    "                                    lp ):\n"
+    "    massesSquaredWithFactors = []\n";
+    for( std::vector< RealMassesSquaredMatrix >::const_iterator
+         whichMatrix( scalarMassSquaredMatrices.begin() );
+         whichMatrix < scalarMassSquaredMatrices.end();
+         ++whichMatrix )
+    {
+      pythonFile << "    massSquaredMatrix = numpy.array( [ ";
+      for( std::vector< ParametersAndFieldsProductSum >::const_iterator
+           matrixElement( whichMatrix->MatrixElements().begin() );
+           matrixElement < whichMatrix->MatrixElements().end();
+           ++matrixElement )
+      {
+        if( matrixElement != whichMatrix->MatrixElements().begin() )
+        {
+          pythonFile << ",\n";
+        }
+        pythonFile << matrixElement->AsPython();
+      }
+      pythonFile << " ] )\n"
+      "    M = numpy.reshape( massSquaredMatrix, ( "
+                                 << whichMatrix->NumberOfRows() << ", -1 ) )\n"
+      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( M ),\n"
+      "                     " << whichMatrix->MultiplicityFactor() << " ] )\n";
+    }
+    pythonFile << "    return massesSquaredWithFactors\n"
+    "\n"
+    "def FermionMassesSquaredWithFactors( fv,\n"
+    "                                     lp ):\n"
+    "    massesSquaredWithFactors = []\n";
+    for( std::vector< ComplexMassSquaredMatrix >::const_iterator
+         whichMatrix( fermionMassSquaredMatrices.begin() );
+         whichMatrix < fermionMassSquaredMatrices.end();
+         ++whichMatrix )
+    {
+      pythonFile << "    massSquaredMatrix = numpy.array( [ ";
+      for( std::vector< ComplexParametersAndFieldsProductSum >::const_iterator
+           matrixElement( whichMatrix->MatrixElements().begin() );
+           matrixElement < whichMatrix->MatrixElements().end();
+           ++matrixElement )
+      {
+        if( matrixElement != whichMatrix->MatrixElements().begin() )
+        {
+          pythonFile << ",\n";
+        }
+        pythonFile << "( " << matrixElement->first.AsPython()
+        << " + ( 1j * " << matrixElement->second.AsPython() << " ) )";
+      }
+      pythonFile << " ] )\n"
+      "    M = numpy.reshape( massSquaredMatrix, ( "
+                                 << whichMatrix->NumberOfRows() << ", -1 ) )\n"
+      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( M ),\n"
+      "                     " << whichMatrix->MultiplicityFactor() << " ] )\n";
+    }
+    for( std::vector< SymmetricComplexMassMatrix >::const_iterator
+         whichMatrix( fermionMassMatrices.begin() );
+         whichMatrix < fermionMassMatrices.end();
+         ++whichMatrix )
+    {
+      pythonFile << "    massMatrix = numpy.array( [ ";
+      for( std::vector< ComplexParametersAndFieldsProductSum >::const_iterator
+           matrixElement( whichMatrix->MatrixElements().begin() );
+           matrixElement < whichMatrix->MatrixElements().end();
+           ++matrixElement )
+      {
+        if( matrixElement != whichMatrix->MatrixElements().begin() )
+        {
+          pythonFile << ",\n";
+        }
+        pythonFile << "( " << matrixElement->first.AsPython()
+        << " + ( 1j * " << matrixElement->second.AsPython() << " ) )";
+      }
+      pythonFile << " ] )\n"
+      "    M = numpy.reshape( massMatrix, ( " << whichMatrix->NumberOfRows()
+                                                                << ", -1 ) )\n"
+      "    MM = M.dot( numpy.transpose( numpy.conjugate( M ) ) )\n"
+      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( MM ),\n"
+                              << whichMatrix->MultiplicityFactor() << " ] )\n";
+    }
+    pythonFile << "    return massesSquaredWithFactors\n"
+    "\n"
+    "def VectorMassesSquaredWithFactors( fv,\n"
+    "                                    lp ):\n"
+    "    massesSquaredWithFactors = []\n";
+    for( std::vector< RealMassesSquaredMatrix >::const_iterator
+         whichMatrix( vectorMassSquaredMatrices.begin() );
+         whichMatrix < vectorMassSquaredMatrices.end();
+         ++whichMatrix )
+    {
+      pythonFile << "    massSquaredMatrix = numpy.array( [ ";
+      for( std::vector< ParametersAndFieldsProductSum >::const_iterator
+           matrixElement( whichMatrix->MatrixElements().begin() );
+           matrixElement < whichMatrix->MatrixElements().end();
+           ++matrixElement )
+      {
+        if( matrixElement != whichMatrix->MatrixElements().begin() )
+        {
+          pythonFile << ",\n";
+        }
+        pythonFile << matrixElement->AsPython();
+      }
+      pythonFile << " ] )\n"
+      "    M = numpy.reshape( massSquaredMatrix, ( "
+                                 << whichMatrix->NumberOfRows() << ", -1 ) )\n"
+      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( M ),\n"
+      "                     " << whichMatrix->MultiplicityFactor() << " ] )\n";
+    }
+    pythonFile << "    return massesSquaredWithFactors\n"
+    "\n"
+    "\n"
+    "loopFactor = ( 1.0 / ( 64.0 * math.pi * math.pi ) )\n"
+    "thermalFactor = ( 1.0 / ( 2.0 * math.pi * math.pi ) )\n"
+    "\n"
+    "def JustLoopCorrections( fv,\n"
+    "                         lp,\n"
+    "                         invQSq ):\n"
+    "    totalQuantumCorrections = 0.0\n"
+    "    currentCorrection = JustLoopCorrection(\n"
+    "                                    ScalarMassesSquaredWithFactors( fv,\n"
+    "                                                                  lp ),\n"
+    "                                            1.5,\n"
+    "                                            invQSq )\n"
+    "    totalQuantumCorrections += currentCorrection\n"
+    "    currentCorrection = JustLoopCorrection(\n"
+    "                                   FermionMassesSquaredWithFactors( fv,\n"
+    "                                                                  lp ),\n"
+    "                                            1.5,\n"
+    "                                            invQSq )\n"
+    "    totalQuantumCorrections -= ( 2.0 * currentCorrection )\n"
+    "    currentCorrection = JustLoopCorrection(\n"
+    "                                    VectorMassesSquaredWithFactors( fv,\n"
+    "                                                                  lp ),\n"
+    "                                " << vectorMassCorrectionConstant << ",\n"
+    "                                            invQSq )\n"
+    "    totalQuantumCorrections += ( 3.0 * currentCorrection )\n"
+    "    return ( totalQuantumCorrections * loopFactor )\n"
+    "\n"
+    "def LoopAndThermalCorrections( fv,\n"
+    "                               lp,\n"
+    "                               invQSq,\n"
+    "                               invTSq ):\n"
+    "    totalQuantumCorrections = 0.0\n"
+    "    totalThermalCorrections = 0.0\n"
+    "    currentCorrections = LoopAndThermalCorrection(\n"
+    "                                    ScalarMassesSquaredWithFactors( fv,\n"
+    "                                                                  lp ),\n"
+    "                                                   1.5,\n"
+    "                                                   invQSq,\n"
+    "                                                   invTSq,\n"
+    "                                                   BosonicJ )\n"
+    "# Real scalar degrees of freedom add to both quantum and thermal\n"
+    "# corrections without any factors.\n"
+    "    totalQuantumCorrections += currentCorrections[ 0 ]\n"
+    "    totalThermalCorrections += currentCorrections[ 1 ]\n"
+    "    currentCorrections = LoopAndThermalCorrection(\n"
+    "                                   FermionMassesSquaredWithFactors( fv,\n"
+    "                                                                  lp ),\n"
+    "                                                   1.5,\n"
+    "                                                   invQSq,\n"
+    "                                                   invTSq,\n"
+    "                                                   FermionicJ )\n"
+    "# Weyl fermion degrees of freedom add to both quantum and thermal\n"
+    "# corrections with a factor of 2, though there is an additional minus\n"
+    "# sign for the quantum corrections. (The conventions used in Vevacious\n"
+    "# are that the thermal correction functions already have any minus\n"
+    "# signs for fermions.)\n"
+    "    totalQuantumCorrections -= ( 2.0 * currentCorrections[ 0 ] )\n"
+    "    totalThermalCorrections += ( 2.0 * currentCorrections[ 1 ] )\n"
+    "    currentCorrections = LoopAndThermalCorrection(\n"
+    "                                    VectorMassesSquaredWithFactors( fv,\n"
+    "                                                                  lp ),\n"
+    "                                " << vectorMassCorrectionConstant << ",\n"
+    "                                                   invQSq,\n"
+    "                                                   invTSq,\n"
+    "                                                   BosonicJ )\n"
+    "# Vector boson degrees of freedom add to quantum corrections with a\n"
+    "# factor of 3 in dimensional regularization schemes, and to thermal\n"
+    "# corrections with a factor of 2.\n"
+    "    totalQuantumCorrections += ( 3.0 * currentCorrections[ 0 ] )\n"
+    "    totalThermalCorrections += ( 2.0 * currentCorrections[ 1 ] )\n"
+    "    return ( ( totalQuantumCorrections * loopFactor )\n"
+    "             + ( ( totalThermalCorrections * thermalFactor )\n"
+    "                 / ( invTSq**2 ) ) )\n"
+    "\n"
+    << WriteActualPythonFunction() << "\n"
+    "\n"
+    "# This can be changed to use just the tree-level potential, or the\n"
+    "# loop-corrected potential without thermal corrections.\n"
+    "UnderlyingPotential = LoopAndThermallyCorrectedPotential\n"
+    "\n"
+    "stepSize = 1.0\n"
+    "\n"
+    "def UnderlyingGradient( fv ):\n"
+    "    potentialAtPoint = UnderlyingPotential( fv )\n"
+    "    gradientArray = numpy.zeros( len( fv ) )\n"
+    "    for whichField in range( len( fv ) ):\n"
+    "        displacedPoint = fv.copy()\n"
+    "        displacedPoint[ whichField ] += stepSize\n"
+    "        gradientArray[ whichField ] = ( ( UnderlyingPotential(\n"
+    "                                                       displacedPoint )\n"
+    "                                          - potentialAtPoint )\n"
+    "                                        / stepSize )\n"
+    "    return gradientArray\n"
+    "\n"
+    "def PotentialForCosmotransitions( arrayOfArrays ):\n"
+    "    if ( arrayOfArrays.shape == ( " << numberOfFields << ", ) ):\n"
+    "        return UnderlyingPotential( arrayOfArrays )\n"
+    "    elif ( arrayOfArrays.shape == ( len( arrayOfArrays ), "
+                                                 << numberOfFields << " ) ):\n"
+    "        returnArray = numpy.zeros( len( arrayOfArrays ) )\n"
+    "        for whichIndex in range( len( arrayOfArrays ) ):\n"
+    "            returnArray[ whichIndex ] = UnderlyingPotential(\n"
+    "                                          arrayOfArrays[ whichIndex ] )\n"
+    "        return returnArray\n"
+    "    else:\n"
+    "        return None\n"
+    "\n"
+    "def GradientForCosmotransitions( arrayOfArrays ):\n"
+    "    if ( arrayOfArrays.shape == ( " << numberOfFields << ", ) ):\n"
+    "        return UnderlyingGradient( arrayOfArrays )\n"
+    "    elif ( arrayOfArrays.shape == ( len( arrayOfArrays ), "
+                                                 << numberOfFields << " ) ):\n"
+    "        returnMatrix = arrayOfArrays.copy()\n"
+    "        for whichIndex in range( len( arrayOfArrays ) ):\n"
+    "            returnMatrix[ whichIndex ] = UnderlyingGradient(\n"
+    "                                          arrayOfArrays[ whichIndex ] )\n"
+    "        return returnMatrix\n"
+    "    else:\n"
+    "        return None\n"
+    "\n"
+    "# End of automatically generated file!\n";
+    pythonFile.close();
+  }
+
+  // This parses the model file as XML, filling the polynomials and the mass
+  // matrices, and putting the attributes of each matrix into the vector for
+  // its type, in the same order as the matrices.
+  void PotentialFromPolynomialWithMasses::ParseModelFile(
+                                              std::string const& modelFilename,
+                          std::vector< AttributeMap >& scalarMatrixAttributes,
+                         std::vector< AttributeMap >& fermionMatrixAttributes,
+                  std::vector< AttributeMap >& fermionSquaredMatrixAttributes,
+                          std::vector< AttributeMap >& vectorMatrixAttributes )
   {
     LHPC::RestrictedXmlParser xmlParser;
     std::string xmlFieldVariables( "" );
@@ -252,10 +696,12 @@ namespace VevaciousPlusPlus
             == MassesSquaredCalculator::gaugeBoson )
         {
           vectorMassSquaredMatrices.push_back( massSquaredMatrix );
+          vectorMatrixAttributes.push_back( xmlParser.CurrentAttributes() );
         }
         else
         {
           scalarMassSquaredMatrices.push_back( massSquaredMatrix );
+          scalarMatrixAttributes.push_back( xmlParser.CurrentAttributes() );
         }
       }
       //   </RealBosonMassSquaredMatrix>
@@ -277,6 +723,7 @@ namespace VevaciousPlusPlus
                                     fermionMassMatrix.ElementAt( lineIndex ) );
         }
         fermionMassMatrices.push_back( fermionMassMatrix );
+        fermionMatrixAttributes.push_back( xmlParser.CurrentAttributes() );
       }
       //   </WeylFermionMassMatrix>
       //   <ComplexWeylFermionMassSquaredMatrix>
@@ -298,389 +745,334 @@ namespace VevaciousPlusPlus
                              fermionMassSquaredMatrix.ElementAt( lineIndex ) );
         }
         fermionMassSquaredMatrices.push_back( fermionMassSquaredMatrix );
+        fermionSquaredMatrixAttributes.push_back(
+                                               xmlParser.CurrentAttributes() );
       }
       //   </WeylFermionMassMatrix>
     }
     // </LoopCorrections>
+  }
 
-    if( readImaginaryPartForRealValue )
+  // This fills the polynomials and the mass matrices from the binary cache in
+  // cacheFilename, returning true if it succeeded. It returns false, leaving
+  // the model empty, if there is no cache, if the cache was written for a
+  // model file with a different hash from sourceHash or in a different
+  // layout, if it is corrupt, or if registering its Lagrangian parameters
+  // does not give the same indices as when it was written.
+  bool PotentialFromPolynomialWithMasses::ReadModelCache(
+                                              std::string const& cacheFilename,
+                                               std::uint64_t const sourceHash )
+  {
+    MappedFileReader cacheReader( cacheFilename );
+    if( !(cacheReader.IsMapped()) )
     {
-      std::stringstream warningBuilder;
-      warningBuilder << "At least once in \"" << modelFilename
-      << "\", an imaginary part was read for a polynomial which should be"
-      << " purely real. This imaginary part or these imaginary parts have been"
-      << " ignored, as it may be an artifact of a cancellation which is only"
-      << " apparent when there are values for the Lagrangian parameters (e.g."
-      << " soft SUSY-breaking mass-squared matrices should be Hermitian so the"
-      << " imaginary part of the sum of opposite off-diagonal elements is"
-      << " zero).";
-      WarningLogger::LogWarning( warningBuilder.str() );
+      return false;
     }
+    try
+    {
+      if( ( cacheReader.ReadString() != modelCacheIdentifier )
+          ||
+          ( cacheReader.ReadValue< std::uint32_t >() != modelCacheVersion )
+          ||
+          ( cacheReader.ReadValue< std::uint64_t >() != sourceHash ) )
+      {
+        return false;
+      }
+      vectorMassCorrectionConstant = cacheReader.ReadValue< double >();
+      readImaginaryPartForRealValue
+      = ( cacheReader.ReadValue< std::uint8_t >() != 0 );
+      // Each field has a name and a DSB input string, each of which takes at
+      // least the 8 bytes of its length.
+      numberOfFields = cacheReader.ReadCount( 16 );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        fieldNames.push_back( cacheReader.ReadString() );
+        dsbFieldInputStrings.push_back( cacheReader.ReadString() );
+      }
+      dsbFieldValueInputs.resize( numberOfFields );
+      fieldsAssumedPositive.resize( cacheReader.ReadCount( 8 ) );
+      for( size_t signIndex( 0 );
+           signIndex < fieldsAssumedPositive.size();
+           ++signIndex )
+      {
+        fieldsAssumedPositive[ signIndex ]
+        = cacheReader.ReadValue< std::uint64_t >();
+      }
+      fieldsAssumedNegative.resize( cacheReader.ReadCount( 8 ) );
+      for( size_t signIndex( 0 );
+           signIndex < fieldsAssumedNegative.size();
+           ++signIndex )
+      {
+        fieldsAssumedNegative[ signIndex ]
+        = cacheReader.ReadValue< std::uint64_t >();
+      }
 
-    // Now we can fill the MassesSquaredCalculator* vectors, as their pointers
-    // should remain valid as the other vectors do not change size any more
-    // after the constructor.
-    for( size_t pointerIndex( 0 );
-         pointerIndex < scalarMassSquaredMatrices.size();
-         ++pointerIndex )
+      // The registrations are only read here, as the parameter manager must
+      // not be touched until the whole cache is known to be valid. Each takes
+      // at least the 8 bytes of the name length, 1 byte of validity, and the
+      // 8 bytes of the index.
+      std::vector< std::string > cachedNames;
+      std::vector< std::pair< bool, size_t > > cachedResults;
+      std::set< size_t > validParameterIndices;
+      size_t const numberOfRegistrations( cacheReader.ReadCount( 17 ) );
+      for( size_t registrationIndex( 0 );
+           registrationIndex < numberOfRegistrations;
+           ++registrationIndex )
+      {
+        cachedNames.push_back( cacheReader.ReadString() );
+        bool const cachedValidity( cacheReader.ReadValue< std::uint8_t >()
+                                   != 0 );
+        size_t const cachedIndex( cacheReader.ReadValue< std::uint64_t >() );
+        cachedResults.push_back( std::make_pair( cachedValidity,
+                                                 cachedIndex ) );
+        if( cachedValidity )
+        {
+          validParameterIndices.insert( cachedIndex );
+        }
+      }
+
+      ReadSum( cacheReader,
+               validParameterIndices,
+               treeLevelPotential );
+      ReadSum( cacheReader,
+               validParameterIndices,
+               polynomialLoopCorrections );
+      ReadMatrices( cacheReader,
+                    validParameterIndices,
+                    scalarMassSquaredMatrices );
+      ReadMatrices( cacheReader,
+                    validParameterIndices,
+                    fermionMassMatrices );
+      ReadMatrices( cacheReader,
+                    validParameterIndices,
+                    fermionMassSquaredMatrices );
+      ReadMatrices( cacheReader,
+                    validParameterIndices,
+                    vectorMassSquaredMatrices );
+      if( !(cacheReader.AtEnd()) )
+      {
+        throw std::runtime_error( "Model cache has extra bytes at end!" );
+      }
+
+      // The parameters are registered in the same order as they were while
+      // parsing the model file, so they should get the same indices, unless
+      // for example the parameter manager was set up differently. If they do
+      // not, the model file is parsed, which registers the same names in the
+      // same order anyway, so nothing extra is left in the manager.
+      for( size_t registrationIndex( 0 );
+           registrationIndex < numberOfRegistrations;
+           ++registrationIndex )
+      {
+        std::pair< bool, size_t > const parameterValidityAndIndex(
+                                 lagrangianParameterManager.RegisterParameter(
+                                         cachedNames[ registrationIndex ] ) );
+        std::pair< bool, size_t > const&
+        cachedResult( cachedResults[ registrationIndex ] );
+        if( ( parameterValidityAndIndex.first != cachedResult.first )
+            ||
+            ( cachedResult.first
+              &&
+              ( parameterValidityAndIndex.second != cachedResult.second ) ) )
+        {
+          throw std::runtime_error( "Cached parameter index has changed!" );
+        }
+      }
+      parameterRegistrationOrder.swap( cachedNames );
+      parameterRegistrationResults.swap( cachedResults );
+      return true;
+    }
+    catch( std::exception const& )
     {
-      scalarSquareMasses.push_back(
-                                &(scalarMassSquaredMatrices[ pointerIndex ]) );
+      // Any problem with the cache just means that the model file has to be
+      // parsed, so whatever was read so far is thrown away.
+      vectorMassCorrectionConstant = ( 5.0 / 6.0 );
+      readImaginaryPartForRealValue = false;
+      fieldNames.clear();
+      numberOfFields = 0;
+      dsbFieldInputStrings.clear();
+      dsbFieldValueInputs.clear();
+      fieldsAssumedPositive.clear();
+      fieldsAssumedNegative.clear();
+      parameterRegistrationOrder.clear();
+      parameterRegistrationResults.clear();
+      treeLevelPotential.ParametersAndFieldsProducts().clear();
+      polynomialLoopCorrections.ParametersAndFieldsProducts().clear();
+      scalarMassSquaredMatrices.clear();
+      fermionMassMatrices.clear();
+      fermionMassSquaredMatrices.clear();
+      vectorMassSquaredMatrices.clear();
+      return false;
     }
-    for( size_t pointerIndex( 0 );
-         pointerIndex < fermionMassMatrices.size();
-         ++pointerIndex )
+  }
+
+  // This writes the parsed model into the binary cache in cacheFilename
+  // along with sourceHash. Nothing is written if the file cannot be written,
+  // as the cache is only there to save time.
+  void PotentialFromPolynomialWithMasses::WriteModelCache(
+                                              std::string const& cacheFilename,
+                                                std::uint64_t const sourceHash,
+                     std::vector< AttributeMap > const& scalarMatrixAttributes,
+                    std::vector< AttributeMap > const& fermionMatrixAttributes,
+             std::vector< AttributeMap > const& fermionSquaredMatrixAttributes,
+                    std::vector< AttributeMap > const& vectorMatrixAttributes )
+  {
+    BinaryFileWriter cacheWriter;
+    cacheWriter.AppendString( modelCacheIdentifier );
+    cacheWriter.AppendValue< std::uint32_t >( modelCacheVersion );
+    cacheWriter.AppendValue< std::uint64_t >( sourceHash );
+    cacheWriter.AppendValue< double >( vectorMassCorrectionConstant );
+    cacheWriter.AppendValue< std::uint8_t >( readImaginaryPartForRealValue );
+    cacheWriter.AppendValue< std::uint64_t >( numberOfFields );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
     {
-      fermionSquareMasses.push_back( &(fermionMassMatrices[ pointerIndex ]) );
+      cacheWriter.AppendString( fieldNames[ fieldIndex ] );
+      cacheWriter.AppendString( dsbFieldInputStrings[ fieldIndex ] );
     }
-    for( size_t pointerIndex( 0 );
-         pointerIndex < fermionMassSquaredMatrices.size();
-         ++pointerIndex )
+    cacheWriter.AppendValue< std::uint64_t >( fieldsAssumedPositive.size() );
+    for( size_t signIndex( 0 );
+         signIndex < fieldsAssumedPositive.size();
+         ++signIndex )
     {
-      fermionSquareMasses.push_back(
-                               &(fermionMassSquaredMatrices[ pointerIndex ]) );
+      cacheWriter.AppendValue< std::uint64_t >(
+                                          fieldsAssumedPositive[ signIndex ] );
     }
-    for( size_t pointerIndex( 0 );
-         pointerIndex < vectorMassSquaredMatrices.size();
-         ++pointerIndex )
+    cacheWriter.AppendValue< std::uint64_t >( fieldsAssumedNegative.size() );
+    for( size_t signIndex( 0 );
+         signIndex < fieldsAssumedNegative.size();
+         ++signIndex )
     {
-      vectorSquareMasses.push_back(
-                                &(vectorMassSquaredMatrices[ pointerIndex ]) );
+      cacheWriter.AppendValue< std::uint64_t >(
+                                          fieldsAssumedNegative[ signIndex ] );
     }
-  }
 
-  PotentialFromPolynomialWithMasses::~PotentialFromPolynomialWithMasses()
-  {
-    // This does nothing.
+    // Registering each parameter again just looks up the index which it was
+    // given while parsing the model file.
+    cacheWriter.AppendValue< std::uint64_t >(
+                                         parameterRegistrationOrder.size() );
+    for( std::vector< std::string >::const_iterator
+         parameterName( parameterRegistrationOrder.begin() );
+         parameterName != parameterRegistrationOrder.end();
+         ++parameterName )
+    {
+      std::pair< bool, size_t > const parameterValidityAndIndex(
+              lagrangianParameterManager.RegisterParameter( *parameterName ) );
+      cacheWriter.AppendString( *parameterName );
+      cacheWriter.AppendValue< std::uint8_t >(
+                                            parameterValidityAndIndex.first );
+      cacheWriter.AppendValue< std::uint64_t >(
+                                           parameterValidityAndIndex.second );
+    }
+
+    AppendSum( cacheWriter,
+               treeLevelPotential );
+    AppendSum( cacheWriter,
+               polynomialLoopCorrections );
+    AppendMatrices( cacheWriter,
+                    scalarMassSquaredMatrices,
+                    scalarMatrixAttributes );
+    AppendMatrices( cacheWriter,
+                    fermionMassMatrices,
+                    fermionMatrixAttributes );
+    AppendMatrices( cacheWriter,
+                    fermionMassSquaredMatrices,
+                    fermionSquaredMatrixAttributes );
+    AppendMatrices( cacheWriter,
+                    vectorMassSquaredMatrices,
+                    vectorMatrixAttributes );
+    cacheWriter.WriteFile( cacheFilename );
   }
 
-  // This writes the potential as
-  // def PotentialFunction( fv ): return ...
-  // in pythonFilename for fv being an array of floating-point numbers in the
-  // same order as they are for the field configurations as internal to this
-  // C++ code. It uses the virtual function WriteActualPythonFunction.
-  void PotentialFromPolynomialWithMasses::WriteAsPython(
-                                      std::string const& pythonFilename ) const
+  // This reads a polynomial sum written by AppendSum into polynomialSum,
+  // throwing an exception if it has a field index which is out of range or a
+  // parameter index which is not in validParameterIndices.
+  void PotentialFromPolynomialWithMasses::ReadSum(
+                                                 MappedFileReader& cacheReader,
+                               std::set< size_t > const& validParameterIndices,
+                           ParametersAndFieldsProductSum& polynomialSum ) const
   {
-    std::ofstream pythonFile( pythonFilename.c_str() );
-    pythonFile << std::setprecision( 12 );
-    pythonFile << "# Automatically generated file! Modify at your own PERIL!\n"
-    "# This file was created by Vevacious version "
-    << VersionInformation::CurrentVersion() << "\n"
-    "from __future__ import division\n"
-    "import math\n"
-    "import numpy\n"
-    "\n"
-    "\n"
-    "# The temperature has to be held as a global variable because\n"
-    "# CosmoTransitions.fullTunneling does not pass in the temperature.\n"
-    "temperatureLinear = 0.0\n"
-    "temperatureSquare = 0.0\n"
-    "temperatureFourth = 0.0\n"
-    "temperatureInverseSquare = -1.0\n"
-    "def SetGlobalTemperature( globalTemperature ):\n"
-    "  temperatureLinear = globalTemperature\n"
-    "  temperatureSquare = ( temperatureLinear * temperatureLinear )\n"
-    "  temperatureFourth = ( temperatureSquare * temperatureSquare )\n"
-    "  if ( globalTemperature > 0.0 ):\n"
-    "    temperatureInverseSquare = ( 1.0 / temperatureSquare )\n"
-    "  else:\n"
-    "    temperatureInverseSquare = -1.0\n"
-    "\n"
-    "\n"
-    << ThermalFunctions::JFunctionsAsPython() << "\n"
-    "\n"
-    << lagrangianParameterManager.ParametersAsPython() << "\n"
-    "# The Lagrangian parameters evaluated at the appropriate scale from the\n"
-    "# C++ parameter manager are held in the following global array.\n"
-    "fixedScaleLagrangianParameters = LagrangianParameters( math.log( "
-    << lagrangianParameterManager.AppropriateSingleFixedScale()
-    << " ) )\n"
-    "\n"
-    "# In the following functions, the field configuration is given by fv\n"
-    "# and the Lagrangian parameters are given by lp.\n"
-    "def TreeLevelContribution( fv,\n"
-    "                           lp ):\n"
-    "    return ( " << treeLevelPotential.AsPython() << " )\n"
-    "\n"
-    "# The field configuration is given by fv and the Lagrangian parameters\n"
-    "# are given by lp.\n"
-    "def PolynomialLoopCorrections( fv,\n"
-    "                               lp ):\n"
-    "    return ( " << polynomialLoopCorrections.AsPython() << " )\n"
-    "\n"
-    "def JustLoopCorrection( massesSquaredWithFactors,\n"
-    "                        subtractionConstant,\n"
-    "                        invQSq ):\n"
-    "    cumulativeQuantumCorrection = 0.0\n"
-    "    for massSquaredWithFactor in massesSquaredWithFactors:\n"
-    "        currentQuantumCorrection = 0.0\n"
-    "        for MSq in massSquaredWithFactor[ 0 ]:\n"
-    "            MM = abs( MSq )\n"
-    "            if ( MM > 0.0 ):\n"
-    "                currentQuantumCorrection += ( MM**2\n"
-    "                                       * ( math.log( MM * invQSq )\n"
-    "                                           - subtractionConstant ) )\n"
-    "        cumulativeQuantumCorrection += ( massSquaredWithFactor[ 1 ]\n"
-    "                                         * currentQuantumCorrection )\n"
-    "    return cumulativeQuantumCorrection\n"
-    "\n"
-    "def LoopAndThermalCorrection( massesSquaredWithFactors,\n"
-    "                              subtractionConstant,\n"
-    "                              invQSq,\n"
-    "                              invTSq,\n"
-    "                              JFunction ):\n"
-    "    cumulativeQuantumCorrection = 0.0\n"
-    "    cumulativeThermalCorrection = 0.0\n"
-    "    for massSquaredWithFactor in massesSquaredWithFactors:\n"
-    "        currentQuantumCorrection = 0.0\n"
-    "        currentThermalCorrection = 0.0\n"
-    "        for MSq in massSquaredWithFactor[ 0 ]:\n"
-    "            MM = abs( MSq )\n"
-    "            if ( MM > 0.0 ):\n"
-    "                currentQuantumCorrection += ( MM**2\n"
-    "                                       * ( math.log( MM * invQSq )\n"
-    "                                           - subtractionConstant ) )\n"
-    "            currentThermalCorrection += JFunction( MM * invTSq )\n"
-    "        cumulativeQuantumCorrection += ( massSquaredWithFactor[ 1 ]\n"
-    "                                         * currentQuantumCorrection )\n"
-    "        cumulativeThermalCorrection += ( massSquaredWithFactor[ 1 ]\n"
-    "                                         * currentThermalCorrection )\n"
-    "    return [ cumulativeQuantumCorrection, cumulativeThermalCorrection ]\n"
-    "\n"
-    "def ScalarMassesSquaredWithFactors( fv,\n"
-    "                                    lp ):\n"
-    "    massesSquaredWithFactors = []\n";
-    for( std::vector< RealMassesSquaredMatrix >::const_iterator
-         whichMatrix( scalarMassSquaredMatrices.begin() );
-         whichMatrix < scalarMassSquaredMatrices.end();
-         ++whichMatrix )
-    {
-      pythonFile << "    massSquaredMatrix = numpy.array( [ ";
-      for( std::vector< ParametersAndFieldsProductSum >::const_iterator
-           matrixElement( whichMatrix->MatrixElements().begin() );
-           matrixElement < whichMatrix->MatrixElements().end();
-           ++matrixElement )
-      {
-        if( matrixElement != whichMatrix->MatrixElements().begin() )
-        {
-          pythonFile << ",\n";
-        }
-        pythonFile << matrixElement->AsPython();
-      }
-      pythonFile << " ] )\n"
-      "    M = numpy.reshape( massSquaredMatrix, ( "
-                                 << whichMatrix->NumberOfRows() << ", -1 ) )\n"
-      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( M ),\n"
-      "                     " << whichMatrix->MultiplicityFactor() << " ] )\n";
-    }
-    pythonFile << "    return massesSquaredWithFactors\n"
-    "\n"
-    "def FermionMassesSquaredWithFactors( fv,\n"
-    "                                     lp ):\n"
-    "    massesSquaredWithFactors = []\n";
-    for( std::vector< ComplexMassSquaredMatrix >::const_iterator
-         whichMatrix( fermionMassSquaredMatrices.begin() );
-         whichMatrix < fermionMassSquaredMatrices.end();
-         ++whichMatrix )
-    {
-      pythonFile << "    massSquaredMatrix = numpy.array( [ ";
-      for( std::vector< ComplexParametersAndFieldsProductSum >::const_iterator
-           matrixElement( whichMatrix->MatrixElements().begin() );
-           matrixElement < whichMatrix->MatrixElements().end();
-           ++matrixElement )
-      {
-        if( matrixElement != whichMatrix->MatrixElements().begin() )
-        {
-          pythonFile << ",\n";
-        }
-        pythonFile << "( " << matrixElement->first.AsPython()
-        << " + ( 1j * " << matrixElement->second.AsPython() << " ) )";
-      }
-      pythonFile << " ] )\n"
-      "    M = numpy.reshape( massSquaredMatrix, ( "
-                                 << whichMatrix->NumberOfRows() << ", -1 ) )\n"
-      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( M ),\n"
-      "                     " << whichMatrix->MultiplicityFactor() << " ] )\n";
-    }
-    for( std::vector< SymmetricComplexMassMatrix >::const_iterator
-         whichMatrix( fermionMassMatrices.begin() );
-         whichMatrix < fermionMassMatrices.end();
-         ++whichMatrix )
+    std::vector< ParametersAndFieldsProductTerm >&
+    productTerms( polynomialSum.ParametersAndFieldsProducts() );
+    // Each term takes at least the 8 bytes of its coefficient and the 8 bytes
+    // of each of its two counts.
+    productTerms.resize( cacheReader.ReadCount( 24 ) );
+    for( std::vector< ParametersAndFieldsProductTerm >::iterator
+         productTerm( productTerms.begin() );
+         productTerm != productTerms.end();
+         ++productTerm )
     {
-      pythonFile << "    massMatrix = numpy.array( [ ";
-      for( std::vector< ComplexParametersAndFieldsProductSum >::const_iterator
-           matrixElement( whichMatrix->MatrixElements().begin() );
-           matrixElement < whichMatrix->MatrixElements().end();
-           ++matrixElement )
+      productTerm->MultiplyByConstant( cacheReader.ReadValue< double >() );
+      size_t const numberOfParameters( cacheReader.ReadCount( 8 ) );
+      for( size_t factorIndex( 0 );
+           factorIndex < numberOfParameters;
+           ++factorIndex )
       {
-        if( matrixElement != whichMatrix->MatrixElements().begin() )
+        size_t const
+        parameterIndex( cacheReader.ReadValue< std::uint64_t >() );
+        if( validParameterIndices.count( parameterIndex ) == 0 )
         {
-          pythonFile << ",\n";
+          throw
+          std::runtime_error( "Unknown parameter index in model cache!" );
         }
-        pythonFile << "( " << matrixElement->first.AsPython()
-        << " + ( 1j * " << matrixElement->second.AsPython() << " ) )";
+        productTerm->MultiplyByParameter( parameterIndex );
       }
-      pythonFile << " ] )\n"
-      "    M = numpy.reshape( massMatrix, ( " << whichMatrix->NumberOfRows()
-                                                                << ", -1 ) )\n"
-      "    MM = M.dot( numpy.transpose( numpy.conjugate( M ) ) )\n"
-      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( MM ),\n"
-                              << whichMatrix->MultiplicityFactor() << " ] )\n";
-    }
-    pythonFile << "    return massesSquaredWithFactors\n"
-    "\n"
-    "def VectorMassesSquaredWithFactors( fv,\n"
-    "                                    lp ):\n"
-    "    massesSquaredWithFactors = []\n";
-    for( std::vector< RealMassesSquaredMatrix >::const_iterator
-         whichMatrix( vectorMassSquaredMatrices.begin() );
-         whichMatrix < vectorMassSquaredMatrices.end();
-         ++whichMatrix )
-    {
-      pythonFile << "    massSquaredMatrix = numpy.array( [ ";
-      for( std::vector< ParametersAndFieldsProductSum >::const_iterator
-           matrixElement( whichMatrix->MatrixElements().begin() );
-           matrixElement < whichMatrix->MatrixElements().end();
-           ++matrixElement )
+      // Raising the field powers one at a time in the order in which they
+      // were written gives exactly the same field product as was parsed.
+      size_t const numberOfFactors( cacheReader.ReadCount( 8 ) );
+      for( size_t factorIndex( 0 );
+           factorIndex < numberOfFactors;
+           ++factorIndex )
       {
-        if( matrixElement != whichMatrix->MatrixElements().begin() )
+        size_t const fieldIndex( cacheReader.ReadValue< std::uint64_t >() );
+        if( !( fieldIndex < numberOfFields ) )
         {
-          pythonFile << ",\n";
+          throw std::runtime_error( "Unknown field index in model cache!" );
         }
-        pythonFile << matrixElement->AsPython();
+        productTerm->RaiseFieldPower( fieldIndex,
+                                      1 );
+      }
+    }
+  }
+
+  // This appends the coefficient, parameter indices, and field indices of
+  // each term of polynomialSum to cacheWriter.
+  void PotentialFromPolynomialWithMasses::AppendSum(
+                                                 BinaryFileWriter& cacheWriter,
+                           ParametersAndFieldsProductSum const& polynomialSum )
+  {
+    std::vector< ParametersAndFieldsProductTerm > const&
+    productTerms( polynomialSum.ParametersAndFieldsProducts() );
+    cacheWriter.AppendValue< std::uint64_t >( productTerms.size() );
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         productTerm( productTerms.begin() );
+         productTerm != productTerms.end();
+         ++productTerm )
+    {
+      cacheWriter.AppendValue< double >( productTerm->CoefficientConstant() );
+      std::vector< size_t > const&
+      parameterIndices( productTerm->ParameterIndices() );
+      cacheWriter.AppendValue< std::uint64_t >( parameterIndices.size() );
+      for( size_t factorIndex( 0 );
+           factorIndex < parameterIndices.size();
+           ++factorIndex )
+      {
+        cacheWriter.AppendValue< std::uint64_t >(
+                                             parameterIndices[ factorIndex ] );
+      }
+      std::vector< size_t > const&
+      fieldProduct( productTerm->FieldProductByIndex() );
+      cacheWriter.AppendValue< std::uint64_t >( fieldProduct.size() );
+      for( size_t factorIndex( 0 );
+           factorIndex < fieldProduct.size();
+           ++factorIndex )
+      {
+        cacheWriter.AppendValue< std::uint64_t >(
+                                                 fieldProduct[ factorIndex ] );
       }
-      pythonFile << " ] )\n"
-      "    M = numpy.reshape( massSquaredMatrix, ( "
-                                 << whichMatrix->NumberOfRows() << ", -1 ) )\n"
-      "    massesSquaredWithFactors.append( [ numpy.linalg.eigvalsh( M ),\n"
-      "                     " << whichMatrix->MultiplicityFactor() << " ] )\n";
     }
-    pythonFile << "    return massesSquaredWithFactors\n"
-    "\n"
-    "\n"
-    "loopFactor = ( 1.0 / ( 64.0 * math.pi * math.pi ) )\n"
-    "thermalFactor = ( 1.0 / ( 2.0 * math.pi * math.pi ) )\n"
-    "\n"
-    "def JustLoopCorrections( fv,\n"
-    "                         lp,\n"
-    "                         invQSq ):\n"
-    "    totalQuantumCorrections = 0.0\n"
-    "    currentCorrection = JustLoopCorrection(\n"
-    "                                    ScalarMassesSquaredWithFactors( fv,\n"
-    "                                                                  lp ),\n"
-    "                                            1.5,\n"
-    "                                            invQSq )\n"
-    "    totalQuantumCorrections += currentCorrection\n"
-    "    currentCorrection = JustLoopCorrection(\n"
-    "                                   FermionMassesSquaredWithFactors( fv,\n"
-    "                                                                  lp ),\n"
-    "                                            1.5,\n"
-    "                                            invQSq )\n"
-    "    totalQuantumCorrections -= ( 2.0 * currentCorrection )\n"
-    "    currentCorrection = JustLoopCorrection(\n"
-    "                                    VectorMassesSquaredWithFactors( fv,\n"
-    "                                                                  lp ),\n"
-    "                                " << vectorMassCorrectionConstant << ",\n"
-    "                                            invQSq )\n"
-    "    totalQuantumCorrections += ( 3.0 * currentCorrection )\n"
-    "    return ( totalQuantumCorrections * loopFactor )\n"
-    "\n"
-    "def LoopAndThermalCorrections( fv,\n"
-    "                               lp,\n"
-    "                               invQSq,\n"
-    "                               invTSq ):\n"
-    "    totalQuantumCorrections = 0.0\n"
-    "    totalThermalCorrections = 0.0\n"
-    "    currentCorrections = LoopAndThermalCorrection(\n"
-    "                                    ScalarMassesSquaredWithFactors( fv,\n"
-    "                                                                  lp ),\n"
-    "                                                   1.5,\n"
-    "                                                   invQSq,\n"
-    "                                                   invTSq,\n"
-    "                                                   BosonicJ )\n"
-    "# Real scalar degrees of freedom add to both quantum and thermal\n"
-    "# corrections without any factors.\n"
-    "    totalQuantumCorrections += currentCorrections[ 0 ]\n"
-    "    totalThermalCorrections += currentCorrections[ 1 ]\n"
-    "    currentCorrections = LoopAndThermalCorrection(\n"
-    "                                   FermionMassesSquaredWithFactors( fv,\n"
-    "                                                                  lp ),\n"
-    "                                                   1.5,\n"
-    "                                                   invQSq,\n"
-    "                                                   invTSq,\n"
-    "                                                   FermionicJ )\n"
-    "# Weyl fermion degrees of freedom add to both quantum and thermal\n"
-    "# corrections with a factor of 2, though there is an additional minus\n"
-    "# sign for the quantum corrections. (The conventions used in Vevacious\n"
-    "# are that the thermal correction functions already have any minus\n"
-    "# signs for fermions.)\n"
-    "    totalQuantumCorrections -= ( 2.0 * currentCorrections[ 0 ] )\n"
-    "    totalThermalCorrections += ( 2.0 * currentCorrections[ 1 ] )\n"
-    "    currentCorrections = LoopAndThermalCorrection(\n"
-    "                                    VectorMassesSquaredWithFactors( fv,\n"
-    "                                                                  lp ),\n"
-    "                                " << vectorMassCorrectionConstant << ",\n"
-    "                                                   invQSq,\n"
-    "                                                   invTSq,\n"
-    "                                                   BosonicJ )\n"
-    "# Vector boson degrees of freedom add to quantum corrections with a\n"
-    "# factor of 3 in dimensional regularization schemes, and to thermal\n"
-    "# corrections with a factor of 2.\n"
-    "    totalQuantumCorrections += ( 3.0 * currentCorrections[ 0 ] )\n"
-    "    totalThermalCorrections += ( 2.0 * currentCorrections[ 1 ] )\n"
-    "    return ( ( totalQuantumCorrections * loopFactor )\n"
-    "             + ( ( totalThermalCorrections * thermalFactor )\n"
-    "                 / ( invTSq**2 ) ) )\n"
-    "\n"
-    << WriteActualPythonFunction() << "\n"
-    "\n"
-    "# This can be changed to use just the tree-level potential, or the\n"
-    "# loop-corrected potential without thermal corrections.\n"
-    "UnderlyingPotential = LoopAndThermallyCorrectedPotential\n"
-    "\n"
-    "stepSize = 1.0\n"
-    "\n"
-    "def UnderlyingGradient( fv ):\n"
-    "    potentialAtPoint = UnderlyingPotential( fv )\n"
-    "    gradientArray = numpy.zeros( len( fv ) )\n"
-    "    for whichField in range( len( fv ) ):\n"
-    "        displacedPoint = fv.copy()\n"
-    "        displacedPoint[ whichField ] += stepSize\n"
-    "        gradientArray[ whichField ] = ( ( UnderlyingPotential(\n"
-    "                                                       displacedPoint )\n"
-    "                                          - potentialAtPoint )\n"
-    "                                        / stepSize )\n"
-    "    return gradientArray\n"
-    "\n"
-    "def PotentialForCosmotransitions( arrayOfArrays ):\n"
-    "    if ( arrayOfArrays.shape == ( " << numberOfFields << ", ) ):\n"
-    "        return UnderlyingPotential( arrayOfArrays )\n"
-    "    elif ( arrayOfArrays.shape == ( len( arrayOfArrays ), "
-                                                 << numberOfFields << " ) ):\n"
-    "        returnArray = numpy.zeros( len( arrayOfArrays ) )\n"
-    "        for whichIndex in range( len( arrayOfArrays ) ):\n"
-    "            returnArray[ whichIndex ] = UnderlyingPotential(\n"
-    "                                          arrayOfArrays[ whichIndex ] )\n"
-    "        return returnArray\n"
-    "    else:\n"
-    "        return None\n"
-    "\n"
-    "def GradientForCosmotransitions( arrayOfArrays ):\n"
-    "    if ( arrayOfArrays.shape == ( " << numberOfFields << ", ) ):\n"
-    "        return UnderlyingGradient( arrayOfArrays )\n"
-    "    elif ( arrayOfArrays.shape == ( len( arrayOfArrays ), "
-                                                 << numberOfFields << " ) ):\n"
-    "        returnMatrix = arrayOfArrays.copy()\n"
-    "        for whichIndex in range( len( arrayOfArrays ) ):\n"
-    "            returnMatrix[ whichIndex ] = UnderlyingGradient(\n"
-    "                                          arrayOfArrays[ whichIndex ] )\n"
-    "        return returnMatrix\n"
-    "    else:\n"
-    "        return None\n"
-    "\n"
-    "# End of automatically generated file!\n";
-    pythonFile.close();
   }
 
   // This is just for derived classes.
@@ -700,7 +1092,12 @@ namespace VevaciousPlusPlus
     fieldsAssumedPositive(),
     fieldsAssumedNegative(),
     assumedPositiveOrNegativeTolerance( -1.0 ),
-    readImaginaryPartForRealValue( false )
+    readImaginaryPartForRealValue( false ),
+    polynomialGradient(),
+    numberOfFixedScaleCoefficients( 0 ),
+    parameterRegistrationOrder(),
+    parameterRegistrationResults(),
+    registeredParameterNames()
   {
     // This protected constructor is just an initialization list only used by
     // derived classes which are going to fill up the data members in their own
@@ -710,7 +1107,18 @@ namespace VevaciousPlusPlus
   // This is just for derived classes.
   PotentialFromPolynomialWithMasses::PotentialFromPolynomialWithMasses(
                         PotentialFromPolynomialWithMasses const& copySource ) :
-    PotentialFunction( copySource ),
+    PotentialFromPolynomialWithMasses( copySource,
+                                       copySource.lagrangianParameterManager )
+  {
+    // This constructor is just an initialization list.
+  }
+
+  // This is just for derived classes.
+  PotentialFromPolynomialWithMasses::PotentialFromPolynomialWithMasses(
+                          PotentialFromPolynomialWithMasses const& copySource,
+                     LagrangianParameterManager& lagrangianParameterManager ) :
+    PotentialFunction( copySource,
+                       lagrangianParameterManager ),
     treeLevelPotential( copySource.treeLevelPotential ),
     polynomialLoopCorrections( copySource.polynomialLoopCorrections ),
     scalarSquareMasses(),
@@ -725,8 +1133,42 @@ namespace VevaciousPlusPlus
     fieldsAssumedNegative( copySource.fieldsAssumedNegative ),
     assumedPositiveOrNegativeTolerance(
                                copySource.assumedPositiveOrNegativeTolerance ),
-    readImaginaryPartForRealValue( copySource.readImaginaryPartForRealValue )
+    readImaginaryPartForRealValue( copySource.readImaginaryPartForRealValue ),
+    polynomialGradient( copySource.polynomialGradient ),
+    numberOfFixedScaleCoefficients(
+                                   copySource.numberOfFixedScaleCoefficients ),
+    parameterRegistrationOrder( copySource.parameterRegistrationOrder ),
+    parameterRegistrationResults( copySource.parameterRegistrationResults ),
+    registeredParameterNames()
   {
+    // The copied polynomials and matrices refer to the Lagrangian parameters
+    // by the indices which they have in the manager of copySource, so the
+    // parameters are registered with lagrangianParameterManager in the same
+    // order, which gives the same indices if it was set up in the same way.
+    for( size_t orderIndex( 0 );
+         orderIndex < parameterRegistrationOrder.size();
+         ++orderIndex )
+    {
+      std::string const&
+      parameterName( parameterRegistrationOrder[ orderIndex ] );
+      std::pair< bool, size_t > const&
+      copiedValidityAndIndex( parameterRegistrationResults[ orderIndex ] );
+      std::pair< bool, size_t > const parameterValidityAndIndex(
+               lagrangianParameterManager.RegisterParameter( parameterName ) );
+      if( ( parameterValidityAndIndex.first != copiedValidityAndIndex.first )
+          ||
+          ( copiedValidityAndIndex.first
+            &&
+            ( parameterValidityAndIndex.second
+              != copiedValidityAndIndex.second ) ) )
+      {
+        std::stringstream errorBuilder;
+        errorBuilder << "Registering \"" << parameterName << "\" for a copy of"
+        << " the potential did not give the same index as for the original!";
+        throw std::runtime_error( errorBuilder.str() );
+      }
+    }
+
     // Now we can fill the MassesSquaredCalculator* vectors, as their pointers
     // should remain valid as the other vectors do not change size any more
     // after the constructor.
@@ -764,9 +1206,9 @@ namespace VevaciousPlusPlus
   // that the squared masses were evaluated at the given scale correctly.
   double
   PotentialFromPolynomialWithMasses::LoopAndThermalCorrections(
-          std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors,
-         std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors,
-          std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors,
+   std::vector< DoubleVectorWithDouble > const& scalarMassesSquaredWithFactors,
+  std::vector< DoubleVectorWithDouble > const& fermionMassesSquaredWithFactors,
+   std::vector< DoubleVectorWithDouble > const& vectorMassesSquaredWithFactors,
                                               double const inverseScaleSquared,
                                           double const temperatureValue ) const
   {
@@ -835,6 +1277,172 @@ namespace VevaciousPlusPlus
                  * temperatureValue * temperatureValue ) );
   }
 
+  // This adds the partial derivatives of the one-loop potential with thermal
+  // corrections with respect to the fields to gradientVector, assuming that
+  // the squared masses and their derivatives were evaluated at the given
+  // scale correctly.
+  void PotentialFromPolynomialWithMasses::AddLoopAndThermalCorrectionsGradient(
+   std::vector< DoubleVectorWithDouble > const& scalarMassesSquaredWithFactors,
+ std::vector< MassesSquaredDerivatives > const& scalarMassesSquaredDerivatives,
+  std::vector< DoubleVectorWithDouble > const& fermionMassesSquaredWithFactors,
+std::vector< MassesSquaredDerivatives > const& fermionMassesSquaredDerivatives,
+   std::vector< DoubleVectorWithDouble > const& vectorMassesSquaredWithFactors,
+ std::vector< MassesSquaredDerivatives > const& vectorMassesSquaredDerivatives,
+                                              double const inverseScaleSquared,
+                                                double const temperatureValue,
+                                  std::vector< double >& gradientVector ) const
+  {
+    bool const temperatureGreaterThanZero( temperatureValue > 0.0 );
+    double const inverseTemperatureSquared( temperatureGreaterThanZero ?
+                            ( 1.0 / ( temperatureValue * temperatureValue ) ) :
+                                            -1.0 );
+    double const temperatureFactor( thermalFactor
+                                    * temperatureValue * temperatureValue
+                                    * temperatureValue * temperatureValue );
+
+    // The factors for each type of degree of freedom are the same as in
+    // LoopAndThermalCorrections.
+    AddToCorrectionsGradient( scalarMassesSquaredWithFactors,
+                              scalarMassesSquaredDerivatives,
+                              inverseScaleSquared,
+                              temperatureGreaterThanZero,
+                              inverseTemperatureSquared,
+                              1.5,
+                              &(ThermalFunctions::BosonicJDerivative),
+                              loopFactor,
+                              temperatureFactor,
+                              gradientVector );
+    AddToCorrectionsGradient( fermionMassesSquaredWithFactors,
+                              fermionMassesSquaredDerivatives,
+                              inverseScaleSquared,
+                              temperatureGreaterThanZero,
+                              inverseTemperatureSquared,
+                              1.5,
+                              &(ThermalFunctions::FermionicJDerivative),
+                              ( -2.0 * loopFactor ),
+                              ( 2.0 * temperatureFactor ),
+                              gradientVector );
+    AddToCorrectionsGradient( vectorMassesSquaredWithFactors,
+                              vectorMassesSquaredDerivatives,
+                              inverseScaleSquared,
+                              temperatureGreaterThanZero,
+                              inverseTemperatureSquared,
+                              vectorMassCorrectionConstant,
+                              &(ThermalFunctions::BosonicJDerivative),
+                              ( 3.0 * loopFactor ),
+                              ( 2.0 * temperatureFactor ),
+                              gradientVector );
+  }
+
+  // This compiles the tapes of the polynomial sums, sets up
+  // polynomialGradient, and prepares each of the mass-squared matrices for
+  // evaluation, including derivatives with respect to the fields, and then
+  // assigns each tape the offset of its block of coefficients in a
+  // FixedScaleCoefficients. It should be called once the polynomials and
+  // matrices have all been read in.
+  void PotentialFromPolynomialWithMasses::PrepareForEvaluation()
+  {
+    polynomialGradient.assign( numberOfFields,
+                               ParametersAndFieldsProductSum() );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      polynomialGradient[ fieldIndex ]
+      = treeLevelPotential.PartialDerivative( fieldIndex );
+      ParametersAndFieldsProductSum const
+      loopDerivative( polynomialLoopCorrections.PartialDerivative(
+                                                                fieldIndex ) );
+      std::vector< ParametersAndFieldsProductTerm >&
+      gradientTerms(
+              polynomialGradient[ fieldIndex ].ParametersAndFieldsProducts() );
+      std::vector< ParametersAndFieldsProductTerm > const&
+      loopTerms( loopDerivative.ParametersAndFieldsProducts() );
+      gradientTerms.insert( gradientTerms.end(),
+                            loopTerms.begin(),
+                            loopTerms.end() );
+      polynomialGradient[ fieldIndex ].CompileTape();
+    }
+    treeLevelPotential.CompileTape();
+    polynomialLoopCorrections.CompileTape();
+    std::vector< MassesSquaredCalculator* > const*
+    massSquaredMatrices[] = { &scalarSquareMasses,
+                              &fermionSquareMasses,
+                              &vectorSquareMasses };
+    for( size_t spinIndex( 0 );
+         spinIndex < 3;
+         ++spinIndex )
+    {
+      for( std::vector< MassesSquaredCalculator* >::const_iterator
+           whichMatrix( massSquaredMatrices[ spinIndex ]->begin() );
+           whichMatrix < massSquaredMatrices[ spinIndex ]->end();
+           ++whichMatrix )
+      {
+        (*whichMatrix)->PrepareForEvaluation( numberOfFields );
+      }
+    }
+
+    numberOfFixedScaleCoefficients = 0;
+    treeLevelPotential.AssignCoefficientOffset(
+                                              numberOfFixedScaleCoefficients );
+    polynomialLoopCorrections.AssignCoefficientOffset(
+                                              numberOfFixedScaleCoefficients );
+    for( std::vector< ParametersAndFieldsProductSum >::iterator
+         fieldDerivative( polynomialGradient.begin() );
+         fieldDerivative < polynomialGradient.end();
+         ++fieldDerivative )
+    {
+      fieldDerivative->AssignCoefficientOffset(
+                                              numberOfFixedScaleCoefficients );
+    }
+    for( size_t spinIndex( 0 );
+         spinIndex < 3;
+         ++spinIndex )
+    {
+      for( std::vector< MassesSquaredCalculator* >::const_iterator
+           whichMatrix( massSquaredMatrices[ spinIndex ]->begin() );
+           whichMatrix < massSquaredMatrices[ spinIndex ]->end();
+           ++whichMatrix )
+      {
+        (*whichMatrix)->AssignCoefficientOffsets(
+                                              numberOfFixedScaleCoefficients );
+      }
+    }
+  }
+
+  // This fills the coefficients of all the tapes of the polynomials and mass
+  // matrices in coefficientSnapshot, which should already hold the values of
+  // the Lagrangian parameters at its scale.
+  void PotentialFromPolynomialWithMasses::SetFixedScaleCoefficients(
+                            FixedScaleCoefficients& coefficientSnapshot ) const
+  {
+    treeLevelPotential.SetFixedScaleCoefficients( coefficientSnapshot );
+    polynomialLoopCorrections.SetFixedScaleCoefficients( coefficientSnapshot );
+    for( std::vector< ParametersAndFieldsProductSum >::const_iterator
+         fieldDerivative( polynomialGradient.begin() );
+         fieldDerivative < polynomialGradient.end();
+         ++fieldDerivative )
+    {
+      fieldDerivative->SetFixedScaleCoefficients( coefficientSnapshot );
+    }
+    std::vector< MassesSquaredCalculator* > const*
+    massSquaredMatrices[] = { &scalarSquareMasses,
+                              &fermionSquareMasses,
+                              &vectorSquareMasses };
+    for( size_t spinIndex( 0 );
+         spinIndex < 3;
+         ++spinIndex )
+    {
+      for( std::vector< MassesSquaredCalculator* >::const_iterator
+           whichMatrix( massSquaredMatrices[ spinIndex ]->begin() );
+           whichMatrix < massSquaredMatrices[ spinIndex ]->end();
+           ++whichMatrix )
+      {
+        (*whichMatrix)->SetFixedScaleCoefficients( coefficientSnapshot );
+      }
+    }
+  }
+
   // This interprets stringToParse as a sum of polynomial terms and sets
   // polynomialSum accordingly.
   void PotentialFromPolynomialWithMasses::ParseSumOfPolynomialTerms(
@@ -1088,6 +1696,11 @@ namespace VevaciousPlusPlus
         // a Lagrangian parameter known to lagrangianParameterManager.
         std::pair< bool, size_t > parameterValidityAndIndex(
               lagrangianParameterManager.RegisterParameter( variableString ) );
+        if( registeredParameterNames.insert( variableString ).second )
+        {
+          parameterRegistrationOrder.push_back( variableString );
+          parameterRegistrationResults.push_back( parameterValidityAndIndex );
+        }
         if( parameterValidityAndIndex.first )
         {
           polynomialTerm.MultiplyByParameter( parameterValidityAndIndex.second,
@@ -1170,6 +1783,84 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This adds the derivatives with respect to the fields of the corrections
+  // summed by AddToCorrections to gradientVector, using the derivatives of the
+  // masses-squared given in massesSquaredDerivatives and the derivative of the
+  // thermal correction function given by ThermalFunctionDerivative. The
+  // quantum corrections are multiplied by quantumFactor and the thermal
+  // corrections by thermalFactor before being added.
+  void PotentialFromPolynomialWithMasses::AddToCorrectionsGradient(
+         std::vector< DoubleVectorWithDouble > const& massesSquaredWithFactors,
+       std::vector< MassesSquaredDerivatives > const& massesSquaredDerivatives,
+                                              double const inverseScaleSquared,
+                                         bool const temperatureGreaterThanZero,
+                                        double const inverseTemperatureSquared,
+                                            double const subtractFromLogarithm,
+                           double (*ThermalFunctionDerivative)( double const ),
+                                                    double const quantumFactor,
+                                                    double const thermalFactor,
+                                  std::vector< double >& gradientVector ) const
+  {
+    double massSquared( 0.0 );
+    double massSquaredSign( 1.0 );
+    double correctionDerivative( 0.0 );
+    for( size_t matrixIndex( 0 );
+         matrixIndex < massesSquaredWithFactors.size();
+         ++matrixIndex )
+    {
+      std::vector< double > const&
+      massesSquared( massesSquaredWithFactors[ matrixIndex ].first );
+      MassesSquaredDerivatives const&
+      fieldDerivatives( massesSquaredDerivatives[ matrixIndex ] );
+      for( size_t massIndex( 0 );
+           massIndex < massesSquared.size();
+           ++massIndex )
+      {
+        // AddToCorrections uses the absolute value of each mass-squared, so
+        // the chain rule brings in the sign of the mass-squared.
+        massSquared = massesSquared[ massIndex ];
+        massSquaredSign = 1.0;
+        if( massSquared < 0.0 )
+        {
+          massSquared = -massSquared;
+          massSquaredSign = -1.0;
+        }
+        correctionDerivative = 0.0;
+        if( massSquared > 0.0 )
+        {
+          // The derivative of x^2 ( ln( x / Q^2 ) - c ) with respect to x is
+          // x ( 2 ( ln( x / Q^2 ) - c ) + 1 ).
+          correctionDerivative += ( quantumFactor * massSquared
+                                    * ( 2.0 * ( log( massSquared
+                                                     * inverseScaleSquared )
+                                                - subtractFromLogarithm )
+                                        + 1.0 ) );
+        }
+        if( temperatureGreaterThanZero )
+        {
+          correctionDerivative += ( thermalFactor * inverseTemperatureSquared
+                                    * (*ThermalFunctionDerivative)( massSquared
+                                               * inverseTemperatureSquared ) );
+        }
+        correctionDerivative
+        *= ( massSquaredSign
+             * massesSquaredWithFactors[ matrixIndex ].second );
+        if( correctionDerivative == 0.0 )
+        {
+          continue;
+        }
+        for( size_t fieldIndex( 0 );
+             fieldIndex < fieldDerivatives.size();
+             ++fieldIndex )
+        {
+          gradientVector[ fieldIndex ]
+          += ( correctionDerivative
+               * fieldDerivatives[ fieldIndex ][ massIndex ] );
+        }
+      }
+    }
+  }
+
   // This is for debugging.
   std::string PotentialFromPolynomialWithMasses::AsDebuggingString() const
   {
@@ -34,66 +34,153 @@ namespace VevaciousPlusPlus
     lagrangianParameterManager.RegisterObserver( this );
   }
 
+  RgeImprovedOneLoopPotential::RgeImprovedOneLoopPotential(
+                      PotentialFromPolynomialWithMasses const& potentialToCopy,
+                     LagrangianParameterManager& lagrangianParameterManager ) :
+    PotentialFromPolynomialWithMasses( potentialToCopy,
+                                       lagrangianParameterManager ),
+    LHPC::BasicObserver(),
+    minimumScaleSquared( -1.0 ),
+    maximumScaleSquared( -1.0 )
+  {
+    lagrangianParameterManager.RegisterObserver( this );
+  }
+
   RgeImprovedOneLoopPotential::~RgeImprovedOneLoopPotential()
   {
     // This does nothing.
   }
 
 
-  // This returns the energy density in GeV^4 of the potential for a state
-  // strongly peaked around expectation values (in GeV) for the fields given
-  // by the values of fieldConfiguration and temperature in GeV given by
-  // temperatureValue.
-  double RgeImprovedOneLoopPotential::operator()(
+  // This evaluates the gradient of the potential with respect to the fields
+  // at fieldConfiguration and temperature temperatureValue and places it in
+  // gradientVector. The gradient at fixed Lagrangian parameters is evaluated
+  // analytically, and the contribution from the running of the parameters
+  // with the field-dependent renormalization scale is evaluated from the
+  // change of the potential under steps in the logarithm of the scale which
+  // correspond to steps of numericalStepSize GeV in the length of
+  // fieldConfiguration.
+  void RgeImprovedOneLoopPotential::SetAsGradientAt(
+                                         std::vector< double >& gradientVector,
                                std::vector< double > const& fieldConfiguration,
+                                                double const numericalStepSize,
                                           double const temperatureValue ) const
   {
-    double scaleSquared( temperatureValue * temperatureValue );
-    for( std::vector< double >::const_iterator
-         fieldValue( fieldConfiguration.begin() );
-         fieldValue < fieldConfiguration.end();
-         ++fieldValue )
+    PerformanceLogger::IncrementCounter(
+                                      PerformanceRecord::GradientEvaluations );
+    double const unrestrictedScaleSquared( UnrestrictedScaleSquared(
+                                                            fieldConfiguration,
+                                                          temperatureValue ) );
+    double const
+    scaleSquared( RestrictedScaleSquared( unrestrictedScaleSquared ) );
+    EvaluationWorkspace& threadWorkspace( ThreadWorkspace() );
+    std::vector< double >& parameterValues( threadWorkspace.parameterValues );
+    lagrangianParameterManager.ParameterValues( ( 0.5 * log( scaleSquared ) ),
+                                                parameterValues );
+
+    gradientVector.resize( numberOfFields );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
     {
-      scaleSquared += ( (*fieldValue) * (*fieldValue) );
+      gradientVector[ fieldIndex ]
+      = polynomialGradient[ fieldIndex ]( parameterValues,
+                                          fieldConfiguration );
     }
+    SetMassesSquaredWithFieldDerivatives( parameterValues,
+                                          fieldConfiguration,
+                                          scalarSquareMasses,
+                                threadWorkspace.scalarMassesSquaredWithFactors,
+                              threadWorkspace.scalarMassesSquaredDerivatives );
+    SetMassesSquaredWithFieldDerivatives( parameterValues,
+                                          fieldConfiguration,
+                                          fermionSquareMasses,
+                               threadWorkspace.fermionMassesSquaredWithFactors,
+                             threadWorkspace.fermionMassesSquaredDerivatives );
+    SetMassesSquaredWithFieldDerivatives( parameterValues,
+                                          fieldConfiguration,
+                                          vectorSquareMasses,
+                                threadWorkspace.vectorMassesSquaredWithFactors,
+                              threadWorkspace.vectorMassesSquaredDerivatives );
+    AddLoopAndThermalCorrectionsGradient(
+                                threadWorkspace.scalarMassesSquaredWithFactors,
+                                threadWorkspace.scalarMassesSquaredDerivatives,
+                               threadWorkspace.fermionMassesSquaredWithFactors,
+                               threadWorkspace.fermionMassesSquaredDerivatives,
+                                threadWorkspace.vectorMassesSquaredWithFactors,
+                                threadWorkspace.vectorMassesSquaredDerivatives,
+                                          ( 1.0 / scaleSquared ),
+                                          temperatureValue,
+                                          gradientVector );
 
-    if( scaleSquared < minimumScaleSquared )
+    // If the scale is not held at one of its bounds, it depends on the field
+    // values through Q^2 = T^2 + sum of squares of fields, so the total
+    // derivative picks up dV/d(ln Q^2) * 2 * fieldValue / Q^2 for each field.
+    if( ( scaleSquared != unrestrictedScaleSquared )
+        ||
+        !( scaleSquared > 0.0 ) )
     {
-      scaleSquared = minimumScaleSquared;
+      return;
     }
-    else if( scaleSquared > maximumScaleSquared )
+    double const logarithmStep( ( 2.0 * numericalStepSize )
+                                / sqrt( scaleSquared ) );
+    double const potentialAboveScale( PotentialAtScale( fieldConfiguration,
+                                                        temperatureValue,
+                                                         ( scaleSquared
+                                                  * exp( logarithmStep ) ) ) );
+    double const potentialBelowScale( PotentialAtScale( fieldConfiguration,
+                                                        temperatureValue,
+                                                         ( scaleSquared
+                                                 * exp( -logarithmStep ) ) ) );
+    double const logarithmDerivative( ( potentialAboveScale
+                                        - potentialBelowScale )
+                                      / ( 2.0 * logarithmStep ) );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
     {
-      scaleSquared = maximumScaleSquared;
+      gradientVector[ fieldIndex ]
+      += ( ( 2.0 * logarithmDerivative * fieldConfiguration[ fieldIndex ] )
+           / scaleSquared );
     }
+  }
 
+  // This returns the energy density in GeV^4 of the potential for the fields
+  // given by fieldConfiguration and temperature in GeV given by
+  // temperatureValue, with the Lagrangian parameters evaluated at the
+  // renormalization scale given by the square root of scaleSquared.
+  double RgeImprovedOneLoopPotential::PotentialAtScale(
+                               std::vector< double > const& fieldConfiguration,
+                                                 double const temperatureValue,
+                                              double const scaleSquared ) const
+  {
+    EvaluationWorkspace& threadWorkspace( ThreadWorkspace() );
+    std::vector< double >& parameterValues( threadWorkspace.parameterValues );
     // The logarithm of the scale is of course half the logarithm of the square
     // of the scale.
-    std::vector< double > parameterValues;
     lagrangianParameterManager.ParameterValues( ( 0.5 * log( scaleSquared ) ),
                                                 parameterValues );
 
-    std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( parameterValues,
+    SetMassesSquaredWithMultiplicity( parameterValues,
                                       fieldConfiguration,
                                       scalarSquareMasses,
-                                      scalarMassesSquaredWithFactors );
-    std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( parameterValues,
+                              threadWorkspace.scalarMassesSquaredWithFactors );
+    SetMassesSquaredWithMultiplicity( parameterValues,
                                       fieldConfiguration,
                                       fermionSquareMasses,
-                                      fermionMassesSquaredWithFactors );
-    std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( parameterValues,
+                             threadWorkspace.fermionMassesSquaredWithFactors );
+    SetMassesSquaredWithMultiplicity( parameterValues,
                                       fieldConfiguration,
                                       vectorSquareMasses,
-                                      vectorMassesSquaredWithFactors );
+                              threadWorkspace.vectorMassesSquaredWithFactors );
     return ( treeLevelPotential( parameterValues,
                                  fieldConfiguration )
              + polynomialLoopCorrections( parameterValues,
                                           fieldConfiguration )
-             + LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
-                                          fermionMassesSquaredWithFactors,
-                                          vectorMassesSquaredWithFactors,
+             + LoopAndThermalCorrections(
+                                threadWorkspace.scalarMassesSquaredWithFactors,
+                               threadWorkspace.fermionMassesSquaredWithFactors,
+                                threadWorkspace.vectorMassesSquaredWithFactors,
                                           ( 1.0 / scaleSquared ),
                                           temperatureValue ) );
   }
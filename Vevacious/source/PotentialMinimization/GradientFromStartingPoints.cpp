@@ -9,6 +9,9 @@
  */
 
 #include "PotentialMinimization/GradientFromStartingPoints.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 namespace VevaciousPlusPlus
@@ -19,14 +22,16 @@ namespace VevaciousPlusPlus
             std::unique_ptr<StartingPointFinder> startingPointFinder,
             std::unique_ptr<GradientMinimizer> gradientMinimizer,
             double const extremumSeparationThresholdFraction,
-            double const nonDsbRollingToDsbScalingFactor, bool global_Is_Panic ) :
+            double const nonDsbRollingToDsbScalingFactor, bool global_Is_Panic,
+            unsigned int const numberOfThreads ) :
             PotentialMinimizer( potentialFunction ),
             startingPointFinder( std::move(startingPointFinder) ),
             gradientMinimizer( std::move(gradientMinimizer) ),
             startingPoints(),
             extremumSeparationThresholdFraction( extremumSeparationThresholdFraction ),
             nonDsbRollingToDsbScalingFactor( nonDsbRollingToDsbScalingFactor ),
-            global_Is_Panic(global_Is_Panic)
+            global_Is_Panic(global_Is_Panic),
+            numberOfThreads( numberOfThreads )
     {
         // This constructor is just an initialization list.
     }
@@ -44,7 +49,10 @@ namespace VevaciousPlusPlus
     // foundMinima. It also records the minima lower than dsbVacuum in
     // panicVacua, and of those, it sets panicVacuum to be the minimum in
     // panicVacua closest to dsbVacuum or the global minimum depending on what the user
-    // set for global_Is_Panic. The default is the former.
+    // set for global_Is_Panic. The default is the former. The minimizations
+    // from the starting points are shared out among numberOfThreads threads,
+    // but the results are recorded in the order of startingPoints regardless
+    // of which thread finished first.
     void GradientFromStartingPoints::FindMinima(
             double const minimizationTemperature )
     {
@@ -86,76 +94,65 @@ namespace VevaciousPlusPlus
         std::cout
                 << std::endl
                 << "Gradient-based minimization from a set of starting points:";
-        for( std::vector< std::vector< double > >::const_iterator
-                realSolution( startingPoints.begin() );
-                realSolution != startingPoints.end(); ++realSolution )
+
+        // The minimizations from different starting points are independent of
+        // each other and only use the const, reentrant evaluation of the
+        // potential, so they are shared out among the threads, each storing
+        // its results and its log in the slots for its starting point. Any
+        // exception is caught and stored so that it does not escape the
+        // parallel region, and the results are then processed in the original
+        // order of startingPoints so that foundMinima and panicVacua do not
+        // depend on how the threads were scheduled.
+        size_t const numberOfStartingPoints( startingPoints.size() );
+        std::vector< PotentialMinimum > rolledMinima( numberOfStartingPoints );
+        std::vector< char > rolledToDsbOrSignFlips( numberOfStartingPoints,
+                                                    0 );
+        std::vector< std::string > rollingLogs( numberOfStartingPoints );
+        std::vector< std::string > rollingErrors( numberOfStartingPoints );
+        int threadsToUse( static_cast< int >( numberOfThreads ) );
+#ifdef _OPENMP
+        if( threadsToUse < 1 )
         {
-            std::cout
-                    << std::endl
-                    << "Starting point: "
-                    << potentialFunction.FieldConfigurationAsMathematica( *realSolution );
-            std::cout << std::endl;
-            foundMinimum = (*gradientMinimizer)( *realSolution );
-            std::cout
-                    << "Rolled to: "
-                    << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
-            std::cout << std::endl;
-            bool rolledToDsbOrSignFlip( ( foundMinimum.SquareDistanceTo( dsbVacuum )
-                                          < thresholdSeparationSquared )
-                                        ||
-                                        !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
-                                                                          thresholdSeparation ) ) );
-
-            // We check to see if a starting point that was not the DSB minimum
-            // rolled to the DSB minimum: if so, we scale the starting point's fields
-            // by a factor and pass the scaled set of field values to
-            // gradientMinimizer to roll, and then carry on based on this new
-            // minimum. (We discovered in explorations with Vevacious 1 that
-            // it could happen that the basin of attraction of the DSB minimum at
-            // 1-loop level could grow so large that it would encompass tree-level
-            // minima that belong in some sense to other 1-loop minima, which moved
-            // very far away due to loop corrections, so even though their basins of
-            // attraction also grew very large in the same way that of the DSB
-            // minimum did, they moved enough that their tree-level minima were left
-            // out.)
-            if( rolledToDsbOrSignFlip
-                &&
-                ( dsbVacuum.SquareDistanceTo( *realSolution )
-                  > thresholdSeparationSquared ) )
+            threadsToUse = omp_get_max_threads();
+        }
+#endif
+#pragma omp parallel for schedule( dynamic ) num_threads( threadsToUse )
+        for( size_t pointIndex = 0;
+             pointIndex < numberOfStartingPoints;
+             ++pointIndex )
+        {
+            std::stringstream rollingLog;
+            try
             {
-                // We don't want to bother re-rolling the field origin, so we keep note
-                // of how far away from the field origin realSolution is.
-                double lengthSquared( 0.0 );
-                std::vector< double > scaledPoint( *realSolution );
-                for( std::vector< double >::iterator
-                             scaledField( scaledPoint.begin() );
-                     scaledField < scaledPoint.end();
-                     ++scaledField )
-                {
-                    lengthSquared += ( (*scaledField) * (*scaledField) );
-                    *scaledField *= nonDsbRollingToDsbScalingFactor;
-                }
-                if( lengthSquared > thresholdSeparationSquared )
-                {
-                    std::cout
-                            << "Non-DSB-minimum starting point rolled to the DSB minimum, or a"
-                            << " phase rotation, using the full potential. Trying a scaled"
-                            << " starting point: "
-                            << potentialFunction.FieldConfigurationAsMathematica( scaledPoint );
-                    std::cout << std::endl;
-
-                    foundMinimum = (*gradientMinimizer)( scaledPoint );
-                    rolledToDsbOrSignFlip = ( foundMinimum.SquareDistanceTo( dsbVacuum )
-                                              < thresholdSeparationSquared )
-                                            ||
-                                            !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
-                                                                              thresholdSeparation ) );
-                    std::cout
-                            << "Rolled to: "
-                            << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
-                    std::cout << std::endl;
-                }
+                bool rolledToDsbOrSignFlip( false );
+                rolledMinima[ pointIndex ]
+                = RollFromStartingPoint( startingPoints[ pointIndex ],
+                                         minimizationTemperature,
+                                         thresholdSeparationSquared,
+                                         thresholdSeparation,
+                                         rolledToDsbOrSignFlip,
+                                         rollingLog );
+                rolledToDsbOrSignFlips[ pointIndex ] = rolledToDsbOrSignFlip;
+            }
+            catch( std::exception const& rollingError )
+            {
+                rollingErrors[ pointIndex ].assign( rollingError.what() );
             }
+            rollingLogs[ pointIndex ] = rollingLog.str();
+        }
+
+        for( size_t pointIndex( 0 );
+             pointIndex < numberOfStartingPoints;
+             ++pointIndex )
+        {
+            std::cout << rollingLogs[ pointIndex ];
+            if( !(rollingErrors[ pointIndex ].empty()) )
+            {
+                throw std::runtime_error( rollingErrors[ pointIndex ] );
+            }
+            foundMinimum = rolledMinima[ pointIndex ];
+            bool const
+            rolledToDsbOrSignFlip( rolledToDsbOrSignFlips[ pointIndex ] != 0 );
 
             foundMinima.push_back( foundMinimum );
 
@@ -232,4 +229,92 @@ namespace VevaciousPlusPlus
 
 
  }
+
+    // This uses gradientMinimizer to find the minimum at temperature
+    // minimizationTemperature starting from startingPoint, re-rolling from
+    // startingPoint scaled by nonDsbRollingToDsbScalingFactor if it rolled to
+    // dsbVacuum or a phase rotation of it, and sets rolledToDsbOrSignFlip to
+    // whether the returned minimum is still dsbVacuum or a phase rotation of
+    // it. Progress is written to rollingLog rather than directly to std::cout
+    // so that this can be called from several threads at once.
+    PotentialMinimum GradientFromStartingPoints::RollFromStartingPoint(
+            std::vector< double > const& startingPoint,
+            double const minimizationTemperature,
+            double const thresholdSeparationSquared,
+            double const thresholdSeparation,
+            bool& rolledToDsbOrSignFlip,
+            std::ostream& rollingLog ) const
+    {
+        rollingLog
+                << std::endl
+                << "Starting point: "
+                << potentialFunction.FieldConfigurationAsMathematica( startingPoint );
+        rollingLog << std::endl;
+        PotentialMinimum
+        foundMinimum( gradientMinimizer->MinimumAtTemperature( startingPoint,
+                                                  minimizationTemperature ) );
+        rollingLog
+                << "Rolled to: "
+                << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
+        rollingLog << std::endl;
+        rolledToDsbOrSignFlip = ( ( foundMinimum.SquareDistanceTo( dsbVacuum )
+                                    < thresholdSeparationSquared )
+                                  ||
+                                  !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
+                                                                    thresholdSeparation ) ) );
+
+        // We check to see if a starting point that was not the DSB minimum
+        // rolled to the DSB minimum: if so, we scale the starting point's fields
+        // by a factor and pass the scaled set of field values to
+        // gradientMinimizer to roll, and then carry on based on this new
+        // minimum. (We discovered in explorations with Vevacious 1 that
+        // it could happen that the basin of attraction of the DSB minimum at
+        // 1-loop level could grow so large that it would encompass tree-level
+        // minima that belong in some sense to other 1-loop minima, which moved
+        // very far away due to loop corrections, so even though their basins of
+        // attraction also grew very large in the same way that of the DSB
+        // minimum did, they moved enough that their tree-level minima were left
+        // out.)
+        if( rolledToDsbOrSignFlip
+            &&
+            ( dsbVacuum.SquareDistanceTo( startingPoint )
+              > thresholdSeparationSquared ) )
+        {
+            // We don't want to bother re-rolling the field origin, so we keep note
+            // of how far away from the field origin startingPoint is.
+            double lengthSquared( 0.0 );
+            std::vector< double > scaledPoint( startingPoint );
+            for( std::vector< double >::iterator
+                         scaledField( scaledPoint.begin() );
+                 scaledField < scaledPoint.end();
+                 ++scaledField )
+            {
+                lengthSquared += ( (*scaledField) * (*scaledField) );
+                *scaledField *= nonDsbRollingToDsbScalingFactor;
+            }
+            if( lengthSquared > thresholdSeparationSquared )
+            {
+                rollingLog
+                        << "Non-DSB-minimum starting point rolled to the DSB minimum, or a"
+                        << " phase rotation, using the full potential. Trying a scaled"
+                        << " starting point: "
+                        << potentialFunction.FieldConfigurationAsMathematica( scaledPoint );
+                rollingLog << std::endl;
+
+                foundMinimum
+                = gradientMinimizer->MinimumAtTemperature( scaledPoint,
+                                                  minimizationTemperature );
+                rolledToDsbOrSignFlip = ( foundMinimum.SquareDistanceTo( dsbVacuum )
+                                          < thresholdSeparationSquared )
+                                        ||
+                                        !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
+                                                                          thresholdSeparation ) );
+                rollingLog
+                        << "Rolled to: "
+                        << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
+                rollingLog << std::endl;
+            }
+        }
+        return foundMinimum;
+    }
 }/* namespace VevaciousPlusPlus */
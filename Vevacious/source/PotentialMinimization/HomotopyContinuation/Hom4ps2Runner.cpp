@@ -46,38 +46,20 @@ namespace VevaciousPlusPlus
             std::vector< PolynomialConstraint > const& systemToSolve,
             std::vector< std::vector< double > >& systemSolutions ) const
     {
-      char originalWorkingDirectory[ PATH_MAX ];
-      if( NULL == getcwd( originalWorkingDirectory,
-                          PATH_MAX ) )
-      {
-        std::cout
-                << std::endl
-                << "Error! unable to determine current working directory! (necessary,"
-                << " since this program needs to change directory to the directory where"
-                << " the hom4ps2 executable is, since unfortunately HOM4PS2 runs with"
-                << " relative paths; this program returns to where it was called though,"
-                << " to make batch calls easier.)";
-        std::cout << std::endl;
-        throw std::runtime_error(
-                "could not determine current working directory" );
-      }
-      // Here we change to HOM4PS2 directory
-      int directoryChangeSuccess( chdir( pathToHom4ps2.c_str() ) );
-      if( 0 != directoryChangeSuccess )
-      {
-        throw std::runtime_error(
-                "could not change directory to HOM4PS2 directory" );
-      }
-
-      // Here we create a unique name for a folder within HOM4PS2's folder to run
-      // the point.
-
+      // HOM4PS2 runs with relative paths, so it is run from a folder with a
+      // unique name within HOM4PS2's folder. Rather than changing the working
+      // directory of this process, which would affect any other threads, the
+      // shell which runs HOM4PS2 changes to that folder, and the files are
+      // written and read through their full paths.
       std::string pathname = boost::lexical_cast<std::string>(boost::uuids::random_generator()());
       std::string absolutepathname = pathToHom4ps2 + "/" + pathname;
 
-      // Here we make to the unique directory
+      // Here we make the unique directory with a bin directory with symlinks
+      // to the HOM4PS2 binary files, otherwise HOM4PS2 main executable won't
+      // work as it always searchers for the binary files in ./bin (relative
+      // path)
 
-      std::string systemCommand( "mkdir "+ pathname );
+      std::string systemCommand( "mkdir -p " + absolutepathname + "/bin" );
 
       int systemReturn( system( systemCommand.c_str() ) );
       if( systemReturn == -1 )
@@ -86,31 +68,10 @@ namespace VevaciousPlusPlus
         errorBuilder << "System could not execute \"" << systemCommand << "\".";
         throw std::runtime_error( errorBuilder.str() );
       }
+      ScopedRunFolder const runFolder( absolutepathname );
 
-      // Here we go inside the unique directory
-
-      int tempdirectoryChangeSuccess( chdir( absolutepathname.c_str() ) );
-      if( 0 != tempdirectoryChangeSuccess )
-      {
-        throw std::runtime_error(
-                "could not change directory to the temporary folder within HOM4PS2 directory" );
-      }
-
-      // Here we make a symlink to the HOM4PS2 binary files within the unique
-      // directory, otherwise HOM4PS2 main executable won't work as it always searchers for the
-      // binary files in ./bin (relative path)
-
-      systemCommand.assign( "mkdir bin" );
-
-      systemReturn = system( systemCommand.c_str() ) ;
-      if( systemReturn == -1 )
-      {
-        std::stringstream errorBuilder;
-        errorBuilder << "System could not execute \"" << systemCommand << "\".";
-        throw std::runtime_error( errorBuilder.str() );
-      }
-
-      systemCommand.assign( "ln -s " + pathToHom4ps2 + "/bin/flwcrv ./bin/flwcrv" );
+      systemCommand.assign( "ln -s " + pathToHom4ps2 + "/bin/flwcrv "
+                            + absolutepathname + "/bin/flwcrv" );
 
       systemReturn = system( systemCommand.c_str() ) ;
       if( systemReturn == -1 )
@@ -120,7 +81,8 @@ namespace VevaciousPlusPlus
         throw std::runtime_error( errorBuilder.str() );
       }
 
-      systemCommand.assign(  "ln -s " + pathToHom4ps2 + "/bin/sym2num ./bin/sym2num" );
+      systemCommand.assign( "ln -s " + pathToHom4ps2 + "/bin/sym2num "
+                            + absolutepathname + "/bin/sym2num" );
 
       systemReturn = system( systemCommand.c_str() ) ;
       if( systemReturn == -1 )
@@ -139,25 +101,19 @@ namespace VevaciousPlusPlus
       WriteHom4p2Input( systemToSolve,
                         variableNames,
                         nameToIndexMap,
-                        hom4ps2InputFilename );
+                        absolutepathname + "/" + hom4ps2InputFilename );
 
       std::cout
               << std::endl
               << "Running HOM4PS2!" << std::endl << "-----------------" << std::endl;
       std::cout << std::endl;
 
-      // This is to avoid a bug in HOM4PS2 where it tries to run this file instead of the input.
-
-      systemCommand.assign( "rm ./bin/input.num" );
-      systemReturn = system( systemCommand.c_str() );
-      if( systemReturn == -1 )
-      {
-        std::stringstream errorBuilder;
-        errorBuilder << "System could not execute \"" << systemCommand << "\".";
-        throw std::runtime_error( errorBuilder.str() );
-      }
-      // Running HOM4PS2
-      systemCommand.assign( "/bin/bash -c \"../hom4ps2 " );
+      // Running HOM4PS2 from within the unique directory, first removing
+      // ./bin/input.num to avoid a bug in HOM4PS2 where it tries to run this
+      // file instead of the input.
+      systemCommand.assign( "/bin/bash -c \"cd " );
+      systemCommand.append( absolutepathname );
+      systemCommand.append( " && rm -f ./bin/input.num && ../hom4ps2 " );
       systemCommand.append( hom4ps2InputFilename );
       systemCommand.append(  " <<< " );
       systemCommand.append( homotopyType );
@@ -170,44 +126,15 @@ namespace VevaciousPlusPlus
         throw std::runtime_error( errorBuilder.str() );
       }
 
-      // At this point, we are in the unique directory with hom4ps2 & data.roots
-      // one directory above, so now we fill purelyRealSolutionSets.
+      // HOM4PS2 writes data.roots in the unique directory, so now we fill
+      // purelyRealSolutionSets.
 
-      ParseHom4ps2Output( "./data.roots",
+      ParseHom4ps2Output( absolutepathname + "/data.roots",
                           systemSolutions,
                           variableNames,
                           nameToIndexMap,
                           systemToSolve );
-
-      systemCommand.assign( "rm ./bin/input.num" );
-      systemReturn = system( systemCommand.c_str() );
-      if( systemReturn == -1 )
-      {
-        std::stringstream errorBuilder;
-        errorBuilder << "System could not execute \"" << systemCommand << "\".";
-        throw std::runtime_error( errorBuilder.str() );
-      }
-      // Now we return to the original working directory so as to avoid confusing
-      // the user.
-      directoryChangeSuccess = chdir( originalWorkingDirectory );
-      if( 0 != directoryChangeSuccess )
-      {
-        throw std::runtime_error(
-                "could not change directory back to initial directory" );
-      }
-
-      systemCommand.assign( "rm -rf " + absolutepathname );
-
-      systemReturn = system( systemCommand.c_str() ) ;
-      if( systemReturn == -1 )
-      {
-        std::stringstream errorBuilder;
-        errorBuilder << "System could not execute \"" << systemCommand << "\".";
-        throw std::runtime_error( errorBuilder.str() );
-      }
-
-
-
+      // The unique directory is removed by runFolder going out of scope.
     }
 
     // This sets up the variable names in variableNames and nameToIndexMap,
@@ -418,6 +345,8 @@ namespace VevaciousPlusPlus
       // Now we divide complexSolutions into sets of numberOfVariables complex
       // values, and any which are purely real (within a tolerance of
       // resolutionSize) are kept, along with any valid sign-flip variations.
+      IndexedSolutionSet indexedSolutions( purelyRealSolutionSets,
+                                           resolutionSize );
       std::vector< double > candidateRealSolution( numberOfVariables,
                                                    0.0 );
       bool solutionIsReal( true );
@@ -448,9 +377,8 @@ namespace VevaciousPlusPlus
         if( solutionIsReal )
         {
           AppendSolutionAndValidSignFlips( candidateRealSolution,
-                                           purelyRealSolutionSets,
-                                           systemToSolve,
-                                           resolutionSize );
+                                           indexedSolutions,
+                                           systemToSolve );
         }
       }
 
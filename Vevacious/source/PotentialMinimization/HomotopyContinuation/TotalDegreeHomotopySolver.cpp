@@ -0,0 +1,674 @@
+/*
+ * TotalDegreeHomotopySolver.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "PotentialMinimization/HomotopyContinuation/TotalDegreeHomotopySolver.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace VevaciousPlusPlus
+{
+  TotalDegreeHomotopySolver::ComplexNumber const
+  TotalDegreeHomotopySolver::gammaConstant( std::polar( 1.0,
+                                                        2.0 ) );
+  double const TotalDegreeHomotopySolver::initialStepSize( 0.01 );
+  double const TotalDegreeHomotopySolver::maximumStepSize( 0.1 );
+  double const TotalDegreeHomotopySolver::minimumStepSize( 1.0e-12 );
+  double const TotalDegreeHomotopySolver::correctorTolerance( 1.0e-10 );
+  double const TotalDegreeHomotopySolver::divergenceThreshold( 1.0e8 );
+  double const TotalDegreeHomotopySolver::endgameStartTime( 0.9 );
+  double const TotalDegreeHomotopySolver::endgameMagnitude( 1.0e4 );
+  double const TotalDegreeHomotopySolver::divergenceExponent( 0.5 );
+
+  TotalDegreeHomotopySolver::TotalDegreeHomotopySolver(
+                                                   double const resolutionSize,
+                                          unsigned int const numberOfThreads,
+                                     unsigned int const maximumStepsPerPath ) :
+    PolynomialSystemSolver(),
+    resolutionSize( resolutionSize ),
+    numberOfThreads( numberOfThreads ),
+    maximumStepsPerPath( maximumStepsPerPath )
+  {
+    // This constructor is just an initialization list.
+  }
+
+  TotalDegreeHomotopySolver::~TotalDegreeHomotopySolver()
+  {
+    // This does nothing.
+  }
+
+  TotalDegreeHomotopySolver::PathWorkspace::PathWorkspace(
+                                           ScaledSystem const& scaledSystem ) :
+    powerTable( ( scaledSystem.numberOfVariables
+                  * ( scaledSystem.highestPower + 1 ) ) ),
+    targetValues( scaledSystem.numberOfVariables ),
+    targetJacobian( scaledSystem.numberOfVariables,
+                    scaledSystem.numberOfVariables ),
+    homotopyValues( scaledSystem.numberOfVariables ),
+    homotopyJacobian( scaledSystem.numberOfVariables,
+                      scaledSystem.numberOfVariables ),
+    timeDerivative( scaledSystem.numberOfVariables ),
+    stepVector( scaledSystem.numberOfVariables ),
+    stagePoint( scaledSystem.numberOfVariables )
+  {
+    for( size_t stageIndex( 0 );
+         stageIndex < 4;
+         ++stageIndex )
+    {
+      predictorSlopes[ stageIndex ].resize( scaledSystem.numberOfVariables );
+    }
+  }
+
+
+  // This tracks every path of the total-degree homotopy to fill
+  // systemSolutions with all the purely real solutions of systemToSolve,
+  // along with any valid sign-flip variations of them.
+  void TotalDegreeHomotopySolver::operator()(
+                      std::vector< PolynomialConstraint > const& systemToSolve,
+                 std::vector< std::vector< double > >& systemSolutions ) const
+  {
+    double const fieldScale( FieldScale( systemToSolve ) );
+    ScaledSystem scaledSystem;
+    PrepareScaledSystem( systemToSolve,
+                         fieldScale,
+                         scaledSystem );
+    size_t numberOfPaths( 1 );
+    for( std::vector< unsigned int >::const_iterator
+         totalDegree( scaledSystem.totalDegrees.begin() );
+         totalDegree < scaledSystem.totalDegrees.end();
+         ++totalDegree )
+    {
+      numberOfPaths *= *totalDegree;
+    }
+
+    std::cout
+    << std::endl
+    << "Tracking " << numberOfPaths << " homotopy path"
+    << ( ( numberOfPaths == 1 ) ? "" : "s" ) << " for "
+    << scaledSystem.numberOfVariables << " fields (field scale "
+    << fieldScale << " GeV).";
+    std::cout << std::endl;
+
+    // Each path is tracked independently, storing its end point in the slot
+    // for its index, so that the solutions are appended in the same order
+    // regardless of how the paths were shared out among the threads.
+    std::vector< ComplexVector > pathEnds( numberOfPaths );
+    std::vector< char > pathConverged( numberOfPaths,
+                                       0 );
+    int threadsToUse( static_cast< int >( numberOfThreads ) );
+#ifdef _OPENMP
+    if( threadsToUse < 1 )
+    {
+      threadsToUse = omp_get_max_threads();
+    }
+#endif
+#pragma omp parallel num_threads( threadsToUse )
+    {
+      PathWorkspace pathWorkspace( scaledSystem );
+#pragma omp for schedule( dynamic )
+      for( size_t pathIndex = 0;
+           pathIndex < numberOfPaths;
+           ++pathIndex )
+      {
+        StartPoint( scaledSystem,
+                    pathIndex,
+                    pathEnds[ pathIndex ] );
+        pathConverged[ pathIndex ] = TrackPath( scaledSystem,
+                                                pathEnds[ pathIndex ],
+                                                pathWorkspace );
+      }
+    }
+
+    // Now the end points which are purely real (within a tolerance of
+    // resolutionSize) are kept, along with any valid sign-flip variations.
+    size_t numberOfFiniteSolutions( 0 );
+    IndexedSolutionSet indexedSolutions( systemSolutions,
+                                         resolutionSize );
+    std::vector< double >
+    candidateRealSolution( scaledSystem.numberOfVariables,
+                           0.0 );
+    for( size_t pathIndex( 0 );
+         pathIndex < numberOfPaths;
+         ++pathIndex )
+    {
+      if( pathConverged[ pathIndex ] == 0 )
+      {
+        continue;
+      }
+      ++numberOfFiniteSolutions;
+      bool solutionIsReal( true );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < scaledSystem.numberOfVariables;
+           ++fieldIndex )
+      {
+        if( fabs( fieldScale * pathEnds[ pathIndex ]( fieldIndex ).imag() )
+            > resolutionSize )
+        {
+          solutionIsReal = false;
+          break;
+        }
+        candidateRealSolution[ fieldIndex ]
+        = ( fieldScale * pathEnds[ pathIndex ]( fieldIndex ).real() );
+      }
+      if( solutionIsReal )
+      {
+        AppendSolutionAndValidSignFlips( candidateRealSolution,
+                                         indexedSolutions,
+                                         systemToSolve );
+      }
+    }
+
+    std::cout
+    << "Tracked " << numberOfPaths << " homotopy path"
+    << ( ( numberOfPaths == 1 ) ? "" : "s" ) << ", "
+    << numberOfFiniteSolutions << " of which ended at finite solutions."
+    << " After trying sign-flip variations, returning "
+    << systemSolutions.size() << " purely real solution"
+    << ( ( systemSolutions.size() == 1 ) ? "." : "s." );
+    std::cout << std::endl;
+  }
+
+  // This returns the scale for the fields which minimizes the spread of the
+  // magnitudes of the terms within each constraint, found by a least-squares
+  // fit of the logarithms of the coefficients against the total powers of
+  // the terms.
+  double TotalDegreeHomotopySolver::FieldScale(
+                    std::vector< PolynomialConstraint > const& systemToSolve )
+  {
+    // Each term contributes ( log|c| + p log(s) - m ) to the sum of squares,
+    // where c is its coefficient, p is its total power, and m is a free
+    // overall magnitude for its constraint, so m is the mean of
+    // ( log|c| + p log(s) ) over its constraint and log(s) is the ratio
+    // below.
+    double weightedCovariance( 0.0 );
+    double weightedVariance( 0.0 );
+    for( std::vector< PolynomialConstraint >::const_iterator
+         systemConstraint( systemToSolve.begin() );
+         systemConstraint < systemToSolve.end();
+         ++systemConstraint )
+    {
+      double meanPower( 0.0 );
+      double meanLogarithm( 0.0 );
+      size_t numberOfTerms( 0 );
+      for( PolynomialConstraint::const_iterator
+           constraintTerm( systemConstraint->begin() );
+           constraintTerm < systemConstraint->end();
+           ++constraintTerm )
+      {
+        if( constraintTerm->first != 0.0 )
+        {
+          meanPower += std::accumulate( constraintTerm->second.begin(),
+                                        constraintTerm->second.end(),
+                                        0u );
+          meanLogarithm += log( fabs( constraintTerm->first ) );
+          ++numberOfTerms;
+        }
+      }
+      if( numberOfTerms == 0 )
+      {
+        continue;
+      }
+      meanPower /= static_cast< double >( numberOfTerms );
+      meanLogarithm /= static_cast< double >( numberOfTerms );
+      for( PolynomialConstraint::const_iterator
+           constraintTerm( systemConstraint->begin() );
+           constraintTerm < systemConstraint->end();
+           ++constraintTerm )
+      {
+        if( constraintTerm->first != 0.0 )
+        {
+          double const
+          powerDifference( std::accumulate( constraintTerm->second.begin(),
+                                            constraintTerm->second.end(),
+                                            0u ) - meanPower );
+          weightedCovariance += ( powerDifference
+                                  * ( log( fabs( constraintTerm->first ) )
+                                      - meanLogarithm ) );
+          weightedVariance += ( powerDifference * powerDifference );
+        }
+      }
+    }
+    if( !( weightedVariance > 0.0 ) )
+    {
+      return 1.0;
+    }
+    return exp( -weightedCovariance / weightedVariance );
+  }
+
+  // This fills scaledSystem with the terms of systemToSolve for the fields
+  // divided by fieldScale.
+  void TotalDegreeHomotopySolver::PrepareScaledSystem(
+                      std::vector< PolynomialConstraint > const& systemToSolve,
+                                                       double const fieldScale,
+                                                  ScaledSystem& scaledSystem )
+  {
+    size_t const numberOfVariables( systemToSolve.size() );
+    scaledSystem.numberOfVariables = numberOfVariables;
+    scaledSystem.highestPower = 0;
+    scaledSystem.totalDegrees.assign( numberOfVariables,
+                                      0 );
+    scaledSystem.termOffsets.assign( 1,
+                                     0 );
+    scaledSystem.termCoefficients.clear();
+    scaledSystem.termPowers.clear();
+    for( size_t constraintIndex( 0 );
+         constraintIndex < numberOfVariables;
+         ++constraintIndex )
+    {
+      PolynomialConstraint const&
+      systemConstraint( systemToSolve[ constraintIndex ] );
+      size_t const firstTerm( scaledSystem.termCoefficients.size() );
+      double largestCoefficient( 0.0 );
+      for( PolynomialConstraint::const_iterator
+           constraintTerm( systemConstraint.begin() );
+           constraintTerm < systemConstraint.end();
+           ++constraintTerm )
+      {
+        if( constraintTerm->first == 0.0 )
+        {
+          continue;
+        }
+        if( constraintTerm->second.size() > numberOfVariables )
+        {
+          std::stringstream errorBuilder;
+          errorBuilder
+          << "TotalDegreeHomotopySolver was given a term with powers for "
+          << constraintTerm->second.size() << " fields in a system of "
+          << numberOfVariables << " constraints.";
+          throw std::runtime_error( errorBuilder.str() );
+        }
+        unsigned int totalPower( 0 );
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfVariables;
+             ++fieldIndex )
+        {
+          unsigned int const fieldPower(
+                               ( fieldIndex < constraintTerm->second.size() ) ?
+                                   constraintTerm->second[ fieldIndex ] : 0 );
+          scaledSystem.termPowers.push_back( fieldPower );
+          totalPower += fieldPower;
+          if( fieldPower > scaledSystem.highestPower )
+          {
+            scaledSystem.highestPower = fieldPower;
+          }
+        }
+        if( totalPower > scaledSystem.totalDegrees[ constraintIndex ] )
+        {
+          scaledSystem.totalDegrees[ constraintIndex ] = totalPower;
+        }
+        double const
+        scaledCoefficient( constraintTerm->first
+                           * pow( fieldScale,
+                                  static_cast< int >( totalPower ) ) );
+        scaledSystem.termCoefficients.push_back( scaledCoefficient );
+        if( fabs( scaledCoefficient ) > largestCoefficient )
+        {
+          largestCoefficient = fabs( scaledCoefficient );
+        }
+      }
+      for( size_t termIndex( firstTerm );
+           termIndex < scaledSystem.termCoefficients.size();
+           ++termIndex )
+      {
+        scaledSystem.termCoefficients[ termIndex ] /= largestCoefficient;
+      }
+      scaledSystem.termOffsets.push_back(
+                                     scaledSystem.termCoefficients.size() );
+    }
+  }
+
+  // This sets startPoint to be the solution of the start system with index
+  // pathIndex, counting the roots of unity for each field in turn.
+  void TotalDegreeHomotopySolver::StartPoint( ScaledSystem const& scaledSystem,
+                                              size_t pathIndex,
+                                              ComplexVector& startPoint )
+  {
+    startPoint.resize( scaledSystem.numberOfVariables );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < scaledSystem.numberOfVariables;
+         ++fieldIndex )
+    {
+      size_t const totalDegree( scaledSystem.totalDegrees[ fieldIndex ] );
+      startPoint( fieldIndex )
+      = std::polar( 1.0,
+                    ( ( 2.0 * M_PI
+                        * static_cast< double >( pathIndex % totalDegree ) )
+                      / static_cast< double >( totalDegree ) ) );
+      pathIndex /= totalDegree;
+    }
+  }
+
+  // This puts the values of the scaled target system at pathPoint into
+  // pathWorkspace.targetValues and its Jacobian into
+  // pathWorkspace.targetJacobian.
+  void TotalDegreeHomotopySolver::EvaluateTarget(
+                                              ScaledSystem const& scaledSystem,
+                                                ComplexVector const& pathPoint,
+                                                PathWorkspace& pathWorkspace )
+  {
+    size_t const numberOfVariables( scaledSystem.numberOfVariables );
+    size_t const tableWidth( scaledSystem.highestPower + 1 );
+    std::vector< ComplexNumber >& powerTable( pathWorkspace.powerTable );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfVariables;
+         ++fieldIndex )
+    {
+      ComplexNumber* const fieldPowers( &(powerTable[ fieldIndex
+                                                      * tableWidth ]) );
+      fieldPowers[ 0 ] = 1.0;
+      for( size_t fieldPower( 1 );
+           fieldPower < tableWidth;
+           ++fieldPower )
+      {
+        fieldPowers[ fieldPower ]
+        = ( fieldPowers[ fieldPower - 1 ] * pathPoint( fieldIndex ) );
+      }
+    }
+    pathWorkspace.targetValues.setZero();
+    pathWorkspace.targetJacobian.setZero();
+    unsigned int const* termPowers( scaledSystem.termPowers.data() );
+    for( size_t constraintIndex( 0 );
+         constraintIndex < numberOfVariables;
+         ++constraintIndex )
+    {
+      for( size_t termIndex( scaledSystem.termOffsets[ constraintIndex ] );
+           termIndex < scaledSystem.termOffsets[ constraintIndex + 1 ];
+           ++termIndex )
+      {
+        ComplexNumber termValue( scaledSystem.termCoefficients[ termIndex ] );
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfVariables;
+             ++fieldIndex )
+        {
+          termValue *= powerTable[ ( fieldIndex * tableWidth )
+                                   + termPowers[ fieldIndex ] ];
+        }
+        pathWorkspace.targetValues( constraintIndex ) += termValue;
+
+        // The derivative with respect to each field with a non-zero power is
+        // built from the products of the powers of the other fields, rather
+        // than by dividing termValue by the field value, which may be zero.
+        for( size_t derivativeIndex( 0 );
+             derivativeIndex < numberOfVariables;
+             ++derivativeIndex )
+        {
+          unsigned int const
+          derivativePower( termPowers[ derivativeIndex ] );
+          if( derivativePower == 0 )
+          {
+            continue;
+          }
+          ComplexNumber
+          termDerivative( scaledSystem.termCoefficients[ termIndex ]
+                          * static_cast< double >( derivativePower ) );
+          for( size_t fieldIndex( 0 );
+               fieldIndex < numberOfVariables;
+               ++fieldIndex )
+          {
+            termDerivative *= powerTable[ ( fieldIndex * tableWidth )
+                                          + termPowers[ fieldIndex ]
+                             - ( ( fieldIndex == derivativeIndex ) ? 1 : 0 ) ];
+          }
+          pathWorkspace.targetJacobian( constraintIndex,
+                                        derivativeIndex ) += termDerivative;
+        }
+        termPowers += numberOfVariables;
+      }
+    }
+  }
+
+  // This puts the values of the homotopy at pathPoint and homotopyTime into
+  // pathWorkspace.homotopyValues, its Jacobian with respect to the fields
+  // into pathWorkspace.homotopyJacobian, and its derivative with respect to
+  // homotopyTime into pathWorkspace.timeDerivative.
+  void TotalDegreeHomotopySolver::EvaluateHomotopy(
+                                              ScaledSystem const& scaledSystem,
+                                                ComplexVector const& pathPoint,
+                                                   double const homotopyTime,
+                                                PathWorkspace& pathWorkspace )
+  {
+    EvaluateTarget( scaledSystem,
+                    pathPoint,
+                    pathWorkspace );
+    ComplexNumber const startWeight( ( 1.0 - homotopyTime ) * gammaConstant );
+    pathWorkspace.homotopyJacobian
+    = ( homotopyTime * pathWorkspace.targetJacobian );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < scaledSystem.numberOfVariables;
+         ++fieldIndex )
+    {
+      unsigned int const
+      totalDegree( scaledSystem.totalDegrees[ fieldIndex ] );
+      ComplexNumber const
+      lowerPower( std::pow( pathPoint( fieldIndex ),
+                            static_cast< int >( totalDegree - 1 ) ) );
+      ComplexNumber const
+      startValue( ( lowerPower * pathPoint( fieldIndex ) ) - 1.0 );
+      pathWorkspace.homotopyValues( fieldIndex )
+      = ( ( startWeight * startValue )
+          + ( homotopyTime * pathWorkspace.targetValues( fieldIndex ) ) );
+      pathWorkspace.homotopyJacobian( fieldIndex,
+                                      fieldIndex )
+      += ( startWeight * static_cast< double >( totalDegree ) * lowerPower );
+      pathWorkspace.timeDerivative( fieldIndex )
+      = ( pathWorkspace.targetValues( fieldIndex )
+          - ( gammaConstant * startValue ) );
+    }
+  }
+
+  // This puts the derivative of the path with respect to homotopyTime at
+  // pathPoint into pathSlope, returning false if the Jacobian is singular.
+  bool TotalDegreeHomotopySolver::PathSlope( ScaledSystem const& scaledSystem,
+                                             ComplexVector const& pathPoint,
+                                             double const homotopyTime,
+                                             PathWorkspace& pathWorkspace,
+                                             ComplexVector& pathSlope )
+  {
+    EvaluateHomotopy( scaledSystem,
+                      pathPoint,
+                      homotopyTime,
+                      pathWorkspace );
+    Eigen::PartialPivLU< ComplexMatrix >
+    jacobianDecomposition( pathWorkspace.homotopyJacobian );
+    pathSlope = -jacobianDecomposition.solve( pathWorkspace.timeDerivative );
+    return pathSlope.allFinite();
+  }
+
+  // This tracks the path starting at pathPoint from t = 0 to t = 1 with a
+  // fourth-order Runge-Kutta predictor and a Newton corrector, adapting the
+  // step size, then refines the end point with Newton's method on the target
+  // system. It leaves the end of the path in pathPoint and returns true if it
+  // reached t = 1 without diverging to infinity. Paths which are clearly
+  // diverging in the endgame are abandoned without tracking them to t = 1.
+  bool TotalDegreeHomotopySolver::TrackPath( ScaledSystem const& scaledSystem,
+                                             ComplexVector& pathPoint,
+                                        PathWorkspace& pathWorkspace ) const
+  {
+    double homotopyTime( 0.0 );
+    double stepSize( initialStepSize );
+    unsigned int successiveSteps( 0 );
+    ComplexVector* const predictorSlopes( pathWorkspace.predictorSlopes );
+    for( unsigned int stepCount( 0 );
+         homotopyTime < 1.0;
+         ++stepCount )
+    {
+      if( ( stepCount >= maximumStepsPerPath )
+          ||
+          ( stepSize < minimumStepSize )
+          ||
+          ( pathPoint.cwiseAbs().maxCoeff() > divergenceThreshold ) )
+      {
+        return false;
+      }
+      if( ( homotopyTime + stepSize ) > 1.0 )
+      {
+        stepSize = ( 1.0 - homotopyTime );
+      }
+      double const halfStep( 0.5 * stepSize );
+
+      // The predictor is a fourth-order Runge-Kutta step along the tangent
+      // to the path.
+      bool stepIsGood( PathSlope( scaledSystem,
+                                  pathPoint,
+                                  homotopyTime,
+                                  pathWorkspace,
+                                  predictorSlopes[ 0 ] ) );
+      if( stepIsGood )
+      {
+        pathWorkspace.stagePoint = ( pathPoint
+                                     + ( halfStep * predictorSlopes[ 0 ] ) );
+        stepIsGood = PathSlope( scaledSystem,
+                                pathWorkspace.stagePoint,
+                                ( homotopyTime + halfStep ),
+                                pathWorkspace,
+                                predictorSlopes[ 1 ] );
+      }
+      if( stepIsGood )
+      {
+        pathWorkspace.stagePoint = ( pathPoint
+                                     + ( halfStep * predictorSlopes[ 1 ] ) );
+        stepIsGood = PathSlope( scaledSystem,
+                                pathWorkspace.stagePoint,
+                                ( homotopyTime + halfStep ),
+                                pathWorkspace,
+                                predictorSlopes[ 2 ] );
+      }
+      if( stepIsGood )
+      {
+        pathWorkspace.stagePoint = ( pathPoint
+                                     + ( stepSize * predictorSlopes[ 2 ] ) );
+        stepIsGood = PathSlope( scaledSystem,
+                                pathWorkspace.stagePoint,
+                                ( homotopyTime + stepSize ),
+                                pathWorkspace,
+                                predictorSlopes[ 3 ] );
+      }
+      if( stepIsGood )
+      {
+        pathWorkspace.stagePoint
+        = ( pathPoint + ( ( stepSize / 6.0 )
+                          * ( predictorSlopes[ 0 ]
+                              + ( 2.0 * predictorSlopes[ 1 ] )
+                              + ( 2.0 * predictorSlopes[ 2 ] )
+                              + predictorSlopes[ 3 ] ) ) );
+
+        // The corrector is a few iterations of Newton's method at the new
+        // time, which must converge quickly for the step to be accepted, as
+        // slow convergence suggests that the prediction may have jumped to a
+        // different path.
+        double const nextTime( homotopyTime + stepSize );
+        double lastCorrection( -1.0 );
+        stepIsGood = false;
+        for( unsigned int newtonIteration( 0 );
+             newtonIteration < 3;
+             ++newtonIteration )
+        {
+          EvaluateHomotopy( scaledSystem,
+                            pathWorkspace.stagePoint,
+                            nextTime,
+                            pathWorkspace );
+          Eigen::PartialPivLU< ComplexMatrix >
+          jacobianDecomposition( pathWorkspace.homotopyJacobian );
+          pathWorkspace.stepVector
+          = jacobianDecomposition.solve( pathWorkspace.homotopyValues );
+          if( !(pathWorkspace.stepVector.allFinite()) )
+          {
+            break;
+          }
+          pathWorkspace.stagePoint -= pathWorkspace.stepVector;
+          double const correctionSize( pathWorkspace.stepVector.norm() );
+          if( ( lastCorrection >= 0.0 )
+              &&
+              ( correctionSize > ( 0.5 * lastCorrection ) ) )
+          {
+            break;
+          }
+          lastCorrection = correctionSize;
+          if( correctionSize
+              < ( correctorTolerance
+                  * ( 1.0 + pathWorkspace.stagePoint.norm() ) ) )
+          {
+            stepIsGood = true;
+            break;
+          }
+        }
+        if( stepIsGood )
+        {
+          // In the endgame, the growth of the largest field magnitude over
+          // the step gives an estimate of the exponent w of ( 1 - t )^(-w),
+          // which tends to zero for paths going to finite solutions.
+          if( ( nextTime >= endgameStartTime )
+              &&
+              ( nextTime < 1.0 ) )
+          {
+            double const
+            nextMagnitude( pathWorkspace.stagePoint.cwiseAbs().maxCoeff() );
+            if( ( nextMagnitude > endgameMagnitude )
+                &&
+                ( std::log( nextMagnitude
+                            / pathPoint.cwiseAbs().maxCoeff() )
+                  > ( divergenceExponent
+                      * std::log( ( 1.0 - homotopyTime )
+                                  / ( 1.0 - nextTime ) ) ) ) )
+            {
+              return false;
+            }
+          }
+          pathPoint = pathWorkspace.stagePoint;
+          homotopyTime = nextTime;
+          if( ++successiveSteps >= 3 )
+          {
+            stepSize = std::min( ( 2.0 * stepSize ),
+                                 maximumStepSize );
+            successiveSteps = 0;
+          }
+          continue;
+        }
+      }
+      stepSize *= 0.5;
+      successiveSteps = 0;
+    }
+
+    // At t = 1 the homotopy is just the target system, so the end point is
+    // refined with Newton's method on the target system alone. Singular
+    // solutions converge only linearly, so the refinement just stops when it
+    // stops improving.
+    double lastCorrection( -1.0 );
+    for( unsigned int newtonIteration( 0 );
+         newtonIteration < 10;
+         ++newtonIteration )
+    {
+      EvaluateTarget( scaledSystem,
+                      pathPoint,
+                      pathWorkspace );
+      Eigen::PartialPivLU< ComplexMatrix >
+      jacobianDecomposition( pathWorkspace.targetJacobian );
+      pathWorkspace.stepVector
+      = jacobianDecomposition.solve( pathWorkspace.targetValues );
+      double const correctionSize( pathWorkspace.stepVector.norm() );
+      if( !(pathWorkspace.stepVector.allFinite())
+          ||
+          ( ( lastCorrection >= 0.0 )
+            &&
+            ( correctionSize > lastCorrection ) ) )
+      {
+        break;
+      }
+      pathPoint -= pathWorkspace.stepVector;
+      lastCorrection = correctionSize;
+      if( correctionSize
+          < ( correctorTolerance * ( 1.0 + pathPoint.norm() ) ) )
+      {
+        break;
+      }
+    }
+    return ( pathPoint.allFinite()
+             &&
+             ( pathPoint.cwiseAbs().maxCoeff() < divergenceThreshold ) );
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -6,6 +6,9 @@
  */
 
 #include "PotentialMinimization/StartingPointGeneration/PolynomialAtFixedScalesSolver.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace VevaciousPlusPlus
 {
@@ -16,7 +19,9 @@ namespace VevaciousPlusPlus
                           std::unique_ptr<PolynomialSystemSolver> polynomialSystemSolver,
                                              unsigned int const numberOfScales,
                                          bool const returnOnlyPolynomialMinima,
-                                                size_t const numberOfFields ) :
+                                                   size_t const numberOfFields,
+                                            unsigned int const numberOfThreads,
+                            double const neighbouringScaleDuplicateFraction ) :
     StartingPointFinder(),
     minimizationConditions( numberOfFields,
                             std::vector< ParametersAndFieldsProductTerm >() ),
@@ -25,8 +30,20 @@ namespace VevaciousPlusPlus
     polynomialSystemSolver( std::move(polynomialSystemSolver) ),
     numberOfScales( numberOfScales ),
     returnOnlyPolynomialMinima( returnOnlyPolynomialMinima ),
-    numberOfFields( numberOfFields )
+    numberOfFields( numberOfFields ),
+    numberOfThreads( numberOfThreads ),
+    neighbouringScaleDuplicateFraction( neighbouringScaleDuplicateFraction )
   {
+    if( ( numberOfThreads != 1 )
+        &&
+        !(this->polynomialSystemSolver->CanRunConcurrently()) )
+    {
+      WarningLogger::LogWarning( "The polynomial system solver cannot be run"
+                                 " concurrently, so the scales will be solved"
+                                 " one after another regardless of the number"
+                                 " of threads requested." );
+    }
+
     if( returnOnlyPolynomialMinima )
     {
       polynomialHermitian
@@ -107,6 +124,11 @@ namespace VevaciousPlusPlus
   // solutions with length less than 10^3 or greater than 10^7 are discarded.
   // The lowest scale does not discard any solution for being too small, and
   // the highest scale does not discard any solutions for being too large.
+  // The scales are solved by up to numberOfThreads threads at once if
+  // polynomialSystemSolver can run concurrently, and the solutions are then
+  // appended in order of increasing scale, leaving out any solution which is
+  // within a hypercube of side neighbouringScaleDuplicateFraction times its
+  // length of a solution from the next-lowest scale.
   void PolynomialAtFixedScalesSolver::operator()(
                    std::vector< std::vector< double > >& startingPoints ) const
   {
@@ -115,12 +137,18 @@ namespace VevaciousPlusPlus
       throw std::runtime_error(
                 "PolynomialAtFixedScalesSolver::numberOfScales cannot be 0!" );
     }
-    else if( numberOfScales == 1 )
+
+    // First the scales and the allowed ranges of solution lengths are worked
+    // out, in order of increasing scale.
+    std::vector< double > logScales;
+    std::vector< double > lowerLengthBounds;
+    std::vector< double > upperLengthBounds;
+    if( numberOfScales == 1 )
     {
-      AddSolutions( startingPoints,
-               log( lagrangianParameterManager.AppropriateSingleFixedScale() ),
-                    0.0,
-                    -1.0 );
+      logScales.push_back(
+             log( lagrangianParameterManager.AppropriateSingleFixedScale() ) );
+      lowerLengthBounds.push_back( 0.0 );
+      upperLengthBounds.push_back( -1.0 );
     }
     else
     {
@@ -133,10 +161,9 @@ namespace VevaciousPlusPlus
 
       // Take solutions at the lowest scale, with the allowed solution length
       // range being [ 0.0, exp( logLowestScale + logStep )].
-      AddSolutions( startingPoints,
-                    logLowestScale,
-                    0.0,
-                    exp( logLowestScale + logStep ) );
+      logScales.push_back( logLowestScale );
+      lowerLengthBounds.push_back( 0.0 );
+      upperLengthBounds.push_back( exp( logLowestScale + logStep ) );
 
       // Take solutions from every intermediate scale, with the allowed range
       // being exp(+/- logStep) around each scale.
@@ -146,19 +173,85 @@ namespace VevaciousPlusPlus
            ++scaleStep )
       {
         logCurrentScale += logStep;
-        AddSolutions( startingPoints,
-                      logCurrentScale,
-                      exp( logCurrentScale - logStep ),
-                      exp( logCurrentScale + logStep ) );
+        logScales.push_back( logCurrentScale );
+        lowerLengthBounds.push_back( exp( logCurrentScale - logStep ) );
+        upperLengthBounds.push_back( exp( logCurrentScale + logStep ) );
       }
 
       // Take solutions at the highest scale, with the allowed solution length
       // lower bound being exp(logCurrentScale) which should be
       // exp( logHighestScale - logStep ), and there is no upper bound.
-      AddSolutions( startingPoints,
-                    logHighestScale,
-                    exp( logCurrentScale ),
-                    -1.0 );
+      logScales.push_back( logHighestScale );
+      lowerLengthBounds.push_back( exp( logCurrentScale ) );
+      upperLengthBounds.push_back( -1.0 );
+    }
+
+    // The scales are independent of each other, so if polynomialSystemSolver
+    // allows it, they are shared out among the threads, each putting its
+    // solutions (or the message of any exception, which must not escape the
+    // parallel region) in the slot for its scale.
+    size_t const numberOfSolvedScales( logScales.size() );
+    std::vector< std::vector< std::vector< double > > >
+    solutionsPerScale( numberOfSolvedScales );
+    std::vector< std::string > errorsPerScale( numberOfSolvedScales );
+    int threadsToUse( 1 );
+    if( polynomialSystemSolver->CanRunConcurrently() )
+    {
+      threadsToUse = static_cast< int >( numberOfThreads );
+#ifdef _OPENMP
+      if( threadsToUse < 1 )
+      {
+        threadsToUse = omp_get_max_threads();
+      }
+#endif
+      if( threadsToUse > static_cast< int >( numberOfSolvedScales ) )
+      {
+        threadsToUse = static_cast< int >( numberOfSolvedScales );
+      }
+    }
+#pragma omp parallel for schedule( dynamic ) num_threads( threadsToUse )
+    for( size_t scaleIndex = 0;
+         scaleIndex < numberOfSolvedScales;
+         ++scaleIndex )
+    {
+      try
+      {
+        AddSolutions( solutionsPerScale[ scaleIndex ],
+                      logScales[ scaleIndex ],
+                      lowerLengthBounds[ scaleIndex ],
+                      upperLengthBounds[ scaleIndex ] );
+      }
+      catch( std::exception const& solvingError )
+      {
+        errorsPerScale[ scaleIndex ].assign( solvingError.what() );
+      }
+    }
+
+    // Now the solutions are appended in order of increasing scale, so that
+    // startingPoints does not depend on how the scales were shared out. The
+    // allowed length ranges of neighbouring scales overlap, so a solution
+    // which was also found at the next-lowest scale is left out.
+    for( size_t scaleIndex( 0 );
+         scaleIndex < numberOfSolvedScales;
+         ++scaleIndex )
+    {
+      if( !(errorsPerScale[ scaleIndex ].empty()) )
+      {
+        throw std::runtime_error( errorsPerScale[ scaleIndex ] );
+      }
+      for( std::vector< std::vector< double > >::const_iterator
+           scaleSolution( solutionsPerScale[ scaleIndex ].begin() );
+           scaleSolution != solutionsPerScale[ scaleIndex ].end();
+           ++scaleSolution )
+      {
+        if( ( scaleIndex == 0 )
+            ||
+            !(IsDuplicateOfNeighbouringSolution( *scaleSolution,
+                                       solutionsPerScale[ scaleIndex - 1 ] )) )
+        {
+          startingPoints.push_back( *scaleSolution );
+        }
+      }
     }
   }
 
@@ -184,8 +277,14 @@ namespace VevaciousPlusPlus
                            polynomialConstraints );
 
     // Now polynomialSystemSolver does its job.
-    (*polynomialSystemSolver)( polynomialConstraints,
-                               solutionSet );
+    {
+      PerformanceLogger::ScopedTimer
+      solverTimer( PerformanceRecord::PolynomialSystemSolverTimer );
+      PerformanceLogger::IncrementCounter(
+                                  PerformanceRecord::PolynomialSystemsSolved );
+      (*polynomialSystemSolver)( polynomialConstraints,
+                                 solutionSet );
+    }
 
     std::vector< std::vector< double > > solutionsInRange;
     for( std::vector< std::vector< double > >::const_iterator
@@ -220,6 +319,30 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This returns true if givenSolution is within a hypercube of side
+  // neighbouringScaleDuplicateFraction times the length of givenSolution of
+  // any of the solutions in neighbouringSolutions.
+  bool PolynomialAtFixedScalesSolver::IsDuplicateOfNeighbouringSolution(
+                                    std::vector< double > const& givenSolution,
+      std::vector< std::vector< double > > const& neighbouringSolutions ) const
+  {
+    double const hypercubeSide( neighbouringScaleDuplicateFraction
+                   * sqrt( VectorUtilities::LengthSquared( givenSolution ) ) );
+    for( std::vector< std::vector< double > >::const_iterator
+         neighbouringSolution( neighbouringSolutions.begin() );
+         neighbouringSolution != neighbouringSolutions.end();
+         ++neighbouringSolution )
+    {
+      if( VectorUtilities::DifferenceIsWithinHypercube( givenSolution,
+                                                        *neighbouringSolution,
+                                                        hypercubeSide ) )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // This puts the polynomial constraint system for the given scale into
   // polynomialConstraints.
   void PolynomialAtFixedScalesSolver::PolynomialConstraints(
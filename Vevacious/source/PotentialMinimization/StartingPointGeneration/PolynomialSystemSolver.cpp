@@ -25,9 +25,10 @@ namespace VevaciousPlusPlus
   // resolutionSize either side of givenSolution in the field appropriate to
   // the constraint, and returns false if any of the constraints do not change
   // sign in stepping from one side of givenSolution to the other in any of the
-  // fields.
+  // fields. Each element of givenSolution is restored to its original value
+  // after being stepped, so givenSolution is unchanged when this returns.
   bool PolynomialSystemSolver::IsValidSolution(
-                                           std::vector< double > givenSolution,
+                                          std::vector< double >& givenSolution,
                       std::vector< PolynomialConstraint > const& systemToSolve,
                                                 double const resolutionSize )
   {
@@ -46,6 +47,7 @@ namespace VevaciousPlusPlus
       givenSolution[ fieldIndex ] = ( originalValue + resolutionSize );
       positivePartialSlope = PartialSlope( systemToSolve[ fieldIndex ],
                                            givenSolution );
+      givenSolution[ fieldIndex ] = originalValue;
 
       if( ( ( positivePartialSlope > 0.0 )
             &&
@@ -57,7 +59,6 @@ namespace VevaciousPlusPlus
       {
         return false;
       }
-      givenSolution[ fieldIndex ] = originalValue;
     }
     return true;
   }
@@ -66,7 +67,7 @@ namespace VevaciousPlusPlus
   // fieldConfiguration.
   double PolynomialSystemSolver::PartialSlope(
                                    PolynomialConstraint const& fieldConstraint,
-                                     std::vector< double > fieldConfiguration )
+                              std::vector< double > const& fieldConfiguration )
   {
     double partialSlope( 0.0 );
     double polynomialValue( 0.0 );
@@ -81,7 +81,8 @@ namespace VevaciousPlusPlus
                          survivalProbabilityThreshold ),
     temperatureAccuracy( temperatureAccuracy ),
     vacuumSeparationFractionSquared( vacuumSeparationFraction
-                                     * vacuumSeparationFraction )
+                                     * vacuumSeparationFraction ),
+    bubbleProfileCache()
   {
     // This constructor is just an initialization list.
   }
@@ -117,8 +118,11 @@ namespace VevaciousPlusPlus
     // First we set all variables to their "not calculated" values.
     quantumSurvivalProbability = -1.0;
     quantumLifetimeInSeconds = -1.0;
+    quantumBounceAction = -1.0;
     thermalSurvivalProbability = -1.0;
     dominantTemperatureInGigaElectronVolts = -1.0;
+    bubbleProfileCacheHits = -1;
+    bubbleProfileCacheMisses = -1;
 
     if( tunnelingStrategy == NoTunneling )
     {
@@ -129,6 +133,9 @@ namespace VevaciousPlusPlus
 
       return;
     }
+    // The profiles of the last parameter point are not valid for this one.
+    bubbleProfileCache.Clear();
+    bubbleProfileCache.ResetCounters();
     PrepareCommonExtras( potentialFunction );
     if( tunnelingStrategy == JustQuantum )
     {
@@ -174,6 +181,11 @@ namespace VevaciousPlusPlus
       << " \"NoTunneling\"!";
       std::cout << std::endl;
     }
+    if( bubbleProfileCache.IsTurnedOn() )
+    {
+      bubbleProfileCacheHits = bubbleProfileCache.NumberOfHits();
+      bubbleProfileCacheMisses = bubbleProfileCache.NumberOfMisses();
+    }
   }
 
   // This sets quantumSurvivalProbability and quantumLifetimeInSeconds
@@ -187,6 +199,7 @@ namespace VevaciousPlusPlus
                                         falseVacuum,
                                         trueVacuum,
                                         0.0 ) );
+    quantumBounceAction = quantumAction;
     double const fourthRootOfSolitonicFactor( sqrt(
                 potentialFunction.ScaleSquaredRelevantToTunneling( falseVacuum,
                                                               trueVacuum ) ) );
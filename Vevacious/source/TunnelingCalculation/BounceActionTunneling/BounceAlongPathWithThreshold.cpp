@@ -19,16 +19,21 @@ namespace VevaciousPlusPlus
                                         unsigned int const temperatureAccuracy,
                                     unsigned int const pathPotentialResolution,
                                     unsigned int const pathFindingTimeout,
-                                      double const vacuumSeparationFraction ) :
+                                        double const vacuumSeparationFraction,
+                                      unsigned int const initialPathResolution,
+                                      double const pathPotentialTolerance ) :
     BounceActionTunneler( tunnelingStrategy,
                           survivalProbabilityThreshold,
                           temperatureAccuracy,
                           vacuumSeparationFraction ),
     pathFinders( std::move(pathFinders) ),
     actionCalculator( std::move(actionCalculator) ),
+    additionalChains(),
     thermalIntegrationResolution( thermalIntegrationResolution ),
     pathPotentialResolution( pathPotentialResolution ),
-    pathFindingTimeout( pathFindingTimeout )
+    pathFindingTimeout( pathFindingTimeout ),
+    initialPathResolution( initialPathResolution ),
+    pathPotentialTolerance( pathPotentialTolerance )
   {
     // This constructor is just an initialization list.
   }
@@ -37,12 +42,31 @@ namespace VevaciousPlusPlus
   {
   }
 
+  // This adds another set of path finders and another action calculator,
+  // each set being used by a single thread at a time, so that the bounce
+  // actions for one more temperature can be calculated at the same time in
+  // ContinueThermalTunneling. The path finders and the action calculator keep
+  // state from call to call, so they cannot be shared between threads.
+  void BounceAlongPathWithThreshold::AddConcurrentPathFindingChain(
+                  std::vector< std::unique_ptr<BouncePathFinder> > pathFinders,
+                     std::unique_ptr<BounceActionCalculator> actionCalculator )
+  {
+    additionalChains.push_back( PathFindingChain() );
+    additionalChains.back().pathFinders = std::move(pathFinders);
+    additionalChains.back().actionCalculator = std::move(actionCalculator);
+  }
+
 
   // This sets thermalSurvivalProbability by numerically integrating up to the
   // critical temperature for tunneling to be possible from T = 0 unless the
   // integral already passes a threshold, and sets
   // dominantTemperatureInGigaElectronVolts to be the temperature with the
-  // lowest survival probability.
+  // lowest survival probability. The thermal vacua are tracked from each
+  // temperature to the next first, then the bounce actions for the
+  // temperatures are shared out among the threads which have their own
+  // path-finding chains, and any temperatures which are still running or
+  // waiting once the decay width summed in order of temperature passes the
+  // threshold are abandoned.
   void BounceAlongPathWithThreshold::ContinueThermalTunneling(
                                     PotentialFunction const& potentialFunction,
                                            PotentialMinimum const& falseVacuum,
@@ -55,12 +79,6 @@ namespace VevaciousPlusPlus
     double const thresholdSeparationSquared( vacuumSeparationFractionSquared
                                 * falseVacuum.SquareDistanceTo( trueVacuum ));
 
-    // We sum up decay widths over increasing temperatures.
-    double partialDecayWidth( 0.0 );
-    // The partial decay width scaled by the volume of the observable Universe
-    // is recorded in partialDecayWidth so that the bounce action threshold for
-    // each temperature can be calculated taking into account the contributions
-    // from higher temperatures.
     double const temperatureStep( rangeOfMaxTemperatureForOriginToTrue.first
                  / static_cast< double >( thermalIntegrationResolution + 1 ) );
     double currentTemperature( 0.0 );
@@ -71,9 +89,13 @@ namespace VevaciousPlusPlus
     double const thresholdDecayWidth( -log( survivalProbabilityThreshold )
                  / ( temperatureStep * exp( lnOfThermalIntegrationFactor ) ) );
 
-    double smallestExponent( maximumPowerOfNaturalExponent );
-    dominantTemperatureInGigaElectronVolts = 0.0;
-
+    // The minimizations of the thermal vacua are much quicker than the bounce
+    // actions, but each starts from the vacua of the last temperature, so
+    // they are all done in order first, keeping the temperatures which have
+    // vacua suitable for a tunneling calculation.
+    std::vector< double > tunnelingTemperatures;
+    std::vector< PotentialMinimum > thermalFalseVacua;
+    std::vector< PotentialMinimum > thermalTrueVacua;
     for( unsigned int whichStep( 0 );
          whichStep < thermalIntegrationResolution;
          ++whichStep )
@@ -127,41 +149,152 @@ namespace VevaciousPlusPlus
         WarningLogger::LogWarning( warningBuilder.str() );
         break;
       }
+      tunnelingTemperatures.push_back( currentTemperature );
+      thermalFalseVacua.push_back( thermalFalseVacuum );
+      thermalTrueVacua.push_back( thermalTrueVacuum );
+    }
+
+    // We sum up decay widths over increasing temperatures.
+    double partialDecayWidth( 0.0 );
+    // The partial decay width scaled by the volume of the observable Universe
+    // is recorded in partialDecayWidth. The bounce actions are only summed in
+    // order of temperature, as soon as all the lower temperatures have been
+    // summed, so that the sum stops at the same temperature as it would if
+    // the temperatures were done one at a time. The bounce action threshold
+    // for each temperature depends only on the temperature and
+    // thresholdDecayWidth, not on how much of the sum the other threads have
+    // done, so that the actions do not depend on the order in which the
+    // threads happen to finish. An action cut off below this threshold
+    // contributes more than thresholdDecayWidth on its own, so the sum passes
+    // the threshold at that temperature at the latest, just as it would have
+    // with a threshold lowered by the contributions of lower temperatures.
+    size_t const numberOfTemperatures( tunnelingTemperatures.size() );
+    std::vector< double > bouncesOverTemperatures( numberOfTemperatures,
+                                               maximumPowerOfNaturalExponent );
+    std::vector< bool > temperatureIsDone( numberOfTemperatures,
+                                           false );
+    size_t numberOfSummedTemperatures( 0 );
+    std::atomic< bool > thresholdIsPassed( false );
+
+    double smallestExponent( maximumPowerOfNaturalExponent );
+    dominantTemperatureInGigaElectronVolts = 0.0;
 
-      double const actionThreshold( -currentTemperature
-                                    * log( currentTemperature
-                                           * currentTemperature
-                                           * ( thresholdDecayWidth
-                                               - partialDecayWidth ) ) );
-      double const
-      bounceOverTemperature( BoundedBounceAction( potentialFunction,
-                                                  thermalFalseVacuum,
-                                                  thermalTrueVacuum,
-                                                  currentTemperature,
-                                                  actionThreshold,
-                                                  thresholdSeparationSquared )
-                             / currentTemperature );
-
-      if( bounceOverTemperature < maximumPowerOfNaturalExponent )
+    // Each thread needs its own chain of path finders and action calculator,
+    // so there cannot be more threads than chains. The path finders and
+    // action calculators keep state from one temperature to the next to
+    // start their searches, so each chain is given a fixed set of
+    // temperatures, every numberOfChains-th one, which it does in increasing
+    // order, so that the actions do not depend on which thread happens to
+    // be free first.
+    size_t const numberOfChains( additionalChains.size() + 1 );
+    int threadsToUse( static_cast< int >( numberOfChains ) );
+    // Exceptions cannot propagate out of an OpenMP region, so each temperature
+    // notes any error message and the first is thrown once all the threads
+    // have finished.
+    std::vector< std::string > temperatureErrors( numberOfTemperatures );
+#pragma omp parallel for schedule( static, 1 ) num_threads( threadsToUse )
+    for( size_t chainIndex = 0;
+         chainIndex < numberOfChains;
+         ++chainIndex )
+    {
+      std::vector< std::unique_ptr<BouncePathFinder> > const*
+      chainPathFinders( &pathFinders );
+      BounceActionCalculator* chainCalculator( actionCalculator.get() );
+      if( chainIndex > 0 )
       {
-        partialDecayWidth += ( exp( -bounceOverTemperature )
-                               / ( currentTemperature * currentTemperature ) );
+        chainPathFinders = &(additionalChains[ chainIndex - 1 ].pathFinders);
+        chainCalculator
+        = additionalChains[ chainIndex - 1 ].actionCalculator.get();
       }
-      if( bounceOverTemperature < smallestExponent )
+      for( size_t temperatureIndex( chainIndex );
+           temperatureIndex < numberOfTemperatures;
+           temperatureIndex += numberOfChains )
       {
-        smallestExponent = bounceOverTemperature;
-        dominantTemperatureInGigaElectronVolts = currentTemperature;
+        if( thresholdIsPassed )
+        {
+          break;
+        }
+        try
+        {
+          double const
+          tunnelingTemperature( tunnelingTemperatures[ temperatureIndex ] );
+          double const actionThreshold( -tunnelingTemperature
+                                        * log( tunnelingTemperature
+                                               * tunnelingTemperature
+                                               * thresholdDecayWidth ) );
+          double const
+          bounceOverTemperature( ChainBoundedBounceAction( potentialFunction,
+                                        thermalFalseVacua[ temperatureIndex ],
+                                         thermalTrueVacua[ temperatureIndex ],
+                                                         tunnelingTemperature,
+                                                         actionThreshold,
+                                                    thresholdSeparationSquared,
+                                                         *chainPathFinders,
+                                                         *chainCalculator,
+                                                          &thresholdIsPassed )
+                                 / tunnelingTemperature );
+
+#pragma omp critical( ThermalDecayWidthSum )
+          {
+            bouncesOverTemperatures[ temperatureIndex ] = bounceOverTemperature;
+            temperatureIsDone[ temperatureIndex ] = true;
+            while( !thresholdIsPassed
+                   &&
+                   ( numberOfSummedTemperatures < numberOfTemperatures )
+                   &&
+                   temperatureIsDone[ numberOfSummedTemperatures ] )
+            {
+              size_t const summedIndex( numberOfSummedTemperatures );
+              double const
+              summedBounce( bouncesOverTemperatures[ summedIndex ] );
+              double const
+              summedTemperature( tunnelingTemperatures[ summedIndex ] );
+              if( summedBounce < maximumPowerOfNaturalExponent )
+              {
+                partialDecayWidth += ( exp( -summedBounce )
+                                  / ( summedTemperature * summedTemperature ) );
+              }
+              if( summedBounce < smallestExponent )
+              {
+                smallestExponent = summedBounce;
+                dominantTemperatureInGigaElectronVolts = summedTemperature;
+              }
+              ++numberOfSummedTemperatures;
+
+              if( partialDecayWidth > thresholdDecayWidth )
+              {
+                // We don't bother calculating the rest of the contributions to
+                // the integral of the decay width if it is already large enough
+                // that the survival probability is below the threshold, so any
+                // temperatures still being calculated are abandoned.
+                thresholdIsPassed = true;
+              }
+            }
+          }
+        }
+        catch( std::exception const& caughtException )
+        {
+          temperatureErrors[ temperatureIndex ] = caughtException.what();
+        }
       }
-
-      if( partialDecayWidth > thresholdDecayWidth )
+    }
+    // Errors from temperatures which were abandoned once the threshold was
+    // passed do not matter, while any other error stops the sum at its
+    // temperature, so the first error is thrown.
+    if( !thresholdIsPassed )
+    {
+      for( std::vector< std::string >::const_iterator
+           temperatureError( temperatureErrors.begin() );
+           temperatureError < temperatureErrors.end();
+           ++temperatureError )
       {
-        // We don't bother calculating the rest of the contributions to the
-        // integral of the decay width if it is already large enough that the
-        // survival probability is below the threshold.
-        break;
+        if( !(temperatureError->empty()) )
+        {
+          throw std::runtime_error( *temperatureError );
+        }
       }
-
     }
+
     if( partialDecayWidth > 0.0 )
     {
       logOfMinusLogOfThermalProbability = ( lnOfThermalIntegrationFactor
@@ -182,21 +315,27 @@ namespace VevaciousPlusPlus
     SetThermalSurvivalProbability();
   }
 
-  // This returns either the dimensionless bounce action integrated over four
-  // dimensions (for zero temperature) or the dimensionful bounce action
-  // integrated over three dimensions (for non-zero temperature) for tunneling
-  // from falseVacuum to trueVacuum at temperature tunnelingTemperature, or an
-  // upper bound if the upper bound drops below actionThreshold during the
-  // course of the calculation. The vacua are assumed to already be the minima
-  // at tunnelingTemperature.
-  double BounceAlongPathWithThreshold::BoundedBounceAction(
+  // This does the work of BoundedBounceAction using chainPathFinders and
+  // chainCalculator rather than pathFinders and actionCalculator. If
+  // cancellationFlag is not NULL, it is checked before each new path is tried,
+  // and if it has been set, the lowest action so far is returned straight
+  // away, as it is no longer needed.
+  double BounceAlongPathWithThreshold::ChainBoundedBounceAction(
                                     PotentialFunction const& potentialFunction,
                                            PotentialMinimum const& falseVacuum,
                                             PotentialMinimum const& trueVacuum,
                                              double const tunnelingTemperature,
                                                   double const actionThreshold,
-                                 double const requiredVacuumSeparationSquared )
+                                  double const requiredVacuumSeparationSquared,
+      std::vector< std::unique_ptr<BouncePathFinder> > const& chainPathFinders,
+                                       BounceActionCalculator& chainCalculator,
+                            std::atomic< bool > const* const cancellationFlag )
   {
+    PerformanceLogger::ScopedTimer
+    bounceActionTimer( PerformanceRecord::BounceActionTimer );
+    PerformanceLogger::IncrementCounter(
+                                 PerformanceRecord::BounceActionCalculations );
+    unsigned int pathFinderIterations( 0 );
     std::vector< std::vector< double > > straightPath( 2,
                                             falseVacuum.FieldConfiguration() );
     straightPath.back() = trueVacuum.FieldConfiguration();
@@ -204,29 +343,33 @@ namespace VevaciousPlusPlus
                                                     std::vector< double >( 0 ),
                                                       tunnelingTemperature ) );
 
-    actionCalculator->ResetVacua( potentialFunction,
-                                  falseVacuum,
-                                  trueVacuum,
-                                  tunnelingTemperature );
-
-    SplinePotential pathPotential( potentialFunction,
+    chainCalculator.ResetVacua( potentialFunction,
+                                falseVacuum,
+                                trueVacuum,
+                                tunnelingTemperature );
+
+    // The bubble profiles are shared with bubbleProfileCache, so they are
+    // only deleted once neither this function nor the cache needs them.
+    std::shared_ptr< BubbleProfile const >
+    bestBubble( CachedOrNewBubble( potentialFunction,
+                                   falseVacuum,
+                                   trueVacuum,
                                    *bestPath,
-                                   pathPotentialResolution,
-                                   requiredVacuumSeparationSquared );
+                                   requiredVacuumSeparationSquared,
+                                   chainCalculator,
+                                   true ) );
 
-    if( !(pathPotential.EnergyBarrierWasResolved()) )
+    if( !bestBubble )
     {
       std::stringstream warningBuilder;
       warningBuilder << "Unable to resolve an energy barrier between false"
       << " vacuum and true vacuum: returning bounce action of zero (which"
       << " should be sufficient to exclude the parameter point).";
       WarningLogger::LogWarning( warningBuilder.str() );
+      delete bestPath;
       return 0.0;
     }
 
-    BubbleProfile const* bestBubble( (*actionCalculator)( *bestPath,
-                                                          pathPotential ) );
-
     std::cout << std::endl
     << "Initial path bounce action = " << bestBubble->BounceAction();
     if( bestPath->NonZeroTemperature() )
@@ -250,8 +393,10 @@ namespace VevaciousPlusPlus
               << "Bounce action dropped below threshold, breaking off from looking"
               << " for further path improvements.";
       std::cout << std::endl;
+      PerformanceLogger::AddToHistogram(
+                        PerformanceRecord::PathFinderIterationsPerBounceAction,
+                                         pathFinderIterations );
       double const bounceAction( bestBubble->BounceAction() );
-      delete bestBubble;
       delete bestPath;
       return bounceAction;
     }
@@ -262,10 +407,15 @@ namespace VevaciousPlusPlus
     // Setting the starting time of the path finding
     time( &pathFindingStartTime );
 
-    for( auto pathFinder( pathFinders.begin() );
-         pathFinder < pathFinders.end();
+    for( auto pathFinder( chainPathFinders.begin() );
+         pathFinder < chainPathFinders.end();
          ++pathFinder )
     {
+      if( ( cancellationFlag != NULL ) && *cancellationFlag )
+      {
+        break;
+      }
+
       time(&currentTime);
 
       if (difftime( currentTime, pathFindingStartTime ) > pathFindingTimeout )
@@ -285,7 +435,7 @@ namespace VevaciousPlusPlus
                                                          trueVacuum,
                                                         tunnelingTemperature );
       TunnelPath const* currentPath( bestPath );
-      BubbleProfile const* currentBubble( bestBubble );
+      std::shared_ptr< BubbleProfile const > currentBubble( bestBubble );
 
       // The paths produced in sequence by pathFinder are kept separate from
       // bestPath to give more freedom to pathFinder internally (though I
@@ -294,16 +444,15 @@ namespace VevaciousPlusPlus
       // a local minimum, which wouldn't work if it was sent back to the local
       // minimum at each step).
 
-      // Keeping track of a best path and bubble separately from the last-used
-      // path and bubble without copying any instances requires a bit of
-      // book-keeping. Each iteration of the loop below will produce new
-      // instances of a path and a bubble, and either the new path and bubble
-      // need to be deleted or the previous best need to be deleted. These two
-      // pointers keep track of which is to be deleted. They start as NULL,
-      // allowing the first iteration to delete them before any path has been
-      // marked for deletion.
+      // Keeping track of a best path separately from the last-used path
+      // without copying any instances requires a bit of book-keeping. Each
+      // iteration of the loop below will produce a new instance of a path,
+      // and either the new path needs to be deleted or the previous best
+      // needs to be deleted. This pointer keeps track of which is to be
+      // deleted. It starts as NULL, allowing the first iteration to delete it
+      // before any path has been marked for deletion. The bubbles are shared
+      // pointers so they look after themselves.
       TunnelPath const* pathDeleter( NULL );
-      BubbleProfile const* bubbleDeleter( NULL );
 
       // This loop will get a path from pathFinder and then repeat if
       // pathFinder decides that the path can be improved once the bubble
@@ -315,6 +464,11 @@ namespace VevaciousPlusPlus
         // The nextPath and nextBubble pointers are not strictly necessary,
         // but they make the logic of the code clearer and will probably be
         // optimized away by the compiler anyway.
+        if( ( cancellationFlag != NULL ) && *cancellationFlag )
+        {
+          break;
+        }
+
         time(&currentTime);
 
         if (difftime( currentTime, pathFindingStartTime ) > pathFindingTimeout ) // HERE THE CUTOFF IS SET, MAKE A VARIABLE IN INPUT
@@ -328,20 +482,23 @@ namespace VevaciousPlusPlus
         TunnelPath const*
         nextPath( (*pathFinder)->TryToImprovePath( *currentPath,
                                                    *currentBubble ) );
-
-        SplinePotential potentialApproximation( potentialFunction,
-                                                *nextPath,
-                                                pathPotentialResolution,
-                                             requiredVacuumSeparationSquared );
-
-        BubbleProfile const* nextBubble( (*actionCalculator)( *nextPath,
-                                                    potentialApproximation ) );
-
-        // On the first iteration of the loop, these pointers are NULL, so
-        // it's no problem to delete them. On subsequent iterations, they point
-        // at the higher-action path and bubble from the last iterations
-        // comparison between its nextPath and bestPath.
-        delete bubbleDeleter;
+        ++pathFinderIterations;
+        PerformanceLogger::IncrementCounter(
+                                     PerformanceRecord::PathFinderIterations );
+
+        std::shared_ptr< BubbleProfile const >
+        nextBubble( CachedOrNewBubble( potentialFunction,
+                                       falseVacuum,
+                                       trueVacuum,
+                                       *nextPath,
+                                       requiredVacuumSeparationSquared,
+                                       chainCalculator,
+                                       false ) );
+
+        // On the first iteration of the loop, this pointer is NULL, so it's
+        // no problem to delete it. On subsequent iterations, it points at the
+        // higher-action path from the last iteration's comparison between its
+        // nextPath and bestPath.
         delete pathDeleter;
 
         if( nextBubble->BounceAction() < bestBubble->BounceAction() )
@@ -349,20 +506,18 @@ namespace VevaciousPlusPlus
           // If nextBubble was an improvement on bestBubble, what bestPath
           // currently points at gets marked for deletion either on the next
           // iteration of this loop or just after the loop, and then bestPath
-          // is set to point at nextPath, with the corresponding operations for
-          // the bubble pointers.
-          bubbleDeleter = bestBubble;
+          // is set to point at nextPath, with bestBubble replaced by
+          // nextBubble.
           bestBubble = nextBubble;
           pathDeleter = bestPath;
           bestPath = nextPath;
         }
         else
         {
-          // If nextBubble wasn't an improvement on bestBubble, it and nextPath
-          // will be deleted after being used to generate the nextPath and
+          // If nextBubble wasn't an improvement on bestBubble, nextPath will
+          // be deleted after being used to generate the nextPath and
           // nextBubble of the next iteration of the loop (or after the loop if
-          // this ends up being the last iteration) through these pointers.
-          bubbleDeleter = nextBubble;
+          // this ends up being the last iteration) through this pointer.
           pathDeleter = nextPath;
         }
         currentBubble = nextBubble;
@@ -390,9 +545,8 @@ namespace VevaciousPlusPlus
       } while( ( bestBubble->BounceAction() > actionThreshold )
                &&
                (*pathFinder)->PathCanBeImproved( *currentBubble ) );
-      // At the end of the loop, these point at the last tried path and bubble
-      // which did not end up as the best ones, so deleting them is no problem.
-      delete bubbleDeleter;
+      // At the end of the loop, this points at the last tried path which did
+      // not end up as the best one, so deleting it is no problem.
       delete pathDeleter;
 
       // We don't bother with the rest of the path finders if the action has
@@ -424,8 +578,10 @@ namespace VevaciousPlusPlus
     std::cout << ".";
     std::cout << std::endl;
 
+    PerformanceLogger::AddToHistogram(
+                        PerformanceRecord::PathFinderIterationsPerBounceAction,
+                                       pathFinderIterations );
     double const bounceAction( bestBubble->BounceAction() );
-    delete bestBubble;
     delete bestPath;
     return bounceAction;
   }
@@ -9,9 +9,6 @@
 
 namespace VevaciousPlusPlus
 {
-  std::string
-  CosmoTransitionsRunner::pythonPotentialFilenameBase( "VevaciousPotential" );
-
   CosmoTransitionsRunner::CosmoTransitionsRunner(
                 TunnelingCalculator::TunnelingStrategy const tunnelingStrategy,
                                      double const survivalProbabilityThreshold,
@@ -26,6 +23,8 @@ namespace VevaciousPlusPlus
                           survivalProbabilityThreshold,
                           temperatureAccuracy,
                           vacuumSeparationFraction ),
+    uniqueFilenameTag( UniqueFilenameTag() ),
+    pythonPotentialFilenameBase( "VevaciousPotential" + uniqueFilenameTag ),
     pathToCosmotransitions( pathToCosmotransitions ),
     resolutionOfDsbVacuum( resolutionOfDsbVacuum ),
     maxInnerLoops( maxInnerLoops ),
@@ -55,10 +54,10 @@ namespace VevaciousPlusPlus
                                         PotentialMinimum const& trueVacuum,
                                         double const tunnelingTemperature )
   {
-    std::string const
-    pythonResultFilename( "VevaciousCosmoTransitionsResult.txt" );
-    std::string const
-    pythonMainFilename( "VevaciousCosmoTransitionsRunner.py" );
+    std::string const pythonResultFilename( "VevaciousCosmoTransitionsResult"
+                                            + uniqueFilenameTag + ".txt" );
+    std::string const pythonMainFilename( "VevaciousCosmoTransitionsRunner"
+                                          + uniqueFilenameTag + ".py" );
     std::string systemCommand( "rm " );
     systemCommand.append( pythonMainFilename );
     systemCommand.append( "c" );
@@ -331,7 +330,9 @@ namespace VevaciousPlusPlus
     straightPathActions.clear();
     BubbleShootingOnPathInFieldSpace
     actionCalculator( ( 1.0 / static_cast< double >( resolutionOfDsbVacuum ) ),
-                      32 );
+                      32,
+                      UndershootOvershootBubble::OdeintDefault,
+                      1.0e-6 );
     // The number of shoot attempts doesn't need to be fixed at 32, but it is
     // unlikely that anyone will ever want to change it.
     PotentialMinimum thermalFalseVacuum( falseVacuum );
@@ -365,18 +366,30 @@ namespace VevaciousPlusPlus
       LinearSplineThroughNodes straightSplinePath( straightPath,
                                                    std::vector< double >( 0 ),
                                                    *fitTemperature );
-      SplinePotential potentialApproximation( potentialFunction,
-                                              straightSplinePath,
-                                              resolutionOfDsbVacuum,
-                                              thresholdSeparationSquared );
-      actionCalculator.ResetVacua( potentialFunction,
-                                   thermalFalseVacuum,
-                                   thermalTrueVacuum,
-                                   *fitTemperature );
-      BubbleProfile* bubbleProfile( actionCalculator( straightSplinePath,
+      BubbleProfileCache::CacheKey const
+      cacheKey( bubbleProfileCache.Key( thermalFalseVacuum,
+                                        thermalTrueVacuum,
+                                        straightSplinePath ) );
+      std::shared_ptr< BubbleProfile const >
+      bubbleProfile( bubbleProfileCache.Find( cacheKey ) );
+      if( !bubbleProfile )
+      {
+        SplinePotential potentialApproximation( potentialFunction,
+                                                straightSplinePath,
+                                                resolutionOfDsbVacuum,
+                                                thresholdSeparationSquared );
+        actionCalculator.ResetVacua( potentialFunction,
+                                     thermalFalseVacuum,
+                                     thermalTrueVacuum,
+                                     *fitTemperature );
+        // The cache detaches the profile from actionCalculator, so it can
+        // outlive actionCalculator.
+        bubbleProfile = bubbleProfileCache.Insert( cacheKey,
+                                                 actionCalculator(
+                                                            straightSplinePath,
                                                     potentialApproximation ) );
+      }
       straightPathActions.push_back( bubbleProfile->BounceAction() );
-      delete bubbleProfile;
     }
   }
 
@@ -397,9 +410,11 @@ namespace VevaciousPlusPlus
                                 * falseVacuum.SquareDistanceTo( trueVacuum ) );
 
     std::string const
-    pythonResultFilename( "VevaciousCosmoTransitionsThermalFitResult.txt" );
+    pythonResultFilename( "VevaciousCosmoTransitionsThermalFitResult"
+                          + uniqueFilenameTag + ".txt" );
     std::string const
-    pythonMainFilename( "VevaciousCosmoTransitionsThermalFitter.py" );
+    pythonMainFilename( "VevaciousCosmoTransitionsThermalFitter"
+                        + uniqueFilenameTag + ".py" );
     std::string systemCommand( "rm " );
     systemCommand.append( pythonMainFilename );
     systemCommand.append( "c" );
@@ -576,4 +591,14 @@ namespace VevaciousPlusPlus
     resultStream.close();
   }
 
+  // This returns a tag made from the process ID and a count of the calls to
+  // this function, which is valid as part of the name of a Python module.
+  std::string CosmoTransitionsRunner::UniqueFilenameTag()
+  {
+    static std::atomic< unsigned int > instanceCount( 0 );
+    std::stringstream tagBuilder;
+    tagBuilder << "_" << getpid() << "_" << instanceCount++;
+    return tagBuilder.str();
+  }
+
 } /* namespace VevaciousPlusPlus */
@@ -0,0 +1,470 @@
+/*
+ * PathDeformationTunneler.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "TunnelingCalculation/BounceActionTunneling/PathDeformationTunneler.hpp"
+
+namespace VevaciousPlusPlus
+{
+  double const PathDeformationTunneler::convergedForceRatio( 0.02 );
+  double const PathDeformationTunneler::gradientStepFraction( 1.0E-4 );
+
+  PathDeformationTunneler::PathDeformationTunneler(
+                TunnelingCalculator::TunnelingStrategy const tunnelingStrategy,
+                                     double const survivalProbabilityThreshold,
+                                        unsigned int const temperatureAccuracy,
+                                      unsigned int const resolutionOfDsbVacuum,
+                                              unsigned int const maxInnerLoops,
+                                              unsigned int const maxOuterLoops,
+                           unsigned int const thermalStraightPathFitResolution,
+                                      double const vacuumSeparationFraction ) :
+    CosmoTransitionsRunner( tunnelingStrategy,
+                            survivalProbabilityThreshold,
+                            temperatureAccuracy,
+                            "",
+                            resolutionOfDsbVacuum,
+                            maxInnerLoops,
+                            maxOuterLoops,
+                            thermalStraightPathFitResolution,
+                            vacuumSeparationFraction )
+  {
+    // This constructor is just an initialization list.
+  }
+
+  PathDeformationTunneler::~PathDeformationTunneler()
+  {
+    // This does nothing.
+  }
+
+
+  // This returns either the dimensionless bounce action integrated over four
+  // dimensions (for zero temperature) or the dimensionful bounce action
+  // integrated over three dimensions (for non-zero temperature) for
+  // tunneling from falseVacuum to trueVacuum at temperature
+  // tunnelingTemperature, as the lowest action along the paths from up to
+  // maxOuterLoops rounds of deformation of an initially straight path. The
+  // vacua are assumed to already be the minima at tunnelingTemperature.
+  double PathDeformationTunneler::BounceAction(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                            PotentialMinimum const& trueVacuum,
+                                            double const tunnelingTemperature )
+  {
+    double const
+    vacuumSeparationSquared( falseVacuum.SquareDistanceTo( trueVacuum ) );
+    double const requiredVacuumSeparationSquared(
+                   vacuumSeparationFractionSquared * vacuumSeparationSquared );
+    double const
+    gradientStep( gradientStepFraction * sqrt( vacuumSeparationSquared ) );
+
+    // The path starts as resolutionOfDsbVacuum evenly-spaced segments along
+    // the straight line between the vacua.
+    size_t const numberOfSegments( std::max( 2u,
+                                             resolutionOfDsbVacuum ) );
+    std::vector< double > const&
+    falseConfiguration( falseVacuum.FieldConfiguration() );
+    std::vector< double > const&
+    trueConfiguration( trueVacuum.FieldConfiguration() );
+    std::vector< std::vector< double > > pathNodes( numberOfSegments + 1,
+                                                    falseConfiguration );
+    for( size_t nodeIndex( 1 );
+         nodeIndex <= numberOfSegments;
+         ++nodeIndex )
+    {
+      double const nodeFraction( static_cast< double >( nodeIndex )
+                             / static_cast< double >( numberOfSegments ) );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < falseConfiguration.size();
+           ++fieldIndex )
+      {
+        pathNodes[ nodeIndex ][ fieldIndex ]
+        += ( nodeFraction * ( trueConfiguration[ fieldIndex ]
+                              - falseConfiguration[ fieldIndex ] ) );
+      }
+    }
+
+    // As in InteralGuessFromStraightPaths, the number of shoot attempts
+    // doesn't need to be fixed at 32, but it is unlikely that anyone will
+    // ever want to change it.
+    BubbleShootingOnPathInFieldSpace
+    actionCalculator( ( 1.0 / static_cast< double >( resolutionOfDsbVacuum ) ),
+                      32,
+                      UndershootOvershootBubble::OdeintDefault,
+                      1.0e-6 );
+    actionCalculator.ResetVacua( potentialFunction,
+                                 falseVacuum,
+                                 trueVacuum,
+                                 tunnelingTemperature );
+
+    double lowestAction( std::numeric_limits< double >::max() );
+    for( unsigned int outerLoop( 0 );
+         outerLoop <= maxOuterLoops;
+         ++outerLoop )
+    {
+      LinearSplineThroughNodes tunnelPath( pathNodes,
+                                           std::vector< double >( 0 ),
+                                           tunnelingTemperature );
+      // Only profiles for paths with resolved barriers are put in the cache,
+      // so the potential along the path only needs to be checked if the
+      // profile is not already in the cache.
+      BubbleProfileCache::CacheKey const
+      cacheKey( bubbleProfileCache.Key( falseVacuum,
+                                        trueVacuum,
+                                        tunnelPath ) );
+      std::shared_ptr< BubbleProfile const >
+      bubbleProfile( bubbleProfileCache.Find( cacheKey ) );
+      if( !bubbleProfile )
+      {
+        SplinePotential pathPotential( potentialFunction,
+                                       tunnelPath,
+                                       resolutionOfDsbVacuum,
+                                       requiredVacuumSeparationSquared );
+        if( !(pathPotential.EnergyBarrierWasResolved()) )
+        {
+          if( outerLoop == 0 )
+          {
+            std::stringstream warningBuilder;
+            warningBuilder << "Unable to resolve an energy barrier between"
+            << " false vacuum and true vacuum: returning bounce action of zero"
+            << " (which should be sufficient to exclude the parameter point).";
+            WarningLogger::LogWarning( warningBuilder.str() );
+            return 0.0;
+          }
+          // If a deformation has lost the barrier, the lowest action from the
+          // paths before it is kept.
+          break;
+        }
+        bubbleProfile = bubbleProfileCache.Insert( cacheKey,
+                                                 actionCalculator( tunnelPath,
+                                                           pathPotential ) );
+      }
+      if( bubbleProfile->BounceAction() < lowestAction )
+      {
+        lowestAction = bubbleProfile->BounceAction();
+      }
+      if( ( outerLoop == maxOuterLoops )
+          ||
+          DeformPath( potentialFunction,
+                      tunnelingTemperature,
+                      gradientStep,
+                      tunnelPath,
+                      *bubbleProfile,
+                      pathNodes ) )
+      {
+        break;
+      }
+    }
+
+    std::cout << std::endl << "Path deformation calculated an action of "
+    << lowestAction;
+    if( tunnelingTemperature > 0.0 )
+    {
+      std::cout << " GeV";
+    }
+    std::cout << "." << std::endl;
+
+    return lowestAction;
+  }
+
+  // This moves the nodes of pathNodes (apart from the ends) along the normal
+  // forces on them up to maxInnerLoops times, with the speed of the fields at
+  // each node taken from bubbleProfile along tunnelPath, which should go
+  // through pathNodes. The gradients of the potential at all the nodes are
+  // evaluated together by SetNodeGradients for each inner loop. It then
+  // spaces the nodes evenly along the deformed path again. It returns true
+  // without moving the nodes if the normal forces were already small enough
+  // for the path to have converged.
+  bool PathDeformationTunneler::DeformPath(
+                                    PotentialFunction const& potentialFunction,
+                                             double const tunnelingTemperature,
+                                                     double const gradientStep,
+                                   LinearSplineThroughNodes const& tunnelPath,
+                                            BubbleProfile const& bubbleProfile,
+                      std::vector< std::vector< double > >& pathNodes ) const
+  {
+    size_t const numberOfSegments( pathNodes.size() - 1 );
+    size_t const numberOfFields( pathNodes.front().size() );
+    double const
+    nodeSpacing( 1.0 / static_cast< double >( numberOfSegments ) );
+
+    // The speeds of the fields at the nodes are kept fixed over the inner
+    // loops, as CosmoTransitions does, as the bubble profile is only
+    // recalculated in the outer loop.
+    std::vector< double > fieldSpeedsSquared( pathNodes.size(),
+                                              0.0 );
+    for( size_t nodeIndex( 1 );
+         nodeIndex < numberOfSegments;
+         ++nodeIndex )
+    {
+      fieldSpeedsSquared[ nodeIndex ] = FieldSpeedSquared( bubbleProfile,
+                                                           tunnelPath,
+                                                ( nodeIndex * nodeSpacing ) );
+    }
+
+    // Each step moves the node with the largest normal force by
+    // maximumStep, which starts at a tenth of the spacing of the nodes, and
+    // which grows while the forces shrink and shrinks otherwise.
+    double maximumStep( 0.1 * nodeSpacing * sqrt( tunnelPath.SlopeSquared(
+                                                                   0.0 ) ) );
+    double lastForceRatio( std::numeric_limits< double >::max() );
+    std::vector< Eigen::VectorXd >
+    normalForces( pathNodes.size(),
+                  Eigen::VectorXd::Zero( numberOfFields ) );
+    std::vector< std::vector< double > >
+    nodeGradients( pathNodes.size(),
+                   std::vector< double >( numberOfFields ) );
+    for( unsigned int innerLoop( 0 );
+         innerLoop < std::max( 1u,
+                               maxInnerLoops );
+         ++innerLoop )
+    {
+      SetNodeGradients( potentialFunction,
+                        tunnelingTemperature,
+                        gradientStep,
+                        pathNodes,
+                        nodeGradients );
+      double largestForce( 0.0 );
+      double largestGradient( 0.0 );
+      for( size_t nodeIndex( 1 );
+           nodeIndex < numberOfSegments;
+           ++nodeIndex )
+      {
+        double const gradientLength( NormalForce( pathNodes,
+                                                  nodeIndex,
+                                                  nodeGradients[ nodeIndex ],
+                                              fieldSpeedsSquared[ nodeIndex ],
+                                              normalForces[ nodeIndex ] ) );
+        largestForce = std::max( largestForce,
+                                 normalForces[ nodeIndex ].norm() );
+        largestGradient = std::max( largestGradient,
+                                    gradientLength );
+      }
+      double const forceRatio( ( largestGradient > 0.0 ) ?
+                               ( largestForce / largestGradient ) :
+                               0.0 );
+      if( forceRatio < convergedForceRatio )
+      {
+        if( innerLoop == 0 )
+        {
+          return true;
+        }
+        break;
+      }
+      if( innerLoop > 0 )
+      {
+        maximumStep *= ( ( forceRatio < lastForceRatio ) ? 1.5 : 0.5 );
+      }
+      lastForceRatio = forceRatio;
+      double const stepPerForce( maximumStep / largestForce );
+      for( size_t nodeIndex( 1 );
+           nodeIndex < numberOfSegments;
+           ++nodeIndex )
+      {
+        Eigen::Map< Eigen::VectorXd >( pathNodes[ nodeIndex ].data(),
+                                       numberOfFields )
+        -= ( stepPerForce * normalForces[ nodeIndex ] );
+      }
+    }
+
+    // The nodes are put back at even spacing along the deformed path as a
+    // single batch.
+    LinearSplineThroughNodes deformedPath( pathNodes,
+                                           std::vector< double >( 0 ),
+                                           tunnelingTemperature );
+    std::vector< double > nodeAuxiliaries( numberOfSegments - 1 );
+    for( size_t nodeIndex( 1 );
+         nodeIndex < numberOfSegments;
+         ++nodeIndex )
+    {
+      nodeAuxiliaries[ nodeIndex - 1 ] = ( nodeIndex * nodeSpacing );
+    }
+    std::vector< double > nodeConfigurations;
+    deformedPath.PutOnPathAt( nodeConfigurations,
+                              nodeAuxiliaries );
+    for( size_t nodeIndex( 1 );
+         nodeIndex < numberOfSegments;
+         ++nodeIndex )
+    {
+      std::vector< double >::const_iterator const
+      configurationStart( nodeConfigurations.begin()
+                          + ( ( nodeIndex - 1 ) * numberOfFields ) );
+      pathNodes[ nodeIndex ].assign( configurationStart,
+                                     ( configurationStart + numberOfFields ) );
+    }
+    return false;
+  }
+
+  // This returns the square of the speed of the fields with respect to the
+  // radial variable in bubbleProfile at the point where the path auxiliary is
+  // auxiliaryValue, found by bisection assuming that the path auxiliary
+  // decreases with increasing radial value. It returns 0 for values of the
+  // path auxiliary beyond the center of the bubble.
+  double PathDeformationTunneler::FieldSpeedSquared(
+                                            BubbleProfile const& bubbleProfile,
+                                    LinearSplineThroughNodes const& tunnelPath,
+                                                 double const auxiliaryValue )
+  {
+    if( auxiliaryValue >= bubbleProfile.AuxiliaryAt( 0.0 ) )
+    {
+      return 0.0;
+    }
+    double innerRadius( 0.0 );
+    double outerRadius( bubbleProfile.MaximumPlotRadius() );
+    for( unsigned int bisectionCount( 0 );
+         bisectionCount < 64;
+         ++bisectionCount )
+    {
+      double const middleRadius( 0.5 * ( innerRadius + outerRadius ) );
+      if( bubbleProfile.AuxiliaryAt( middleRadius ) > auxiliaryValue )
+      {
+        innerRadius = middleRadius;
+      }
+      else
+      {
+        outerRadius = middleRadius;
+      }
+    }
+    double const auxiliarySlope( bubbleProfile.AuxiliarySlopeAt(
+                                     0.5 * ( innerRadius + outerRadius ) ) );
+    return ( auxiliarySlope * auxiliarySlope
+             * tunnelPath.SlopeSquared( auxiliaryValue ) );
+  }
+
+  // This puts the gradient of the potential at each node of pathNodes apart
+  // from the ends into nodeGradients, which must already have an element for
+  // every node. If potentialFunction has an analytic gradient, it is
+  // evaluated node by node, as that is cheaper than any finite difference.
+  // Otherwise the nodes and their displacements by gradientStep along each
+  // field are all evaluated as a single batch by EvaluateBatch, and the
+  // gradients are taken as forward differences.
+  void PathDeformationTunneler::SetNodeGradients(
+                                    PotentialFunction const& potentialFunction,
+                                             double const tunnelingTemperature,
+                                                     double const gradientStep,
+                         std::vector< std::vector< double > > const& pathNodes,
+                         std::vector< std::vector< double > >& nodeGradients )
+  {
+    size_t const numberOfInteriorNodes( pathNodes.size() - 2 );
+    if( potentialFunction.HasAnalyticGradient() )
+    {
+      for( size_t nodeIndex( 1 );
+           nodeIndex <= numberOfInteriorNodes;
+           ++nodeIndex )
+      {
+        potentialFunction.SetAsGradientAt( nodeGradients[ nodeIndex ],
+                                           pathNodes[ nodeIndex ],
+                                           gradientStep,
+                                           tunnelingTemperature );
+      }
+      return;
+    }
+
+    // Each interior node contributes its own configuration followed by one
+    // configuration displaced along each field in turn.
+    size_t const numberOfFields( pathNodes.front().size() );
+    size_t const configurationsPerNode( numberOfFields + 1 );
+    std::vector< double > displacedConfigurations;
+    displacedConfigurations.reserve( numberOfInteriorNodes
+                                     * configurationsPerNode
+                                     * numberOfFields );
+    for( size_t nodeIndex( 1 );
+         nodeIndex <= numberOfInteriorNodes;
+         ++nodeIndex )
+    {
+      for( size_t configurationIndex( 0 );
+           configurationIndex < configurationsPerNode;
+           ++configurationIndex )
+      {
+        displacedConfigurations.insert( displacedConfigurations.end(),
+                                        pathNodes[ nodeIndex ].begin(),
+                                        pathNodes[ nodeIndex ].end() );
+        if( configurationIndex > 0 )
+        {
+          displacedConfigurations[ displacedConfigurations.size()
+                                   - numberOfFields
+                                   + configurationIndex - 1 ]
+          += gradientStep;
+        }
+      }
+    }
+    std::vector< double > potentialValues;
+    potentialFunction.EvaluateBatch( displacedConfigurations,
+                                     tunnelingTemperature,
+                                     potentialValues );
+    for( size_t nodeIndex( 1 );
+         nodeIndex <= numberOfInteriorNodes;
+         ++nodeIndex )
+    {
+      size_t const
+      nodeStart( ( nodeIndex - 1 ) * configurationsPerNode );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        nodeGradients[ nodeIndex ][ fieldIndex ]
+        = ( ( potentialValues[ nodeStart + fieldIndex + 1 ]
+              - potentialValues[ nodeStart ] )
+            / gradientStep );
+      }
+    }
+  }
+
+  // This puts the normal force on the node with index nodeIndex of pathNodes
+  // into normalForce and returns the length of nodeGradient, the gradient of
+  // the potential at the node. The normal force is the gradient minus
+  // fieldSpeedSquared times the curvature of the path at the node, with the
+  // component along the path projected out.
+  double PathDeformationTunneler::NormalForce(
+                         std::vector< std::vector< double > > const& pathNodes,
+                                                 size_t const nodeIndex,
+                                     std::vector< double > const& nodeGradient,
+                                                double const fieldSpeedSquared,
+                                                 Eigen::VectorXd& normalForce )
+  {
+    size_t const numberOfFields( pathNodes[ nodeIndex ].size() );
+    Eigen::Map< Eigen::VectorXd const >
+    previousNode( pathNodes[ nodeIndex - 1 ].data(),
+                  numberOfFields );
+    Eigen::Map< Eigen::VectorXd const >
+    currentNode( pathNodes[ nodeIndex ].data(),
+                 numberOfFields );
+    Eigen::Map< Eigen::VectorXd const >
+    nextNode( pathNodes[ nodeIndex + 1 ].data(),
+              numberOfFields );
+    Eigen::VectorXd const incomingSegment( currentNode - previousNode );
+    Eigen::VectorXd const outgoingSegment( nextNode - currentNode );
+    double const incomingLength( incomingSegment.norm() );
+    double const outgoingLength( outgoingSegment.norm() );
+
+    Eigen::Map< Eigen::VectorXd const >
+    potentialGradient( nodeGradient.data(),
+                       numberOfFields );
+    if( !( ( incomingLength > 0.0 ) && ( outgoingLength > 0.0 ) ) )
+    {
+      // A node on top of its neighbor has no well-defined tangent, so it is
+      // left where it is until the nodes are spaced evenly again.
+      normalForce.setZero( numberOfFields );
+      return potentialGradient.norm();
+    }
+
+    // The normal force is the gradient of the potential minus the square of
+    // the speed of the fields times the curvature of the path, both with
+    // their components along the path projected out. The curvature is the
+    // second derivative of the fields with respect to the distance along the
+    // path.
+    Eigen::VectorXd const
+    pathTangent( ( nextNode - previousNode ).normalized() );
+    Eigen::VectorXd const
+    pathCurvature( ( ( outgoingSegment / outgoingLength )
+                     - ( incomingSegment / incomingLength ) )
+                   * ( 2.0 / ( incomingLength + outgoingLength ) ) );
+    normalForce
+    = ( potentialGradient - ( fieldSpeedSquared * pathCurvature ) );
+    normalForce -= ( normalForce.dot( pathTangent ) * pathTangent );
+    return potentialGradient.norm();
+  }
+
+} /* namespace VevaciousPlusPlus */
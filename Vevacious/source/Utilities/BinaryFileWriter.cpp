@@ -0,0 +1,61 @@
+/*
+ * BinaryFileWriter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "Utilities/BinaryFileWriter.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  BinaryFileWriter::BinaryFileWriter() :
+    fileBytes( "" )
+  {
+    // This constructor is just an initialization list.
+  }
+
+  BinaryFileWriter::~BinaryFileWriter()
+  {
+    // This does nothing.
+  }
+
+
+  // This writes all the appended bytes to fileName, returning false if the
+  // file could not be written, for example if the folder is read-only.
+  bool BinaryFileWriter::WriteFile( std::string const& fileName ) const
+  {
+    std::string const temporaryName( fileName + UniqueTemporaryTag() );
+    std::ofstream outputFile( temporaryName.c_str(),
+                              ( std::ios::out | std::ios::binary ) );
+    if( !(outputFile.is_open()) )
+    {
+      return false;
+    }
+    outputFile.write( fileBytes.data(),
+                      fileBytes.size() );
+    outputFile.close();
+    if( outputFile.fail()
+        ||
+        ( rename( temporaryName.c_str(),
+                  fileName.c_str() ) != 0 ) )
+    {
+      remove( temporaryName.c_str() );
+      return false;
+    }
+    return true;
+  }
+
+  // This returns a tag made of the process ID and a count of the calls to
+  // this function, so that temporary files from different processes or
+  // threads do not clash.
+  std::string BinaryFileWriter::UniqueTemporaryTag()
+  {
+    static std::atomic< unsigned int > temporaryCount( 0 );
+    std::stringstream tagBuilder;
+    tagBuilder << ".tmp." << getpid() << "." << temporaryCount++;
+    return tagBuilder.str();
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -0,0 +1,74 @@
+/*
+ * MappedFileReader.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "Utilities/MappedFileReader.hpp"
+
+namespace VevaciousPlusPlus
+{
+  std::uint64_t const MappedFileReader::initialHash( 14695981039346656037ULL );
+
+  MappedFileReader::MappedFileReader( std::string const& fileName ) :
+    mappedBytes( NULL ),
+    fileSize( 0 ),
+    readPosition( 0 )
+  {
+    int const fileDescriptor( open( fileName.c_str(),
+                                    O_RDONLY ) );
+    if( fileDescriptor < 0 )
+    {
+      return;
+    }
+    struct stat fileStatus;
+    // An empty file cannot be mapped, so it is left as not mapped.
+    if( ( fstat( fileDescriptor,
+                 &fileStatus ) == 0 )
+        &&
+        ( fileStatus.st_size > 0 ) )
+    {
+      void* const mappingResult( mmap( NULL,
+                                       fileStatus.st_size,
+                                       PROT_READ,
+                                       MAP_PRIVATE,
+                                       fileDescriptor,
+                                       0 ) );
+      if( mappingResult != MAP_FAILED )
+      {
+        mappedBytes = static_cast< char const* >( mappingResult );
+        fileSize = fileStatus.st_size;
+      }
+    }
+    // The mapping stays valid after the file is closed.
+    close( fileDescriptor );
+  }
+
+  MappedFileReader::~MappedFileReader()
+  {
+    if( mappedBytes != NULL )
+    {
+      munmap( const_cast< char* >( mappedBytes ),
+              fileSize );
+    }
+  }
+
+
+  // This returns the 64-bit FNV-1a hash of numberOfBytes bytes starting at
+  // bytesToHash, continuing from hashSoFar.
+  std::uint64_t MappedFileReader::HashBytes( char const* bytesToHash,
+                                             size_t const numberOfBytes,
+                                             std::uint64_t hashSoFar )
+  {
+    for( size_t byteIndex( 0 );
+         byteIndex < numberOfBytes;
+         ++byteIndex )
+    {
+      hashSoFar ^= static_cast< unsigned char >( bytesToHash[ byteIndex ] );
+      hashSoFar *= 1099511628211ULL;
+    }
+    return hashSoFar;
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -0,0 +1,15 @@
+/*
+ * PerformanceLogger.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "Utilities/PerformanceLogger.hpp"
+
+namespace VevaciousPlusPlus
+{
+  PerformanceRecord* PerformanceLogger::sharedPerformanceRecord( NULL );
+  thread_local PerformanceRecord*
+  PerformanceLogger::threadPerformanceRecord( NULL );
+}
@@ -0,0 +1,367 @@
+/*
+ * PerformanceRecord.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "Utilities/PerformanceRecord.hpp"
+
+namespace VevaciousPlusPlus
+{
+  size_t const PerformanceRecord::numberOfHistogramBins;
+  size_t const PerformanceRecord::cacheLineBytes;
+  std::atomic< unsigned long long > PerformanceRecord::lastGeneration( 0 );
+  thread_local unsigned long long PerformanceRecord::cachedGeneration( 0 );
+  thread_local long long* PerformanceRecord::cachedCounterValues( NULL );
+
+  char const* const
+  PerformanceRecord::stageNames[ NumberOfStages ] = {
+    "PotentialMinimization",
+    "TunnelingCalculation",
+    "WholePoint" };
+
+  char const* const
+  PerformanceRecord::counterNames[ NumberOfCounters ] = {
+    "PotentialEvaluations",
+    "GradientEvaluations",
+    "MigradCalls",
+    "PolynomialSystemsSolved",
+    "HomotopySolutions",
+    "BounceActionCalculations",
+    "PathFinderIterations",
+    "BubbleProfiles",
+    "ShootingAttempts" };
+
+  char const* const
+  PerformanceRecord::histogramNames[ NumberOfHistograms ] = {
+    "FunctionCallsPerMigrad",
+    "PathFinderIterationsPerBounceAction",
+    "ShootingAttemptsPerBubbleProfile" };
+
+  char const* const
+  PerformanceRecord::timerNames[ NumberOfTimers ] = {
+    "Migrad",
+    "PolynomialSystemSolver",
+    "BounceAction",
+    "BubbleShooting" };
+
+  PerformanceRecord::PerformanceRecord() :
+    threadCounterBlocks(),
+    recordGeneration( 0 )
+  {
+    Reset();
+  }
+
+  PerformanceRecord::~PerformanceRecord()
+  {
+    // This does nothing.
+  }
+
+
+  // This sets all the counters, histogram bins and times back to zero.
+  void PerformanceRecord::Reset()
+  {
+    for( size_t stageIndex( 0 );
+         stageIndex < NumberOfStages;
+         ++stageIndex )
+    {
+      stageNanoseconds[ stageIndex ].store( 0 );
+    }
+    for( size_t counterIndex( 0 );
+         counterIndex < NumberOfCounters;
+         ++counterIndex )
+    {
+      counterValues[ counterIndex ] = 0;
+    }
+#pragma omp critical( PerformanceRecordThreadCounters )
+    {
+      DropThreadCounters();
+    }
+    for( size_t histogramIndex( 0 );
+         histogramIndex < NumberOfHistograms;
+         ++histogramIndex )
+    {
+      for( size_t binIndex( 0 );
+           binIndex < numberOfHistogramBins;
+           ++binIndex )
+      {
+        histogramBins[ histogramIndex ][ binIndex ].store( 0 );
+      }
+    }
+    for( size_t timerIndex( 0 );
+         timerIndex < NumberOfTimers;
+         ++timerIndex )
+    {
+      timerNanoseconds[ timerIndex ].store( 0 );
+    }
+  }
+
+  // This adds the counts of all the threads to the counters and starts new
+  // blocks for any further counts. It must not be called while any thread
+  // might be counting into this record.
+  void PerformanceRecord::MergeThreadCounters()
+  {
+#pragma omp critical( PerformanceRecordThreadCounters )
+    {
+      for( std::vector< std::unique_ptr< ThreadCounters > >::const_iterator
+           threadCounters( threadCounterBlocks.begin() );
+           threadCounters != threadCounterBlocks.end();
+           ++threadCounters )
+      {
+        for( size_t counterIndex( 0 );
+             counterIndex < NumberOfCounters;
+             ++counterIndex )
+        {
+          counterValues[ counterIndex ]
+          += (*threadCounters)->counterValues[ counterIndex ];
+        }
+      }
+      DropThreadCounters();
+    }
+  }
+
+  // This returns the record as a <Performance> element for the results XML,
+  // with each line indented by indentationSpaces spaces.
+  std::string
+  PerformanceRecord::AsXmlElement( int const indentationSpaces ) const
+  {
+    std::string const outerIndent( indentationSpaces,
+                                   ' ' );
+    std::string const innerIndent( outerIndent + "  " );
+    std::string const elementIndent( innerIndent + "  " );
+    std::string const valueIndent( elementIndent + "  " );
+    std::stringstream xmlBuilder;
+    xmlBuilder << std::setprecision( 6 )
+    << outerIndent << "<Performance>\n"
+    << innerIndent << "<StageTimes>\n"
+    << elementIndent << "<!-- wall-clock times in seconds -->\n";
+    for( size_t stageIndex( 0 );
+         stageIndex < NumberOfStages;
+         ++stageIndex )
+    {
+      xmlBuilder << elementIndent << "<" << stageNames[ stageIndex ] << ">\n"
+      << valueIndent << StageSeconds( static_cast< StageName >( stageIndex ) )
+      << "\n"
+      << elementIndent << "</" << stageNames[ stageIndex ] << ">\n";
+    }
+    xmlBuilder << innerIndent << "</StageTimes>\n"
+    << innerIndent << "<ThreadSummedTimes>\n"
+    << elementIndent << "<!-- in seconds, summed over all threads -->\n";
+    for( size_t timerIndex( 0 );
+         timerIndex < NumberOfTimers;
+         ++timerIndex )
+    {
+      xmlBuilder << elementIndent << "<" << timerNames[ timerIndex ] << ">\n"
+      << valueIndent << TimerSeconds( static_cast< TimerName >( timerIndex ) )
+      << "\n"
+      << elementIndent << "</" << timerNames[ timerIndex ] << ">\n";
+    }
+    xmlBuilder << innerIndent << "</ThreadSummedTimes>\n"
+    << innerIndent << "<Counters>\n";
+    for( size_t counterIndex( 0 );
+         counterIndex < NumberOfCounters;
+         ++counterIndex )
+    {
+      xmlBuilder
+      << elementIndent << "<" << counterNames[ counterIndex ] << ">\n"
+      << valueIndent
+      << CounterValue( static_cast< CounterName >( counterIndex ) ) << "\n"
+      << elementIndent << "</" << counterNames[ counterIndex ] << ">\n";
+    }
+    xmlBuilder << innerIndent << "</Counters>\n"
+    << innerIndent << "<Histograms>\n";
+    for( size_t histogramIndex( 0 );
+         histogramIndex < NumberOfHistograms;
+         ++histogramIndex )
+    {
+      xmlBuilder
+      << elementIndent << "<" << histogramNames[ histogramIndex ] << ">";
+      bool histogramIsEmpty( true );
+      for( size_t binIndex( 0 );
+           binIndex < numberOfHistogramBins;
+           ++binIndex )
+      {
+        long long const
+        binCount( histogramBins[ histogramIndex ][ binIndex ].load() );
+        if( binCount > 0 )
+        {
+          histogramIsEmpty = false;
+          xmlBuilder << "\n"
+          << valueIndent << "<Bin>\n"
+          << valueIndent << "  <Range>\n"
+          << valueIndent << "    " << BinRange( binIndex ) << "\n"
+          << valueIndent << "  </Range>\n"
+          << valueIndent << "  <Count>\n"
+          << valueIndent << "    " << binCount << "\n"
+          << valueIndent << "  </Count>\n"
+          << valueIndent << "</Bin>";
+        }
+      }
+      if( histogramIsEmpty )
+      {
+        xmlBuilder << "<!-- Nothing recorded. -->";
+      }
+      else
+      {
+        xmlBuilder << "\n" << elementIndent;
+      }
+      xmlBuilder << "</" << histogramNames[ histogramIndex ] << ">\n";
+    }
+    xmlBuilder << innerIndent << "</Histograms>\n"
+    << outerIndent << "</Performance>\n";
+    return xmlBuilder.str();
+  }
+
+  // This returns the record as a single line of JSON (without the newline at
+  // the end), with pointName as the value of the "point" member.
+  std::string
+  PerformanceRecord::AsJsonLine( std::string const& pointName ) const
+  {
+    std::stringstream jsonBuilder;
+    jsonBuilder << std::setprecision( 6 )
+    << "{\"point\":\"" << JsonEscaped( pointName ) << "\",\"stageSeconds\":{";
+    for( size_t stageIndex( 0 );
+         stageIndex < NumberOfStages;
+         ++stageIndex )
+    {
+      if( stageIndex > 0 )
+      {
+        jsonBuilder << ",";
+      }
+      jsonBuilder << "\"" << stageNames[ stageIndex ] << "\":"
+      << StageSeconds( static_cast< StageName >( stageIndex ) );
+    }
+    jsonBuilder << "},\"threadSummedSeconds\":{";
+    for( size_t timerIndex( 0 );
+         timerIndex < NumberOfTimers;
+         ++timerIndex )
+    {
+      if( timerIndex > 0 )
+      {
+        jsonBuilder << ",";
+      }
+      jsonBuilder << "\"" << timerNames[ timerIndex ] << "\":"
+      << TimerSeconds( static_cast< TimerName >( timerIndex ) );
+    }
+    jsonBuilder << "},\"counters\":{";
+    for( size_t counterIndex( 0 );
+         counterIndex < NumberOfCounters;
+         ++counterIndex )
+    {
+      if( counterIndex > 0 )
+      {
+        jsonBuilder << ",";
+      }
+      jsonBuilder << "\"" << counterNames[ counterIndex ] << "\":"
+      << CounterValue( static_cast< CounterName >( counterIndex ) );
+    }
+    jsonBuilder << "},\"histograms\":{";
+    for( size_t histogramIndex( 0 );
+         histogramIndex < NumberOfHistograms;
+         ++histogramIndex )
+    {
+      if( histogramIndex > 0 )
+      {
+        jsonBuilder << ",";
+      }
+      jsonBuilder << "\"" << histogramNames[ histogramIndex ] << "\":{";
+      bool firstBin( true );
+      for( size_t binIndex( 0 );
+           binIndex < numberOfHistogramBins;
+           ++binIndex )
+      {
+        long long const
+        binCount( histogramBins[ histogramIndex ][ binIndex ].load() );
+        if( binCount > 0 )
+        {
+          if( !firstBin )
+          {
+            jsonBuilder << ",";
+          }
+          firstBin = false;
+          jsonBuilder << "\"" << BinRange( binIndex ) << "\":" << binCount;
+        }
+      }
+      jsonBuilder << "}";
+    }
+    jsonBuilder << "}}";
+    return jsonBuilder.str();
+  }
+
+  // This returns the range of values covered by the histogram bin with index
+  // binIndex as a string such as "4-7", or "1073741824+" for the last bin.
+  std::string PerformanceRecord::BinRange( size_t const binIndex )
+  {
+    if( binIndex == 0 )
+    {
+      return "0";
+    }
+    unsigned long long const lowerBound( 1ULL << ( binIndex - 1 ) );
+    std::stringstream rangeBuilder;
+    rangeBuilder << lowerBound;
+    if( binIndex == ( numberOfHistogramBins - 1 ) )
+    {
+      rangeBuilder << "+";
+    }
+    else if( binIndex > 1 )
+    {
+      rangeBuilder << "-" << ( ( lowerBound << 1 ) - 1 );
+    }
+    return rangeBuilder.str();
+  }
+
+  // This returns stringToEscape with backslashes, quotes and control
+  // characters escaped for use as a JSON string.
+  std::string
+  PerformanceRecord::JsonEscaped( std::string const& stringToEscape )
+  {
+    std::stringstream escapeBuilder;
+    for( std::string::const_iterator
+         stringCharacter( stringToEscape.begin() );
+         stringCharacter != stringToEscape.end();
+         ++stringCharacter )
+    {
+      if( ( *stringCharacter == '\"' )
+          ||
+          ( *stringCharacter == '\\' ) )
+      {
+        escapeBuilder << '\\' << *stringCharacter;
+      }
+      else if( static_cast< unsigned char >( *stringCharacter ) < 0x20 )
+      {
+        escapeBuilder << "\\u" << std::hex << std::setw( 4 )
+        << std::setfill( '0' )
+        << static_cast< int >( *stringCharacter ) << std::dec;
+      }
+      else
+      {
+        escapeBuilder << *stringCharacter;
+      }
+    }
+    return escapeBuilder.str();
+  }
+
+  // This adds a new block of counters for the calling thread, starting at
+  // zero, and returns a pointer to its counters.
+  long long* PerformanceRecord::NewThreadCounters()
+  {
+    long long* newCounterValues( NULL );
+#pragma omp critical( PerformanceRecordThreadCounters )
+    {
+      threadCounterBlocks.emplace_back( new ThreadCounters() );
+      newCounterValues = threadCounterBlocks.back()->counterValues;
+    }
+    return newCounterValues;
+  }
+
+  // This drops the blocks of counters of all the threads and gives the record
+  // a new generation. It should only be called from within the critical
+  // section for the blocks.
+  void PerformanceRecord::DropThreadCounters()
+  {
+    threadCounterBlocks.clear();
+    recordGeneration = ++lastGeneration;
+  }
+
+} /* namespace VevaciousPlusPlus */
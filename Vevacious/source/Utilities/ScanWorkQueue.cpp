@@ -0,0 +1,406 @@
+/*
+ * ScanWorkQueue.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Ben O'Leary (benjamin.oleary@gmail.com)
+ */
+
+#include "Utilities/ScanWorkQueue.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  ScanWorkQueue::ScanWorkQueue( std::string const& inputSuffix,
+                                std::string const& claimSuffix,
+                                std::string const& outputSuffix,
+                                double const leaseInSeconds ) :
+    inputSuffix( inputSuffix ),
+    claimSuffix( claimSuffix ),
+    outputSuffix( outputSuffix ),
+    leaseInSeconds( leaseInSeconds ),
+    workItems(),
+    nextIndex( 0 ),
+    currentIndex( 0 ),
+    holdingClaim( false ),
+    claimTime( 0 ),
+    journalFile( "" ),
+    workerName( WorkerName() )
+  {
+    // This constructor is just an initialization list.
+  }
+
+  ScanWorkQueue::~ScanWorkQueue()
+  {
+    // This does nothing. If the current input was not finished, for example
+    // because running it threw an exception, its claim is left for its lease
+    // to expire rather than letting other processes run into the same
+    // problem straight away.
+  }
+
+
+  // This takes the names of all the files in the folder given by
+  // inputDirectory which end in inputSuffix, and prepares the names of the
+  // claim files in claimDirectory and of the output files in outputDirectory,
+  // creating those folders if they do not already exist.
+  void ScanWorkQueue::PrepareFilenames( std::string const& inputDirectory,
+                                        std::string const& claimDirectory,
+                                        std::string const& outputDirectory )
+  {
+    EnsureDirectoryExists( claimDirectory );
+    EnsureDirectoryExists( outputDirectory );
+    journalFile.assign( outputDirectory + "/VevaciousScanJournal.txt" );
+    std::string const
+    journalName( journalFile.substr( journalFile.rfind( '/' ) + 1 ) );
+    DIR* directoryPointer( opendir( inputDirectory.c_str() ) );
+    if( directoryPointer == NULL )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "Could not read directory \"" << inputDirectory
+      << "\": " << strerror( errno );
+      throw std::runtime_error( errorBuilder.str() );
+    }
+    // The input folder might also be the claim or output folder, so claim
+    // files, output files, and the journal are not taken as inputs.
+    std::vector< std::string > baseNames;
+    std::string currentFilename( "" );
+    for( dirent* structPointer( readdir( directoryPointer ) );
+         structPointer != NULL;
+         structPointer = readdir( directoryPointer ) )
+    {
+      currentFilename.assign( structPointer->d_name );
+      if( ( currentFilename == "." )
+          ||
+          ( currentFilename == ".." )
+          ||
+          ( currentFilename == journalName )
+          ||
+          !( inputSuffix.size() < currentFilename.size() )
+          ||
+          ( currentFilename.compare( ( currentFilename.size()
+                                       - inputSuffix.size() ),
+                                     inputSuffix.size(),
+                                     inputSuffix ) != 0 ) )
+      {
+        continue;
+      }
+      std::string const baseName( currentFilename.substr( 0,
+                           ( currentFilename.size() - inputSuffix.size() ) ) );
+      if( ( !(claimSuffix.empty())
+            &&
+            ( currentFilename.size() > claimSuffix.size() )
+            &&
+            ( currentFilename.compare( ( currentFilename.size()
+                                         - claimSuffix.size() ),
+                                       claimSuffix.size(),
+                                       claimSuffix ) == 0 ) )
+          ||
+          ( currentFilename.find( claimSuffix + ".stale." )
+            != std::string::npos )
+          ||
+          ( !(outputSuffix.empty())
+            &&
+            ( currentFilename.size() > outputSuffix.size() )
+            &&
+            ( currentFilename.compare( ( currentFilename.size()
+                                         - outputSuffix.size() ),
+                                       outputSuffix.size(),
+                                       outputSuffix ) == 0 ) ) )
+      {
+        continue;
+      }
+      baseNames.push_back( baseName );
+    }
+    closedir( directoryPointer );
+
+    // Every process works through the inputs in the same order, so that the
+    // scan progresses in a predictable way.
+    std::sort( baseNames.begin(),
+               baseNames.end() );
+    workItems.clear();
+    workItems.reserve( baseNames.size() );
+    WorkItem workItem;
+    for( std::vector< std::string >::const_iterator
+         baseName( baseNames.begin() );
+         baseName != baseNames.end();
+         ++baseName )
+    {
+      workItem.baseName.assign( *baseName );
+      workItem.inputFile.assign( inputDirectory + "/"
+                                 + (*baseName) + inputSuffix );
+      workItem.claimFile.assign( claimDirectory + "/"
+                                 + (*baseName) + claimSuffix );
+      workItem.outputFile.assign( outputDirectory + "/"
+                                  + (*baseName) + outputSuffix );
+      workItems.push_back( workItem );
+    }
+    nextIndex = 0;
+    currentIndex = 0;
+    holdingClaim = false;
+  }
+
+  // This claims the next input which has no output file and no live claim by
+  // another process, returning false if there are no more such inputs. If the
+  // claim on the previous input was not released by FinishCurrentPoint, it is
+  // released without marking the input as finished.
+  bool ScanWorkQueue::ClaimNextPoint()
+  {
+    ReleaseCurrentClaim();
+    while( nextIndex < workItems.size() )
+    {
+      size_t const itemIndex( nextIndex++ );
+      WorkItem const& workItem( workItems[ itemIndex ] );
+      if( FileExists( workItem.outputFile )
+          ||
+          !(FileExists( workItem.inputFile ))
+          ||
+          !(TryToClaim( itemIndex )) )
+      {
+        continue;
+      }
+      // Another process might have finished the input and removed its claim
+      // between the check for the output file and the claim being made.
+      if( FileExists( workItem.outputFile ) )
+      {
+        unlink( workItem.claimFile.c_str() );
+        continue;
+      }
+      currentIndex = itemIndex;
+      holdingClaim = true;
+      claimTime = time( NULL );
+      WriteJournalEntry( "claimed",
+                         workItem.baseName );
+      return true;
+    }
+    return false;
+  }
+
+  // This marks the currently claimed input as finished in the journal and
+  // removes its claim file. It should be called once the output file has been
+  // written.
+  void ScanWorkQueue::FinishCurrentPoint()
+  {
+    if( !holdingClaim )
+    {
+      return;
+    }
+    std::stringstream entryBuilder;
+    entryBuilder << "finished after "
+    << difftime( time( NULL ),
+                 claimTime )
+    << "s";
+    WriteJournalEntry( entryBuilder.str(),
+                       workItems[ currentIndex ].baseName );
+    if( ( unlink( CurrentClaim().c_str() ) != 0 )
+        &&
+        ( errno != ENOENT ) )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "Could not delete \"" << CurrentClaim() << "\": "
+      << strerror( errno );
+      throw std::runtime_error( errorBuilder.str() );
+    }
+    holdingClaim = false;
+  }
+
+  // This tries to create the claim file for workItems[ itemIndex ],
+  // recovering it from a crashed process if its lease has expired, and
+  // returns true if the claim now belongs to this process.
+  bool ScanWorkQueue::TryToClaim( size_t const itemIndex )
+  {
+    std::string const& claimFile( workItems[ itemIndex ].claimFile );
+    // Only one process can create the claim file with O_EXCL, even if several
+    // try at the same time. If the file already exists, it is only tried once
+    // more, after a stale claim has been removed.
+    for( int claimAttempt( 0 );
+         claimAttempt < 2;
+         ++claimAttempt )
+    {
+      int const fileDescriptor( open( claimFile.c_str(),
+                                      ( O_WRONLY | O_CREAT | O_EXCL ),
+                                      0644 ) );
+      if( fileDescriptor >= 0 )
+      {
+        std::string const claimContent( workerName + "\n" );
+        ssize_t const bytesWritten( write( fileDescriptor,
+                                           claimContent.c_str(),
+                                           claimContent.size() ) );
+        close( fileDescriptor );
+        if( bytesWritten < 0 )
+        {
+          std::stringstream errorBuilder;
+          errorBuilder << "Could not write to \"" << claimFile << "\": "
+          << strerror( errno );
+          throw std::runtime_error( errorBuilder.str() );
+        }
+        return true;
+      }
+      if( errno != EEXIST )
+      {
+        std::stringstream errorBuilder;
+        errorBuilder << "Could not create \"" << claimFile << "\": "
+        << strerror( errno );
+        throw std::runtime_error( errorBuilder.str() );
+      }
+      if( !(RecoverStaleClaim( itemIndex )) )
+      {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  // This renames the claim file of workItems[ itemIndex ] to a name unique to
+  // this process if it has not been touched for longer than leaseInSeconds,
+  // and then deletes it, returning true if the claim file is now gone so that
+  // it is worth trying to claim the input again.
+  bool ScanWorkQueue::RecoverStaleClaim( size_t const itemIndex )
+  {
+    std::string const& claimFile( workItems[ itemIndex ].claimFile );
+    struct stat claimStatus;
+    if( stat( claimFile.c_str(),
+              &claimStatus ) != 0 )
+    {
+      // The claim was removed in the meantime.
+      return ( errno == ENOENT );
+    }
+    if( !( difftime( time( NULL ),
+                     claimStatus.st_mtime ) > leaseInSeconds ) )
+    {
+      return false;
+    }
+    // Only one process can rename the stale claim file. However, between
+    // the check on the time and the renaming, another process might have
+    // already recovered the stale claim and made a fresh one, so the time of
+    // the renamed file is checked again, and if it turns out to be a live
+    // claim, it is put back (with link, which will not replace a file). If
+    // yet another process has made a claim in the meantime, link fails, and
+    // the renamed file is left in place and the conflict is recorded in the
+    // journal, rather than deleting the only record of the live claim.
+    std::string const staleFile( claimFile + ".stale." + workerName );
+    if( rename( claimFile.c_str(),
+                staleFile.c_str() ) != 0 )
+    {
+      return false;
+    }
+    if( ( stat( staleFile.c_str(),
+                &claimStatus ) == 0 )
+        &&
+        !( difftime( time( NULL ),
+                     claimStatus.st_mtime ) > leaseInSeconds ) )
+    {
+      if( link( staleFile.c_str(),
+                claimFile.c_str() ) == 0 )
+      {
+        unlink( staleFile.c_str() );
+      }
+      else
+      {
+        std::stringstream entryBuilder;
+        entryBuilder << "could not restore live claim (" << strerror( errno )
+        << ", kept as \"" << staleFile << "\") on";
+        WriteJournalEntry( entryBuilder.str(),
+                           workItems[ itemIndex ].baseName );
+      }
+      return false;
+    }
+    unlink( staleFile.c_str() );
+    WriteJournalEntry( "recovered stale claim on",
+                       workItems[ itemIndex ].baseName );
+    return true;
+  }
+
+  // This deletes the claim file of the current input if this process holds
+  // it.
+  void ScanWorkQueue::ReleaseCurrentClaim()
+  {
+    if( holdingClaim )
+    {
+      WriteJournalEntry( "released",
+                         workItems[ currentIndex ].baseName );
+      unlink( CurrentClaim().c_str() );
+      holdingClaim = false;
+    }
+  }
+
+  // This appends a line with the time, this worker's name, journalEntry, and
+  // baseName to the journal, with a single write so that lines from different
+  // processes are not mixed.
+  void ScanWorkQueue::WriteJournalEntry( std::string const& journalEntry,
+                                         std::string const& baseName ) const
+  {
+    std::stringstream lineBuilder;
+    lineBuilder << time( NULL ) << " " << workerName << " " << journalEntry
+    << " " << baseName << "\n";
+    std::string const journalLine( lineBuilder.str() );
+    int const fileDescriptor( open( journalFile.c_str(),
+                                    ( O_WRONLY | O_CREAT | O_APPEND ),
+                                    0644 ) );
+    if( ( fileDescriptor < 0 )
+        ||
+        ( write( fileDescriptor,
+                 journalLine.c_str(),
+                 journalLine.size() ) < 0 ) )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "Could not write to \"" << journalFile << "\": "
+      << strerror( errno );
+      if( fileDescriptor >= 0 )
+      {
+        close( fileDescriptor );
+      }
+      throw std::runtime_error( errorBuilder.str() );
+    }
+    close( fileDescriptor );
+  }
+
+  // This creates the folder given by directoryName and any missing parent
+  // folders, throwing an exception if it could not.
+  void
+  ScanWorkQueue::EnsureDirectoryExists( std::string const& directoryName )
+  {
+    // Each folder along the path is made in turn, as with mkdir -p, ignoring
+    // those which already exist.
+    size_t separatorPosition( directoryName.find( '/',
+                                                  1 ) );
+    while( separatorPosition != std::string::npos )
+    {
+      mkdir( directoryName.substr( 0,
+                                   separatorPosition ).c_str(),
+             0755 );
+      separatorPosition = directoryName.find( '/',
+                                              ( separatorPosition + 1 ) );
+    }
+    mkdir( directoryName.c_str(),
+           0755 );
+    struct stat directoryStatus;
+    if( ( stat( directoryName.c_str(),
+                &directoryStatus ) != 0 )
+        ||
+        !(S_ISDIR( directoryStatus.st_mode )) )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "Could not create directory \"" << directoryName
+      << "\"!";
+      throw std::runtime_error( errorBuilder.str() );
+    }
+  }
+
+  // This returns the name of the host, the process ID, and a count of the
+  // calls to this function, so that queues on different threads of the same
+  // process are told apart.
+  std::string ScanWorkQueue::WorkerName()
+  {
+    static std::atomic< unsigned int > queueCount( 0 );
+    char hostName[ 256 ];
+    if( gethostname( hostName,
+                     sizeof( hostName ) ) != 0 )
+    {
+      hostName[ 0 ] = '\0';
+    }
+    hostName[ sizeof( hostName ) - 1 ] = '\0';
+    std::stringstream nameBuilder;
+    nameBuilder << hostName << "." << getpid() << "." << queueCount++;
+    return nameBuilder.str();
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -10,6 +10,8 @@
 
 namespace VevaciousPlusPlus
 {
-  std::vector< std::string >* WarningLogger::warningMessages( NULL );
+  std::vector< std::string >* WarningLogger::sharedWarningMessages( NULL );
+  thread_local std::vector< std::string >*
+  WarningLogger::threadWarningMessages( NULL );
 }
 
@@ -7,6 +7,9 @@
  */
 
 #include "VevaciousPlusPlus.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace VevaciousPlusPlus
 {
@@ -22,28 +25,102 @@ namespace VevaciousPlusPlus
                                    TunnelingCalculator& tunnelingCalculator ) :
     lagrangianParameterManager( &(potentialMinimizer.GetPotentialFunction(
                                           ).GetLagrangianParameterManager()) ),
+    lagrangianParameterManagerClass( "" ),
+    lagrangianParameterManagerArguments( "" ),
+    potentialFunctionClass( "" ),
     potentialMinimizer( &potentialMinimizer ),
     tunnelingCalculator( &tunnelingCalculator ),
+    tunnelingClassChoice( "" ),
+    tunnelingConstructorArguments( "" ),
+    numberOfPanicVacuaToTunnelTo( 1 ),
+    panicVacuumOrdering( OrderByDistance ),
+    additionalTunnelingCalculators(),
+    tunnelingTargets(),
+    fastestQuantumChannel( 0 ),
+    fastestThermalChannel( 0 ),
     warningMessagesFromConstructor(),
     resultsFromLastRunAsXml( "<!-- No results yet. -->" ),
-    warningMessagesFromLastRun()
+    warningMessagesFromLastRun(),
+    performanceRecord(),
+    performanceJsonFilename( "" )
   {
     // This constructor is just an initialization list.
   }
 
   // This is the constructor that we expect to be used in normal use: it reads
   // in an initialization file in XML with name given by initializationFileName
-  // and then assembles the appropriate components for the objects. The body of
-  // the constructor is just a lot of statements reading in XML elements and
-  // creating new instances of components.
+  // and then assembles the appropriate components for the objects. The work
+  // is done by AssembleFromInitializationFile, which is just a lot of
+  // statements reading in XML elements and creating new instances of
+  // components.
   VevaciousPlusPlus::VevaciousPlusPlus(
                                   std::string const& initializationFileName ) :
+    lagrangianParameterManagerClass( "" ),
+    lagrangianParameterManagerArguments( "" ),
+    potentialFunctionClass( "" ),
+    tunnelingClassChoice( "" ),
+    tunnelingConstructorArguments( "" ),
+    numberOfPanicVacuaToTunnelTo( 1 ),
+    panicVacuumOrdering( OrderByDistance ),
+    additionalTunnelingCalculators(),
+    tunnelingTargets(),
+    fastestQuantumChannel( 0 ),
+    fastestThermalChannel( 0 ),
+    warningMessagesFromConstructor(),
+    resultsFromLastRunAsXml( "<!-- No results yet. -->" ),
+    warningMessagesFromLastRun(),
+    performanceRecord(),
+    performanceJsonFilename( "" )
+  {
+    AssembleFromInitializationFile( initializationFileName,
+                                    NULL );
+  }
 
+  // This reads the initialization file in the same way as the constructor
+  // which only takes initializationFileName, but copies the potential
+  // function of modelSource rather than reading the model file again.
+  VevaciousPlusPlus::VevaciousPlusPlus(
+                                    std::string const& initializationFileName,
+                                      VevaciousPlusPlus const& modelSource ) :
+    lagrangianParameterManagerClass( "" ),
+    lagrangianParameterManagerArguments( "" ),
+    potentialFunctionClass( "" ),
+    tunnelingClassChoice( "" ),
+    tunnelingConstructorArguments( "" ),
+    numberOfPanicVacuaToTunnelTo( 1 ),
+    panicVacuumOrdering( OrderByDistance ),
+    additionalTunnelingCalculators(),
+    tunnelingTargets(),
+    fastestQuantumChannel( 0 ),
+    fastestThermalChannel( 0 ),
     warningMessagesFromConstructor(),
     resultsFromLastRunAsXml( "<!-- No results yet. -->" ),
-    warningMessagesFromLastRun()
+    warningMessagesFromLastRun(),
+    performanceRecord(),
+    performanceJsonFilename( "" )
+  {
+    AssembleFromInitializationFile( initializationFileName,
+                                    &modelSource );
+  }
+
+  VevaciousPlusPlus::~VevaciousPlusPlus()
+  {
+//     std::cout
+//        << std::endl
+//        << " Vevacious object has died! ";
+//      std::cout << std::endl;
+  }
+
+  // This reads the initialization file given by initializationFileName and
+  // creates the components which it specifies, copying the potential function
+  // of modelSource rather than reading the model file if modelSource is not
+  // NULL.
+  void VevaciousPlusPlus::AssembleFromInitializationFile(
+                                    std::string const& initializationFileName,
+                                VevaciousPlusPlus const* const modelSource )
   {
-    WarningLogger::SetWarningRecord( &warningMessagesFromConstructor );
+    WarningLogger::ScopedRecord
+    warningRecordForConstructor( warningMessagesFromConstructor );
     std::string potentialFunctionInitializationFilename( "error" );
     std::string potentialMinimizerInitializationFilename( "error" );
     std::string tunnelingCalculatorInitializationFilename( "error" );
@@ -68,23 +145,22 @@ namespace VevaciousPlusPlus
         tunnelingCalculatorInitializationFilename
         = xmlParser.TrimmedCurrentBody();
       }
+      else if( xmlParser.CurrentName() == "PerformanceJsonFile" )
+      {
+        performanceJsonFilename = xmlParser.TrimmedCurrentBody();
+      }
     }
     FullPotentialDescription
-    fullPotentialDescription(std::move( CreateFullPotentialDescription(
-                                   potentialFunctionInitializationFilename ) ));
+    fullPotentialDescription( ( modelSource == NULL ) ?
+                              CreateFullPotentialDescription(
+                                   potentialFunctionInitializationFilename ) :
+                              CopyFullPotentialDescription( *modelSource ) );
     lagrangianParameterManager = std::move(fullPotentialDescription.first);
     ownedPotentialFunction = std::move(fullPotentialDescription.second);
     potentialMinimizer =  std::move(CreatePotentialMinimizer( *ownedPotentialFunction,
                                 potentialMinimizerInitializationFilename ));
     tunnelingCalculator = std::move(CreateTunnelingCalculator( tunnelingCalculatorInitializationFilename ));
-    WarningLogger::SetWarningRecord( NULL );
-  }
-  VevaciousPlusPlus::~VevaciousPlusPlus()
-  {
-//     std::cout
-//        << std::endl
-//        << " Vevacious object has died! ";
-//      std::cout << std::endl;
+    ReadTunnelingChannelOptions( tunnelingCalculatorInitializationFilename );
   }
 
     //This reads in a Slha block and passes it over to LagrangianParameterManager updating 
@@ -108,56 +184,84 @@ namespace VevaciousPlusPlus
   void VevaciousPlusPlus::RunPoint( std::string const& newInput )
   {
     warningMessagesFromLastRun.clear();
-    WarningLogger::SetWarningRecord( &warningMessagesFromLastRun );
-    time_t runStartTime;
-    time_t runEndTime;
-    time_t stageStartTime;
-    time_t stageEndTime;
-    time( &runStartTime );
-    std::cout
-    << std::endl
-    << "Running \"" << newInput << "\" starting at "
-    << ctime( &runStartTime );
-    std::cout << std::endl;
-
-    time( &stageStartTime );
-    lagrangianParameterManager->NewParameterPoint( newInput );
-    potentialMinimizer->FindMinima( 0.0 );
-    time( &stageEndTime );
-    std::cout << std::endl
-    << "Minimization of potential took " << difftime( stageEndTime,
-                                                      stageStartTime )
-    << " seconds, finished at " << ctime( &stageEndTime );
-    std::cout << std::endl;
-
-    if( potentialMinimizer->DsbVacuumIsMetastable() )
+    performanceRecord.Reset();
+    // The durations are measured with a monotonic clock, while the calendar
+    // time is only used for the time stamps printed with them.
+    PerformanceRecord::PerformanceClock::time_point const
+    runStartTime( PerformanceRecord::PerformanceClock::now() );
+    PerformanceRecord::PerformanceClock::time_point stageStartTime;
+    std::time_t calendarTime( time( NULL ) );
     {
-      time( &stageStartTime );
-      tunnelingCalculator->CalculateTunneling(
-                                    potentialMinimizer->GetPotentialFunction(),
-                                               potentialMinimizer->DsbVacuum(),
-                                           potentialMinimizer->PanicVacuum() );
-      time( &stageEndTime );
-      std::cout << std::endl
-      << "Tunneling calculation took " << difftime( stageEndTime,
-                                                    stageStartTime )
-      << " seconds, finished at " << ctime( &stageEndTime );
+      // The records are only set while the stages of the point run, and are
+      // unset again when the scope ends even if one of the stages throws an
+      // exception, so that nothing is recorded into them from other runs.
+      WarningLogger::ScopedRecord
+      warningRecordForPoint( warningMessagesFromLastRun );
+      PerformanceLogger::ScopedRecord
+      performanceRecordForPoint( performanceRecord );
+      std::cout
+      << std::endl
+      << "Running \"" << newInput << "\" starting at "
+      << ctime( &calendarTime );
       std::cout << std::endl;
+
+      stageStartTime = PerformanceRecord::PerformanceClock::now();
+      lagrangianParameterManager->NewParameterPoint( newInput );
+      potentialMinimizer->FindMinima( 0.0 );
+      performanceRecord.SetStageTime(
+                                PerformanceRecord::PotentialMinimizationStage,
+                                ( PerformanceRecord::PerformanceClock::now()
+                                  - stageStartTime ) );
+      calendarTime = time( NULL );
+      std::cout << std::endl
+      << "Minimization of potential took "
+      << performanceRecord.StageSeconds(
+                                PerformanceRecord::PotentialMinimizationStage )
+      << " seconds, finished at " << ctime( &calendarTime );
       std::cout << std::endl;
+
+      tunnelingTargets.clear();
+      fastestQuantumChannel = 0;
+      fastestThermalChannel = 0;
+      if( potentialMinimizer->DsbVacuumIsMetastable() )
+      {
+        stageStartTime = PerformanceRecord::PerformanceClock::now();
+        CalculateTunnelingToPanicVacua();
+        performanceRecord.SetStageTime(
+                                 PerformanceRecord::TunnelingCalculationStage,
+                                ( PerformanceRecord::PerformanceClock::now()
+                                  - stageStartTime ) );
+        calendarTime = time( NULL );
+        std::cout << std::endl
+        << "Tunneling calculation took "
+        << performanceRecord.StageSeconds(
+                                 PerformanceRecord::TunnelingCalculationStage )
+        << " seconds, finished at " << ctime( &calendarTime );
+        std::cout << std::endl;
+        std::cout << std::endl;
+      }
     }
 
-    WarningLogger::SetWarningRecord( NULL );
+    // The time for the whole point is taken before the results are prepared
+    // so that it can be included in them.
+    performanceRecord.SetStageTime( PerformanceRecord::WholePointStage,
+                                   ( PerformanceRecord::PerformanceClock::now()
+                                     - runStartTime ) );
     PrepareResultsAsXml();
+    if( !(performanceJsonFilename.empty()) )
+    {
+      AppendPerformanceJsonLine( newInput );
+    }
     std::cout
     << std::endl
     << "Result:" << std::endl << resultsFromLastRunAsXml;
     std::cout << std::endl;
 
-    time( &runEndTime );
+    calendarTime = time( NULL );
     std::cout << std::endl
-    << "Total running time was " << difftime( runEndTime,
-                                              runStartTime )
-    << " seconds, finished at " << ctime( &runEndTime );
+    << "Total running time was "
+    << performanceRecord.StageSeconds( PerformanceRecord::WholePointStage )
+    << " seconds, finished at " << ctime( &calendarTime );
     std::cout << std::endl;
     if( newInput == "internal" ){lagrangianParameterManager->ClearParameterPoint(); }
   }
@@ -205,54 +309,54 @@ namespace VevaciousPlusPlus
     }
     outputFile << "BLOCK VEVACIOUSZEROTEMPERATURE # Results at T = 0\n"
     "# [index] [verdict float]\n";
-    if( tunnelingCalculator->QuantumSurvivalProbability() >= 0.0 )
+    if( QuantumResult().QuantumSurvivalProbability() >= 0.0 )
     {
       outputFile <<  "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                            tunnelingCalculator->QuantumSurvivalProbability() )
+                                 QuantumResult().QuantumSurvivalProbability() )
       << "  # Probability of DSB vacuum surviving 4.3E17 seconds\n";
       outputFile << "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                              tunnelingCalculator->QuantumLifetimeInSeconds() )
+                                   QuantumResult().QuantumLifetimeInSeconds() )
       << "  # Tunneling time out of DSB vacuum in seconds\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfQuantumProbability() )
+                          QuantumResult().LogOfMinusLogOfQuantumProbability() )
       << "  # L = ln(-ln(P)), => P = e^(-e^L)\n";
     }
     else
     {
       outputFile << "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-          tunnelingCalculator->QuantumSurvivalProbability() )
+               QuantumResult().QuantumSurvivalProbability() )
       << "  # Not calculated: ignore this number\n"
       "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                              tunnelingCalculator->QuantumLifetimeInSeconds() )
+                                   QuantumResult().QuantumLifetimeInSeconds() )
       << "  # Not calculated: ignore this number\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfQuantumProbability() )
+                          QuantumResult().LogOfMinusLogOfQuantumProbability() )
       << "  # Not calculated: ignore this number\n";
     }
     outputFile << "BLOCK VEVACIOUSNONZEROTEMPERATURE # Results at T != 0\n"
     "# [index] [verdict float]\n";
-    if( tunnelingCalculator->ThermalSurvivalProbability() >= 0.0 )
+    if( ThermalResult().ThermalSurvivalProbability() >= 0.0 )
     {
       outputFile <<  "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                            tunnelingCalculator->ThermalSurvivalProbability() )
+                                 ThermalResult().ThermalSurvivalProbability() )
       << "  # Probability of DSB vacuum surviving thermal tunneling\n";
       outputFile << "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                tunnelingCalculator->DominantTemperatureInGigaElectronVolts() )
+                     ThermalResult().DominantTemperatureInGigaElectronVolts() )
       << "  # Dominant tunneling temperature in GeV\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfThermalProbability() )
+                          ThermalResult().LogOfMinusLogOfThermalProbability() )
       << "  # L = ln(-ln(P)), => P = e^(-e^L)\n";
     }
     else
     {
       outputFile << "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                            tunnelingCalculator->ThermalSurvivalProbability() )
+                                 ThermalResult().ThermalSurvivalProbability() )
       << "  # Not calculated: ignore this number\n"
       "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                 tunnelingCalculator->DominantTemperatureInGigaElectronVolts() )
+                     ThermalResult().DominantTemperatureInGigaElectronVolts() )
       << "  # Not calculated: ignore this number\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfThermalProbability() )
+                          ThermalResult().LogOfMinusLogOfThermalProbability() )
       << "  # Not calculated: ignore this number\n";
     }
     outputFile
@@ -304,6 +408,57 @@ namespace VevaciousPlusPlus
                                                  (*panicFields)[ fieldIndex ] )
       << "  # " << fieldNames[ fieldIndex ] << "\n";
     }
+    if( potentialMinimizer->DsbVacuumIsMetastable()
+        &&
+        ( tunnelingTargets.size() > 1 ) )
+    {
+      outputFile
+      << "BLOCK VEVACIOUSCHANNELS # Results for each panic vacuum\n"
+      "# [channel] [index] [result float]\n";
+      for( size_t channelIndex( 0 );
+           channelIndex < tunnelingTargets.size();
+           ++channelIndex )
+      {
+        TunnelingCalculator const&
+        channelCalculator( ChannelCalculator( channelIndex ) );
+        outputFile << ' ' << std::setw( 2 ) << channelIndex << "  1  "
+        << LHPC::ParsingUtilities::FormatNumberForSlha(
+                                      channelCalculator.QuantumBounceAction() )
+        << "  # Bounce action at T = 0\n"
+        << ' ' << std::setw( 2 ) << channelIndex << "  2  "
+        << LHPC::ParsingUtilities::FormatNumberForSlha(
+                        channelCalculator.LogOfMinusLogOfQuantumProbability() )
+        << "  # L = ln(-ln(P)) at T = 0\n"
+        << ' ' << std::setw( 2 ) << channelIndex << "  3  "
+        << LHPC::ParsingUtilities::FormatNumberForSlha(
+                        channelCalculator.LogOfMinusLogOfThermalProbability() )
+        << "  # L = ln(-ln(P)) at T != 0\n"
+        << ' ' << std::setw( 2 ) << channelIndex << "  4  "
+        << LHPC::ParsingUtilities::FormatNumberForSlha(
+                   channelCalculator.DominantTemperatureInGigaElectronVolts() )
+        << "  # Dominant tunneling temperature in GeV\n";
+      }
+      outputFile
+      << "BLOCK VEVACIOUSCHANNELVACUA # VEVs for each panic vacuum in GeV\n"
+      "# [channel] [index] [field VEV in GeV]\n";
+      for( size_t channelIndex( 0 );
+           channelIndex < tunnelingTargets.size();
+           ++channelIndex )
+      {
+        std::vector< double > const&
+        channelFields( tunnelingTargets[ channelIndex ].FieldConfiguration() );
+        for( size_t fieldIndex( 0 );
+             fieldIndex < fieldNames.size();
+             ++fieldIndex )
+        {
+          outputFile << ' ' << std::setw( 2 ) << channelIndex
+          << ' ' << std::setw( 2 ) << fieldIndex << "  "
+          << LHPC::ParsingUtilities::FormatNumberForSlha(
+                                                channelFields[ fieldIndex ] )
+          << "  # " << fieldNames[ fieldIndex ] << "\n";
+        }
+      }
+    }
     outputFile << "BLOCK VEVACIOUSWARNINGS # ";
     std::vector< std::string > const
     warningMessagesToReport( WarningMessagesToReport() );
@@ -327,7 +482,9 @@ namespace VevaciousPlusPlus
 
   // This creates a new LagrangianParameterManager and a new
   // PotentialFunction according to the XML elements in the file given by
-  // potentialFunctionInitializationFilename and returns pointers to them.
+  // potentialFunctionInitializationFilename and returns pointers to them,
+  // recording their classes and the arguments of the manager so that
+  // CopyFullPotentialDescription can make copies of them.
   VevaciousPlusPlus::FullPotentialDescription
   VevaciousPlusPlus::CreateFullPotentialDescription(
                    std::string const& potentialFunctionInitializationFilename )
@@ -335,9 +492,9 @@ namespace VevaciousPlusPlus
     
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.OpenRootElementOfFile( potentialFunctionInitializationFilename );
-    std::string lagrangianParameterManagerClass( "error" );
-    std::string lagrangianParameterManagerArguments( "error" );
-    std::string potentialFunctionClass( "error" );
+    lagrangianParameterManagerClass.assign( "error" );
+    lagrangianParameterManagerArguments.assign( "error" );
+    potentialFunctionClass.assign( "error" );
     std::string potentialFunctionArguments( "error" );
 
     // The root element of this file should have child elements
@@ -362,6 +519,37 @@ namespace VevaciousPlusPlus
     return FullPotentialDescription(std::move(createdLagrangianParameterManager), std::move(createdPotentialFunction)  );
   }
 
+  // This creates a new LagrangianParameterManager of the same class and with
+  // the same arguments as that of modelSource, and a copy of the
+  // PotentialFunction of modelSource which is bound to the new manager, and
+  // returns pointers to them.
+  VevaciousPlusPlus::FullPotentialDescription
+  VevaciousPlusPlus::CopyFullPotentialDescription(
+                                        VevaciousPlusPlus const& modelSource )
+  {
+    if( !(modelSource.ownedPotentialFunction) )
+    {
+      throw std::runtime_error( "Only a VevaciousPlusPlus object created from"
+                                " an initialization file can be copied." );
+    }
+    lagrangianParameterManagerClass
+    = modelSource.lagrangianParameterManagerClass;
+    lagrangianParameterManagerArguments
+    = modelSource.lagrangianParameterManagerArguments;
+    potentialFunctionClass = modelSource.potentialFunctionClass;
+    std::unique_ptr< LesHouchesAccordBlockEntryManager >
+    createdLagrangianParameterManager( CreateLagrangianParameterManager(
+                                               lagrangianParameterManagerClass,
+                                       lagrangianParameterManagerArguments ) );
+    std::unique_ptr< PotentialFromPolynomialWithMasses >
+    createdPotentialFunction( CreatePotentialFunction( potentialFunctionClass,
+                                         *(modelSource.ownedPotentialFunction),
+                                        *createdLagrangianParameterManager ) );
+    return FullPotentialDescription(
+                                 std::move( createdLagrangianParameterManager ),
+                                       std::move( createdPotentialFunction ) );
+  }
+
   // This creates a new LagrangianParameterManager based on the given
   // arguments and returns a pointer to it.
   std::unique_ptr<LesHouchesAccordBlockEntryManager>
@@ -449,6 +637,35 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This creates a copy of potentialToCopy, which must be of the class given
+  // by classChoice, bound to lagrangianParameterManager, and returns a
+  // pointer to it.
+  std::unique_ptr<PotentialFromPolynomialWithMasses>
+  VevaciousPlusPlus::CreatePotentialFunction( std::string const& classChoice,
+                      PotentialFromPolynomialWithMasses const& potentialToCopy,
+                       LagrangianParameterManager& lagrangianParameterManager )
+  {
+    if( classChoice == "FixedScaleOneLoopPotential" )
+    {
+      return Utils::make_unique<FixedScaleOneLoopPotential>( potentialToCopy,
+                                                lagrangianParameterManager );
+    }
+    else if( classChoice == "RgeImprovedOneLoopPotential" )
+    {
+      return Utils::make_unique<RgeImprovedOneLoopPotential>( potentialToCopy,
+                                                lagrangianParameterManager );
+    }
+    else
+    {
+      std::stringstream errorStream;
+      errorStream
+      << "Cannot copy a potential of class \"" << classChoice << "\"! The"
+      << " only options currently valid are \"FixedScaleOneLoopPotential\""
+      << " and \"RgeImprovedOneLoopPotential\".";
+      throw std::runtime_error( errorStream.str() );
+    }
+  }
+
   // This creates a new GradientFromStartingPoints based on the given
   // arguments and returns a pointer to it.
   std::unique_ptr<GradientFromStartingPoints>
@@ -465,10 +682,14 @@ namespace VevaciousPlusPlus
     double extremumSeparationThresholdFraction( 0.05 );
     double nonDsbRollingToDsbScalingFactor( 4.0 );
     bool global_Is_Panic = false;
+    unsigned int numberOfThreads( 1 );
     // The <ConstructorArguments> for this class should have child elements
     // <StartingPointFinderClass> and <GradientMinimizerClass>, and
-    // optionally <ExtremumSeparationThresholdFraction> and
-    // <NonDsbRollingToDsbScalingFactor>.
+    // optionally <ExtremumSeparationThresholdFraction>,
+    // <NonDsbRollingToDsbScalingFactor>, <GlobalIsPanic> and
+    // <NumberOfThreads>. <NumberOfThreads> sets how many threads share out
+    // the minimizations from the starting points, with 0 meaning as many as
+    // OpenMP would use by default.
     while( xmlParser.ReadNextElement() )
     {
       ReadClassAndArguments( xmlParser,
@@ -488,6 +709,9 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "GlobalIsPanic",
                                      global_Is_Panic );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfThreads",
+                                     numberOfThreads );
     }
     std::unique_ptr<StartingPointFinder>
     startingPointFinder(std::move( CreateStartingPointFinder( potentialFunction,
@@ -501,7 +725,8 @@ namespace VevaciousPlusPlus
                                            std::move(startingPointFinder),
                                            std::move(gradientMinimizer),
                                            extremumSeparationThresholdFraction,
-                                           nonDsbRollingToDsbScalingFactor, global_Is_Panic );
+                                           nonDsbRollingToDsbScalingFactor, global_Is_Panic,
+                                           numberOfThreads );
   }
 
   // This creates a new PolynomialAtFixedScalesSolver based on the given
@@ -517,6 +742,14 @@ namespace VevaciousPlusPlus
     bool returnOnlyPolynomialMinima( false );
     std::string polynomialSystemSolverClass( "error" );
     std::string polynomialSystemSolverArguments( "error" );
+    unsigned int numberOfThreads( 1 );
+    double neighbouringScaleDuplicateFraction( 0.01 );
+    // Optionally, <NumberOfThreads> sets how many scales may be solved at
+    // once (0 meaning as many as OpenMP would use by default), if the
+    // polynomial system solver allows it, and
+    // <NeighbouringScaleDuplicateFraction> sets how close, relative to its
+    // length, a solution has to be to one from the next-lowest scale to be
+    // left out as a duplicate.
     while( xmlParser.ReadNextElement() )
     {
       InterpretElementIfNameMatches( xmlParser,
@@ -525,6 +758,12 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "ReturnOnlyPolynomialMinima",
                                      returnOnlyPolynomialMinima );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfThreads",
+                                     numberOfThreads );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NeighbouringScaleDuplicateFraction",
+                                     neighbouringScaleDuplicateFraction );
       ReadClassAndArguments( xmlParser,
                              "PolynomialSystemSolver",
                              polynomialSystemSolverClass,
@@ -540,7 +779,9 @@ namespace VevaciousPlusPlus
                                               std::move(polynomialSystemSolver),
                                               numberOfScales,
                                               returnOnlyPolynomialMinima,
-                                  potentialFunction.NumberOfFieldVariables() );
+                                    potentialFunction.NumberOfFieldVariables(),
+                                              numberOfThreads,
+                                         neighbouringScaleDuplicateFraction );
   }
 
   // This puts the content of the current element of xmlParser into
@@ -622,7 +863,10 @@ namespace VevaciousPlusPlus
     // <TunnelingStrategy>, <SurvivalProbabilityThreshold>,
     // <CriticalTemperatureAccuracy>, <EvaporationBarrierResolution>,
     // <PathToCosmotransitions>, <PathResolution>, <MaxInnerLoops>, and
-    // <MaxOuterLoops>.
+    // <MaxOuterLoops>, and optionally <BubbleProfileCacheSize> and
+    // <BubbleCacheQuantization> as for BounceAlongPathWithThreshold, though
+    // only the bubble profiles along straight paths for the thermal action
+    // fit are kept.
     std::string tunnelingStrategy( "ThermalThenQuantum" );
     double survivalProbabilityThreshold( 0.1 );
     unsigned int thermalStraightPathFitResolution( 5 );
@@ -632,6 +876,8 @@ namespace VevaciousPlusPlus
     double vacuumSeparationFraction( 0.2 );
     unsigned int maxInnerLoops( 10 );
     unsigned int maxOuterLoops( 10 );
+    unsigned int bubbleProfileCacheSize( 64 );
+    double bubbleCacheQuantization( 1.0E-9 );
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.LoadString( constructorArguments );
     while( xmlParser.ReadNextElement() )
@@ -663,19 +909,100 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "MaxOuterLoops",
                                      maxOuterLoops );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "BubbleProfileCacheSize",
+                                     bubbleProfileCacheSize );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "BubbleCacheQuantization",
+                                     bubbleCacheQuantization );
+    }
+    CheckSurvivalProbabilityThreshold( survivalProbabilityThreshold );
+
+    std::unique_ptr<CosmoTransitionsRunner>
+    cosmoTransitionsRunner( Utils::make_unique<CosmoTransitionsRunner>(
+                               InterpretTunnelingStrategy( tunnelingStrategy ),
+                                                  survivalProbabilityThreshold,
+                                                           temperatureAccuracy,
+                                                        pathToCosmotransitions,
+                                                         resolutionOfDsbVacuum,
+                                                                 maxInnerLoops,
+                                                                 maxOuterLoops,
+                                              thermalStraightPathFitResolution,
+                                                  vacuumSeparationFraction ) );
+    cosmoTransitionsRunner->SetBubbleProfileCache( bubbleProfileCacheSize,
+                                                   bubbleCacheQuantization );
+    return cosmoTransitionsRunner;
+  }
+
+  // This creates a new PathDeformationTunneler based on the given arguments
+  // and returns a pointer to it.
+  std::unique_ptr<PathDeformationTunneler>
+  VevaciousPlusPlus::CreatePathDeformationTunneler(
+                                      std::string const& constructorArguments )
+  {
+    // The <ConstructorArguments> for this class take the same child elements
+    // as for CosmoTransitionsRunner, with the same defaults, though
+    // <PathToCosmotransitions> is not needed and so is ignored.
+    std::string tunnelingStrategy( "ThermalThenQuantum" );
+    double survivalProbabilityThreshold( 0.1 );
+    unsigned int thermalStraightPathFitResolution( 5 );
+    unsigned int temperatureAccuracy( 7 );
+    unsigned int resolutionOfDsbVacuum( 20 );
+    double vacuumSeparationFraction( 0.2 );
+    unsigned int maxInnerLoops( 10 );
+    unsigned int maxOuterLoops( 10 );
+    unsigned int bubbleProfileCacheSize( 64 );
+    double bubbleCacheQuantization( 1.0E-9 );
+    LHPC::RestrictedXmlParser xmlParser;
+    xmlParser.LoadString( constructorArguments );
+    while( xmlParser.ReadNextElement() )
+    {
+      InterpretElementIfNameMatches( xmlParser,
+                                     "TunnelingStrategy",
+                                     tunnelingStrategy );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "SurvivalProbabilityThreshold",
+                                     survivalProbabilityThreshold );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "ThermalActionResolution",
+                                     thermalStraightPathFitResolution );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "CriticalTemperatureAccuracy",
+                                     temperatureAccuracy );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "PathResolution",
+                                     resolutionOfDsbVacuum );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "MinimumVacuumSeparationFraction",
+                                     vacuumSeparationFraction );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "MaxInnerLoops",
+                                     maxInnerLoops );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "MaxOuterLoops",
+                                     maxOuterLoops );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "BubbleProfileCacheSize",
+                                     bubbleProfileCacheSize );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "BubbleCacheQuantization",
+                                     bubbleCacheQuantization );
     }
     CheckSurvivalProbabilityThreshold( survivalProbabilityThreshold );
 
-    return Utils::make_unique<CosmoTransitionsRunner>(
+    std::unique_ptr<PathDeformationTunneler>
+    pathDeformationTunneler( Utils::make_unique<PathDeformationTunneler>(
                                InterpretTunnelingStrategy( tunnelingStrategy ),
-                                       survivalProbabilityThreshold,
-                                       temperatureAccuracy,
-                                       pathToCosmotransitions,
-                                       resolutionOfDsbVacuum,
-                                       maxInnerLoops,
-                                       maxOuterLoops,
-                                       thermalStraightPathFitResolution,
-                                       vacuumSeparationFraction );
+                                                  survivalProbabilityThreshold,
+                                                           temperatureAccuracy,
+                                                         resolutionOfDsbVacuum,
+                                                                 maxInnerLoops,
+                                                                 maxOuterLoops,
+                                              thermalStraightPathFitResolution,
+                                                  vacuumSeparationFraction ) );
+    pathDeformationTunneler->SetBubbleProfileCache( bubbleProfileCacheSize,
+                                                    bubbleCacheQuantization );
+    return pathDeformationTunneler;
   }
 
   // This interprets the given string as the appropriate element of the
@@ -719,6 +1046,20 @@ namespace VevaciousPlusPlus
   VevaciousPlusPlus::CreateBounceAlongPathWithThreshold(
                                       std::string const& constructorArguments )
   {
+    // Optionally, <NumberOfThreads> sets how many temperatures may have their
+    // bounce actions calculated at the same time for thermal tunneling (0
+    // meaning the OpenMP default), each thread having its own set of path
+    // finders and bounce action calculator. Optionally,
+    // <PathPotentialTolerance> set to a positive number makes the potential
+    // along each path be sampled adaptively, starting from
+    // <InitialPathResolution> segments and halving segments where the
+    // interpolation is off by more than the tolerance times the range of the
+    // potential along the path, down to 1 / <PathResolution> of the path.
+    // Optionally, <BubbleProfileCacheSize> sets how many bubble profiles are
+    // kept to be re-used for the same vacua, temperature, and path (0
+    // turning off the cache), with <BubbleCacheQuantization> setting the
+    // fraction of the distance between the vacua to which field values are
+    // rounded when comparing them.
     std::string tunnelPathFinders( "" );
     std::string bouncePotentialFitClass( "BubbleShootingOnSpline" );
     std::string bouncePotentialFitArguments( "" );
@@ -729,6 +1070,11 @@ namespace VevaciousPlusPlus
     unsigned int resolutionOfPathPotential( 100 );
     unsigned int pathFindingTimeout( 10000000 );
     double vacuumSeparationFraction( 0.2 );
+    unsigned int numberOfThreads( 1 );
+    unsigned int initialPathResolution( 16 );
+    double pathPotentialTolerance( 0.0 );
+    unsigned int bubbleProfileCacheSize( 64 );
+    double bubbleCacheQuantization( 1.0E-9 );
 
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.LoadString( constructorArguments );
@@ -749,12 +1095,27 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "PathResolution",
                                      resolutionOfPathPotential );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "InitialPathResolution",
+                                     initialPathResolution );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "PathPotentialTolerance",
+                                     pathPotentialTolerance );
       InterpretElementIfNameMatches( xmlParser,
                                      "Timeout",
                                      pathFindingTimeout );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfThreads",
+                                     numberOfThreads );
       InterpretElementIfNameMatches( xmlParser,
                                      "MinimumVacuumSeparationFraction",
                                      vacuumSeparationFraction );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "BubbleProfileCacheSize",
+                                     bubbleProfileCacheSize );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "BubbleCacheQuantization",
+                                     bubbleCacheQuantization );
       ReadClassAndArguments( xmlParser,
                              "BouncePotentialFit",
                              bouncePotentialFitClass,
@@ -781,15 +1142,41 @@ namespace VevaciousPlusPlus
                        CreateBounceActionCalculator( bouncePotentialFitClass,
                                                bouncePotentialFitArguments ) ) );
 
-    return Utils::make_unique<BounceAlongPathWithThreshold>( std::move(pathFinders),
+    std::unique_ptr<BounceAlongPathWithThreshold>
+    bounceAlongPath( Utils::make_unique<BounceAlongPathWithThreshold>(
+                                                        std::move(pathFinders),
                                              std::move(bounceActionCalculator),
                                InterpretTunnelingStrategy( tunnelingStrategy ),
-                                             survivalProbabilityThreshold,
-                                             thermalIntegrationResolution,
-                                             temperatureAccuracy,
-                                             resolutionOfPathPotential,
-                                             pathFindingTimeout,
-                                             vacuumSeparationFraction );
+                                                  survivalProbabilityThreshold,
+                                                  thermalIntegrationResolution,
+                                                           temperatureAccuracy,
+                                                     resolutionOfPathPotential,
+                                                            pathFindingTimeout,
+                                                      vacuumSeparationFraction,
+                                                         initialPathResolution,
+                                                    pathPotentialTolerance ) );
+    bounceAlongPath->SetBubbleProfileCache( bubbleProfileCacheSize,
+                                            bubbleCacheQuantization );
+
+#ifdef _OPENMP
+    if( numberOfThreads < 1 )
+    {
+      numberOfThreads = static_cast< unsigned int >( omp_get_max_threads() );
+    }
+#endif
+    // The path finders and bounce action calculators keep state between
+    // calls, so each extra thread gets its own, made from the same XML.
+    for( unsigned int threadIndex( 1 );
+         threadIndex < numberOfThreads;
+         ++threadIndex )
+    {
+      bounceAlongPath->AddConcurrentPathFindingChain(
+                                  CreateBouncePathFinders( tunnelPathFinders ),
+                                                 CreateBounceActionCalculator(
+                                                       bouncePotentialFitClass,
+                                               bouncePotentialFitArguments ) );
+    }
+    return bounceAlongPath;
   }
 
   // This parses the XMl of tunnelPathFinders to construct a set of
@@ -847,6 +1234,9 @@ namespace VevaciousPlusPlus
   {
     // The <ConstructorArguments> for this class should have child elements
     // <NumberOfPathSegments>, <MinuitStrategy> and <MinuitTolerance>.
+    // Optionally, <NumberOfThreads> sets how many threads share out the
+    // minimizations on the hyperplanes through the nodes (0 meaning the
+    // OpenMP default).
     unsigned int numberOfPathSegments( 100 );
     unsigned int numberOfAllowedWorsenings( 3 );
     double convergenceThresholdFraction( 0.05 );
@@ -854,6 +1244,7 @@ namespace VevaciousPlusPlus
     std::string neighborDisplacementWeightsString( "0.5, 0.25" );
     unsigned int minuitStrategy( 1 );
     double minuitToleranceFraction( 0.5 );
+    unsigned int numberOfThreads( 1 );
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.LoadString( constructorArguments );
     while( xmlParser.ReadNextElement() )
@@ -861,6 +1252,9 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "NumberOfPathSegments",
                                      numberOfPathSegments );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfThreads",
+                                     numberOfThreads );
       InterpretElementIfNameMatches( xmlParser,
                                      "NumberOfAllowedWorsenings",
                                      numberOfAllowedWorsenings );
@@ -900,7 +1294,190 @@ namespace VevaciousPlusPlus
                                                      minuitDampingFraction,
                                                    neighborDisplacementWeights,
                                                      minuitStrategy,
-                                                     minuitToleranceFraction );
+                                                     minuitToleranceFraction,
+                                                     numberOfThreads );
+  }
+
+  // This reads <TunnelingClass>, <NumberOfPanicVacua>, and
+  // <PanicVacuumOrdering> from the file given by
+  // tunnelingCalculatorInitializationFilename, for creating more tunneling
+  // calculators for tunneling to more than one panic vacuum.
+  void VevaciousPlusPlus::ReadTunnelingChannelOptions(
+                 std::string const& tunnelingCalculatorInitializationFilename )
+  {
+    // Optionally, <NumberOfPanicVacua> sets how many of the panic vacua
+    // found by the potential minimizer are tunneled to, each with its own
+    // tunneling calculator, with 0 meaning all of them and 1 (the default)
+    // meaning just the panic vacuum chosen by the potential minimizer.
+    // Optionally, <PanicVacuumOrdering> set to "Depth" takes the deepest
+    // panic vacua, rather than the closest to the DSB vacuum (given by
+    // "Distance", the default).
+    std::string orderingChoice( "Distance" );
+    LHPC::RestrictedXmlParser xmlParser;
+    xmlParser.OpenRootElementOfFile(
+                                   tunnelingCalculatorInitializationFilename );
+    while( xmlParser.ReadNextElement() )
+    {
+      ReadClassAndArguments( xmlParser,
+                             "TunnelingClass",
+                             tunnelingClassChoice,
+                             tunnelingConstructorArguments );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfPanicVacua",
+                                     numberOfPanicVacuaToTunnelTo );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "PanicVacuumOrdering",
+                                     orderingChoice );
+    }
+    if( orderingChoice == "Depth" )
+    {
+      panicVacuumOrdering = OrderByDepth;
+    }
+    else if( orderingChoice == "Distance" )
+    {
+      panicVacuumOrdering = OrderByDistance;
+    }
+    else
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "\"" << orderingChoice << "\" is not a valid ordering"
+      << " of panic vacua. Valid options are \"Depth\" or \"Distance\".";
+      throw std::runtime_error( errorBuilder.str() );
+    }
+  }
+
+  // This returns the panic vacua to tunnel to, according to
+  // numberOfPanicVacuaToTunnelTo and panicVacuumOrdering.
+  std::vector< PotentialMinimum > VevaciousPlusPlus::ChoosePanicVacua() const
+  {
+    // Without the class of tunnelingCalculator, no more calculators can be
+    // created, so only the panic vacuum chosen by potentialMinimizer can be
+    // tunneled to.
+    if( ( numberOfPanicVacuaToTunnelTo == 1 )
+        ||
+        tunnelingClassChoice.empty() )
+    {
+      return std::vector< PotentialMinimum >( 1,
+                                           potentialMinimizer->PanicVacuum() );
+    }
+    std::vector< PotentialMinimum >
+    panicVacua( potentialMinimizer->PanicVacua() );
+    PotentialMinimum const& dsbVacuum( potentialMinimizer->DsbVacuum() );
+    if( panicVacuumOrdering == OrderByDepth )
+    {
+      std::stable_sort( panicVacua.begin(),
+                        panicVacua.end(),
+                        []( PotentialMinimum const& firstVacuum,
+                            PotentialMinimum const& secondVacuum )
+                        { return ( firstVacuum.PotentialValue()
+                                   < secondVacuum.PotentialValue() ); } );
+    }
+    else
+    {
+      std::stable_sort( panicVacua.begin(),
+                        panicVacua.end(),
+                        [ &dsbVacuum ]( PotentialMinimum const& firstVacuum,
+                                        PotentialMinimum const& secondVacuum )
+                        { return ( firstVacuum.SquareDistanceTo( dsbVacuum )
+                                   < secondVacuum.SquareDistanceTo(
+                                                       dsbVacuum ) ); } );
+    }
+    if( ( numberOfPanicVacuaToTunnelTo > 0 )
+        &&
+        ( panicVacua.size() > numberOfPanicVacuaToTunnelTo ) )
+    {
+      panicVacua.resize( numberOfPanicVacuaToTunnelTo );
+    }
+    return panicVacua;
+  }
+
+  // This calculates tunneling from the DSB vacuum to each of the vacua
+  // chosen by ChoosePanicVacua, each with its own tunneling calculator, at
+  // the same time as far as possible, and then sets fastestQuantumChannel and
+  // fastestThermalChannel to be the indices of the channels with the shortest
+  // lifetime at zero temperature and the lowest survival probability at
+  // non-zero temperatures respectively.
+  void VevaciousPlusPlus::CalculateTunnelingToPanicVacua()
+  {
+    tunnelingTargets = ChoosePanicVacua();
+    while( ( additionalTunnelingCalculators.size() + 1 )
+           < tunnelingTargets.size() )
+    {
+      additionalTunnelingCalculators.push_back( CreateTunnelingCalculator(
+                                                          tunnelingClassChoice,
+                                             tunnelingConstructorArguments ) );
+    }
+    if( tunnelingTargets.size() > 1 )
+    {
+      std::cout << std::endl
+      << "Calculating tunneling to " << tunnelingTargets.size()
+      << " panic vacua.";
+      std::cout << std::endl;
+    }
+
+    // Exceptions cannot leave an OpenMP loop, so they are caught and the
+    // first is thrown again once all the channels have finished.
+    int const
+    numberOfChannels( static_cast< int >( tunnelingTargets.size() ) );
+    std::vector< std::exception_ptr > channelExceptions( numberOfChannels );
+#pragma omp parallel for schedule( dynamic )
+    for( int channelIndex = 0;
+         channelIndex < numberOfChannels;
+         ++channelIndex )
+    {
+      try
+      {
+        ChannelCalculator( channelIndex ).CalculateTunneling(
+                                    potentialMinimizer->GetPotentialFunction(),
+                                               potentialMinimizer->DsbVacuum(),
+                                          tunnelingTargets[ channelIndex ] );
+      }
+      catch( ... )
+      {
+        channelExceptions[ channelIndex ] = std::current_exception();
+      }
+    }
+    for( std::vector< std::exception_ptr >::const_iterator
+         channelException( channelExceptions.begin() );
+         channelException != channelExceptions.end();
+         ++channelException )
+    {
+      if( *channelException )
+      {
+        std::rethrow_exception( *channelException );
+      }
+    }
+
+    // The decay is dominated by the fastest channel, so the results are
+    // taken from that channel, separately for zero and non-zero
+    // temperatures, as each channel might not calculate both.
+    fastestQuantumChannel = 0;
+    fastestThermalChannel = 0;
+    for( size_t channelIndex( 1 );
+         channelIndex < tunnelingTargets.size();
+         ++channelIndex )
+    {
+      TunnelingCalculator const&
+      channelCalculator( ChannelCalculator( channelIndex ) );
+      if( ( channelCalculator.QuantumSurvivalProbability() >= 0.0 )
+          &&
+          ( ( QuantumResult().QuantumSurvivalProbability() < 0.0 )
+            ||
+            ( channelCalculator.QuantumLifetimeInSeconds()
+              < QuantumResult().QuantumLifetimeInSeconds() ) ) )
+      {
+        fastestQuantumChannel = channelIndex;
+      }
+      if( ( channelCalculator.ThermalSurvivalProbability() >= 0.0 )
+          &&
+          ( ( ThermalResult().ThermalSurvivalProbability() < 0.0 )
+            ||
+            ( channelCalculator.LogOfMinusLogOfThermalProbability()
+              > ThermalResult().LogOfMinusLogOfThermalProbability() ) ) )
+      {
+        fastestThermalChannel = channelIndex;
+      }
+    }
   }
 
   // This prepares the results in XML format, stored in resultsAsXml;
@@ -927,19 +1504,19 @@ namespace VevaciousPlusPlus
                                                                  "PanicVacuum",
                                                                   fieldNames )
       << "\n";
-      if( tunnelingCalculator->QuantumSurvivalProbability() >= 0.0 )
+      if( QuantumResult().QuantumSurvivalProbability() >= 0.0 )
       {
         xmlBuilder << "  <ZeroTemperatureDsbSurvival>\n"
         << "    <DsbSurvivalProbability>\n"
-        << "      " << tunnelingCalculator->QuantumSurvivalProbability()
+        << "      " << QuantumResult().QuantumSurvivalProbability()
         << "\n"
         << "    </DsbSurvivalProbability>\n"
         << "    <LogOfMinusLogOfDsbSurvival>\n"
-        << "      " << tunnelingCalculator->LogOfMinusLogOfQuantumProbability()
+        << "      " << QuantumResult().LogOfMinusLogOfQuantumProbability()
         << " <!-- this = ln(-ln(P)), so P = e^(-e^this)) -->\n"
         << "    </LogOfMinusLogOfDsbSurvival>\n"
         << "    <DsbLifetime>\n"
-        << "      " << tunnelingCalculator->QuantumLifetimeInSeconds()
+        << "      " << QuantumResult().QuantumLifetimeInSeconds()
         << " <!-- in seconds; age of observed Universe is 4.3E+17s -->\n"
         << "    </DsbLifetime>\n"
         "  </ZeroTemperatureDsbSurvival>\n";
@@ -949,20 +1526,20 @@ namespace VevaciousPlusPlus
         xmlBuilder << "  <!-- Survival probability at zero temperature not"
         << " calculated. -->\n";
       }
-      if( tunnelingCalculator->ThermalSurvivalProbability() >= 0.0 )
+      if( ThermalResult().ThermalSurvivalProbability() >= 0.0 )
       {
         xmlBuilder << "  <NonZeroTemperatureDsbSurvival>\n"
         << "    <DsbSurvivalProbability>\n"
-        << "      " << tunnelingCalculator->ThermalSurvivalProbability()
+        << "      " << ThermalResult().ThermalSurvivalProbability()
         << "\n"
         << "    </DsbSurvivalProbability>\n"
         << "    <LogOfMinusLogOfDsbSurvival>\n"
-        << "      " << tunnelingCalculator->LogOfMinusLogOfThermalProbability()
+        << "      " << ThermalResult().LogOfMinusLogOfThermalProbability()
         << " <!-- this = ln(-ln(P)), so P = e^(-e^this)) --> \n"
         << "    </LogOfMinusLogOfDsbSurvival>\n"
         << "    <DominantTunnelingTemperature>\n"
         << "      "
-        << tunnelingCalculator->DominantTemperatureInGigaElectronVolts()
+        << ThermalResult().DominantTemperatureInGigaElectronVolts()
         << " <!-- in GeV -->\n"
         << "    </DominantTunnelingTemperature>\n"
         << "  </NonZeroTemperatureDsbSurvival>\n";
@@ -972,8 +1549,91 @@ namespace VevaciousPlusPlus
         xmlBuilder << "  <!-- Survival probability at non-zero temperatures"
         << " not calculated. -->\n";
       }
+      if( tunnelingTargets.size() > 1 )
+      {
+        xmlBuilder << "  <TunnelingChannels>\n";
+        for( size_t channelIndex( 0 );
+             channelIndex < tunnelingTargets.size();
+             ++channelIndex )
+        {
+          TunnelingCalculator const&
+          channelCalculator( ChannelCalculator( channelIndex ) );
+          xmlBuilder << "    <TunnelingChannel>\n"
+          << "      <ChannelIndex>\n"
+          << "        " << channelIndex << "\n"
+          << "      </ChannelIndex>\n"
+          << tunnelingTargets[ channelIndex ].AsVevaciousXmlElement(
+                                                                 "PanicVacuum",
+                                                                  fieldNames )
+          << "\n";
+          if( channelCalculator.QuantumSurvivalProbability() >= 0.0 )
+          {
+            xmlBuilder << "      <ZeroTemperatureBounceAction>\n"
+            << "        " << channelCalculator.QuantumBounceAction() << "\n"
+            << "      </ZeroTemperatureBounceAction>\n"
+            << "      <LogOfMinusLogOfZeroTemperatureSurvival>\n"
+            << "        "
+            << channelCalculator.LogOfMinusLogOfQuantumProbability() << "\n"
+            << "      </LogOfMinusLogOfZeroTemperatureSurvival>\n"
+            << "      <DsbLifetime>\n"
+            << "        " << channelCalculator.QuantumLifetimeInSeconds()
+            << " <!-- in seconds -->\n"
+            << "      </DsbLifetime>\n";
+          }
+          if( channelCalculator.ThermalSurvivalProbability() >= 0.0 )
+          {
+            xmlBuilder << "      <LogOfMinusLogOfNonZeroTemperatureSurvival>\n"
+            << "        "
+            << channelCalculator.LogOfMinusLogOfThermalProbability() << "\n"
+            << "      </LogOfMinusLogOfNonZeroTemperatureSurvival>\n"
+            << "      <DominantTunnelingTemperature>\n"
+            << "        "
+            << channelCalculator.DominantTemperatureInGigaElectronVolts()
+            << " <!-- in GeV -->\n"
+            << "      </DominantTunnelingTemperature>\n";
+          }
+          xmlBuilder << "    </TunnelingChannel>\n";
+        }
+        xmlBuilder << "    <FastestZeroTemperatureChannel>\n"
+        << "      " << fastestQuantumChannel << "\n"
+        << "    </FastestZeroTemperatureChannel>\n"
+        << "    <FastestNonZeroTemperatureChannel>\n"
+        << "      " << fastestThermalChannel << "\n"
+        << "    </FastestNonZeroTemperatureChannel>\n"
+        << "  </TunnelingChannels>\n";
+      }
+      // The bubble profile cache counts are summed over all the channels.
+      long bubbleProfileCacheHits( 0 );
+      long bubbleProfileCacheMisses( 0 );
+      for( size_t channelIndex( 0 );
+           channelIndex < tunnelingTargets.size();
+           ++channelIndex )
+      {
+        TunnelingCalculator const&
+        channelCalculator( ChannelCalculator( channelIndex ) );
+        if( channelCalculator.BubbleProfileCacheHits() >= 0 )
+        {
+          bubbleProfileCacheHits += channelCalculator.BubbleProfileCacheHits();
+          bubbleProfileCacheMisses
+          += channelCalculator.BubbleProfileCacheMisses();
+        }
+      }
+      if( tunnelingCalculator->BubbleProfileCacheHits() >= 0 )
+      {
+        xmlBuilder << "  <BubbleProfileCache>\n"
+        << "    <Hits>\n"
+        << "      " << bubbleProfileCacheHits
+        << " <!-- bubble profiles re-used rather than calculated -->\n"
+        << "    </Hits>\n"
+        << "    <Misses>\n"
+        << "      " << bubbleProfileCacheMisses
+        << "\n"
+        << "    </Misses>\n"
+        << "  </BubbleProfileCache>\n";
+      }
     }
-    xmlBuilder << "  <WarningMessages>";
+    xmlBuilder << performanceRecord.AsXmlElement( 2 )
+    << "  <WarningMessages>";
     std::vector< std::string > const
     warningMessagesToReport( WarningMessagesToReport() );
     if( warningMessagesToReport.empty() )
@@ -998,4 +1658,31 @@ namespace VevaciousPlusPlus
     resultsFromLastRunAsXml.assign( xmlBuilder.str() );
   }
 
+  // This appends performanceRecord as a line of JSON to the file named by
+  // performanceJsonFilename, with pointName identifying the run. Several
+  // objects may append to the same file at once, so each line is written in
+  // a critical section in a single write.
+  void VevaciousPlusPlus::AppendPerformanceJsonLine(
+                                          std::string const& pointName ) const
+  {
+    std::string const
+    jsonLine( performanceRecord.AsJsonLine( pointName ) + "\n" );
+#pragma omp critical( PerformanceJsonWriting )
+    {
+      std::ofstream jsonFile( performanceJsonFilename.c_str(),
+                              std::ios::app );
+      if( jsonFile.good() )
+      {
+        jsonFile.write( jsonLine.data(),
+                        jsonLine.size() );
+      }
+      else
+      {
+        std::cout << std::endl << "Could not open \""
+        << performanceJsonFilename << "\" to append performance record."
+        << std::endl;
+      }
+    }
+  }
+
 } /* namespace VevaciousPlusPlus */
@@ -8,13 +8,67 @@
 
 #include "VevaciousPlusPlus.hpp"
 #include "LHPC/Utilities/RestrictedXmlParser.hpp"
-#include "Utilities/FilePlaceholderManager.hpp"
+#include "Utilities/ScanWorkQueue.hpp"
+#include <memory>
+#include <exception>
+#include <vector>
+
+
+// This throws the first exception in workerExceptions, if there is one.
+void RethrowFirstException(
+                    std::vector< std::exception_ptr > const& workerExceptions )
+{
+  for( std::vector< std::exception_ptr >::const_iterator
+       workerException( workerExceptions.begin() );
+       workerException != workerExceptions.end();
+       ++workerException )
+  {
+    if( *workerException )
+    {
+      std::rethrow_exception( *workerException );
+    }
+  }
+}
 
 
 int main( int argumentCount,
           char** argumentCharArrays )
 {
-  if( argumentCount != 2 )
+  // Optionally, "--threads N" before or after the name of the input file sets
+  // how many VevaciousPlusPlus objects work through the files of
+  // <ParameterPointSet> elements at the same time, each on its own thread.
+  std::string inputFilename( "" );
+  int numberOfThreads( 1 );
+  bool argumentsAreValid( true );
+  for( int argumentIndex( 1 );
+       argumentIndex < argumentCount;
+       ++argumentIndex )
+  {
+    std::string const argumentString( argumentCharArrays[ argumentIndex ] );
+    if( argumentString == "--threads" )
+    {
+      // A trailing "--threads" without a number is an error rather than the
+      // name of the input file.
+      if( ( argumentIndex + 1 ) < argumentCount )
+      {
+        numberOfThreads = atoi( argumentCharArrays[ ++argumentIndex ] );
+        argumentsAreValid = ( argumentsAreValid && ( numberOfThreads > 0 ) );
+      }
+      else
+      {
+        argumentsAreValid = false;
+      }
+    }
+    else if( inputFilename.empty() )
+    {
+      inputFilename.assign( argumentString );
+    }
+    else
+    {
+      argumentsAreValid = false;
+    }
+  }
+  if( !argumentsAreValid || inputFilename.empty() )
   {
     std::cout
     << std::endl
@@ -25,10 +79,13 @@ int main( int argumentCount,
     << " \"bin/VevaciousPlusPlusMainInput.xml\", which has comments describing"
     << " each of the elements.";
     std::cout << std::endl;
+    std::cout << "Optionally, \"--threads N\" runs the files of"
+    << " <ParameterPointSet> elements with N VevaciousPlusPlus objects at the"
+    << " same time, each on its own thread.";
+    std::cout << std::endl;
   }
   else
   {
-    std::string inputFilename( argumentCharArrays[ 1 ] );
     std::string initializationFile( "" );
     std::vector< std::pair< std::string, std::string > > parameterPoints;
     LHPC::RestrictedXmlParser xmlParser;
@@ -56,14 +113,49 @@ int main( int argumentCount,
     // according to the XML input file. Alternatively, one can create the
     // PotentialMinimizer and TunnelingCalculator components externally and
     // pass them to the other constructor.
-    VevaciousPlusPlus::VevaciousPlusPlus
-    vevaciousPlusPlus( initializationFile );
+    // With more than one thread, each thread has its own VevaciousPlusPlus
+    // object, as each has its own Lagrangian parameters for its current
+    // point, and the potential function is bound to them. Only the first
+    // object reads the model file, and the others copy its parsed potential
+    // function, binding their copies to their own Lagrangian parameter
+    // managers. The other objects are created at the same time, and any
+    // parallel loops within them run on the thread of their object unless
+    // nested OpenMP parallelism has been turned on.
+    std::vector< std::unique_ptr< VevaciousPlusPlus::VevaciousPlusPlus > >
+    vevaciousInstances( numberOfThreads );
+    std::vector< std::exception_ptr > workerExceptions( numberOfThreads );
+    vevaciousInstances.front().reset(
+                new VevaciousPlusPlus::VevaciousPlusPlus( initializationFile ) );
+    VevaciousPlusPlus::VevaciousPlusPlus const&
+    modelSource( *(vevaciousInstances.front()) );
+#pragma omp parallel for schedule( static, 1 ) num_threads( numberOfThreads ) \
+                         if( numberOfThreads > 2 )
+    for( int workerIndex = 1;
+         workerIndex < numberOfThreads;
+         ++workerIndex )
+    {
+      try
+      {
+        vevaciousInstances[ workerIndex ].reset(
+                                      new VevaciousPlusPlus::VevaciousPlusPlus(
+                                                            initializationFile,
+                                                               modelSource ) );
+      }
+      catch( ... )
+      {
+        workerExceptions[ workerIndex ] = std::current_exception();
+      }
+    }
+    RethrowFirstException( workerExceptions );
+    VevaciousPlusPlus::VevaciousPlusPlus&
+    vevaciousPlusPlus( *(vevaciousInstances.front()) );
 
     std::string runPointInput( "" );
     std::string outputFilename( "" );
     bool appendLhaOutputToLhaInput( false );
     std::string inputFolder( "" );
     std::string outputFolder( "" );
+    double claimLeaseInSeconds( 86400.0 );
     for( std::vector< std::pair< std::string, std::string > >::const_iterator
          parameterElement( parameterPoints.begin() );
          parameterElement != parameterPoints.end();
@@ -119,6 +211,11 @@ int main( int argumentCount,
           {
             outputFolder = xmlParser.TrimmedCurrentBody();
           }
+          else if( xmlParser.CurrentName() == "ClaimLeaseInSeconds" )
+          {
+            claimLeaseInSeconds = LHPC::ParsingUtilities::StringToDouble(
+                                             xmlParser.TrimmedCurrentBody() );
+          }
           else if( xmlParser.CurrentName() == "AppendLhaOutputToLhaInput" )
           {
             appendLhaOutputToLhaInput = true;
@@ -135,24 +232,50 @@ int main( int argumentCount,
           return EXIT_FAILURE;
         }
 
-        VevaciousPlusPlus::FilePlaceholderManager placeholderManager( "",
-                                                                ".placeholder",
-                                                                     ".vout" );
-        placeholderManager.PrepareFilenames( inputFolder,
-                                             outputFolder,
-                                             outputFolder );
-
-        while( placeholderManager.HoldNextPlace() )
+        // Each input file is claimed atomically, so any number of processes
+        // and threads can work through the same folder at the same time. A
+        // claim which is older than claimLeaseInSeconds is taken to have been
+        // left by a process which crashed, and claims are not renewed while
+        // their points run, so it must be longer than the time taken to run
+        // the slowest point. Each thread has its own queue for its own
+        // VevaciousPlusPlus object.
+#pragma omp parallel for schedule( static, 1 ) num_threads( numberOfThreads ) \
+                         if( numberOfThreads > 1 )
+        for( int workerIndex = 0;
+             workerIndex < numberOfThreads;
+             ++workerIndex )
         {
-          vevaciousPlusPlus.RunPoint( placeholderManager.CurrentInput() );
-          vevaciousPlusPlus.WriteResultsAsXmlFile(
-                                          placeholderManager.CurrentOutput() );
-          if( appendLhaOutputToLhaInput )
+          try
+          {
+            VevaciousPlusPlus::VevaciousPlusPlus&
+            workerVevacious( *(vevaciousInstances[ workerIndex ]) );
+            VevaciousPlusPlus::ScanWorkQueue workQueue( "",
+                                                        ".placeholder",
+                                                        ".vout",
+                                                        claimLeaseInSeconds );
+            workQueue.PrepareFilenames( inputFolder,
+                                        outputFolder,
+                                        outputFolder );
+
+            while( workQueue.ClaimNextPoint() )
+            {
+              workerVevacious.RunPoint( workQueue.CurrentInput() );
+              workerVevacious.WriteResultsAsXmlFile(
+                                                   workQueue.CurrentOutput() );
+              if( appendLhaOutputToLhaInput )
+              {
+                workerVevacious.AppendResultsToLhaFile(
+                                                    workQueue.CurrentInput() );
+              }
+              workQueue.FinishCurrentPoint();
+            }
+          }
+          catch( ... )
           {
-            vevaciousPlusPlus.AppendResultsToLhaFile(
-                                           placeholderManager.CurrentInput() );
+            workerExceptions[ workerIndex ] = std::current_exception();
           }
         }
+        RethrowFirstException( workerExceptions );
       }
     }
   }